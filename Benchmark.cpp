@@ -0,0 +1,340 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchmark.cpp
+// ============
+// render the scene offscreen and measure the frame throughput
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+#include "Profiler.h"
+#include "RingBuffer.h"
+#include "GLState.h"
+#include "FrameCapture.h"
+
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// declaration of global variables
+namespace
+{
+	// frames drawn before the measurement starts
+	const int g_WarmupFrames = 10;
+	// most frames waited for the scene textures to finish loading
+	const int g_MaxLoadingFrames = 5000;
+	// frames that may be queued on the GPU, like a swap chain
+	const int g_FramesInFlight = 3;
+
+	// one submitted frame waiting for the GPU
+	struct FRAME_FENCE
+	{
+		GLsync fence;
+		double startTime;
+	};
+}
+
+/***********************************************************
+ *  Benchmark()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+Benchmark::Benchmark(SceneManager* pSceneManager, ViewManager* pViewManager)
+{
+	m_pSceneManager = pSceneManager;
+	m_pViewManager = pViewManager;
+	m_framebuffer = 0;
+	m_colorBuffer = 0;
+	m_depthBuffer = 0;
+	m_latencyBudget = 0.0;
+}
+
+/***********************************************************
+ *  ~Benchmark()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+Benchmark::~Benchmark()
+{
+	DestroyFramebuffer();
+	m_pSceneManager = NULL;
+	m_pViewManager = NULL;
+}
+
+/***********************************************************
+ *  Run()
+ *
+ *  This method is used for rendering the scene offscreen for
+ *  the passed in number of frames.  The scene textures are
+ *  loaded and a few frames are drawn first, so that only the
+ *  steady state is measured.
+ ***********************************************************/
+bool Benchmark::Run(int width, int height, int frameCount)
+{
+	if ((NULL == m_pSceneManager) || (NULL == m_pViewManager) || (frameCount <= 0))
+	{
+		return(false);
+	}
+
+	if (CreateFramebuffer(width, height) == false)
+	{
+		return(false);
+	}
+	m_pViewManager->SetViewSize(width, height);
+	glViewport(0, 0, width, height);
+
+	// stream in the scene textures and warm up the driver
+	int loadingFrames = 0;
+	while (((loadingFrames < g_WarmupFrames) || (m_pSceneManager->GetPendingTextureCount() > 0)) &&
+		(loadingFrames < g_MaxLoadingFrames))
+	{
+		RenderFrame();
+		glFinish();
+		loadingFrames++;
+	}
+	// a replay is measured from its first frame
+	FrameCapture::RewindReplay();
+
+	std::deque<FRAME_FENCE> pendingFrames;
+	std::vector<double> latencies;
+	latencies.reserve(frameCount);
+
+	double benchmarkStart = glfwGetTime();
+	for (int i = 0; i < frameCount; i++)
+	{
+		FRAME_FENCE frame;
+		frame.startTime = glfwGetTime();
+
+		Profiler::BeginFrame();
+		RenderFrame();
+		Profiler::EndFrame();
+
+		frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		pendingFrames.push_back(frame);
+
+		// wait for the oldest frame once too many are queued,
+		// and collect any other frames that are already done
+		while (pendingFrames.size() > 0)
+		{
+			GLuint64 timeout = (pendingFrames.size() > g_FramesInFlight) ? 1000000000 : 0;
+			GLenum result = glClientWaitSync(pendingFrames.front().fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+			if ((result != GL_ALREADY_SIGNALED) && (result != GL_CONDITION_SATISFIED))
+			{
+				break;
+			}
+			latencies.push_back((glfwGetTime() - pendingFrames.front().startTime) * 1000.0);
+			glDeleteSync(pendingFrames.front().fence);
+			pendingFrames.pop_front();
+		}
+	}
+
+	// finish the frames that are still queued
+	while (pendingFrames.size() > 0)
+	{
+		glClientWaitSync(pendingFrames.front().fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+		latencies.push_back((glfwGetTime() - pendingFrames.front().startTime) * 1000.0);
+		glDeleteSync(pendingFrames.front().fence);
+		pendingFrames.pop_front();
+	}
+	double benchmarkSeconds = glfwGetTime() - benchmarkStart;
+
+	const SceneManager::RENDER_STATS& renderStats = m_pSceneManager->GetRenderStats();
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << "INFO: benchmark " << width << "x" << height << ", " << frameCount << " frames in " << benchmarkSeconds << " s" << std::endl;
+	std::cout << "INFO: frames per second: " << ((benchmarkSeconds > 0.0) ? frameCount / benchmarkSeconds : 0.0) << std::endl;
+	std::cout << "INFO: frame latency ms p50 " << Profiler::GetPercentile(latencies, 50.0)
+		<< " p95 " << Profiler::GetPercentile(latencies, 95.0)
+		<< " p99 " << Profiler::GetPercentile(latencies, 99.0)
+		<< " max " << Profiler::GetPercentile(latencies, 100.0) << std::endl;
+	std::cout << std::defaultfloat;
+	std::cout << "INFO: draw calls per frame: " << renderStats.drawCalls
+		<< ", instanced objects: " << renderStats.instancedObjects
+		<< ", state changes: " << renderStats.stateChanges
+		<< ", culled objects: " << renderStats.culledObjects
+		<< ", occluded objects: " << renderStats.occludedObjects
+		<< ", reduced detail objects: " << renderStats.reducedDetailObjects
+		<< ", static batched objects: " << renderStats.staticObjects
+		<< ", GPU driven objects: " << renderStats.gpuDrivenObjects
+		<< ", shader program changes: " << renderStats.programChanges << std::endl;
+	std::cout << "INFO: depth pre-pass draw calls: " << renderStats.prePassDrawCalls
+		<< ", shaded samples: " << renderStats.shadedSamples
+		<< ", shaded samples per pixel: " << renderStats.shadedSamplesPerPixel << std::endl;
+	std::cout << "INFO: shadow maps drawn: " << renderStats.shadowMapsDrawn
+		<< ", shadow draw calls: " << renderStats.shadowDrawCalls << std::endl;
+	std::cout << "INFO: GL calls per frame: " << GLState::GetIssuedCalls()
+		<< ", filtered GL calls: " << GLState::GetFilteredCalls() << std::endl;
+	std::cout << "INFO: frames that waited on the ring buffer: " << RingBuffer::GetStallCount() << std::endl;
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	DestroyFramebuffer();
+
+	double p95 = Profiler::GetPercentile(latencies, 95.0);
+	if (m_resultsFilename.empty() == false)
+	{
+		std::ofstream file(m_resultsFilename.c_str());
+		if (!file)
+		{
+			std::cout << "Could not write the benchmark results to " << m_resultsFilename << std::endl;
+		}
+		else
+		{
+			file << "# latency <p50 ms> <p95 ms> <p99 ms> <max ms>" << std::endl;
+			file << "latency " << Profiler::GetPercentile(latencies, 50.0) << " " << p95 << " "
+				<< Profiler::GetPercentile(latencies, 99.0) << " " << Profiler::GetPercentile(latencies, 100.0) << std::endl;
+		}
+	}
+
+	if ((m_latencyBudget > 0.0) && (p95 > m_latencyBudget))
+	{
+		std::cout << "ERROR: frame latency p95 " << p95 << " ms is over the budget of "
+			<< m_latencyBudget << " ms" << std::endl;
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  SetLatencyBudget()
+ *
+ *  This method is used for setting the p95 frame latency in
+ *  milliseconds above which the run fails.
+ ***********************************************************/
+void Benchmark::SetLatencyBudget(double p95Ms)
+{
+	m_latencyBudget = p95Ms;
+}
+
+/***********************************************************
+ *  LoadBaseline()
+ *
+ *  This method is used for reading the results file of an
+ *  earlier run and setting the budget to its p95 latency
+ *  plus the passed in percentage.
+ ***********************************************************/
+bool Benchmark::LoadBaseline(const char* filename, double tolerancePercent)
+{
+	std::ifstream file(filename);
+	if (!file)
+	{
+		std::cout << "Could not open the benchmark baseline " << filename << std::endl;
+		return(false);
+	}
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		std::istringstream record(line);
+		std::string keyword;
+		double p50 = 0.0;
+		double p95 = 0.0;
+		if ((record >> keyword) && (keyword == "latency") && (record >> p50 >> p95))
+		{
+			m_latencyBudget = p95 * (1.0 + tolerancePercent / 100.0);
+			std::cout << "INFO: baseline p95 " << p95 << " ms, budget " << m_latencyBudget << " ms" << std::endl;
+			return(true);
+		}
+	}
+
+	std::cout << "No latency record in the benchmark baseline " << filename << std::endl;
+	return(false);
+}
+
+/***********************************************************
+ *  SetResultsFile()
+ *
+ *  This method is used for setting the file that the latency
+ *  percentiles are written into, to be used as the baseline
+ *  of later runs.
+ ***********************************************************/
+void Benchmark::SetResultsFile(const char* filename)
+{
+	m_resultsFilename = (NULL != filename) ? filename : "";
+}
+
+/***********************************************************
+ *  CreateFramebuffer()
+ *
+ *  This method is used for creating the offscreen framebuffer
+ *  with a color and a depth attachment, and binding it so
+ *  that all of the following drawing goes into it.
+ ***********************************************************/
+bool Benchmark::CreateFramebuffer(int width, int height)
+{
+	DestroyFramebuffer();
+
+	glGenRenderbuffers(1, &m_colorBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+	glGenRenderbuffers(1, &m_depthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &m_framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Could not create the " << width << "x" << height << " offscreen framebuffer" << std::endl;
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		DestroyFramebuffer();
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  DestroyFramebuffer()
+ *
+ *  This method is used for freeing the offscreen framebuffer.
+ ***********************************************************/
+void Benchmark::DestroyFramebuffer()
+{
+	if (0 != m_framebuffer)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		m_framebuffer = 0;
+	}
+	if (0 != m_colorBuffer)
+	{
+		glDeleteRenderbuffers(1, &m_colorBuffer);
+		m_colorBuffer = 0;
+	}
+	if (0 != m_depthBuffer)
+	{
+		glDeleteRenderbuffers(1, &m_depthBuffer);
+		m_depthBuffer = 0;
+	}
+}
+
+/***********************************************************
+ *  RenderFrame()
+ *
+ *  This method is used for drawing one frame the same way as
+ *  the main loop, without swapping any window buffers.
+ ***********************************************************/
+void Benchmark::RenderFrame()
+{
+	GLState::ResetFrameCounters();
+	GLState::Enable(GL_DEPTH_TEST);
+	GLState::ClearColor(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	RingBuffer::BeginFrame();
+
+	m_pViewManager->PrepareSceneView();
+	m_pSceneManager->SetViewProjection(m_pViewManager->GetViewProjection());
+	m_pSceneManager->SetLodView(m_pViewManager->GetCameraPosition(), m_pViewManager->GetFieldOfView(), m_pViewManager->GetViewHeight());
+	m_pSceneManager->SetClusterView(m_pViewManager->GetView(), m_pViewManager->GetProjection(),
+		m_pViewManager->GetNearPlane(), m_pViewManager->GetFarPlane(),
+		m_pViewManager->GetViewWidth(), m_pViewManager->GetViewHeight());
+	m_pSceneManager->RenderScene();
+	RingBuffer::EndFrame();
+}
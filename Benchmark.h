@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchmark.h
+// ============
+// render the scene offscreen and measure the frame throughput
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "SceneManager.h"
+#include "ViewManager.h"
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  Benchmark
+ *
+ *  This class contains the code for the headless mode, which
+ *  renders the prepared scene into a framebuffer object for a
+ *  fixed number of frames and reports the frames per second
+ *  and the latency of each frame, from the start of the frame
+ *  until the GPU has finished it.  With a latency budget the
+ *  run fails when the p95 latency goes over it, which turns a
+ *  replayed fly-through into a regression test.
+ ***********************************************************/
+class Benchmark
+{
+public:
+	// constructor
+	Benchmark(SceneManager* pSceneManager, ViewManager* pViewManager);
+	// destructor
+	~Benchmark();
+
+	// render the scene offscreen and print the results
+	bool Run(int width, int height, int frameCount);
+
+	// fail the run when the p95 frame latency is over this many
+	// milliseconds, or never when it is zero
+	void SetLatencyBudget(double p95Ms);
+	// set the budget from the results of an earlier run, allowing
+	// the passed in percentage of slowdown
+	bool LoadBaseline(const char* filename, double tolerancePercent);
+	// write the latency percentiles of the run into this file
+	void SetResultsFile(const char* filename);
+
+private:
+	// pointer to scene manager object
+	SceneManager* m_pSceneManager;
+	// pointer to view manager object
+	ViewManager* m_pViewManager;
+	// offscreen framebuffer and its attachments
+	GLuint m_framebuffer;
+	GLuint m_colorBuffer;
+	GLuint m_depthBuffer;
+	// p95 latency that fails the run, and the results file
+	double m_latencyBudget;
+	std::string m_resultsFilename;
+
+	// create the framebuffer object with the passed in size
+	bool CreateFramebuffer(int width, int height);
+	// free the framebuffer object
+	void DestroyFramebuffer();
+	// draw one frame of the scene into the framebuffer
+	void RenderFrame();
+};
@@ -0,0 +1,336 @@
+///////////////////////////////////////////////////////////////////////////////
+// clusteredlights.cpp
+// ============
+// assign the scene lights to view space clusters in a compute shader
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ClusteredLights.h"
+#include "GLState.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	const int CLUSTER_COUNT = ClusteredLights::GRID_TILES_X * ClusteredLights::GRID_TILES_Y * ClusteredLights::GRID_SLICES;
+	// threads in one compute work group
+	const int ASSIGN_GROUP_SIZE = 64;
+
+	static_assert(sizeof(ClusteredLights::LIGHT_RECORD) == 80, "light record must match the std430 layout");
+
+	// the compute shader that builds the view space box of each
+	// cluster and lists the lights whose range reaches the box
+	const char* g_AssignShaderSource =
+		"#version 430 core\n"
+		"layout(local_size_x = 64) in;\n"
+		"struct ClusterLight\n"
+		"{\n"
+		"    vec4 position;\n"
+		"    vec4 direction;\n"
+		"    vec4 ambientColor;\n"
+		"    vec4 diffuseColor;\n"
+		"    vec4 specularColor;\n"
+		"};\n"
+		"layout(std140, binding = 3) uniform ClusterBlock\n"
+		"{\n"
+		"    uvec4 clusterGrid;\n"
+		"    vec4 clusterDepth;\n"
+		"    vec4 clusterViewport;\n"
+		"};\n"
+		"layout(std430, binding = 7) readonly buffer ClusterLightBlock { ClusterLight clusterLights[]; };\n"
+		"layout(std430, binding = 8) writeonly buffer ClusterCountBlock { uint clusterLightCounts[]; };\n"
+		"layout(std430, binding = 9) writeonly buffer ClusterIndexBlock { uint clusterLightIndices[]; };\n"
+		"uniform mat4 view;\n"
+		"uniform mat4 inverseProjection;\n"
+		"uniform uint lightCount;\n"
+		"vec3 Unproject(vec2 ndc, float ndcDepth)\n"
+		"{\n"
+		"    vec4 point = inverseProjection * vec4(ndc, ndcDepth, 1.0);\n"
+		"    return point.xyz / point.w;\n"
+		"}\n"
+		"vec3 PointAtDepth(vec3 nearPoint, vec3 farPoint, float depth)\n"
+		"{\n"
+		"    return mix(nearPoint, farPoint, (-depth - nearPoint.z) / (farPoint.z - nearPoint.z));\n"
+		"}\n"
+		"void main()\n"
+		"{\n"
+		"    uint cluster = gl_GlobalInvocationID.x;\n"
+		"    if (cluster >= clusterGrid.x * clusterGrid.y * clusterGrid.z)\n"
+		"        return;\n"
+		"    uint x = cluster % clusterGrid.x;\n"
+		"    uint y = (cluster / clusterGrid.x) % clusterGrid.y;\n"
+		"    uint z = cluster / (clusterGrid.x * clusterGrid.y);\n"
+		"    vec2 tileMin = vec2(x, y) / vec2(clusterGrid.xy) * 2.0 - 1.0;\n"
+		"    vec2 tileMax = vec2(x + 1u, y + 1u) / vec2(clusterGrid.xy) * 2.0 - 1.0;\n"
+		"    float depthRatio = clusterDepth.y / clusterDepth.x;\n"
+		"    float sliceNear = clusterDepth.x * pow(depthRatio, float(z) / float(clusterGrid.z));\n"
+		"    float sliceFar = clusterDepth.x * pow(depthRatio, float(z + 1u) / float(clusterGrid.z));\n"
+		"    vec3 boundsMin = vec3(1e30);\n"
+		"    vec3 boundsMax = vec3(-1e30);\n"
+		"    for (int corner = 0; corner < 4; corner++)\n"
+		"    {\n"
+		"        vec2 ndc = vec2(((corner & 1) != 0) ? tileMax.x : tileMin.x, ((corner & 2) != 0) ? tileMax.y : tileMin.y);\n"
+		"        vec3 nearPoint = Unproject(ndc, -1.0);\n"
+		"        vec3 farPoint = Unproject(ndc, 1.0);\n"
+		"        vec3 sliceNearPoint = PointAtDepth(nearPoint, farPoint, sliceNear);\n"
+		"        vec3 sliceFarPoint = PointAtDepth(nearPoint, farPoint, sliceFar);\n"
+		"        boundsMin = min(boundsMin, min(sliceNearPoint, sliceFarPoint));\n"
+		"        boundsMax = max(boundsMax, max(sliceNearPoint, sliceFarPoint));\n"
+		"    }\n"
+		"    uint count = 0u;\n"
+		"    uint firstIndex = cluster * clusterGrid.w;\n"
+		"    for (uint i = 0u; (i < lightCount) && (count < clusterGrid.w); i++)\n"
+		"    {\n"
+		"        float range = clusterLights[i].position.w;\n"
+		"        if (range > 0.0)\n"
+		"        {\n"
+		"            vec3 center = (view * vec4(clusterLights[i].position.xyz, 1.0)).xyz;\n"
+		"            vec3 offset = clamp(center, boundsMin, boundsMax) - center;\n"
+		"            if (dot(offset, offset) > range * range)\n"
+		"                continue;\n"
+		"        }\n"
+		"        clusterLightIndices[firstIndex + count] = i;\n"
+		"        count++;\n"
+		"    }\n"
+		"    clusterLightCounts[cluster] = count;\n"
+		"}\n";
+}
+
+/***********************************************************
+ *  ClusteredLights()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ClusteredLights::ClusteredLights()
+{
+	m_assignProgram = 0;
+	m_viewLocation = -1;
+	m_inverseProjectionLocation = -1;
+	m_lightCountLocation = -1;
+	m_clusterBuffer = 0;
+	m_lightBuffer = 0;
+	m_countBuffer = 0;
+	m_indexBuffer = 0;
+	m_lightCount = 0;
+	m_clusterBlock = CLUSTER_BLOCK_STD140();
+}
+
+/***********************************************************
+ *  ~ClusteredLights()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ClusteredLights::~ClusteredLights()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing all of the buffers and the
+ *  compute shader program.
+ ***********************************************************/
+void ClusteredLights::Destroy()
+{
+	GLuint* buffers[4] = { &m_clusterBuffer, &m_lightBuffer, &m_countBuffer, &m_indexBuffer };
+	for (int i = 0; i < 4; i++)
+	{
+		if (0 != *buffers[i])
+		{
+			glDeleteBuffers(1, buffers[i]);
+			*buffers[i] = 0;
+		}
+	}
+
+	if (0 != m_assignProgram)
+	{
+		glDeleteProgram(m_assignProgram);
+		m_assignProgram = 0;
+	}
+	m_lightCount = 0;
+}
+
+/***********************************************************
+ *  IsSupported()
+ *
+ *  This method is used for checking whether the driver has
+ *  compute shaders and shader storage buffers.
+ ***********************************************************/
+bool ClusteredLights::IsSupported()
+{
+	return(GLEW_VERSION_4_3 || (GLEW_ARB_compute_shader && GLEW_ARB_shader_storage_buffer_object));
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for compiling and linking the light
+ *  assignment compute shader and allocating the light lists
+ *  of all the clusters.  It returns false when the shader
+ *  cannot be built, in which case the lights stay in the
+ *  light block.
+ ***********************************************************/
+bool ClusteredLights::Initialize()
+{
+	GLint success = 0;
+	GLchar infoLog[512];
+
+	if (0 != m_assignProgram)
+	{
+		return(true);
+	}
+
+	GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+	glShaderSource(shader, 1, &g_AssignShaderSource, NULL);
+	glCompileShader(shader);
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		glGetShaderInfoLog(shader, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR: light assignment compute shader compilation failed\n" << infoLog << std::endl;
+		glDeleteShader(shader);
+		return(false);
+	}
+
+	m_assignProgram = glCreateProgram();
+	glAttachShader(m_assignProgram, shader);
+	glLinkProgram(m_assignProgram);
+	glDeleteShader(shader);
+	glGetProgramiv(m_assignProgram, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		glGetProgramInfoLog(m_assignProgram, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR: light assignment compute shader linking failed\n" << infoLog << std::endl;
+		glDeleteProgram(m_assignProgram);
+		m_assignProgram = 0;
+		return(false);
+	}
+
+	m_viewLocation = glGetUniformLocation(m_assignProgram, "view");
+	m_inverseProjectionLocation = glGetUniformLocation(m_assignProgram, "inverseProjection");
+	m_lightCountLocation = glGetUniformLocation(m_assignProgram, "lightCount");
+
+	// the lists are only written and read on the GPU
+	glGenBuffers(1, &m_countBuffer);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_countBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, CLUSTER_COUNT * sizeof(GLuint), NULL, GL_DYNAMIC_COPY);
+	glGenBuffers(1, &m_indexBuffer);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_indexBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, CLUSTER_COUNT * MAX_CLUSTER_LIGHTS * sizeof(GLuint), NULL, GL_DYNAMIC_COPY);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	glGenBuffers(1, &m_clusterBuffer);
+	glBindBuffer(GL_UNIFORM_BUFFER, m_clusterBuffer);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(CLUSTER_BLOCK_STD140), NULL, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	return(true);
+}
+
+/***********************************************************
+ *  SetLights()
+ *
+ *  This method is used for uploading the records of all the
+ *  scene lights in world space.  The lights do not move, so
+ *  only the view changes between frames.
+ ***********************************************************/
+void ClusteredLights::SetLights(const std::vector<LIGHT_RECORD>& lights)
+{
+	if (0 == m_assignProgram)
+	{
+		return;
+	}
+
+	if (0 == m_lightBuffer)
+	{
+		glGenBuffers(1, &m_lightBuffer);
+	}
+
+	// keep at least one record so that the buffer can be bound
+	LIGHT_RECORD emptyRecord = {};
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_lightBuffer);
+	if (lights.size() > 0)
+	{
+		glBufferData(GL_SHADER_STORAGE_BUFFER, lights.size() * sizeof(LIGHT_RECORD), lights.data(), GL_STATIC_DRAW);
+	}
+	else
+	{
+		glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(LIGHT_RECORD), &emptyRecord, GL_STATIC_DRAW);
+	}
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	m_lightCount = (int)lights.size();
+}
+
+/***********************************************************
+ *  GetLightCount()
+ *
+ *  This method is used for getting the number of light
+ *  records.
+ ***********************************************************/
+int ClusteredLights::GetLightCount() const
+{
+	return(m_lightCount);
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for running the compute shader that
+ *  lists the lights of each cluster for the passed in view.
+ *  The cluster parameters are only uploaded again when the
+ *  projection or the view size changed, and the barrier
+ *  makes the lists visible to the following draws.
+ ***********************************************************/
+void ClusteredLights::Update(const glm::mat4& view, const glm::mat4& projection,
+	float nearPlane, float farPlane, int viewWidth, int viewHeight)
+{
+	if ((0 == m_assignProgram) || (0 == m_lightBuffer))
+	{
+		return;
+	}
+
+	// the slice of a depth d is log(d) * scale + bias
+	float depthLog = logf(farPlane / nearPlane);
+	CLUSTER_BLOCK_STD140 clusterBlock;
+	clusterBlock.grid[0] = GRID_TILES_X;
+	clusterBlock.grid[1] = GRID_TILES_Y;
+	clusterBlock.grid[2] = GRID_SLICES;
+	clusterBlock.grid[3] = MAX_CLUSTER_LIGHTS;
+	clusterBlock.depth = glm::vec4(nearPlane, farPlane,
+		(float)GRID_SLICES / depthLog, -(float)GRID_SLICES * logf(nearPlane) / depthLog);
+	clusterBlock.viewport = glm::vec4((float)viewWidth, (float)viewHeight, 0.0f, 0.0f);
+	if (memcmp(&clusterBlock, &m_clusterBlock, sizeof(CLUSTER_BLOCK_STD140)) != 0)
+	{
+		m_clusterBlock = clusterBlock;
+		glBindBuffer(GL_UNIFORM_BUFFER, m_clusterBuffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CLUSTER_BLOCK_STD140), &m_clusterBlock);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	glBindBufferBase(GL_UNIFORM_BUFFER, CLUSTER_BLOCK_BINDING, m_clusterBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_RECORD_BLOCK_BINDING, m_lightBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_COUNT_BLOCK_BINDING, m_countBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_INDEX_BLOCK_BINDING, m_indexBuffer);
+
+	glm::mat4 inverseProjection = glm::inverse(projection);
+
+	GLuint activeProgram = GLState::GetProgram();
+	GLState::UseProgram(m_assignProgram);
+	glUniformMatrix4fv(m_viewLocation, 1, GL_FALSE, glm::value_ptr(view));
+	glUniformMatrix4fv(m_inverseProjectionLocation, 1, GL_FALSE, glm::value_ptr(inverseProjection));
+	glUniform1ui(m_lightCountLocation, (GLuint)m_lightCount);
+	glDispatchCompute((CLUSTER_COUNT + ASSIGN_GROUP_SIZE - 1) / ASSIGN_GROUP_SIZE, 1, 1);
+	GLState::UseProgram(activeProgram);
+
+	// the fragment shaders read the lists written above
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
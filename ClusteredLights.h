@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////
+// clusteredlights.h
+// ============
+// assign the scene lights to view space clusters in a compute shader
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  ClusteredLights
+ *
+ *  This class contains the code for clustered forward
+ *  lighting.  The view frustum is split into a grid of
+ *  screen tiles and exponential depth slices, and each frame
+ *  a compute shader lists the lights that reach each of the
+ *  clusters, so a fragment only evaluates the lights of its
+ *  own cluster instead of every light in the scene.  Lights
+ *  with a range of zero, like the directional lights, reach
+ *  every cluster.  The fragment shader reads the lists as:
+ *
+ *    struct ClusterLight
+ *    {
+ *        vec4 position;          // w = range, 0 for every cluster
+ *        vec4 direction;         // w = focalStrength
+ *        vec4 ambientColor;
+ *        vec4 diffuseColor;
+ *        vec4 specularColor;     // w = specularIntensity
+ *    };
+ *    layout(std140) uniform ClusterBlock
+ *    {
+ *        uvec4 clusterGrid;      // tiles x, y, slices, lights per cluster
+ *        vec4 clusterDepth;      // near, far, slice scale, slice bias
+ *        vec4 clusterViewport;   // width, height
+ *    };
+ *    layout(std430) readonly buffer ClusterLightBlock { ClusterLight clusterLights[]; };
+ *    layout(std430) readonly buffer ClusterCountBlock { uint clusterLightCounts[]; };
+ *    layout(std430) readonly buffer ClusterIndexBlock { uint clusterLightIndices[]; };
+ *
+ *    float viewDepth = -(view * vec4(fragmentPosition, 1.0)).z;
+ *    uint slice = uint(max(log(viewDepth) * clusterDepth.z + clusterDepth.w, 0.0));
+ *    uvec2 tile = uvec2(gl_FragCoord.xy / clusterViewport.xy * vec2(clusterGrid.xy));
+ *    uint cluster = (min(slice, clusterGrid.z - 1u) * clusterGrid.y + tile.y) * clusterGrid.x + tile.x;
+ *    for (uint i = 0u; i < clusterLightCounts[cluster]; i++)
+ *        ... clusterLights[clusterLightIndices[cluster * clusterGrid.w + i]] ...
+ ***********************************************************/
+class ClusteredLights
+{
+public:
+	// constructor
+	ClusteredLights();
+	// destructor
+	~ClusteredLights();
+
+	// std430 layout of one light record
+	struct LIGHT_RECORD
+	{
+		glm::vec4 position;
+		glm::vec4 direction;
+		glm::vec4 ambientColor;
+		glm::vec4 diffuseColor;
+		glm::vec4 specularColor;
+	};
+
+	// size of the cluster grid
+	static const int GRID_TILES_X = 16;
+	static const int GRID_TILES_Y = 9;
+	static const int GRID_SLICES = 24;
+	// most lights listed for one cluster
+	static const int MAX_CLUSTER_LIGHTS = 128;
+
+	// uniform buffer binding point of the cluster parameters
+	static const GLuint CLUSTER_BLOCK_BINDING = 3;
+	// shader storage buffer binding points of the light lists
+	static const GLuint LIGHT_RECORD_BLOCK_BINDING = 7;
+	static const GLuint LIGHT_COUNT_BLOCK_BINDING = 8;
+	static const GLuint LIGHT_INDEX_BLOCK_BINDING = 9;
+
+	// true when the driver supports compute shaders and storage buffers
+	static bool IsSupported();
+
+	// compile the light assignment compute shader
+	bool Initialize();
+
+	// replace the light records
+	void SetLights(const std::vector<LIGHT_RECORD>& lights);
+	int GetLightCount() const;
+
+	// list the lights of every cluster of this view
+	void Update(const glm::mat4& view, const glm::mat4& projection,
+		float nearPlane, float farPlane, int viewWidth, int viewHeight);
+
+private:
+	// std140 layout of the cluster block
+	struct CLUSTER_BLOCK_STD140
+	{
+		GLuint grid[4];
+		glm::vec4 depth;
+		glm::vec4 viewport;
+	};
+
+	// compute shader program and its uniform locations
+	GLuint m_assignProgram;
+	GLint m_viewLocation;
+	GLint m_inverseProjectionLocation;
+	GLint m_lightCountLocation;
+
+	// cluster parameters and the buffers of the light lists
+	GLuint m_clusterBuffer;
+	GLuint m_lightBuffer;
+	GLuint m_countBuffer;
+	GLuint m_indexBuffer;
+	int m_lightCount;
+	// cluster parameters last uploaded
+	CLUSTER_BLOCK_STD140 m_clusterBlock;
+
+	// free all of the buffers and the program
+	void Destroy();
+};
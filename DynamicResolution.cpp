@@ -0,0 +1,327 @@
+///////////////////////////////////////////////////////////////////////////////
+// dynamicresolution.cpp
+// ============
+// render the scene at a scaled resolution that holds a frame time budget
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// frames until the timer queries measure a new size, which
+	// covers the frames the profiler reads back late
+	const int g_LatencyFrames = 8;
+	// frames measured at one size before it is changed again
+	const int g_SettleFrames = 30;
+	// weight of each new time in the smoothed time
+	const double g_Smoothing = 0.1;
+	// the time aimed for, leaving room below the budget
+	const double g_Headroom = 0.9;
+	// the scale only grows once the time is below this part of
+	// the aimed for time, so it does not flip back and forth
+	const double g_GrowThreshold = 0.8;
+	// largest change of the scale in one step
+	const float g_MaxShrinkStep = 0.85f;
+	const float g_MaxGrowStep = 1.1f;
+	// the render size is kept to a multiple of this many pixels
+	const int g_SizeAlignment = 8;
+}
+
+const float DynamicResolution::MIN_SCALE = 0.5f;
+const float DynamicResolution::MAX_SCALE = 1.0f;
+
+/***********************************************************
+ *  DynamicResolution()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+DynamicResolution::DynamicResolution()
+{
+	m_framebuffer = 0;
+	m_colorBuffer = 0;
+	m_depthBuffer = 0;
+	m_windowWidth = 0;
+	m_windowHeight = 0;
+	m_renderWidth = 0;
+	m_renderHeight = 0;
+	m_targetFrameMs = 0.0;
+	m_scale = MAX_SCALE;
+	m_smoothedMs = -1.0;
+	m_framesSinceChange = 0;
+	m_scaleChanges = 0;
+}
+
+/***********************************************************
+ *  ~DynamicResolution()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+DynamicResolution::~DynamicResolution()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for creating the framebuffer at the
+ *  window size, starting at the full scale.
+ ***********************************************************/
+bool DynamicResolution::Initialize(int windowWidth, int windowHeight, double targetFrameMs)
+{
+	m_targetFrameMs = targetFrameMs;
+	m_scale = MAX_SCALE;
+	m_smoothedMs = -1.0;
+	m_framesSinceChange = 0;
+	m_scaleChanges = 0;
+
+	return(Resize(windowWidth, windowHeight));
+}
+
+/***********************************************************
+ *  Resize()
+ *
+ *  This method is used for allocating the color and depth
+ *  attachments again when the window size changed.  A window
+ *  that is minimized has no size, and keeps the framebuffer
+ *  it had.
+ ***********************************************************/
+bool DynamicResolution::Resize(int windowWidth, int windowHeight)
+{
+	if ((windowWidth <= 0) || (windowHeight <= 0))
+	{
+		return(false);
+	}
+	if ((0 != m_framebuffer) && (windowWidth == m_windowWidth) && (windowHeight == m_windowHeight))
+	{
+		return(true);
+	}
+
+	Destroy();
+	m_windowWidth = windowWidth;
+	m_windowHeight = windowHeight;
+
+	glGenRenderbuffers(1, &m_colorBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, m_windowWidth, m_windowHeight);
+
+	glGenRenderbuffers(1, &m_depthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, m_windowWidth, m_windowHeight);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &m_framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "DynamicResolution: could not create the " << m_windowWidth << "x" << m_windowHeight << " scaled framebuffer" << std::endl;
+		Destroy();
+		return(false);
+	}
+
+	ApplyScale(m_scale);
+
+	return(true);
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for binding the framebuffer and
+ *  setting the viewport to the scaled image, so that the
+ *  clear and all of the scene drawing go into it.
+ ***********************************************************/
+void DynamicResolution::BeginFrame()
+{
+	if (0 == m_framebuffer)
+	{
+		return;
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glViewport(0, 0, m_renderWidth, m_renderHeight);
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for stretching the scaled image over
+ *  the whole window with linear filtering, and drawing into
+ *  the window again afterwards.
+ ***********************************************************/
+void DynamicResolution::EndFrame()
+{
+	if (0 == m_framebuffer)
+	{
+		return;
+	}
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+	glBlitFramebuffer(0, 0, m_renderWidth, m_renderHeight,
+		0, 0, m_windowWidth, m_windowHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(0, 0, m_windowWidth, m_windowHeight);
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for moving the scale toward the size
+ *  at which the GPU time fits the budget.  The times of the
+ *  first frames after a change still belong to the old size
+ *  and are skipped.
+ ***********************************************************/
+void DynamicResolution::Update(double gpuFrameMs)
+{
+	m_framesSinceChange++;
+	if ((gpuFrameMs < 0.0) || (m_targetFrameMs <= 0.0) || (m_framesSinceChange <= g_LatencyFrames))
+	{
+		return;
+	}
+
+	m_smoothedMs = (m_smoothedMs < 0.0) ? gpuFrameMs : m_smoothedMs + (gpuFrameMs - m_smoothedMs) * g_Smoothing;
+	if ((m_framesSinceChange < g_SettleFrames) || (m_smoothedMs <= 0.0))
+	{
+		return;
+	}
+
+	double aimedMs = m_targetFrameMs * g_Headroom;
+	bool bShrink = (m_smoothedMs > aimedMs) && (m_scale > MIN_SCALE);
+	bool bGrow = (m_smoothedMs < aimedMs * g_GrowThreshold) && (m_scale < MAX_SCALE);
+	if ((bShrink == false) && (bGrow == false))
+	{
+		return;
+	}
+
+	// the time grows with the pixels, which is the scale squared
+	float step = (float)std::sqrt(aimedMs / m_smoothedMs);
+	step = std::min(std::max(step, g_MaxShrinkStep), g_MaxGrowStep);
+	float scale = std::min(std::max(m_scale * step, MIN_SCALE), MAX_SCALE);
+
+	int renderWidth = m_renderWidth;
+	int renderHeight = m_renderHeight;
+	ApplyScale(scale);
+	if ((renderWidth != m_renderWidth) || (renderHeight != m_renderHeight))
+	{
+		m_smoothedMs = -1.0;
+		m_framesSinceChange = 0;
+		m_scaleChanges++;
+	}
+}
+
+/***********************************************************
+ *  GetRenderWidth()
+ *
+ *  This method is used for getting the width of the scaled
+ *  image in pixels.
+ ***********************************************************/
+int DynamicResolution::GetRenderWidth() const
+{
+	return(m_renderWidth);
+}
+
+/***********************************************************
+ *  GetRenderHeight()
+ *
+ *  This method is used for getting the height of the scaled
+ *  image in pixels.
+ ***********************************************************/
+int DynamicResolution::GetRenderHeight() const
+{
+	return(m_renderHeight);
+}
+
+/***********************************************************
+ *  GetScale()
+ *
+ *  This method is used for getting the scale of each side of
+ *  the image.
+ ***********************************************************/
+float DynamicResolution::GetScale() const
+{
+	return(m_scale);
+}
+
+/***********************************************************
+ *  PrintReport()
+ *
+ *  This method is used for printing the render size and how
+ *  often it changed since the last report.
+ ***********************************************************/
+void DynamicResolution::PrintReport()
+{
+	if (0 == m_framebuffer)
+	{
+		return;
+	}
+
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << "INFO: render scale " << m_scale << ", " << m_renderWidth << "x" << m_renderHeight
+		<< " of " << m_windowWidth << "x" << m_windowHeight
+		<< ", GPU ms " << ((m_smoothedMs >= 0.0) ? m_smoothedMs : 0.0)
+		<< " of " << m_targetFrameMs << ", scale changes: " << m_scaleChanges << std::endl;
+	std::cout << std::defaultfloat;
+
+	m_scaleChanges = 0;
+}
+
+/***********************************************************
+ *  ApplyScale()
+ *
+ *  This method is used for setting the render size from the
+ *  scale, kept to a multiple of a few pixels that is never
+ *  larger than the window.
+ ***********************************************************/
+void DynamicResolution::ApplyScale(float scale)
+{
+	m_scale = scale;
+
+	int sizes[2] = { m_windowWidth, m_windowHeight };
+	int* renderSizes[2] = { &m_renderWidth, &m_renderHeight };
+	for (int i = 0; i < 2; i++)
+	{
+		int size = (int)((float)sizes[i] * scale + 0.5f);
+		size = ((size + g_SizeAlignment / 2) / g_SizeAlignment) * g_SizeAlignment;
+		*renderSizes[i] = std::min(std::max(size, g_SizeAlignment), sizes[i]);
+	}
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the framebuffer and its
+ *  attachments.
+ ***********************************************************/
+void DynamicResolution::Destroy()
+{
+	if (0 != m_framebuffer)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		m_framebuffer = 0;
+	}
+	if (0 != m_colorBuffer)
+	{
+		glDeleteRenderbuffers(1, &m_colorBuffer);
+		m_colorBuffer = 0;
+	}
+	if (0 != m_depthBuffer)
+	{
+		glDeleteRenderbuffers(1, &m_depthBuffer);
+		m_depthBuffer = 0;
+	}
+}
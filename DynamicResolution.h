@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+// dynamicresolution.h
+// ============
+// render the scene at a scaled resolution that holds a frame time budget
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+/***********************************************************
+ *  DynamicResolution
+ *
+ *  This class contains the code for drawing the scene into an
+ *  offscreen framebuffer that is scaled down on a GPU that
+ *  cannot keep up, and stretching it over the window with a
+ *  filtered blit.  The framebuffer has the size of the window
+ *  and the scaled image only uses its lower left corner, so
+ *  a change of the scale never allocates anything.
+ *
+ *  The scale is picked from the GPU time of the rendering,
+ *  as measured by the profiler timer queries.  The time is
+ *  smoothed, and since it grows with the number of pixels,
+ *  the scale is changed by the square root of the ratio
+ *  between the budget and the time.  After every change the
+ *  controller waits until the timer queries measure the new
+ *  size, so that it never chases its own old results.
+ ***********************************************************/
+class DynamicResolution
+{
+public:
+	// constructor
+	DynamicResolution();
+	// destructor
+	~DynamicResolution();
+
+	// smallest and largest render scale of each side
+	static const float MIN_SCALE;
+	static const float MAX_SCALE;
+
+	// create the framebuffer for the window size, holding the
+	// rendering to the passed in GPU time per frame
+	bool Initialize(int windowWidth, int windowHeight, double targetFrameMs);
+	// allocate the framebuffer again for a new window size
+	bool Resize(int windowWidth, int windowHeight);
+
+	// draw the following frame into the scaled framebuffer
+	void BeginFrame();
+	// stretch the scaled image over the window
+	void EndFrame();
+	// pick the scale of the next frames from a GPU frame time,
+	// or a negative time when none was measured yet
+	void Update(double gpuFrameMs);
+
+	// size of the scaled image, and the scale of each side
+	int GetRenderWidth() const;
+	int GetRenderHeight() const;
+	float GetScale() const;
+
+	// print the scale and the times it was picked from
+	void PrintReport();
+
+private:
+	// framebuffer of the window size and its attachments
+	GLuint m_framebuffer;
+	GLuint m_colorBuffer;
+	GLuint m_depthBuffer;
+	int m_windowWidth;
+	int m_windowHeight;
+	int m_renderWidth;
+	int m_renderHeight;
+
+	// controller state
+	double m_targetFrameMs;
+	float m_scale;
+	double m_smoothedMs;
+	int m_framesSinceChange;
+	int m_scaleChanges;
+
+	// set the render size from the scale and the window size
+	void ApplyScale(float scale);
+	// free the framebuffer and its attachments
+	void Destroy();
+};
@@ -0,0 +1,182 @@
+///////////////////////////////////////////////////////////////////////////////
+// filewatcher.cpp
+// ============
+// notice when the files that the scene was loaded from are changed
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FileWatcher.h"
+
+#include <sys/stat.h>
+
+#include <chrono>
+
+/***********************************************************
+ *  FileWatcher()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FileWatcher::FileWatcher()
+{
+	m_intervalMs = 250;
+	m_bStopping = false;
+}
+
+/***********************************************************
+ *  ~FileWatcher()
+ *
+ *  The destructor for the class - stops the watching thread
+ ***********************************************************/
+FileWatcher::~FileWatcher()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStopping = true;
+	}
+	m_wakeUp.notify_all();
+
+	if (m_thread.joinable() == true)
+	{
+		m_thread.join();
+	}
+}
+
+/***********************************************************
+ *  Start()
+ *
+ *  This method is used for starting the thread that checks
+ *  the watched files every passed in number of milliseconds.
+ ***********************************************************/
+void FileWatcher::Start(int intervalMs)
+{
+	if (m_thread.joinable() == true)
+	{
+		return;
+	}
+
+	m_intervalMs = (intervalMs > 0) ? intervalMs : 250;
+	m_thread = std::thread(&FileWatcher::WatchLoop, this);
+}
+
+/***********************************************************
+ *  WatchFile()
+ *
+ *  This method is used for adding a file to the watched
+ *  files.  A file that is already watched is not added again,
+ *  and a file that does not exist yet is reported once it is
+ *  created.
+ ***********************************************************/
+void FileWatcher::WatchFile(const std::string& filename)
+{
+	WATCHED_FILE file;
+	file.filename = filename;
+	file.size = -1;
+	file.modifiedTime = -1;
+	file.bChanging = false;
+	GetFileState(filename, file.size, file.modifiedTime);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (int i = 0; i < m_files.size(); i++)
+	{
+		if (m_files[i].filename == filename)
+		{
+			return;
+		}
+	}
+	m_files.push_back(file);
+}
+
+/***********************************************************
+ *  TakeChangedFiles()
+ *
+ *  This method is used for getting the files that changed
+ *  since the last call.
+ ***********************************************************/
+void FileWatcher::TakeChangedFiles(std::vector<std::string>& filenames)
+{
+	filenames.clear();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	filenames.swap(m_changedFiles);
+}
+
+/***********************************************************
+ *  WatchLoop()
+ *
+ *  This method is run by the watching thread.  The files are
+ *  copied out under the lock and their state is read without
+ *  it, so that a slow file system never holds up the OpenGL
+ *  thread taking the changed files.
+ ***********************************************************/
+void FileWatcher::WatchLoop()
+{
+	while (true)
+	{
+		std::vector<WATCHED_FILE> files;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wakeUp.wait_for(lock, std::chrono::milliseconds(m_intervalMs), [this] { return(m_bStopping); });
+			if (m_bStopping == true)
+			{
+				return;
+			}
+			files = m_files;
+		}
+
+		std::vector<long long> sizes(files.size(), -1);
+		std::vector<long long> modifiedTimes(files.size(), -1);
+		for (int i = 0; i < files.size(); i++)
+		{
+			GetFileState(files[i].filename, sizes[i], modifiedTimes[i]);
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (int i = 0; (i < files.size()) && (i < m_files.size()); i++)
+		{
+			WATCHED_FILE& file = m_files[i];
+
+			// an editor may remove a file for a moment while saving it
+			if (sizes[i] < 0)
+			{
+				continue;
+			}
+
+			if ((sizes[i] != file.size) || (modifiedTimes[i] != file.modifiedTime))
+			{
+				// wait one more check for the writing to finish
+				file.size = sizes[i];
+				file.modifiedTime = modifiedTimes[i];
+				file.bChanging = true;
+			}
+			else if (file.bChanging == true)
+			{
+				m_changedFiles.push_back(file.filename);
+				file.bChanging = false;
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  GetFileState()
+ *
+ *  This method is used for reading the size and the time of
+ *  the last change of a file.
+ ***********************************************************/
+bool FileWatcher::GetFileState(const std::string& filename, long long& size, long long& modifiedTime)
+{
+	struct stat fileInfo;
+
+	if (stat(filename.c_str(), &fileInfo) != 0)
+	{
+		size = -1;
+		modifiedTime = -1;
+		return(false);
+	}
+
+	size = (long long)fileInfo.st_size;
+	modifiedTime = (long long)fileInfo.st_mtime;
+	return(true);
+}
@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////
+// filewatcher.h
+// ============
+// notice when the files that the scene was loaded from are changed
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  FileWatcher
+ *
+ *  This class contains the code for watching a list of files
+ *  for changes, so that the scene can reload them while it
+ *  runs.  A background thread compares the size and the
+ *  modification time of every file a few times per second,
+ *  and a file is only reported once it has stayed the same
+ *  for one more check, which skips the half written files of
+ *  an editor that is still saving.  The OpenGL thread takes
+ *  the changed files once per frame without waiting.
+ ***********************************************************/
+class FileWatcher
+{
+public:
+	// constructor
+	FileWatcher();
+	// destructor - stops the watching thread
+	~FileWatcher();
+
+	// check the watched files this often once started
+	void Start(int intervalMs);
+	// add a file, whose current state is taken as unchanged
+	void WatchFile(const std::string& filename);
+
+	// move out the files that changed since the last call
+	void TakeChangedFiles(std::vector<std::string>& filenames);
+
+private:
+	// one watched file and the state it was last reported in
+	struct WATCHED_FILE
+	{
+		std::string filename;
+		long long size;
+		long long modifiedTime;
+		// set when the file changed and waits for one more check
+		bool bChanging;
+	};
+
+	std::thread m_thread;
+	std::mutex m_mutex;
+	std::condition_variable m_wakeUp;
+	std::vector<WATCHED_FILE> m_files;
+	std::vector<std::string> m_changedFiles;
+	int m_intervalMs;
+	bool m_bStopping;
+
+	// check the watched files until the watcher is destroyed
+	void WatchLoop();
+	// read the size and modification time of a file, or false
+	// when it cannot be read right now
+	static bool GetFileState(const std::string& filename, long long& size, long long& modifiedTime);
+};
@@ -0,0 +1,326 @@
+///////////////////////////////////////////////////////////////////////////////
+// framecapture.cpp
+// ============
+// record the camera input of each frame and replay it deterministically
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameCapture.h"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// declaration of global variables
+namespace
+{
+	// enough digits for every float to be read back unchanged
+	const int g_FloatPrecision = 9;
+
+	// frame with no input and no pose
+	FrameCapture::CAPTURE_FRAME EmptyFrame()
+	{
+		FrameCapture::CAPTURE_FRAME frame = {};
+		return(frame);
+	}
+
+	// write a few floats of a record, each after a space
+	void WriteFloats(std::ostream& stream, const float* values, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			stream << " " << values[i];
+		}
+	}
+
+	// read a few floats of a record
+	bool ReadFloats(std::istream& stream, float* values, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			if (!(stream >> values[i]))
+			{
+				return(false);
+			}
+		}
+		return(true);
+	}
+}
+
+bool FrameCapture::m_bRecording = false;
+std::string FrameCapture::m_filename;
+std::vector<FrameCapture::CAPTURE_FRAME> FrameCapture::m_frames;
+FrameCapture::CAPTURE_FRAME FrameCapture::m_pendingInput = EmptyFrame();
+int FrameCapture::m_replayFrame = -1;
+
+/***********************************************************
+ *  StartRecording()
+ *
+ *  This method is used for collecting the frames of a new
+ *  recording.  The file is opened once here, so that a path
+ *  that cannot be written is reported before the fly-through
+ *  rather than after it.
+ ***********************************************************/
+bool FrameCapture::StartRecording(const char* filename)
+{
+	std::ofstream file(filename);
+	if (!file)
+	{
+		std::cout << "FrameCapture: could not write " << filename << std::endl;
+		return(false);
+	}
+
+	m_filename = filename;
+	m_frames.clear();
+	m_pendingInput = EmptyFrame();
+	m_replayFrame = -1;
+	m_bRecording = true;
+
+	return(true);
+}
+
+/***********************************************************
+ *  StopRecording()
+ *
+ *  This method is used for writing the recorded frames into
+ *  the file given when the recording started.
+ ***********************************************************/
+bool FrameCapture::StopRecording()
+{
+	if (m_bRecording == false)
+	{
+		return(false);
+	}
+	m_bRecording = false;
+
+	std::ofstream file(m_filename.c_str());
+	if (!file)
+	{
+		std::cout << "FrameCapture: could not write " << m_filename << std::endl;
+		return(false);
+	}
+
+	file << std::setprecision(g_FloatPrecision);
+	file << "# frame <delta time> <keys> <mouse x y> <scroll> <position> <front> <up> <zoom> <orthographic>" << std::endl;
+	for (size_t i = 0; i < m_frames.size(); i++)
+	{
+		const CAPTURE_FRAME& frame = m_frames[i];
+		file << "frame";
+		WriteFloats(file, &frame.deltaTime, 1);
+		file << " " << frame.keys;
+		WriteFloats(file, frame.mouseOffset, 2);
+		WriteFloats(file, &frame.scrollOffset, 1);
+		WriteFloats(file, frame.position, 3);
+		WriteFloats(file, frame.front, 3);
+		WriteFloats(file, frame.up, 3);
+		WriteFloats(file, &frame.zoom, 1);
+		file << " " << (frame.bOrthographic ? 1 : 0) << std::endl;
+	}
+
+	std::cout << "INFO: recorded " << m_frames.size() << " frames into " << m_filename << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  LoadReplay()
+ *
+ *  This method is used for reading a recording and starting
+ *  its replay.  A line that cannot be read is reported and
+ *  fails the whole file, so a damaged recording can never
+ *  quietly measure a different fly-through.
+ ***********************************************************/
+bool FrameCapture::LoadReplay(const char* filename)
+{
+	std::ifstream file(filename);
+	if (!file)
+	{
+		std::cout << "FrameCapture: could not open " << filename << std::endl;
+		return(false);
+	}
+
+	std::vector<CAPTURE_FRAME> frames;
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(file, line))
+	{
+		lineNumber++;
+
+		size_t comment = line.find('#');
+		if (comment != std::string::npos)
+		{
+			line.erase(comment);
+		}
+
+		std::istringstream record(line);
+		std::string keyword;
+		if (!(record >> keyword))
+		{
+			continue;
+		}
+
+		CAPTURE_FRAME frame = EmptyFrame();
+		int orthographic = 0;
+		bool bValid = (keyword == "frame") &&
+			ReadFloats(record, &frame.deltaTime, 1) &&
+			(record >> frame.keys) &&
+			ReadFloats(record, frame.mouseOffset, 2) &&
+			ReadFloats(record, &frame.scrollOffset, 1) &&
+			ReadFloats(record, frame.position, 3) &&
+			ReadFloats(record, frame.front, 3) &&
+			ReadFloats(record, frame.up, 3) &&
+			ReadFloats(record, &frame.zoom, 1) &&
+			(record >> orthographic);
+		if (bValid == false)
+		{
+			std::cout << "FrameCapture: invalid record on line " << lineNumber << " of " << filename << std::endl;
+			return(false);
+		}
+
+		frame.bOrthographic = (orthographic != 0);
+		frames.push_back(frame);
+	}
+
+	if (frames.size() == 0)
+	{
+		std::cout << "FrameCapture: no frames in " << filename << std::endl;
+		return(false);
+	}
+
+	m_bRecording = false;
+	m_frames.swap(frames);
+	m_replayFrame = 0;
+
+	std::cout << "INFO: replaying " << m_frames.size() << " frames from " << filename << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  RewindReplay()
+ *
+ *  This method is used for starting the loaded replay over
+ *  from its first frame, after the benchmark warmup frames
+ *  have used some of them.
+ ***********************************************************/
+void FrameCapture::RewindReplay()
+{
+	if ((m_bRecording == false) && (m_frames.size() > 0))
+	{
+		m_replayFrame = 0;
+	}
+}
+
+/***********************************************************
+ *  IsRecording()
+ *
+ *  This method is used for checking whether the input of the
+ *  frames is being recorded.
+ ***********************************************************/
+bool FrameCapture::IsRecording()
+{
+	return(m_bRecording);
+}
+
+/***********************************************************
+ *  IsReplaying()
+ *
+ *  This method is used for checking whether the camera is
+ *  driven by the replay, which ends after its last frame and
+ *  gives the camera back to the live input.
+ ***********************************************************/
+bool FrameCapture::IsReplaying()
+{
+	return((m_replayFrame >= 0) && (m_replayFrame < (int)m_frames.size()));
+}
+
+/***********************************************************
+ *  GetFrameCount()
+ *
+ *  This method is used for getting the number of frames that
+ *  were recorded or loaded for the replay.
+ ***********************************************************/
+int FrameCapture::GetFrameCount()
+{
+	return((int)m_frames.size());
+}
+
+/***********************************************************
+ *  AddKeys()
+ *
+ *  This method is used for adding the keys held down during
+ *  one update to the frame being recorded.
+ ***********************************************************/
+void FrameCapture::AddKeys(unsigned int keys)
+{
+	m_pendingInput.keys |= keys;
+}
+
+/***********************************************************
+ *  AddMouseMovement()
+ *
+ *  This method is used for adding the offsets of one mouse
+ *  move event to the frame being recorded.
+ ***********************************************************/
+void FrameCapture::AddMouseMovement(float xOffset, float yOffset)
+{
+	m_pendingInput.mouseOffset[0] += xOffset;
+	m_pendingInput.mouseOffset[1] += yOffset;
+}
+
+/***********************************************************
+ *  AddScroll()
+ *
+ *  This method is used for adding the offset of one scroll
+ *  wheel event to the frame being recorded.
+ ***********************************************************/
+void FrameCapture::AddScroll(float yOffset)
+{
+	m_pendingInput.scrollOffset += yOffset;
+}
+
+/***********************************************************
+ *  RecordFrame()
+ *
+ *  This method is used for finishing the recorded frame with
+ *  the passed in time step and camera pose, and the input
+ *  collected since the frame before.
+ ***********************************************************/
+void FrameCapture::RecordFrame(const CAPTURE_FRAME& pose)
+{
+	if (m_bRecording == false)
+	{
+		return;
+	}
+
+	CAPTURE_FRAME frame = pose;
+	frame.keys = m_pendingInput.keys;
+	frame.mouseOffset[0] = m_pendingInput.mouseOffset[0];
+	frame.mouseOffset[1] = m_pendingInput.mouseOffset[1];
+	frame.scrollOffset = m_pendingInput.scrollOffset;
+	m_frames.push_back(frame);
+
+	m_pendingInput = EmptyFrame();
+}
+
+/***********************************************************
+ *  NextReplayFrame()
+ *
+ *  This method is used for taking the next frame of the
+ *  replay, returning false once every frame has been used.
+ ***********************************************************/
+bool FrameCapture::NextReplayFrame(CAPTURE_FRAME& frame)
+{
+	if (IsReplaying() == false)
+	{
+		return(false);
+	}
+
+	frame = m_frames[m_replayFrame];
+	m_replayFrame++;
+
+	return(true);
+}
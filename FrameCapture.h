@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////
+// framecapture.h
+// ============
+// record the camera input of each frame and replay it deterministically
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  FrameCapture
+ *
+ *  This class is used for recording a fly-through of the
+ *  scene and playing it back.  While recording, the view
+ *  manager adds the keys, mouse movement and scrolling of
+ *  each frame, and the camera pose and the time step that
+ *  they led to.  The frames are kept in memory and written
+ *  to a text file when recording stops, one record per line:
+ *
+ *    frame <delta time> <keys> <mouse x y> <scroll>
+ *          <position x y z> <front x y z> <up x y z>
+ *          <zoom> <orthographic 0 or 1>
+ *
+ *  A replay sets the recorded pose on the camera for every
+ *  frame instead of reading the input, so the same frames
+ *  are drawn at any frame rate and on any machine.  The input
+ *  is kept with the pose to show what drove the camera.
+ ***********************************************************/
+class FrameCapture
+{
+public:
+	// keys held down during a frame
+	enum CAPTURE_KEY
+	{
+		KEY_FORWARD = 0x01,
+		KEY_BACKWARD = 0x02,
+		KEY_LEFT = 0x04,
+		KEY_RIGHT = 0x08,
+		KEY_UP = 0x10,
+		KEY_DOWN = 0x20,
+		KEY_PERSPECTIVE = 0x40,
+		KEY_ORTHOGRAPHIC = 0x80
+	};
+
+	// the input and the resulting camera pose of one frame
+	struct CAPTURE_FRAME
+	{
+		float deltaTime;
+		unsigned int keys;
+		float mouseOffset[2];
+		float scrollOffset;
+		float position[3];
+		float front[3];
+		float up[3];
+		float zoom;
+		bool bOrthographic;
+	};
+
+	// start collecting frames that are written to the file
+	static bool StartRecording(const char* filename);
+	// write the collected frames and stop recording
+	static bool StopRecording();
+	// read the frames of a recording for replaying them
+	static bool LoadReplay(const char* filename);
+	// start the replay over from its first frame
+	static void RewindReplay();
+
+	// true while frames are recorded, or replayed frames remain
+	static bool IsRecording();
+	static bool IsReplaying();
+	// number of frames recorded or loaded for the replay
+	static int GetFrameCount();
+
+	// input of the frame being recorded
+	static void AddKeys(unsigned int keys);
+	static void AddMouseMovement(float xOffset, float yOffset);
+	static void AddScroll(float yOffset);
+	// finish the recorded frame with the time step and the camera
+	// pose it led to, the input is taken from the calls above
+	static void RecordFrame(const CAPTURE_FRAME& pose);
+	// take the next frame of the replay, false once all are used
+	static bool NextReplayFrame(CAPTURE_FRAME& frame);
+
+private:
+	static bool m_bRecording;
+	static std::string m_filename;
+	static std::vector<CAPTURE_FRAME> m_frames;
+	// input collected for the frame being recorded
+	static CAPTURE_FRAME m_pendingInput;
+	// index of the next replayed frame, or -1 when not replaying
+	static int m_replayFrame;
+};
@@ -0,0 +1,235 @@
+///////////////////////////////////////////////////////////////////////////////
+// framepacer.cpp
+// ============
+// pace the frames of the main loop and measure the input latency
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FramePacer.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+// declaration of global variables
+namespace
+{
+	// longest wait for one frame fence, in nanoseconds
+	const GLuint64 g_FenceTimeout = 1000000000;
+	// the frame rate cap sleeps until this close to the deadline
+	// and spins for the rest, since sleeps overshoot, in seconds
+	const double g_SpinTime = 0.002;
+}
+
+/***********************************************************
+ *  FramePacer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FramePacer::FramePacer()
+{
+	m_frameRateCap = 0;
+	m_framesInFlight = 2;
+	m_nextFrameTime = 0.0;
+	m_inputTime = 0;
+}
+
+/***********************************************************
+ *  ~FramePacer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FramePacer::~FramePacer()
+{
+	m_pendingFrames.clear();
+	m_freeQueries.clear();
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for setting the swap interval of the
+ *  current window and the limits used by BeginFrame().  The
+ *  adaptive vsync swaps late frames right away instead of
+ *  waiting a whole refresh, and falls back to the plain vsync
+ *  when the driver does not support it.
+ ***********************************************************/
+void FramePacer::Initialize(PACING_MODE mode, int frameRateCap, int framesInFlight)
+{
+	m_frameRateCap = std::max(frameRateCap, 0);
+	m_framesInFlight = std::max(framesInFlight, 1);
+	m_nextFrameTime = glfwGetTime();
+
+	int swapInterval = 1;
+	if (mode == PACING_UNCAPPED)
+	{
+		swapInterval = 0;
+	}
+	else if (mode == PACING_ADAPTIVE_VSYNC)
+	{
+		if (glfwExtensionSupported("WGL_EXT_swap_control_tear") ||
+			glfwExtensionSupported("GLX_EXT_swap_control_tear"))
+		{
+			swapInterval = -1;
+		}
+		else
+		{
+			std::cout << "INFO: adaptive vsync is not supported, using vsync" << std::endl;
+		}
+	}
+	glfwSwapInterval(swapInterval);
+
+	std::cout << "INFO: swap interval " << swapInterval
+		<< ", frame rate cap " << m_frameRateCap
+		<< ", frames in flight " << m_framesInFlight << std::endl;
+}
+
+/***********************************************************
+ *  Shutdown()
+ *
+ *  This method is used for waiting for the queued frames and
+ *  freeing their fences and queries, while the OpenGL context
+ *  still exists.
+ ***********************************************************/
+void FramePacer::Shutdown()
+{
+	CollectFrames(0);
+
+	if (m_freeQueries.size() > 0)
+	{
+		glDeleteQueries((GLsizei)m_freeQueries.size(), m_freeQueries.data());
+		m_freeQueries.clear();
+	}
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for waiting until fewer frames than
+ *  the frames in flight are queued on the GPU and the frame
+ *  rate cap allows the next frame.  The input time is taken
+ *  last, so the caller should poll the input right after.
+ ***********************************************************/
+void FramePacer::BeginFrame()
+{
+	CollectFrames(m_framesInFlight - 1);
+	WaitForFrameRateCap();
+
+	glGetInteger64v(GL_TIMESTAMP, &m_inputTime);
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for placing the fence and the GPU
+ *  timestamp behind the swap of the frame.
+ ***********************************************************/
+void FramePacer::EndFrame()
+{
+	PENDING_FRAME frame;
+
+	if (m_freeQueries.size() > 0)
+	{
+		frame.timestampQuery = m_freeQueries.back();
+		m_freeQueries.pop_back();
+	}
+	else
+	{
+		glGenQueries(1, &frame.timestampQuery);
+	}
+	glQueryCounter(frame.timestampQuery, GL_TIMESTAMP);
+	frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	frame.inputTime = m_inputTime;
+
+	m_pendingFrames.push_back(frame);
+}
+
+/***********************************************************
+ *  CollectFrames()
+ *
+ *  This method is used for recording the latency of every
+ *  queued frame the GPU has finished.  While more than the
+ *  passed in number of frames are queued, it waits for the
+ *  oldest one.
+ ***********************************************************/
+void FramePacer::CollectFrames(int maxPending)
+{
+	while (m_pendingFrames.size() > 0)
+	{
+		PENDING_FRAME& frame = m_pendingFrames.front();
+
+		GLuint64 timeout = ((int)m_pendingFrames.size() > maxPending) ? g_FenceTimeout : 0;
+		GLenum result = glClientWaitSync(frame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+		if ((result != GL_ALREADY_SIGNALED) && (result != GL_CONDITION_SATISFIED))
+		{
+			break;
+		}
+
+		// the fence follows the timestamp, so its result is ready
+		GLint64 finishTime = 0;
+		glGetQueryObjecti64v(frame.timestampQuery, GL_QUERY_RESULT, &finishTime);
+		m_latencies.push_back((double)(finishTime - frame.inputTime) / 1000000.0);
+
+		glDeleteSync(frame.fence);
+		m_freeQueries.push_back(frame.timestampQuery);
+		m_pendingFrames.pop_front();
+	}
+}
+
+/***********************************************************
+ *  WaitForFrameRateCap()
+ *
+ *  This method is used for holding the frame back until the
+ *  start time of the frame rate cap.  A frame that starts
+ *  late moves the following start times instead of letting
+ *  the next frames catch up in a burst.
+ ***********************************************************/
+void FramePacer::WaitForFrameRateCap()
+{
+	if (m_frameRateCap <= 0)
+	{
+		return;
+	}
+
+	double now = glfwGetTime();
+	double remaining = m_nextFrameTime - now;
+	if (remaining > g_SpinTime)
+	{
+		std::this_thread::sleep_for(std::chrono::duration<double>(remaining - g_SpinTime));
+	}
+	while (glfwGetTime() < m_nextFrameTime)
+	{
+		std::this_thread::yield();
+	}
+
+	now = glfwGetTime();
+	m_nextFrameTime = std::max(m_nextFrameTime + 1.0 / m_frameRateCap, now);
+}
+
+/***********************************************************
+ *  PrintReport()
+ *
+ *  This method is used for printing the input latency of the
+ *  frames finished since the last report.
+ ***********************************************************/
+void FramePacer::PrintReport()
+{
+	if (m_latencies.size() == 0)
+	{
+		return;
+	}
+
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << "INFO: input latency ms p50 " << Profiler::GetPercentile(m_latencies, 50.0)
+		<< " p95 " << Profiler::GetPercentile(m_latencies, 95.0)
+		<< " p99 " << Profiler::GetPercentile(m_latencies, 99.0)
+		<< " max " << Profiler::GetPercentile(m_latencies, 100.0) << std::endl;
+	std::cout << std::defaultfloat;
+
+	m_latencies.clear();
+}
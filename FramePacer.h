@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////
+// framepacer.h
+// ============
+// pace the frames of the main loop and measure the input latency
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+// GLFW library
+#include "GLFW/glfw3.h"
+
+#include <deque>
+#include <vector>
+
+/***********************************************************
+ *  FramePacer
+ *
+ *  This class contains the code for deciding when the main
+ *  loop starts each frame.  It keeps at most the configured
+ *  number of frames queued on the GPU, holds a frame back to
+ *  stay under the frame rate cap, and only then lets the loop
+ *  sample the input, so that the view is built from the
+ *  freshest input possible.  The latency of every frame is
+ *  measured on the GPU clock, from the moment the input was
+ *  sampled until the GPU has finished the swapped frame,
+ *  which is the part of the input to photon latency that the
+ *  application controls.
+ ***********************************************************/
+class FramePacer
+{
+public:
+	// constructor
+	FramePacer();
+	// destructor
+	~FramePacer();
+
+	// how the swaps wait for the display
+	enum PACING_MODE
+	{
+		PACING_VSYNC,
+		PACING_ADAPTIVE_VSYNC,
+		PACING_UNCAPPED
+	};
+
+	// set the swap interval and the limits of the frame pacing,
+	// with a frame rate cap of 0 for no cap
+	void Initialize(PACING_MODE mode, int frameRateCap, int framesInFlight);
+	// free the fences and queries that are still pending
+	void Shutdown();
+
+	// wait until the next frame may start, then record the time
+	// at which the input for it is sampled
+	void BeginFrame();
+	// queue the measurement of the frame after its swap
+	void EndFrame();
+
+	// print the input latency percentiles since the last report
+	void PrintReport();
+
+private:
+	// one swapped frame waiting for the GPU
+	struct PENDING_FRAME
+	{
+		GLsync fence;
+		GLuint timestampQuery;
+		GLint64 inputTime;
+	};
+
+	// frames queued on the GPU, oldest first
+	std::deque<PENDING_FRAME> m_pendingFrames;
+	// queries of finished frames, reused for later frames
+	std::vector<GLuint> m_freeQueries;
+	// input to GPU completion latency of each finished frame in ms
+	std::vector<double> m_latencies;
+
+	int m_frameRateCap;
+	int m_framesInFlight;
+	// time the next capped frame may start, in seconds
+	double m_nextFrameTime;
+	// GPU time at which the input of this frame was sampled
+	GLint64 m_inputTime;
+
+	// collect the frames the GPU has finished, waiting for the
+	// oldest ones while more than maxPending are queued
+	void CollectFrames(int maxPending);
+	// hold the frame back until the frame rate cap allows it
+	void WaitForFrameRateCap();
+};
@@ -0,0 +1,416 @@
+///////////////////////////////////////////////////////////////////////////////
+// frustumculler.cpp
+// ============
+// find the objects inside the view frustum with a bounding volume hierarchy
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrustumCuller.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+// declaration of global variables
+namespace
+{
+	// most objects kept in one leaf node
+	const int g_MaxLeafItems = 4;
+	// plane mask with all six frustum planes still to be tested
+	const unsigned int g_AllPlanes = 0x3f;
+	// hierarchies over fewer objects are walked on one thread
+	const size_t g_ParallelQueryItems = 4096;
+
+	/***********************************************************
+	 *  MergeBounds()
+	 *
+	 *  Grow a box so that it also contains another box.
+	 ***********************************************************/
+	void MergeBounds(FrustumCuller::BOUNDS& bounds, const FrustumCuller::BOUNDS& other)
+	{
+		bounds.min = glm::min(bounds.min, other.min);
+		bounds.max = glm::max(bounds.max, other.max);
+	}
+}
+
+/***********************************************************
+ *  FrustumCuller()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrustumCuller::FrustumCuller()
+{
+	// until a frustum is set, every object is visible
+	for (int i = 0; i < 6; i++)
+	{
+		m_planes[i] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+}
+
+/***********************************************************
+ *  Build()
+ *
+ *  This method is used for building the hierarchy over the
+ *  boxes of the objects.  The passed in indices of the boxes
+ *  are the indices returned by Query().
+ ***********************************************************/
+void FrustumCuller::Build(const std::vector<BOUNDS>& bounds)
+{
+	m_nodes.clear();
+	m_itemIndices.resize(bounds.size());
+	for (int i = 0; i < m_itemIndices.size(); i++)
+	{
+		m_itemIndices[i] = i;
+	}
+
+	if (bounds.size() > 0)
+	{
+		m_nodes.reserve(2 * bounds.size() / g_MaxLeafItems + 1);
+		BuildNode(bounds, 0, (int)bounds.size());
+	}
+
+	m_itemBounds.resize(bounds.size());
+	for (int i = 0; i < m_itemIndices.size(); i++)
+	{
+		m_itemBounds[i] = bounds[m_itemIndices[i]];
+	}
+}
+
+/***********************************************************
+ *  BuildNode()
+ *
+ *  This method is used for building one node and its
+ *  children.  The objects are split at the median of their
+ *  box centers along the longest axis of the centers.
+ ***********************************************************/
+int FrustumCuller::BuildNode(const std::vector<BOUNDS>& bounds, int firstItem, int itemCount)
+{
+	int nodeIndex = (int)m_nodes.size();
+	m_nodes.push_back(BVH_NODE());
+
+	BOUNDS nodeBounds = bounds[m_itemIndices[firstItem]];
+	glm::vec3 centerMin = (nodeBounds.min + nodeBounds.max) * 0.5f;
+	glm::vec3 centerMax = centerMin;
+	for (int i = 1; i < itemCount; i++)
+	{
+		const BOUNDS& itemBounds = bounds[m_itemIndices[firstItem + i]];
+		glm::vec3 center = (itemBounds.min + itemBounds.max) * 0.5f;
+		MergeBounds(nodeBounds, itemBounds);
+		centerMin = glm::min(centerMin, center);
+		centerMax = glm::max(centerMax, center);
+	}
+
+	m_nodes[nodeIndex].bounds = nodeBounds;
+	m_nodes[nodeIndex].firstItem = firstItem;
+	m_nodes[nodeIndex].itemCount = itemCount;
+	m_nodes[nodeIndex].rightChild = -1;
+
+	glm::vec3 centerSize = centerMax - centerMin;
+	if ((itemCount <= g_MaxLeafItems) || (glm::max(centerSize.x, glm::max(centerSize.y, centerSize.z)) <= 0.0f))
+	{
+		return(nodeIndex);
+	}
+
+	int axis = 0;
+	if ((centerSize.y > centerSize.x) && (centerSize.y >= centerSize.z))
+	{
+		axis = 1;
+	}
+	else if ((centerSize.z > centerSize.x) && (centerSize.z > centerSize.y))
+	{
+		axis = 2;
+	}
+
+	int leftCount = itemCount / 2;
+	std::nth_element(
+		m_itemIndices.begin() + firstItem,
+		m_itemIndices.begin() + firstItem + leftCount,
+		m_itemIndices.begin() + firstItem + itemCount,
+		[&bounds, axis](int a, int b)
+		{
+			return((bounds[a].min[axis] + bounds[a].max[axis]) < (bounds[b].min[axis] + bounds[b].max[axis]));
+		});
+
+	BuildNode(bounds, firstItem, leftCount);
+	int rightChild = BuildNode(bounds, firstItem + leftCount, itemCount - leftCount);
+	m_nodes[nodeIndex].rightChild = rightChild;
+
+	return(nodeIndex);
+}
+
+/***********************************************************
+ *  Refit()
+ *
+ *  This method is used for recomputing the node boxes after
+ *  some of the objects moved.  Children are stored after
+ *  their parents, so one pass from the back of the node
+ *  list updates every node after its children.
+ ***********************************************************/
+void FrustumCuller::Refit(const std::vector<BOUNDS>& bounds)
+{
+	if (bounds.size() != m_itemIndices.size())
+	{
+		Build(bounds);
+		return;
+	}
+
+	for (int i = 0; i < m_itemIndices.size(); i++)
+	{
+		m_itemBounds[i] = bounds[m_itemIndices[i]];
+	}
+
+	for (int i = (int)m_nodes.size() - 1; i >= 0; i--)
+	{
+		BVH_NODE& node = m_nodes[i];
+		if (node.rightChild < 0)
+		{
+			node.bounds = m_itemBounds[node.firstItem];
+			for (int j = 1; j < node.itemCount; j++)
+			{
+				MergeBounds(node.bounds, m_itemBounds[node.firstItem + j]);
+			}
+		}
+		else
+		{
+			node.bounds = m_nodes[i + 1].bounds;
+			MergeBounds(node.bounds, m_nodes[node.rightChild].bounds);
+		}
+	}
+}
+
+/***********************************************************
+ *  SetFrustum()
+ *
+ *  This method is used for extracting the left, right,
+ *  bottom, top, near and far planes from the rows of the
+ *  combined view and projection matrix.
+ ***********************************************************/
+void FrustumCuller::SetFrustum(const glm::mat4& viewProjection)
+{
+	glm::vec4 rows[4];
+	for (int i = 0; i < 4; i++)
+	{
+		rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+	}
+
+	m_planes[0] = rows[3] + rows[0];
+	m_planes[1] = rows[3] - rows[0];
+	m_planes[2] = rows[3] + rows[1];
+	m_planes[3] = rows[3] - rows[1];
+	m_planes[4] = rows[3] + rows[2];
+	m_planes[5] = rows[3] - rows[2];
+
+	for (int i = 0; i < 6; i++)
+	{
+		float length = glm::length(glm::vec3(m_planes[i]));
+		if (length > 0.0f)
+		{
+			m_planes[i] /= length;
+		}
+	}
+}
+
+/***********************************************************
+ *  GetPlanes()
+ *
+ *  This method is used for getting the six frustum planes,
+ *  for culling that is done outside of the hierarchy.
+ ***********************************************************/
+const glm::vec4* FrustumCuller::GetPlanes() const
+{
+	return(m_planes);
+}
+
+/***********************************************************
+ *  Query()
+ *
+ *  This method is used for collecting the objects whose boxes
+ *  are not entirely outside the frustum.  Each node only tests
+ *  the planes that its parent was not already inside of.  The
+ *  hierarchies of large scenes are split into subtrees that
+ *  are walked by parallel jobs, each into its own list.
+ ***********************************************************/
+void FrustumCuller::Query(std::vector<int>& visibleItems) const
+{
+	visibleItems.clear();
+	if (m_nodes.size() == 0)
+	{
+		return;
+	}
+
+	if ((m_itemIndices.size() < g_ParallelQueryItems) || (JobSystem::GetThreadCount() == 1))
+	{
+		QueryNode(0, g_AllPlanes, visibleItems);
+		std::sort(visibleItems.begin(), visibleItems.end());
+		return;
+	}
+
+	// split the top of the tree until there are a few subtrees
+	// for every thread, so that stealing can balance them
+	std::vector<int> subtrees(1, 0);
+	size_t targetCount = (size_t)JobSystem::GetThreadCount() * 4;
+	bool bSplit = true;
+	while ((subtrees.size() < targetCount) && (bSplit == true))
+	{
+		std::vector<int> children;
+		bSplit = false;
+		for (int i = 0; i < subtrees.size(); i++)
+		{
+			const BVH_NODE& node = m_nodes[subtrees[i]];
+			if (node.rightChild < 0)
+			{
+				children.push_back(subtrees[i]);
+				continue;
+			}
+			children.push_back(subtrees[i] + 1);
+			children.push_back(node.rightChild);
+			bSplit = true;
+		}
+		subtrees.swap(children);
+	}
+
+	std::vector<std::vector<int> > subtreeItems(subtrees.size());
+	JobSystem::ParallelFor((int)subtrees.size(), 1,
+		[&](int begin, int end)
+		{
+			for (int i = begin; i < end; i++)
+			{
+				QueryNode(subtrees[i], g_AllPlanes, subtreeItems[i]);
+			}
+		});
+
+	for (int i = 0; i < subtreeItems.size(); i++)
+	{
+		visibleItems.insert(visibleItems.end(), subtreeItems[i].begin(), subtreeItems[i].end());
+	}
+	std::sort(visibleItems.begin(), visibleItems.end());
+}
+
+/***********************************************************
+ *  QueryNode()
+ *
+ *  This method is used for appending the visible objects of
+ *  one subtree, starting with the planes in the passed in
+ *  mask.  It only reads the hierarchy, so several subtrees
+ *  can be walked at the same time.
+ ***********************************************************/
+void FrustumCuller::QueryNode(int rootNode, unsigned int rootMask, std::vector<int>& visibleItems) const
+{
+	// pairs of node index and the planes still to be tested
+	int stackNodes[64];
+	unsigned int stackMasks[64];
+	int stackSize = 0;
+
+	stackNodes[stackSize] = rootNode;
+	stackMasks[stackSize] = rootMask;
+	stackSize++;
+
+	while (stackSize > 0)
+	{
+		stackSize--;
+		const BVH_NODE& node = m_nodes[stackNodes[stackSize]];
+		unsigned int planeMask = stackMasks[stackSize];
+
+		if (IsOutside(node.bounds, planeMask) == true)
+		{
+			continue;
+		}
+
+		// nodes entirely inside add all of their objects
+		if (planeMask == 0)
+		{
+			visibleItems.insert(visibleItems.end(),
+				m_itemIndices.begin() + node.firstItem,
+				m_itemIndices.begin() + node.firstItem + node.itemCount);
+			continue;
+		}
+
+		// leaves test their objects against the remaining planes
+		if ((node.rightChild < 0) || (stackSize + 2 > 64))
+		{
+			for (int i = node.firstItem; i < node.firstItem + node.itemCount; i++)
+			{
+				unsigned int itemMask = planeMask;
+				if (IsOutside(m_itemBounds[i], itemMask) == false)
+				{
+					visibleItems.push_back(m_itemIndices[i]);
+				}
+			}
+			continue;
+		}
+
+		int nodeIndex = (int)(&node - &m_nodes[0]);
+		stackNodes[stackSize] = node.rightChild;
+		stackMasks[stackSize] = planeMask;
+		stackSize++;
+		stackNodes[stackSize] = nodeIndex + 1;
+		stackMasks[stackSize] = planeMask;
+		stackSize++;
+	}
+}
+
+/***********************************************************
+ *  IsOutside()
+ *
+ *  This method is used for testing a box against the frustum
+ *  planes in the passed in mask.  The box is outside when its
+ *  corner furthest along the normal of a plane is behind it,
+ *  and entirely inside a plane when the opposite corner is in
+ *  front of it, which clears the bit of that plane.
+ ***********************************************************/
+bool FrustumCuller::IsOutside(const BOUNDS& bounds, unsigned int& planeMask) const
+{
+	for (int i = 0; i < 6; i++)
+	{
+		if ((planeMask & (1u << i)) == 0)
+		{
+			continue;
+		}
+
+		glm::vec3 normal = glm::vec3(m_planes[i]);
+		glm::vec3 farCorner = glm::vec3(
+			(normal.x >= 0.0f) ? bounds.max.x : bounds.min.x,
+			(normal.y >= 0.0f) ? bounds.max.y : bounds.min.y,
+			(normal.z >= 0.0f) ? bounds.max.z : bounds.min.z);
+		glm::vec3 nearCorner = bounds.min + bounds.max - farCorner;
+
+		if (glm::dot(normal, farCorner) + m_planes[i].w < 0.0f)
+		{
+			return(true);
+		}
+		if (glm::dot(normal, nearCorner) + m_planes[i].w >= 0.0f)
+		{
+			planeMask &= ~(1u << i);
+		}
+	}
+
+	return(false);
+}
+
+/***********************************************************
+ *  TransformBounds()
+ *
+ *  This method is used for getting the world space box that
+ *  contains a local space box after the model transformation,
+ *  by transforming the center and the half size separately.
+ ***********************************************************/
+FrustumCuller::BOUNDS FrustumCuller::TransformBounds(const BOUNDS& localBounds, const glm::mat4& model)
+{
+	glm::vec3 center = (localBounds.min + localBounds.max) * 0.5f;
+	glm::vec3 halfSize = (localBounds.max - localBounds.min) * 0.5f;
+
+	glm::vec3 worldCenter = glm::vec3(model * glm::vec4(center, 1.0f));
+	glm::vec3 worldHalfSize = glm::vec3(0.0f);
+	for (int column = 0; column < 3; column++)
+	{
+		worldHalfSize += glm::abs(glm::vec3(model[column])) * halfSize[column];
+	}
+
+	BOUNDS worldBounds;
+	worldBounds.min = worldCenter - worldHalfSize;
+	worldBounds.max = worldCenter + worldHalfSize;
+
+	return(worldBounds);
+}
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+// frustumculler.h
+// ============
+// find the objects inside the view frustum with a bounding volume hierarchy
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  FrustumCuller
+ *
+ *  This class contains the code for building a bounding
+ *  volume hierarchy over the world space boxes of the scene
+ *  objects, and for collecting the objects whose boxes touch
+ *  the frustum of the current view and projection matrices.
+ *  Nodes that are entirely inside the frustum add all of
+ *  their objects without testing them one by one, and nodes
+ *  entirely outside skip their objects altogether.
+ ***********************************************************/
+class FrustumCuller
+{
+public:
+	// an axis aligned bounding box
+	struct BOUNDS
+	{
+		glm::vec3 min;
+		glm::vec3 max;
+	};
+
+	// constructor
+	FrustumCuller();
+
+	// build the hierarchy over the boxes of all objects
+	void Build(const std::vector<BOUNDS>& bounds);
+	// update the node boxes after objects moved, keeping the tree
+	void Refit(const std::vector<BOUNDS>& bounds);
+
+	// extract the six frustum planes from a view-projection matrix
+	void SetFrustum(const glm::mat4& viewProjection);
+	// collect the indices of the visible objects in ascending order
+	void Query(std::vector<int>& visibleItems) const;
+	// the six frustum planes as (normal, distance), pointing inwards
+	const glm::vec4* GetPlanes() const;
+
+	// box of a local space box after a model transformation
+	static BOUNDS TransformBounds(const BOUNDS& localBounds, const glm::mat4& model);
+
+private:
+	// one node of the hierarchy, stored in depth-first order so
+	// that the left child directly follows its parent
+	struct BVH_NODE
+	{
+		BOUNDS bounds;
+		// range of the node's objects in m_itemIndices
+		int firstItem;
+		int itemCount;
+		// index of the right child, or -1 for a leaf
+		int rightChild;
+	};
+
+	std::vector<BVH_NODE> m_nodes;
+	// object indices ordered so every node covers a contiguous range
+	std::vector<int> m_itemIndices;
+	// object boxes in the order of m_itemIndices, for testing the
+	// objects of leaf nodes one by one
+	std::vector<BOUNDS> m_itemBounds;
+	// frustum planes as (normal, distance), pointing inwards
+	glm::vec4 m_planes[6];
+
+	// build the subtree over a range of m_itemIndices
+	int BuildNode(const std::vector<BOUNDS>& bounds, int firstItem, int itemCount);
+	// append the visible objects of the subtree under one node
+	void QueryNode(int rootNode, unsigned int rootMask, std::vector<int>& visibleItems) const;
+	// test a box against the planes in the mask, clearing the bits
+	// of the planes the box is entirely inside of
+	bool IsOutside(const BOUNDS& bounds, unsigned int& planeMask) const;
+};
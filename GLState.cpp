@@ -0,0 +1,567 @@
+///////////////////////////////////////////////////////////////////////////////
+// glstate.cpp
+// ============
+// shadow the OpenGL state and drop the calls that change nothing
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GLState.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	// uniform locations above this are sent without tracking
+	const GLint g_MaxTrackedLocation = 1024;
+	// texture units above this are bound without tracking
+	const GLuint g_MaxTrackedUnits = 32;
+
+	// states of a tracked capability or depth mask
+	const int STATE_UNKNOWN = -1;
+	const int STATE_OFF = 0;
+	const int STATE_ON = 1;
+}
+
+GLuint GLState::m_program = 0;
+bool GLState::m_bProgramKnown = false;
+std::unordered_map<GLuint, std::vector<GLState::UNIFORM_VALUE> > GLState::m_uniformValues;
+std::vector<GLState::UNIFORM_VALUE>* GLState::m_pUniforms = NULL;
+GLuint GLState::m_vertexArray = 0;
+bool GLState::m_bVertexArrayKnown = false;
+GLuint GLState::m_activeTexture = 0;
+bool GLState::m_bActiveTextureKnown = false;
+std::vector<GLuint> GLState::m_textures2D;
+std::vector<GLuint> GLState::m_textureArrays;
+std::vector<GLState::CAPABILITY> GLState::m_capabilities;
+int GLState::m_depthMask = STATE_UNKNOWN;
+int GLState::m_colorMask = STATE_UNKNOWN;
+GLenum GLState::m_depthFunc = GL_NONE;
+glm::vec4 GLState::m_clearColor = glm::vec4(0.0f);
+bool GLState::m_bClearColorKnown = false;
+int GLState::m_issuedCalls = 0;
+int GLState::m_filteredCalls = 0;
+
+/***********************************************************
+ *  BindActiveProgram()
+ *
+ *  This method is used for adopting the program that the
+ *  shader manager made active, since it calls glUseProgram
+ *  itself.  It must be called right after the shader manager
+ *  activates a program.
+ ***********************************************************/
+void GLState::BindActiveProgram()
+{
+	GLint programID = 0;
+
+	glGetIntegerv(GL_CURRENT_PROGRAM, &programID);
+	m_program = (GLuint)programID;
+	m_bProgramKnown = true;
+	m_pUniforms = &m_uniformValues[m_program];
+}
+
+/***********************************************************
+ *  UseProgram()
+ *
+ *  This method is used for making the passed in program
+ *  active.  The uniform values are kept for each program, so
+ *  switching to another program and back keeps filtering.
+ ***********************************************************/
+void GLState::UseProgram(GLuint program)
+{
+	if ((m_bProgramKnown == true) && (m_program == program))
+	{
+		m_filteredCalls++;
+		return;
+	}
+
+	glUseProgram(program);
+	m_program = program;
+	m_bProgramKnown = true;
+	m_pUniforms = &m_uniformValues[m_program];
+	m_issuedCalls++;
+}
+
+/***********************************************************
+ *  GetProgram()
+ *
+ *  This method is used for getting the active program without
+ *  querying the driver.
+ ***********************************************************/
+GLuint GLState::GetProgram()
+{
+	if (m_bProgramKnown == false)
+	{
+		BindActiveProgram();
+	}
+
+	return(m_program);
+}
+
+/***********************************************************
+ *  BindVertexArray()
+ *
+ *  This method is used for binding a vertex array unless it is
+ *  already bound.
+ ***********************************************************/
+void GLState::BindVertexArray(GLuint vao)
+{
+	if ((m_bVertexArrayKnown == true) && (m_vertexArray == vao))
+	{
+		m_filteredCalls++;
+		return;
+	}
+
+	glBindVertexArray(vao);
+	m_vertexArray = vao;
+	m_bVertexArrayKnown = true;
+	m_issuedCalls++;
+}
+
+/***********************************************************
+ *  InvalidateVertexArray()
+ *
+ *  This method is used for forgetting which vertex array is
+ *  bound, after code outside this class has bound one.
+ ***********************************************************/
+void GLState::InvalidateVertexArray()
+{
+	m_bVertexArrayKnown = false;
+}
+
+/***********************************************************
+ *  ForgetVertexArray()
+ *
+ *  This method is used for forgetting a vertex array that is
+ *  about to be deleted, because OpenGL unbinds it and may
+ *  hand out its name again.
+ ***********************************************************/
+void GLState::ForgetVertexArray(GLuint vao)
+{
+	if (m_vertexArray == vao)
+	{
+		m_bVertexArrayKnown = false;
+	}
+}
+
+/***********************************************************
+ *  ActiveTexture()
+ *
+ *  This method is used for selecting the active texture unit
+ *  unless it is already selected.
+ ***********************************************************/
+void GLState::ActiveTexture(GLuint unit)
+{
+	if ((m_bActiveTextureKnown == true) && (m_activeTexture == unit))
+	{
+		m_filteredCalls++;
+		return;
+	}
+
+	glActiveTexture(GL_TEXTURE0 + unit);
+	m_activeTexture = unit;
+	m_bActiveTextureKnown = true;
+	m_issuedCalls++;
+}
+
+/***********************************************************
+ *  BindTexture()
+ *
+ *  This method is used for binding a texture on the active
+ *  texture unit unless it is already bound there.
+ ***********************************************************/
+void GLState::BindTexture(GLenum target, GLuint texture)
+{
+	GLuint* pSlot = GetTextureSlot(target);
+	if ((NULL != pSlot) && (*pSlot == texture))
+	{
+		m_filteredCalls++;
+		return;
+	}
+
+	glBindTexture(target, texture);
+	if (NULL != pSlot)
+	{
+		*pSlot = texture;
+	}
+	m_issuedCalls++;
+}
+
+/***********************************************************
+ *  ForgetTexture()
+ *
+ *  This method is used for forgetting a texture that is about
+ *  to be deleted, on every unit it is bound to.
+ ***********************************************************/
+void GLState::ForgetTexture(GLuint texture)
+{
+	for (int i = 0; i < m_textures2D.size(); i++)
+	{
+		if (m_textures2D[i] == texture)
+		{
+			m_textures2D[i] = 0;
+		}
+		if (m_textureArrays[i] == texture)
+		{
+			m_textureArrays[i] = 0;
+		}
+	}
+}
+
+/***********************************************************
+ *  GetTextureSlot()
+ *
+ *  This method is used for getting the remembered binding of
+ *  a texture target on the active unit, or NULL when the unit
+ *  or the target is not tracked.  A texture unit starts with
+ *  nothing bound, like in OpenGL.
+ ***********************************************************/
+GLuint* GLState::GetTextureSlot(GLenum target)
+{
+	if ((m_bActiveTextureKnown == false) || (m_activeTexture >= g_MaxTrackedUnits))
+	{
+		return(NULL);
+	}
+
+	if (m_textures2D.size() == 0)
+	{
+		m_textures2D.resize(g_MaxTrackedUnits, 0);
+		m_textureArrays.resize(g_MaxTrackedUnits, 0);
+	}
+
+	if (target == GL_TEXTURE_2D)
+	{
+		return(&m_textures2D[m_activeTexture]);
+	}
+	if (target == GL_TEXTURE_2D_ARRAY)
+	{
+		return(&m_textureArrays[m_activeTexture]);
+	}
+
+	return(NULL);
+}
+
+/***********************************************************
+ *  Enable()
+ *
+ *  This method is used for turning on a capability unless it
+ *  is already on.
+ ***********************************************************/
+void GLState::Enable(GLenum capability)
+{
+	if (FilterCapability(capability, true) == false)
+	{
+		glEnable(capability);
+	}
+}
+
+/***********************************************************
+ *  Disable()
+ *
+ *  This method is used for turning off a capability unless it
+ *  is already off.
+ ***********************************************************/
+void GLState::Disable(GLenum capability)
+{
+	if (FilterCapability(capability, false) == false)
+	{
+		glDisable(capability);
+	}
+}
+
+/***********************************************************
+ *  FilterCapability()
+ *
+ *  This method is used for checking whether a capability is
+ *  already in the passed in state, and remembering the new
+ *  state when it is not.
+ ***********************************************************/
+bool GLState::FilterCapability(GLenum capability, bool bEnabled)
+{
+	int state = bEnabled ? STATE_ON : STATE_OFF;
+
+	for (int i = 0; i < m_capabilities.size(); i++)
+	{
+		if (m_capabilities[i].capability == capability)
+		{
+			if (m_capabilities[i].state == state)
+			{
+				m_filteredCalls++;
+				return(true);
+			}
+			m_capabilities[i].state = state;
+			m_issuedCalls++;
+			return(false);
+		}
+	}
+
+	CAPABILITY entry;
+	entry.capability = capability;
+	entry.state = state;
+	m_capabilities.push_back(entry);
+	m_issuedCalls++;
+
+	return(false);
+}
+
+/***********************************************************
+ *  DepthMask()
+ *
+ *  This method is used for turning depth writes on or off
+ *  unless they already are.
+ ***********************************************************/
+void GLState::DepthMask(GLboolean bWrite)
+{
+	int state = (bWrite == GL_TRUE) ? STATE_ON : STATE_OFF;
+	if (m_depthMask == state)
+	{
+		m_filteredCalls++;
+		return;
+	}
+
+	glDepthMask(bWrite);
+	m_depthMask = state;
+	m_issuedCalls++;
+}
+
+/***********************************************************
+ *  ColorMask()
+ *
+ *  This method is used for turning the writes of all of the
+ *  color channels on or off, unless they already are.
+ ***********************************************************/
+void GLState::ColorMask(GLboolean bWrite)
+{
+	int state = (bWrite == GL_TRUE) ? STATE_ON : STATE_OFF;
+	if (m_colorMask == state)
+	{
+		m_filteredCalls++;
+		return;
+	}
+
+	glColorMask(bWrite, bWrite, bWrite, bWrite);
+	m_colorMask = state;
+	m_issuedCalls++;
+}
+
+/***********************************************************
+ *  DepthFunc()
+ *
+ *  This method is used for setting the depth comparison unless
+ *  it is already set.
+ ***********************************************************/
+void GLState::DepthFunc(GLenum function)
+{
+	if (m_depthFunc == function)
+	{
+		m_filteredCalls++;
+		return;
+	}
+
+	glDepthFunc(function);
+	m_depthFunc = function;
+	m_issuedCalls++;
+}
+
+/***********************************************************
+ *  ClearColor()
+ *
+ *  This method is used for setting the clear color unless it
+ *  is already set.
+ ***********************************************************/
+void GLState::ClearColor(const glm::vec4& color)
+{
+	if ((m_bClearColorKnown == true) && (m_clearColor == color))
+	{
+		m_filteredCalls++;
+		return;
+	}
+
+	glClearColor(color.r, color.g, color.b, color.a);
+	m_clearColor = color;
+	m_bClearColorKnown = true;
+	m_issuedCalls++;
+}
+
+/***********************************************************
+ *  FilterUniform()
+ *
+ *  This method is used for comparing a uniform value with the
+ *  last one sent to the same location of the active program.
+ *  Locations of -1 are dropped, since OpenGL ignores them.
+ ***********************************************************/
+bool GLState::FilterUniform(GLint location, const void* data, GLuint size)
+{
+	if (location < 0)
+	{
+		m_filteredCalls++;
+		return(true);
+	}
+
+	if (NULL == m_pUniforms)
+	{
+		BindActiveProgram();
+	}
+
+	if (location >= g_MaxTrackedLocation)
+	{
+		m_issuedCalls++;
+		return(false);
+	}
+
+	if (location >= (GLint)m_pUniforms->size())
+	{
+		UNIFORM_VALUE unset = {};
+		m_pUniforms->resize(location + 1, unset);
+	}
+
+	UNIFORM_VALUE& value = (*m_pUniforms)[location];
+	if ((value.size == size) && (memcmp(value.data, data, size) == 0))
+	{
+		m_filteredCalls++;
+		return(true);
+	}
+
+	value.size = size;
+	memcpy(value.data, data, size);
+	m_issuedCalls++;
+
+	return(false);
+}
+
+/***********************************************************
+ *  Uniform1i()
+ *
+ *  This method is used for setting an int, bool or sampler
+ *  uniform of the active program.
+ ***********************************************************/
+void GLState::Uniform1i(GLint location, GLint value)
+{
+	if (FilterUniform(location, &value, sizeof(value)) == false)
+	{
+		glUniform1i(location, value);
+	}
+}
+
+/***********************************************************
+ *  Uniform1f()
+ *
+ *  This method is used for setting a float uniform of the
+ *  active program.
+ ***********************************************************/
+void GLState::Uniform1f(GLint location, GLfloat value)
+{
+	if (FilterUniform(location, &value, sizeof(value)) == false)
+	{
+		glUniform1f(location, value);
+	}
+}
+
+/***********************************************************
+ *  Uniform2f()
+ *
+ *  This method is used for setting a vec2 uniform of the
+ *  active program.
+ ***********************************************************/
+void GLState::Uniform2f(GLint location, const glm::vec2& value)
+{
+	if (FilterUniform(location, glm::value_ptr(value), sizeof(value)) == false)
+	{
+		glUniform2fv(location, 1, glm::value_ptr(value));
+	}
+}
+
+/***********************************************************
+ *  Uniform3f()
+ *
+ *  This method is used for setting a vec3 uniform of the
+ *  active program.
+ ***********************************************************/
+void GLState::Uniform3f(GLint location, const glm::vec3& value)
+{
+	if (FilterUniform(location, glm::value_ptr(value), sizeof(value)) == false)
+	{
+		glUniform3fv(location, 1, glm::value_ptr(value));
+	}
+}
+
+/***********************************************************
+ *  Uniform4f()
+ *
+ *  This method is used for setting a vec4 uniform of the
+ *  active program.
+ ***********************************************************/
+void GLState::Uniform4f(GLint location, const glm::vec4& value)
+{
+	if (FilterUniform(location, glm::value_ptr(value), sizeof(value)) == false)
+	{
+		glUniform4fv(location, 1, glm::value_ptr(value));
+	}
+}
+
+/***********************************************************
+ *  Uniform2ui()
+ *
+ *  This method is used for setting a uvec2 uniform of the
+ *  active program, like a bindless texture handle.
+ ***********************************************************/
+void GLState::Uniform2ui(GLint location, GLuint x, GLuint y)
+{
+	GLuint value[2] = { x, y };
+	if (FilterUniform(location, value, sizeof(value)) == false)
+	{
+		glUniform2ui(location, x, y);
+	}
+}
+
+/***********************************************************
+ *  UniformMatrix4()
+ *
+ *  This method is used for setting a mat4 uniform of the
+ *  active program.
+ ***********************************************************/
+void GLState::UniformMatrix4(GLint location, const glm::mat4& value)
+{
+	if (FilterUniform(location, glm::value_ptr(value), sizeof(value)) == false)
+	{
+		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+}
+
+/***********************************************************
+ *  ResetFrameCounters()
+ *
+ *  This method is used for starting the call counters of a
+ *  new frame.
+ ***********************************************************/
+void GLState::ResetFrameCounters()
+{
+	m_issuedCalls = 0;
+	m_filteredCalls = 0;
+}
+
+/***********************************************************
+ *  GetIssuedCalls()
+ *
+ *  This method is used for getting the number of calls sent
+ *  to the driver since the last reset.
+ ***********************************************************/
+int GLState::GetIssuedCalls()
+{
+	return(m_issuedCalls);
+}
+
+/***********************************************************
+ *  GetFilteredCalls()
+ *
+ *  This method is used for getting the number of calls that
+ *  were dropped since the last reset.
+ ***********************************************************/
+int GLState::GetFilteredCalls()
+{
+	return(m_filteredCalls);
+}
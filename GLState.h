@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+// glstate.h
+// ============
+// shadow the OpenGL state and drop the calls that change nothing
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+/***********************************************************
+ *  GLState
+ *
+ *  This class is used for keeping a copy of the OpenGL state
+ *  that the managers set over and over - the shader program,
+ *  the vertex array, the texture bindings, a few capabilities
+ *  and the uniform values of each program.  A call that would
+ *  set a value the state already has is dropped and counted
+ *  instead of being sent to the driver.  State changed around
+ *  this class, like the vertex arrays bound by ShapeMeshes,
+ *  has to be invalidated by the caller, and a uniform must
+ *  either always or never be set through this class.
+ ***********************************************************/
+class GLState
+{
+public:
+	// adopt the shader program activated by the shader manager
+	static void BindActiveProgram();
+	// make the passed in program active
+	static void UseProgram(GLuint program);
+	// the shader program that is currently active
+	static GLuint GetProgram();
+
+	// bind a vertex array, or 0 to unbind it
+	static void BindVertexArray(GLuint vao);
+	// forget the bound vertex array after it was bound elsewhere
+	static void InvalidateVertexArray();
+	// forget a vertex array before it is deleted
+	static void ForgetVertexArray(GLuint vao);
+
+	// select the active texture unit
+	static void ActiveTexture(GLuint unit);
+	// bind a 2D or array texture on the active texture unit
+	static void BindTexture(GLenum target, GLuint texture);
+	// forget a texture before it is deleted
+	static void ForgetTexture(GLuint texture);
+
+	// turn a capability like GL_DEPTH_TEST on or off
+	static void Enable(GLenum capability);
+	static void Disable(GLenum capability);
+	static void DepthMask(GLboolean bWrite);
+	static void ColorMask(GLboolean bWrite);
+	static void DepthFunc(GLenum function);
+	static void ClearColor(const glm::vec4& color);
+
+	// set uniforms of the active program
+	static void Uniform1i(GLint location, GLint value);
+	static void Uniform1f(GLint location, GLfloat value);
+	static void Uniform2f(GLint location, const glm::vec2& value);
+	static void Uniform3f(GLint location, const glm::vec3& value);
+	static void Uniform4f(GLint location, const glm::vec4& value);
+	static void Uniform2ui(GLint location, GLuint x, GLuint y);
+	static void UniformMatrix4(GLint location, const glm::mat4& value);
+
+	// reset the call counters at the start of each frame
+	static void ResetFrameCounters();
+	// calls sent to the driver and dropped since the last reset
+	static int GetIssuedCalls();
+	static int GetFilteredCalls();
+
+private:
+	// last value sent to one uniform location, up to a mat4
+	struct UNIFORM_VALUE
+	{
+		GLuint size;
+		GLfloat data[16];
+	};
+
+	// one tracked capability and whether it is on, off or unknown
+	struct CAPABILITY
+	{
+		GLenum capability;
+		int state;
+	};
+
+	static GLuint m_program;
+	static bool m_bProgramKnown;
+	// last uniform values of each program, by location
+	static std::unordered_map<GLuint, std::vector<UNIFORM_VALUE> > m_uniformValues;
+	static std::vector<UNIFORM_VALUE>* m_pUniforms;
+
+	static GLuint m_vertexArray;
+	static bool m_bVertexArrayKnown;
+
+	static GLuint m_activeTexture;
+	static bool m_bActiveTextureKnown;
+	// bound 2D and array textures of each texture unit
+	static std::vector<GLuint> m_textures2D;
+	static std::vector<GLuint> m_textureArrays;
+
+	static std::vector<CAPABILITY> m_capabilities;
+	static int m_depthMask;
+	static int m_colorMask;
+	static GLenum m_depthFunc;
+	static glm::vec4 m_clearColor;
+	static bool m_bClearColorKnown;
+
+	static int m_issuedCalls;
+	static int m_filteredCalls;
+
+	// true when the call should be dropped, otherwise the new value
+	// is remembered and the call counted as issued
+	static bool FilterUniform(GLint location, const void* data, GLuint size);
+	static bool FilterCapability(GLenum capability, bool bEnabled);
+	// the binding slot of a texture target on the active unit
+	static GLuint* GetTextureSlot(GLenum target);
+};
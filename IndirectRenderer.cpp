@@ -0,0 +1,472 @@
+///////////////////////////////////////////////////////////////////////////////
+// indirectrenderer.cpp
+// ============
+// cull objects in a compute shader and draw them with one indirect call
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "IndirectRenderer.h"
+#include "MeshLibrary.h"
+#include "GLState.h"
+#include "OcclusionCuller.h"
+
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	const int g_FloatsPerVertex = MeshLibrary::FLOATS_PER_VERTEX;
+
+	// binding points of the buffers only used by the compute shader
+	const GLuint MESH_RANGE_BLOCK_BINDING = 4;
+	const GLuint COMMAND_BLOCK_BINDING = 5;
+	const GLuint COUNT_BLOCK_BINDING = 6;
+	// threads in one compute work group
+	const int CULL_GROUP_SIZE = 64;
+
+	static_assert(sizeof(IndirectRenderer::OBJECT_RECORD) == 144, "object record must match the std430 layout");
+
+	// the compute shader that turns the visible object records
+	// into draw commands
+	const char* g_CullShaderSource =
+		"#version 430 core\n"
+		"layout(local_size_x = 64) in;\n"
+		"struct ObjectRecord\n"
+		"{\n"
+		"    mat4 model;\n"
+		"    vec4 color;\n"
+		"    vec4 boundsMin;\n"
+		"    vec4 boundsMax;\n"
+		"    uvec2 textureHandle;\n"
+		"    vec2 uvScale;\n"
+		"    int materialIndex;\n"
+		"    uint meshRange;\n"
+		"    int useTexture;\n"
+		"    int padding;\n"
+		"};\n"
+		"struct MeshRange { uint indexCount; uint firstIndex; };\n"
+		"struct DrawCommand { uint count; uint instanceCount; uint firstIndex; int baseVertex; uint baseInstance; };\n"
+		"layout(std430, binding = 3) readonly buffer ObjectBlock { ObjectRecord objects[]; };\n"
+		"layout(std430, binding = 4) readonly buffer MeshRangeBlock { MeshRange meshRanges[]; };\n"
+		"layout(std430, binding = 5) writeonly buffer CommandBlock { DrawCommand commands[]; };\n"
+		"layout(std430, binding = 6) buffer CountBlock { uint drawCount; };\n"
+		"uniform vec4 frustumPlanes[6];\n"
+		"uniform uint objectCount;\n"
+		"uniform bool bOcclusion;\n"
+		"uniform sampler2D pyramidTexture;\n"
+		"uniform int pyramidLevels;\n"
+		"uniform mat4 pyramidViewProjection;\n"
+		"bool IsOccluded(vec3 boundsMin, vec3 boundsMax)\n"
+		"{\n"
+		"    vec2 rectMin = vec2(1.0);\n"
+		"    vec2 rectMax = vec2(0.0);\n"
+		"    float nearest = 1.0;\n"
+		"    for (int i = 0; i < 8; i++)\n"
+		"    {\n"
+		"        vec3 corner = mix(boundsMin, boundsMax, bvec3((i & 1) != 0, (i & 2) != 0, (i & 4) != 0));\n"
+		"        vec4 clip = pyramidViewProjection * vec4(corner, 1.0);\n"
+		"        if (clip.w <= 0.0)\n"
+		"            return false;\n"
+		"        vec3 window = clip.xyz / clip.w * 0.5 + 0.5;\n"
+		"        rectMin = min(rectMin, window.xy);\n"
+		"        rectMax = max(rectMax, window.xy);\n"
+		"        nearest = min(nearest, window.z);\n"
+		"    }\n"
+		"    rectMin = clamp(rectMin, 0.0, 1.0);\n"
+		"    rectMax = clamp(rectMax, 0.0, 1.0);\n"
+		"    vec2 extent = (rectMax - rectMin) * vec2(textureSize(pyramidTexture, 0));\n"
+		"    int level = clamp(int(ceil(log2(max(max(extent.x, extent.y), 1.0)))), 0, pyramidLevels - 1);\n"
+		"    ivec2 levelSize = textureSize(pyramidTexture, level);\n"
+		"    ivec2 first = min(ivec2(rectMin * vec2(levelSize)), levelSize - 1);\n"
+		"    ivec2 last = min(ivec2(rectMax * vec2(levelSize)), levelSize - 1);\n"
+		"    for (int y = first.y; y <= last.y; y++)\n"
+		"        for (int x = first.x; x <= last.x; x++)\n"
+		"            if (nearest <= texelFetch(pyramidTexture, ivec2(x, y), level).r)\n"
+		"                return false;\n"
+		"    return true;\n"
+		"}\n"
+		"void main()\n"
+		"{\n"
+		"    uint index = gl_GlobalInvocationID.x;\n"
+		"    if (index >= objectCount)\n"
+		"        return;\n"
+		"    vec3 boundsMin = objects[index].boundsMin.xyz;\n"
+		"    vec3 boundsMax = objects[index].boundsMax.xyz;\n"
+		"    for (int i = 0; i < 6; i++)\n"
+		"    {\n"
+		"        vec3 farCorner = mix(boundsMin, boundsMax, greaterThanEqual(frustumPlanes[i].xyz, vec3(0.0)));\n"
+		"        if (dot(frustumPlanes[i].xyz, farCorner) + frustumPlanes[i].w < 0.0)\n"
+		"            return;\n"
+		"    }\n"
+		"    if (bOcclusion && IsOccluded(boundsMin, boundsMax))\n"
+		"        return;\n"
+		"    MeshRange range = meshRanges[objects[index].meshRange];\n"
+		"    uint slot = atomicAdd(drawCount, 1u);\n"
+		"    commands[slot] = DrawCommand(range.indexCount, 1u, range.firstIndex, 0, index);\n"
+		"}\n";
+
+	// layout of one glMultiDrawElementsIndirect command
+	struct DRAW_COMMAND
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+}
+
+/***********************************************************
+ *  IndirectRenderer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+IndirectRenderer::IndirectRenderer()
+{
+	m_cullProgram = 0;
+	m_frustumPlanesLocation = -1;
+	m_objectCountLocation = -1;
+	m_occlusionLocation = -1;
+	m_pyramidLevelsLocation = -1;
+	m_pyramidViewProjectionLocation = -1;
+	m_pyramidTexture = 0;
+	m_pyramidLevels = 0;
+	m_pyramidViewProjection = glm::mat4(1.0f);
+	m_vao = 0;
+	m_vertexBuffer = 0;
+	m_indexBuffer = 0;
+	m_objectBuffer = 0;
+	m_meshRangeBuffer = 0;
+	m_commandBuffer = 0;
+	m_countBuffer = 0;
+	m_objectCount = 0;
+	m_commandCapacity = 0;
+}
+
+/***********************************************************
+ *  ~IndirectRenderer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+IndirectRenderer::~IndirectRenderer()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing all of the buffers and the
+ *  compute shader program.
+ ***********************************************************/
+void IndirectRenderer::Destroy()
+{
+	if (0 != m_vao)
+	{
+		GLState::ForgetVertexArray(m_vao);
+		glDeleteVertexArrays(1, &m_vao);
+		m_vao = 0;
+	}
+
+	GLuint* buffers[6] = { &m_vertexBuffer, &m_indexBuffer, &m_objectBuffer, &m_meshRangeBuffer, &m_commandBuffer, &m_countBuffer };
+	for (int i = 0; i < 6; i++)
+	{
+		if (0 != *buffers[i])
+		{
+			glDeleteBuffers(1, buffers[i]);
+			*buffers[i] = 0;
+		}
+	}
+
+	if (0 != m_cullProgram)
+	{
+		glDeleteProgram(m_cullProgram);
+		m_cullProgram = 0;
+	}
+	m_objectCount = 0;
+	m_commandCapacity = 0;
+}
+
+/***********************************************************
+ *  IsSupported()
+ *
+ *  This method is used for checking whether the driver has
+ *  compute shaders, storage buffers and indirect draws that
+ *  read the draw count from a buffer.
+ ***********************************************************/
+bool IndirectRenderer::IsSupported()
+{
+	bool bCompute = GLEW_VERSION_4_3 || (GLEW_ARB_compute_shader && GLEW_ARB_shader_storage_buffer_object && GLEW_ARB_multi_draw_indirect);
+	bool bDrawCount = GLEW_VERSION_4_6 || GLEW_ARB_indirect_parameters;
+	bool bBaseInstance = GLEW_VERSION_4_6 || GLEW_ARB_shader_draw_parameters;
+
+	return(bCompute && bDrawCount && bBaseInstance);
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for compiling and linking the culling
+ *  compute shader.  It returns false when the shader cannot
+ *  be built, in which case the objects must be drawn by the
+ *  CPU instead.
+ ***********************************************************/
+bool IndirectRenderer::Initialize()
+{
+	GLint success = 0;
+	GLchar infoLog[512];
+
+	if (0 != m_cullProgram)
+	{
+		return(true);
+	}
+
+	GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+	glShaderSource(shader, 1, &g_CullShaderSource, NULL);
+	glCompileShader(shader);
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		glGetShaderInfoLog(shader, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR: culling compute shader compilation failed\n" << infoLog << std::endl;
+		glDeleteShader(shader);
+		return(false);
+	}
+
+	m_cullProgram = glCreateProgram();
+	glAttachShader(m_cullProgram, shader);
+	glLinkProgram(m_cullProgram);
+	glDeleteShader(shader);
+	glGetProgramiv(m_cullProgram, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		glGetProgramInfoLog(m_cullProgram, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR: culling compute shader linking failed\n" << infoLog << std::endl;
+		glDeleteProgram(m_cullProgram);
+		m_cullProgram = 0;
+		return(false);
+	}
+
+	m_frustumPlanesLocation = glGetUniformLocation(m_cullProgram, "frustumPlanes");
+	m_objectCountLocation = glGetUniformLocation(m_cullProgram, "objectCount");
+	m_occlusionLocation = glGetUniformLocation(m_cullProgram, "bOcclusion");
+	m_pyramidLevelsLocation = glGetUniformLocation(m_cullProgram, "pyramidLevels");
+	m_pyramidViewProjectionLocation = glGetUniformLocation(m_cullProgram, "pyramidViewProjection");
+
+	// the pyramid is always sampled from the same texture unit
+	GLuint activeProgram = GLState::GetProgram();
+	GLState::UseProgram(m_cullProgram);
+	glUniform1i(glGetUniformLocation(m_cullProgram, "pyramidTexture"), OcclusionCuller::PYRAMID_TEXTURE_UNIT);
+	GLState::UseProgram(activeProgram);
+
+	glGenBuffers(1, &m_countBuffer);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_countBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint), NULL, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	return(true);
+}
+
+/***********************************************************
+ *  AddMesh()
+ *
+ *  This method is used for adding the vertices and indices of
+ *  one mesh to the shared geometry.  It returns the mesh range
+ *  that the object records refer to.
+ ***********************************************************/
+int IndirectRenderer::AddMesh(const std::vector<GLfloat>& vertices, const std::vector<GLuint>& indices)
+{
+	GLuint firstVertex = (GLuint)(m_vertices.size() / g_FloatsPerVertex);
+
+	MESH_RANGE range;
+	range.indexCount = (GLuint)indices.size();
+	range.firstIndex = (GLuint)m_indices.size();
+	m_meshRanges.push_back(range);
+
+	m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
+	for (int i = 0; i < indices.size(); i++)
+	{
+		m_indices.push_back(firstVertex + indices[i]);
+	}
+
+	return((int)m_meshRanges.size() - 1);
+}
+
+/***********************************************************
+ *  UploadMeshes()
+ *
+ *  This method is used for uploading the shared geometry and
+ *  the mesh ranges, using the same attribute locations as the
+ *  other meshes.
+ ***********************************************************/
+void IndirectRenderer::UploadMeshes()
+{
+	const GLint stride = sizeof(GLfloat) * g_FloatsPerVertex;
+
+	if (0 == m_vao)
+	{
+		glGenVertexArrays(1, &m_vao);
+		glGenBuffers(1, &m_vertexBuffer);
+		glGenBuffers(1, &m_indexBuffer);
+		glGenBuffers(1, &m_meshRangeBuffer);
+	}
+
+	GLState::BindVertexArray(m_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(GLfloat), m_vertices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(GLuint), m_indices.data(), GL_STATIC_DRAW);
+
+	// vertex position, normal and texture coordinate
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(GLfloat) * 3));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(GLfloat) * 6));
+	glEnableVertexAttribArray(2);
+
+	GLState::BindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_meshRangeBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, m_meshRanges.size() * sizeof(MESH_RANGE), m_meshRanges.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/***********************************************************
+ *  SetObjects()
+ *
+ *  This method is used for uploading the records of all of the
+ *  objects, and making room for one draw command per object.
+ ***********************************************************/
+void IndirectRenderer::SetObjects(const std::vector<OBJECT_RECORD>& objects)
+{
+	if (0 == m_objectBuffer)
+	{
+		glGenBuffers(1, &m_objectBuffer);
+		glGenBuffers(1, &m_commandBuffer);
+	}
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_objectBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, objects.size() * sizeof(OBJECT_RECORD), objects.data(), GL_STATIC_DRAW);
+
+	// the commands are only written by the compute shader
+	if (objects.size() > m_commandCapacity)
+	{
+		m_commandCapacity = (int)objects.size();
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_commandBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, m_commandCapacity * sizeof(DRAW_COMMAND), NULL, GL_DYNAMIC_DRAW);
+	}
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	m_objectCount = (int)objects.size();
+}
+
+/***********************************************************
+ *  GetObjectCount()
+ *
+ *  This method is used for getting the number of records in
+ *  the object buffer.
+ ***********************************************************/
+int IndirectRenderer::GetObjectCount() const
+{
+	return(m_objectCount);
+}
+
+/***********************************************************
+ *  SetOcclusion()
+ *
+ *  This method is used for setting the depth pyramid that the
+ *  next Cull() also tests the objects against, and the
+ *  view-projection it was drawn with.  A texture of 0 turns
+ *  the occlusion test off.
+ ***********************************************************/
+void IndirectRenderer::SetOcclusion(GLuint pyramidTexture, int pyramidLevels, const glm::mat4& pyramidViewProjection)
+{
+	m_pyramidTexture = pyramidTexture;
+	m_pyramidLevels = pyramidLevels;
+	m_pyramidViewProjection = pyramidViewProjection;
+}
+
+/***********************************************************
+ *  Cull()
+ *
+ *  This method is used for running the compute shader over all
+ *  of the object records, which appends one draw command for
+ *  every object inside the frustum, and not hidden in the
+ *  depth pyramid when one is set.  The shader program that
+ *  was active before is made active again afterwards.
+ ***********************************************************/
+void IndirectRenderer::Cull(const glm::vec4* frustumPlanes)
+{
+	GLuint zero = 0;
+
+	if ((0 == m_cullProgram) || (m_objectCount == 0))
+	{
+		return;
+	}
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_countBuffer);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint), &zero);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	GLuint activeProgram = GLState::GetProgram();
+	GLState::UseProgram(m_cullProgram);
+	glUniform4fv(m_frustumPlanesLocation, 6, &frustumPlanes[0].x);
+	glUniform1ui(m_objectCountLocation, (GLuint)m_objectCount);
+	glUniform1i(m_occlusionLocation, (0 != m_pyramidTexture) ? 1 : 0);
+	if (0 != m_pyramidTexture)
+	{
+		glUniform1i(m_pyramidLevelsLocation, m_pyramidLevels);
+		glUniformMatrix4fv(m_pyramidViewProjectionLocation, 1, GL_FALSE, &m_pyramidViewProjection[0][0]);
+		GLState::ActiveTexture(OcclusionCuller::PYRAMID_TEXTURE_UNIT);
+		GLState::BindTexture(GL_TEXTURE_2D, m_pyramidTexture);
+		GLState::ActiveTexture(0);
+	}
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, OBJECT_BLOCK_BINDING, m_objectBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, MESH_RANGE_BLOCK_BINDING, m_meshRangeBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMMAND_BLOCK_BINDING, m_commandBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COUNT_BLOCK_BINDING, m_countBuffer);
+
+	glDispatchCompute((m_objectCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE, 1, 1);
+
+	// the draw reads the commands and the count as indirect data
+	glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+	GLState::UseProgram(activeProgram);
+}
+
+/***********************************************************
+ *  Draw()
+ *
+ *  This method is used for drawing every command written by
+ *  the last Cull() with one call.  The number of commands is
+ *  read by the GPU, so nothing waits for the culling results.
+ ***********************************************************/
+void IndirectRenderer::Draw()
+{
+	if ((0 == m_vao) || (m_objectCount == 0))
+	{
+		return;
+	}
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, OBJECT_BLOCK_BINDING, m_objectBuffer);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+	glBindBuffer(GL_PARAMETER_BUFFER, m_countBuffer);
+	GLState::BindVertexArray(m_vao);
+
+	if (GLEW_VERSION_4_6)
+	{
+		glMultiDrawElementsIndirectCount(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)0, 0, m_objectCount, 0);
+	}
+	else
+	{
+		glMultiDrawElementsIndirectCountARB(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)0, 0, m_objectCount, 0);
+	}
+
+	glBindBuffer(GL_PARAMETER_BUFFER, 0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
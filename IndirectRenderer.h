@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////
+// indirectrenderer.h
+// ============
+// cull objects in a compute shader and draw them with one indirect call
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  IndirectRenderer
+ *
+ *  This class contains the code for the GPU driven drawing of
+ *  scene objects.  The record of every object lives in a
+ *  shader storage buffer, a compute shader tests the bounds
+ *  of each record against the frustum planes and appends a
+ *  draw command for each visible object, and all of them are
+ *  drawn with one glMultiDrawElementsIndirectCount call that
+ *  reads the number of commands from the GPU.  The base
+ *  instance of each command is the index of its record, which
+ *  the vertex and fragment shaders read as:
+ *
+ *    struct ObjectRecord
+ *    {
+ *        mat4 model;
+ *        vec4 color;
+ *        vec4 boundsMin;
+ *        vec4 boundsMax;
+ *        uvec2 textureHandle;
+ *        vec2 uvScale;
+ *        int materialIndex;
+ *        uint meshRange;
+ *        int useTexture;
+ *        int padding;
+ *    };
+ *    layout(std430) buffer ObjectBlock
+ *    {
+ *        ObjectRecord objects[];
+ *    };
+ *    uniform bool bUseObjectBuffer;
+ *    ... objects[gl_BaseInstance] ...
+ *
+ *  where the texture handle is a bindless texture handle.
+ ***********************************************************/
+class IndirectRenderer
+{
+public:
+	// constructor
+	IndirectRenderer();
+	// destructor
+	~IndirectRenderer();
+
+	// std430 layout of one object record
+	struct OBJECT_RECORD
+	{
+		glm::mat4 model;
+		glm::vec4 color;
+		glm::vec4 boundsMin;
+		glm::vec4 boundsMax;
+		GLuint textureHandle[2];
+		glm::vec2 uvScale;
+		GLint materialIndex;
+		GLuint meshRange;
+		GLint useTexture;
+		GLint padding;
+	};
+
+	// shader storage buffer binding point of the object records
+	static const GLuint OBJECT_BLOCK_BINDING = 3;
+
+	// true when the driver supports compute shaders and indirect
+	// draws with a GPU written draw count
+	static bool IsSupported();
+
+	// compile the culling compute shader
+	bool Initialize();
+
+	// add the geometry of one mesh, returning its mesh range
+	int AddMesh(const std::vector<GLfloat>& vertices, const std::vector<GLuint>& indices);
+	// upload the geometry of all the added meshes
+	void UploadMeshes();
+
+	// replace the object records
+	void SetObjects(const std::vector<OBJECT_RECORD>& objects);
+	int GetObjectCount() const;
+
+	// also skip the objects hidden in this depth pyramid, or 0
+	void SetOcclusion(GLuint pyramidTexture, int pyramidLevels, const glm::mat4& pyramidViewProjection);
+	// write the draw commands of the objects inside the frustum
+	void Cull(const glm::vec4* frustumPlanes);
+	// draw the commands written by the last Cull() with one call
+	void Draw();
+
+private:
+	// range of indices of one mesh in the shared index buffer
+	struct MESH_RANGE
+	{
+		GLuint indexCount;
+		GLuint firstIndex;
+	};
+
+	// geometry waiting for the upload
+	std::vector<GLfloat> m_vertices;
+	std::vector<GLuint> m_indices;
+	std::vector<MESH_RANGE> m_meshRanges;
+
+	// compute shader program and its uniform locations
+	GLuint m_cullProgram;
+	GLint m_frustumPlanesLocation;
+	GLint m_objectCountLocation;
+	GLint m_occlusionLocation;
+	GLint m_pyramidLevelsLocation;
+	GLint m_pyramidViewProjectionLocation;
+
+	// depth pyramid of the occlusion test, or 0 without it
+	GLuint m_pyramidTexture;
+	int m_pyramidLevels;
+	glm::mat4 m_pyramidViewProjection;
+
+	// shared geometry of all of the meshes
+	GLuint m_vao;
+	GLuint m_vertexBuffer;
+	GLuint m_indexBuffer;
+	// storage buffers read and written by the compute shader
+	GLuint m_objectBuffer;
+	GLuint m_meshRangeBuffer;
+	GLuint m_commandBuffer;
+	GLuint m_countBuffer;
+	// number of records and of allocated commands
+	int m_objectCount;
+	int m_commandCapacity;
+
+	// free all of the buffers and the program
+	void Destroy();
+};
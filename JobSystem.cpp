@@ -0,0 +1,249 @@
+///////////////////////////////////////////////////////////////////////////////
+// jobsystem.cpp
+// ============
+// run the per-frame scene traversal on a work-stealing thread pool
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "JobSystem.h"
+
+#include <iostream>
+
+std::vector<std::thread> JobSystem::m_workers;
+std::vector<JobSystem::JOB_QUEUE*> JobSystem::m_queues;
+std::atomic<int> JobSystem::m_queuedJobs(0);
+std::atomic<bool> JobSystem::m_bRunning(false);
+std::mutex JobSystem::m_wakeMutex;
+std::condition_variable JobSystem::m_wakeCondition;
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for creating a job queue for the main
+ *  thread and for each worker, and starting the workers.
+ ***********************************************************/
+void JobSystem::Initialize(int workerCount)
+{
+	if (m_bRunning == true)
+	{
+		return;
+	}
+
+	if (workerCount <= 0)
+	{
+		workerCount = (int)std::thread::hardware_concurrency() - 1;
+	}
+	if (workerCount < 0)
+	{
+		workerCount = 0;
+	}
+
+	for (int i = 0; i <= workerCount; i++)
+	{
+		m_queues.push_back(new JOB_QUEUE());
+	}
+
+	m_bRunning = true;
+	for (int i = 1; i <= workerCount; i++)
+	{
+		m_workers.push_back(std::thread(WorkerMain, i));
+	}
+
+	std::cout << "INFO: scene traversal runs on " << GetThreadCount() << " threads" << std::endl;
+}
+
+/***********************************************************
+ *  Shutdown()
+ *
+ *  This method is used for waking all of the workers so that
+ *  they see the pool stopping, and joining them.
+ ***********************************************************/
+void JobSystem::Shutdown()
+{
+	if (m_bRunning == false)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_bRunning = false;
+	}
+	m_wakeCondition.notify_all();
+
+	for (int i = 0; i < m_workers.size(); i++)
+	{
+		m_workers[i].join();
+	}
+	m_workers.clear();
+
+	for (int i = 0; i < m_queues.size(); i++)
+	{
+		delete m_queues[i];
+	}
+	m_queues.clear();
+}
+
+/***********************************************************
+ *  GetThreadCount()
+ *
+ *  This method is used for getting the number of threads that
+ *  the jobs are split across.
+ ***********************************************************/
+int JobSystem::GetThreadCount()
+{
+	return((int)m_workers.size() + 1);
+}
+
+/***********************************************************
+ *  GetChunkCount()
+ *
+ *  This method is used for getting the number of chunks a
+ *  range is split into, so that each chunk can write its
+ *  results into its own list.  The chunk of a job is its
+ *  begin divided by the grain size.
+ ***********************************************************/
+int JobSystem::GetChunkCount(int count, int grainSize)
+{
+	if (grainSize < 1)
+	{
+		grainSize = 1;
+	}
+
+	return((count + grainSize - 1) / grainSize);
+}
+
+/***********************************************************
+ *  ParallelFor()
+ *
+ *  This method is used for running the passed in function
+ *  over chunks of the range.  The chunks are dealt out to the
+ *  queues in turn, and the main thread keeps running jobs
+ *  until every chunk is done.  Ranges of a single chunk, or
+ *  any range without workers, run right away on the main
+ *  thread.
+ ***********************************************************/
+void JobSystem::ParallelFor(int count, int grainSize, const std::function<void(int, int)>& function)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+	if (grainSize < 1)
+	{
+		grainSize = 1;
+	}
+
+	if ((m_workers.size() == 0) || (count <= grainSize))
+	{
+		for (int begin = 0; begin < count; begin += grainSize)
+		{
+			function(begin, (begin + grainSize < count) ? begin + grainSize : count);
+		}
+		return;
+	}
+
+	std::atomic<int> pendingJobs(GetChunkCount(count, grainSize));
+
+	int queueIndex = 0;
+	for (int begin = 0; begin < count; begin += grainSize)
+	{
+		JOB job;
+		job.pFunction = &function;
+		job.begin = begin;
+		job.end = (begin + grainSize < count) ? begin + grainSize : count;
+		job.pPendingJobs = &pendingJobs;
+
+		JOB_QUEUE* pQueue = m_queues[queueIndex];
+		{
+			std::lock_guard<std::mutex> lock(pQueue->mutex);
+			pQueue->jobs.push_back(job);
+		}
+		m_queuedJobs++;
+		queueIndex = (queueIndex + 1) % (int)m_queues.size();
+	}
+
+	// taking the lock makes sure that no worker is between
+	// checking for jobs and going to sleep
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+	}
+	m_wakeCondition.notify_all();
+
+	while (pendingJobs > 0)
+	{
+		if (RunOneJob(0) == false)
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+/***********************************************************
+ *  RunOneJob()
+ *
+ *  This method is used for running the newest job of the
+ *  passed in queue, or else the oldest job of the first other
+ *  queue that has one.
+ ***********************************************************/
+bool JobSystem::RunOneJob(int queueIndex)
+{
+	JOB job;
+	bool bFound = false;
+
+	{
+		JOB_QUEUE* pQueue = m_queues[queueIndex];
+		std::lock_guard<std::mutex> lock(pQueue->mutex);
+		if (pQueue->jobs.size() > 0)
+		{
+			job = pQueue->jobs.back();
+			pQueue->jobs.pop_back();
+			bFound = true;
+		}
+	}
+
+	for (int i = 1; (bFound == false) && (i < m_queues.size()); i++)
+	{
+		JOB_QUEUE* pVictim = m_queues[(queueIndex + i) % m_queues.size()];
+		std::lock_guard<std::mutex> lock(pVictim->mutex);
+		if (pVictim->jobs.size() > 0)
+		{
+			job = pVictim->jobs.front();
+			pVictim->jobs.pop_front();
+			bFound = true;
+		}
+	}
+
+	if (bFound == false)
+	{
+		return(false);
+	}
+
+	m_queuedJobs--;
+	(*job.pFunction)(job.begin, job.end);
+	(*job.pPendingJobs)--;
+
+	return(true);
+}
+
+/***********************************************************
+ *  WorkerMain()
+ *
+ *  This method is used for running jobs on a worker thread,
+ *  and sleeping while there are none.
+ ***********************************************************/
+void JobSystem::WorkerMain(int queueIndex)
+{
+	while (m_bRunning == true)
+	{
+		if (RunOneJob(queueIndex) == true)
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_wakeMutex);
+		m_wakeCondition.wait(lock, []() { return((m_queuedJobs > 0) || (m_bRunning == false)); });
+	}
+}
@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////
+// jobsystem.h
+// ============
+// run the per-frame scene traversal on a work-stealing thread pool
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  JobSystem
+ *
+ *  This class is used for splitting loops over the render
+ *  list into jobs that run on a pool of worker threads.  Each
+ *  thread has its own queue of jobs, takes new work from the
+ *  back of it, and steals from the front of the other queues
+ *  once it runs dry, so a slow chunk does not hold up the
+ *  rest.  The thread calling ParallelFor() works on the jobs
+ *  too and returns once all of them are done.  Jobs must not
+ *  make any OpenGL calls, which stay on the main thread, and
+ *  ParallelFor() is only called from the main thread.
+ ***********************************************************/
+class JobSystem
+{
+public:
+	// start the worker threads, with 0 for one less than the
+	// number of cores, since the main thread works as well
+	static void Initialize(int workerCount);
+	// stop and join the worker threads
+	static void Shutdown();
+	// number of threads working on the jobs, including the main one
+	static int GetThreadCount();
+
+	// call function(begin, end) for chunks of at most grainSize of
+	// the range [0, count), and wait until every chunk has run
+	static void ParallelFor(int count, int grainSize, const std::function<void(int, int)>& function);
+	// number of chunks that ParallelFor() splits a range into
+	static int GetChunkCount(int count, int grainSize);
+
+private:
+	// one chunk of a ParallelFor() range
+	struct JOB
+	{
+		const std::function<void(int, int)>* pFunction;
+		int begin;
+		int end;
+		std::atomic<int>* pPendingJobs;
+	};
+
+	// the jobs queued for one thread, with index 0 for the main thread
+	struct JOB_QUEUE
+	{
+		std::mutex mutex;
+		std::deque<JOB> jobs;
+	};
+
+	static std::vector<std::thread> m_workers;
+	static std::vector<JOB_QUEUE*> m_queues;
+	// jobs waiting in any of the queues
+	static std::atomic<int> m_queuedJobs;
+	static std::atomic<bool> m_bRunning;
+	// idle workers sleep here until jobs are queued
+	static std::mutex m_wakeMutex;
+	static std::condition_variable m_wakeCondition;
+
+	// loop of each worker thread
+	static void WorkerMain(int queueIndex);
+	// run one job from the own queue or stolen from another one,
+	// returning false when all of the queues are empty
+	static bool RunOneJob(int queueIndex);
+};
@@ -1,5 +1,8 @@
 #include <iostream>         // error handling and output
 #include <cstdlib>          // EXIT_FAILURE
+#include <cstring>          // strcmp
+#include <cstdio>           // sscanf
+#include <algorithm>        // std::min
 
 #include <GL/glew.h>        // GLEW library
 #include "GLFW/glfw3.h"     // GLFW library
@@ -13,6 +16,16 @@
 #include "ViewManager.h"
 #include "ShapeMeshes.h"
 #include "ShaderManager.h"
+#include "UniformCache.h"
+#include "GLState.h"
+#include "Profiler.h"
+#include "Benchmark.h"
+#include "RingBuffer.h"
+#include "FramePacer.h"
+#include "JobSystem.h"
+#include "ProgramCache.h"
+#include "FrameCapture.h"
+#include "DynamicResolution.h"
 
 // Namespace for declaring global variables
 namespace
@@ -29,12 +42,26 @@ namespace
 	ShaderManager* g_ShaderManager = nullptr;
 	// view manager object for managing the 3D view setup and projection to 2D
 	ViewManager* g_ViewManager = nullptr;
+
+	// frames between the profiler reports
+	const int PROFILER_REPORT_FRAMES = 600;
+	// bytes of per-frame data that each frame in flight can write
+	const GLsizeiptr RING_BUFFER_FRAME_SIZE = 16 * 1024 * 1024;
+	// the camera moves in fixed steps of this many seconds
+	const double FIXED_UPDATE_STEP = 1.0 / 120.0;
+	// most time caught up after a stall, so it cannot spiral
+	const double MAX_UPDATE_TIME = 0.25;
+
+	// the GLSL files of the shader program
+	const char* const VERTEX_SHADER_PATH = "../../Utilities/shaders/vertexShader.glsl";
+	const char* const FRAGMENT_SHADER_PATH = "../../Utilities/shaders/fragmentShader.glsl";
 }
 
 // Function declarations - all functions that are called manually
 // need to be pre-declared at the beginning of the source code.
 bool InitializeGLFW();
 bool InitializeGLEW();
+void LoadShaderProgram(bool bUseProgramCache);
 
 
 /***********************************************************
@@ -45,6 +72,250 @@ bool InitializeGLEW();
  ***********************************************************/
 int main(int argc, char* argv[])
 {
+	// command line options:
+	//   --trace <file>             write a Chrome trace of the frame scopes
+	//   --profile-draws            also time each Draw* object of the scene
+	//   --headless                 render offscreen and run the benchmark
+	//   --resolution <w>x<h>       size of the offscreen image
+	//   --frames <n>               number of measured benchmark frames
+	//   --objects <n>              add n synthetic objects to the scene
+	//   --lights <n>               add n synthetic point lights to the scene
+	//   --no-vsync                 do not wait for vsync in the window
+	//   --pacing <mode>            vsync, adaptive or uncapped swaps
+	//   --fps-cap <n>              start at most n frames per second
+	//   --frames-in-flight <n>     frames queued on the GPU, default 2
+	//   --threads <n>              worker threads for the scene traversal
+	//   --scene <file>             load a .scene or .sceneb scene file
+	//   --export-scene <file>      write the prepared scene to a file
+	//   --gpu-driven               cull and draw the objects on the GPU
+	//   --no-program-cache         always compile the shaders from source
+	//   --depth-mode <mode>        state, front-to-back or prepass order
+	//   --occlusion-culling        skip the objects hidden behind others
+	//   --record <file>            record the camera of every window frame
+	//   --replay <file>            drive the camera by a recorded fly-through
+	//   --latency-budget <ms>      fail the benchmark above this p95 latency
+	//   --baseline <file>          fail when slower than an earlier result
+	//   --tolerance <percent>      slowdown allowed over the baseline, 10
+	//   --results <file>           write the benchmark latency percentiles
+	//   --hot-reload               reload the edited scene and texture files
+	//   --dynamic-resolution <ms>  scale the render size to hold this GPU time
+	//   --shadows                  cast the shadows of the spot and sun lights
+	//
+	// e.g. the benchmark runs of the kitchen and the large scenes:
+	//   --headless --frames 1000
+	//   --headless --frames 200 --objects 10000
+	//   --headless --frames 50 --objects 100000
+	//   --headless --frames 50 --objects 100000 --gpu-driven
+	//   --headless --frames 200 --objects 10000 --lights 256
+	//   --headless --frames 200 --objects 10000 --depth-mode prepass
+	//   --headless --frames 200 --objects 10000 --occlusion-culling
+	//   --headless --frames 200 --objects 10000 --shadows
+	//
+	// e.g. recording a fly-through, and replaying it as a regression test:
+	//   --record flythrough.capture
+	//   --headless --replay flythrough.capture --results baseline.txt
+	//   --headless --replay flythrough.capture --baseline baseline.txt
+	//
+	// e.g. editing the kitchen scene while it runs:
+	//   --export-scene kitchen.scene
+	//   --scene kitchen.scene --hot-reload
+	//
+	// e.g. holding 60 frames per second with many lights on a weak GPU:
+	//   --lights 256 --dynamic-resolution 14
+	bool bHeadless = false;
+	FramePacer::PACING_MODE pacingMode = FramePacer::PACING_VSYNC;
+	int frameRateCap = 0;
+	int framesInFlight = 2;
+	int workerThreads = 0;
+	int benchmarkWidth = 1920;
+	int benchmarkHeight = 1080;
+	int benchmarkFrames = 500;
+	int syntheticObjects = 0;
+	int syntheticLights = 0;
+	const char* sceneFilename = NULL;
+	const char* exportFilename = NULL;
+	bool bGpuDriven = false;
+	bool bUseProgramCache = true;
+	SceneManager::DEPTH_MODE depthMode = SceneManager::DEPTH_STATE_ORDER;
+	bool bOcclusionCulling = false;
+	const char* recordFilename = NULL;
+	const char* replayFilename = NULL;
+	const char* baselineFilename = NULL;
+	const char* resultsFilename = NULL;
+	double latencyBudget = 0.0;
+	double baselineTolerance = 10.0;
+	bool bHotReload = false;
+	bool bShadows = false;
+	double resolutionTargetMs = 0.0;
+	for (int i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--trace") == 0) && (i + 1 < argc))
+		{
+			Profiler::SetTraceFile(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--profile-draws") == 0)
+		{
+			Profiler::SetDrawScopes(true);
+		}
+		else if (strcmp(argv[i], "--headless") == 0)
+		{
+			bHeadless = true;
+		}
+		else if ((strcmp(argv[i], "--resolution") == 0) && (i + 1 < argc))
+		{
+			if (sscanf(argv[++i], "%dx%d", &benchmarkWidth, &benchmarkHeight) != 2)
+			{
+				std::cout << "Invalid resolution: " << argv[i] << std::endl;
+				return(EXIT_FAILURE);
+			}
+		}
+		else if ((strcmp(argv[i], "--frames") == 0) && (i + 1 < argc))
+		{
+			benchmarkFrames = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--objects") == 0) && (i + 1 < argc))
+		{
+			syntheticObjects = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--lights") == 0) && (i + 1 < argc))
+		{
+			syntheticLights = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--no-vsync") == 0)
+		{
+			pacingMode = FramePacer::PACING_UNCAPPED;
+		}
+		else if ((strcmp(argv[i], "--pacing") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (strcmp(argv[i], "vsync") == 0)
+			{
+				pacingMode = FramePacer::PACING_VSYNC;
+			}
+			else if (strcmp(argv[i], "adaptive") == 0)
+			{
+				pacingMode = FramePacer::PACING_ADAPTIVE_VSYNC;
+			}
+			else if (strcmp(argv[i], "uncapped") == 0)
+			{
+				pacingMode = FramePacer::PACING_UNCAPPED;
+			}
+			else
+			{
+				std::cout << "Invalid pacing mode: " << argv[i] << std::endl;
+				return(EXIT_FAILURE);
+			}
+		}
+		else if ((strcmp(argv[i], "--fps-cap") == 0) && (i + 1 < argc))
+		{
+			frameRateCap = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--frames-in-flight") == 0) && (i + 1 < argc))
+		{
+			framesInFlight = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc))
+		{
+			workerThreads = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--scene") == 0) && (i + 1 < argc))
+		{
+			sceneFilename = argv[++i];
+		}
+		else if ((strcmp(argv[i], "--export-scene") == 0) && (i + 1 < argc))
+		{
+			exportFilename = argv[++i];
+		}
+		else if (strcmp(argv[i], "--gpu-driven") == 0)
+		{
+			bGpuDriven = true;
+		}
+		else if (strcmp(argv[i], "--no-program-cache") == 0)
+		{
+			bUseProgramCache = false;
+		}
+		else if ((strcmp(argv[i], "--depth-mode") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (strcmp(argv[i], "state") == 0)
+			{
+				depthMode = SceneManager::DEPTH_STATE_ORDER;
+			}
+			else if (strcmp(argv[i], "front-to-back") == 0)
+			{
+				depthMode = SceneManager::DEPTH_FRONT_TO_BACK;
+			}
+			else if (strcmp(argv[i], "prepass") == 0)
+			{
+				depthMode = SceneManager::DEPTH_PREPASS;
+			}
+			else
+			{
+				std::cout << "Invalid depth mode: " << argv[i] << std::endl;
+				return(EXIT_FAILURE);
+			}
+		}
+		else if (strcmp(argv[i], "--occlusion-culling") == 0)
+		{
+			bOcclusionCulling = true;
+		}
+		else if ((strcmp(argv[i], "--record") == 0) && (i + 1 < argc))
+		{
+			recordFilename = argv[++i];
+		}
+		else if ((strcmp(argv[i], "--replay") == 0) && (i + 1 < argc))
+		{
+			replayFilename = argv[++i];
+		}
+		else if ((strcmp(argv[i], "--latency-budget") == 0) && (i + 1 < argc))
+		{
+			latencyBudget = atof(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--baseline") == 0) && (i + 1 < argc))
+		{
+			baselineFilename = argv[++i];
+		}
+		else if ((strcmp(argv[i], "--tolerance") == 0) && (i + 1 < argc))
+		{
+			baselineTolerance = atof(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--results") == 0) && (i + 1 < argc))
+		{
+			resultsFilename = argv[++i];
+		}
+		else if (strcmp(argv[i], "--hot-reload") == 0)
+		{
+			bHotReload = true;
+		}
+		else if ((strcmp(argv[i], "--dynamic-resolution") == 0) && (i + 1 < argc))
+		{
+			resolutionTargetMs = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--shadows") == 0)
+		{
+			bShadows = true;
+		}
+	}
+
+	// the capture files are opened before anything is initialized,
+	// so a path that cannot be read or written exits cleanly.  A
+	// replay drives the camera in both modes, and the benchmark
+	// measures each of its frames once
+	if (NULL != replayFilename)
+	{
+		if (FrameCapture::LoadReplay(replayFilename) == false)
+		{
+			return(EXIT_FAILURE);
+		}
+		benchmarkFrames = FrameCapture::GetFrameCount();
+	}
+	// the camera of the window frames is recorded until it closes
+	if ((bHeadless == false) && (NULL != recordFilename) &&
+		(FrameCapture::StartRecording(recordFilename) == false))
+	{
+		return(EXIT_FAILURE);
+	}
+
 	// if GLFW fails initialization, then terminate the application
 	if (InitializeGLFW() == false)
 	{
@@ -57,49 +328,247 @@ int main(int argc, char* argv[])
 	g_ViewManager = new ViewManager(
 		g_ShaderManager);
 
-	// try to create the main display window
-	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
-
+	// try to create the main display window, or only a hidden
+	// one holding the OpenGL context for the headless mode
+	if (bHeadless == true)
+	{
+		g_Window = g_ViewManager->CreateOffscreenWindow(WINDOW_TITLE);
+	}
+	else
+	{
+		g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
+	}
+	if (NULL == g_Window)
+	{
+		return(EXIT_FAILURE);
+	}
 	// if GLEW fails initialization, then terminate the application
 	if (InitializeGLEW() == false)
 	{
 		return(EXIT_FAILURE);
 	}
 
-	// load the shader code from the external GLSL files
-	g_ShaderManager->LoadShaders(
-		"../../Utilities/shaders/vertexShader.glsl",
-		"../../Utilities/shaders/fragmentShader.glsl");
+	// timer queries are part of every supported OpenGL version
+	Profiler::Initialize(true);
+	// the per-frame view and instance data is streamed through
+	// a persistently mapped buffer when the driver supports it
+	RingBuffer::Initialize(RING_BUFFER_FRAME_SIZE);
+	// the scene traversal is split across the cores
+	JobSystem::Initialize(workerThreads);
+
+	// load the shader program from its cached binary, or else
+	// compile the shader code from the external GLSL files
+	LoadShaderProgram(bUseProgramCache);
 	g_ShaderManager->use();
+	GLState::BindActiveProgram();
+
+	// resolve the view uniforms once now that the shaders are active
+	g_ViewManager->CacheUniformLocations();
 
 	// try to create a new scene manager object and prepare the 3D scene
 	g_SceneManager = new SceneManager(g_ShaderManager);
+	g_SceneManager->SetSceneFile(sceneFilename);
+	g_SceneManager->SetGpuDriven(bGpuDriven);
+	g_SceneManager->SetDepthMode(depthMode);
+	g_SceneManager->SetOcclusionCulling(bOcclusionCulling);
+	g_SceneManager->SetHotReload(bHotReload);
+	g_SceneManager->SetShadows(bShadows);
+	g_SceneManager->SetShaderSources(VERTEX_SHADER_PATH, FRAGMENT_SHADER_PATH, bUseProgramCache);
 	g_SceneManager->PrepareScene();
+	g_SceneManager->AddSyntheticObjects(syntheticObjects);
+	g_SceneManager->AddSyntheticLights(syntheticLights);
+	if (NULL != exportFilename)
+	{
+		g_SceneManager->SaveSceneFile(exportFilename);
+	}
+
+	// the headless mode measures the scene and exits
+	if (bHeadless == true)
+	{
+		Benchmark benchmark(g_SceneManager, g_ViewManager);
+		benchmark.SetLatencyBudget(latencyBudget);
+		benchmark.SetResultsFile(resultsFilename);
+		bool bBenchmarked = true;
+		if (NULL != baselineFilename)
+		{
+			bBenchmarked = benchmark.LoadBaseline(baselineFilename, baselineTolerance);
+		}
+		if (bBenchmarked == true)
+		{
+			bBenchmarked = benchmark.Run(benchmarkWidth, benchmarkHeight, benchmarkFrames);
+		}
+
+		Profiler::Shutdown();
+		Profiler::PrintReport();
+		RingBuffer::Shutdown();
+		JobSystem::Shutdown();
+
+		delete g_SceneManager;
+		g_SceneManager = NULL;
+		delete g_ViewManager;
+		g_ViewManager = NULL;
+		delete g_ShaderManager;
+		g_ShaderManager = NULL;
+
+		exit(bBenchmarked ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	// the frame pacer sets the swap interval of the window, since
+	// nothing waits for the display while benchmarking
+	FramePacer framePacer;
+	framePacer.Initialize(pacingMode, frameRateCap, framesInFlight);
+	// camera time that has not been simulated by a fixed step yet
+	double updateTime = 0.0;
+	double lastUpdateTime = glfwGetTime();
+
+	// the number of rendered frames
+	int frameCount = 0;
+
+	// the scene is drawn at a scaled size and stretched over the
+	// window when a GPU time budget is given
+	DynamicResolution dynamicResolution;
+	bool bDynamicResolution = false;
+	if (resolutionTargetMs > 0.0)
+	{
+		bDynamicResolution = dynamicResolution.Initialize(g_ViewManager->GetWindowWidth(),
+			g_ViewManager->GetWindowHeight(), resolutionTargetMs);
+	}
 
 	// loop will keep running until the application is closed 
 	// or until an error has occurred
 	while (!glfwWindowShouldClose(g_Window))
 	{
+		// start counting the uniform name lookups for this frame
+		UniformCache::ResetFrameLookups();
+		GLState::ResetFrameCounters();
+		Profiler::BeginFrame();
+
+		// wait for a free frame slot and the frame rate cap before
+		// the input is sampled, so the frame uses the latest input
+		int stageScope = Profiler::BeginScope("FramePacing");
+		framePacer.BeginFrame();
+		Profiler::EndScope(stageScope);
+
+		// query the latest GLFW events
+		stageScope = Profiler::BeginScope("PollEvents");
+		glfwPollEvents();
+		Profiler::EndScope(stageScope);
+
+		// move the camera in fixed steps for the time that passed
+		stageScope = Profiler::BeginScope("UpdateView");
+		double currentTime = glfwGetTime();
+		updateTime += std::min(currentTime - lastUpdateTime, MAX_UPDATE_TIME);
+		lastUpdateTime = currentTime;
+		while (updateTime >= FIXED_UPDATE_STEP)
+		{
+			g_ViewManager->UpdateView((float)FIXED_UPDATE_STEP);
+			updateTime -= FIXED_UPDATE_STEP;
+		}
+		Profiler::EndScope(stageScope);
+
+		// wait until the GPU has read this frame's section of the
+		// ring buffer from three frames ago
+		RingBuffer::BeginFrame();
+
 		// Enable z-depth
-		glEnable(GL_DEPTH_TEST);
+		GLState::Enable(GL_DEPTH_TEST);
+
+		// draw at the scaled size, or else at the window size, while
+		// the aspect ratio of the projection is always the window's
+		if (bDynamicResolution == true)
+		{
+			dynamicResolution.Resize(g_ViewManager->GetWindowWidth(), g_ViewManager->GetWindowHeight());
+			dynamicResolution.BeginFrame();
+			g_ViewManager->SetViewSize(dynamicResolution.GetRenderWidth(), dynamicResolution.GetRenderHeight());
+			g_ViewManager->SetAspectRatio(g_ViewManager->GetWindowWidth(), g_ViewManager->GetWindowHeight());
+		}
+		else
+		{
+			glViewport(0, 0, g_ViewManager->GetWindowWidth(), g_ViewManager->GetWindowHeight());
+			g_ViewManager->SetViewSize(g_ViewManager->GetWindowWidth(), g_ViewManager->GetWindowHeight());
+		}
 
 		// Clear the frame and z buffers
-		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		stageScope = Profiler::BeginScope("Clear");
+		GLState::ClearColor(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		Profiler::EndScope(stageScope);
 
 		// convert from 3D object space to 2D view
+		stageScope = Profiler::BeginScope("PrepareSceneView");
 		g_ViewManager->PrepareSceneView();
+		g_SceneManager->SetViewProjection(g_ViewManager->GetViewProjection());
+		g_SceneManager->SetLodView(g_ViewManager->GetCameraPosition(), g_ViewManager->GetFieldOfView(), g_ViewManager->GetViewHeight());
+		g_SceneManager->SetClusterView(g_ViewManager->GetView(), g_ViewManager->GetProjection(),
+			g_ViewManager->GetNearPlane(), g_ViewManager->GetFarPlane(),
+			g_ViewManager->GetViewWidth(), g_ViewManager->GetViewHeight());
+		Profiler::EndScope(stageScope);
 
 		// refresh the 3D scene
+		stageScope = Profiler::BeginScope("RenderScene");
 		g_SceneManager->RenderScene();
+		Profiler::EndScope(stageScope);
 
+		// the GPU is done with this frame's section once it reaches
+		// the commands recorded so far
+		RingBuffer::EndFrame();
+
+		// stretch the scaled image over the window, and pick the
+		// scale of the next frames from the measured scene time
+		if (bDynamicResolution == true)
+		{
+			stageScope = Profiler::BeginScope("Upscale");
+			dynamicResolution.EndFrame();
+			Profiler::EndScope(stageScope);
+			dynamicResolution.Update(Profiler::GetLastGpuMs("RenderScene"));
+		}
 
 		// Flips the the back buffer with the front buffer every frame.
+		stageScope = Profiler::BeginScope("SwapBuffers");
 		glfwSwapBuffers(g_Window);
+		Profiler::EndScope(stageScope);
+		framePacer.EndFrame();
 
-		// query the latest GLFW events
-		glfwPollEvents();
+		Profiler::EndFrame();
+		frameCount++;
+		if ((frameCount % PROFILER_REPORT_FRAMES) == 0)
+		{
+			Profiler::PrintReport();
+			framePacer.PrintReport();
+			dynamicResolution.PrintReport();
+
+			// the uniform name lookups should be zero for every frame
+			// at steady state
+			std::cout << "INFO: uniform name lookups per frame: " << UniformCache::GetFrameLookups() << std::endl;
+
+			// the render list counters of the last frame
+			const SceneManager::RENDER_STATS& renderStats = g_SceneManager->GetRenderStats();
+			std::cout << "INFO: draw calls: " << renderStats.drawCalls
+				<< ", instanced objects: " << renderStats.instancedObjects
+				<< ", state changes: " << renderStats.stateChanges
+				<< ", redundant state changes skipped: " << renderStats.stateChangesSkipped
+				<< ", culled objects: " << renderStats.culledObjects
+				<< ", occluded objects: " << renderStats.occludedObjects
+				<< ", reduced detail objects: " << renderStats.reducedDetailObjects
+				<< ", static batched objects: " << renderStats.staticObjects
+				<< ", GPU driven objects: " << renderStats.gpuDrivenObjects
+				<< ", shader program changes: " << renderStats.programChanges
+				<< ", depth pre-pass draw calls: " << renderStats.prePassDrawCalls
+				<< ", shadow maps drawn: " << renderStats.shadowMapsDrawn
+				<< ", shadow draw calls: " << renderStats.shadowDrawCalls
+				<< ", filtered GL calls: " << GLState::GetFilteredCalls() << std::endl;
+		}
 	}
+	framePacer.Shutdown();
+	framePacer.PrintReport();
+	FrameCapture::StopRecording();
+
+	// report the final percentiles and write the trace file
+	// while the OpenGL context still exists
+	Profiler::Shutdown();
+	Profiler::PrintReport();
+	RingBuffer::Shutdown();
+	JobSystem::Shutdown();
 
 	// clear the allocated manager objects from memory
 	if (NULL != g_SceneManager)
@@ -174,4 +643,51 @@ bool InitializeGLEW()
 	std::cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << "\n" << std::endl;
 
 	return(true);
-}
\ No newline at end of file
+}
+/***********************************************************
+ *	LoadShaderProgram()
+ *
+ *  This function is used to restore the linked shader program
+ *  from the binary saved by an earlier launch, or to compile
+ *  it from source and save its binary for the next launch.
+ *  Sources that cannot be read are still passed to the shader
+ *  manager so that it reports the error.
+ ***********************************************************/
+void LoadShaderProgram(bool bUseProgramCache)
+{
+	double startTime = glfwGetTime();
+
+	std::string vertexSource;
+	std::string fragmentSource;
+	bool bCacheable = (bUseProgramCache == true) &&
+		(ProgramCache::IsSupported() == true) &&
+		(ProgramCache::ReadSource(VERTEX_SHADER_PATH, vertexSource) == true) &&
+		(ProgramCache::ReadSource(FRAGMENT_SHADER_PATH, fragmentSource) == true);
+
+	unsigned long long programKey = 0;
+	std::string cachePath;
+	if (bCacheable == true)
+	{
+		programKey = ProgramCache::GetProgramKey(vertexSource, fragmentSource);
+		cachePath = ProgramCache::GetCachePath(VERTEX_SHADER_PATH, programKey);
+
+		GLuint program = ProgramCache::Load(cachePath, programKey);
+		if (0 != program)
+		{
+			g_ShaderManager->m_programID = program;
+			std::cout << "INFO: shader program restored from " << cachePath << " in "
+				<< (glfwGetTime() - startTime) * 1000.0 << " ms" << std::endl;
+			return;
+		}
+	}
+
+	g_ShaderManager->LoadShaders(VERTEX_SHADER_PATH, FRAGMENT_SHADER_PATH);
+	std::cout << "INFO: shader program compiled from source in "
+		<< (glfwGetTime() - startTime) * 1000.0 << " ms" << std::endl;
+
+	if ((bCacheable == true) &&
+		(ProgramCache::Save(g_ShaderManager->m_programID, cachePath, programKey) == false))
+	{
+		std::cout << "Could not save the shader program binary to " << cachePath << std::endl;
+	}
+}
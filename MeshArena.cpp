@@ -0,0 +1,217 @@
+///////////////////////////////////////////////////////////////////////////////
+// mesharena.cpp
+// ============
+// keep the geometry of many meshes in one shared vertex and index buffer
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshArena.h"
+#include "MeshLibrary.h"
+#include "GLState.h"
+
+// declaration of global variables
+namespace
+{
+	// number of floats per vertex - position, normal, texture coordinate
+	const int g_FloatsPerVertex = MeshLibrary::FLOATS_PER_VERTEX;
+}
+
+/***********************************************************
+ *  MeshArena()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+MeshArena::MeshArena()
+{
+	m_vao = 0;
+	m_vertexBuffer = 0;
+	m_indexBuffer = 0;
+	m_vertexBufferSize = 0;
+	m_indexBufferSize = 0;
+	m_uploadedVertices = 0;
+	m_uploadedIndices = 0;
+}
+
+/***********************************************************
+ *  ~MeshArena()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+MeshArena::~MeshArena()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the shared buffers and the
+ *  vertex array, along with every mesh in them.
+ ***********************************************************/
+void MeshArena::Destroy()
+{
+	if (0 != m_vao)
+	{
+		GLState::ForgetVertexArray(m_vao);
+		glDeleteVertexArrays(1, &m_vao);
+		m_vao = 0;
+	}
+
+	GLuint* buffers[2] = { &m_vertexBuffer, &m_indexBuffer };
+	for (int i = 0; i < 2; i++)
+	{
+		if (0 != *buffers[i])
+		{
+			glDeleteBuffers(1, buffers[i]);
+			*buffers[i] = 0;
+		}
+	}
+
+	m_vertices.clear();
+	m_indices.clear();
+	m_vertexBufferSize = 0;
+	m_indexBufferSize = 0;
+	m_uploadedVertices = 0;
+	m_uploadedIndices = 0;
+}
+
+/***********************************************************
+ *  Reserve()
+ *
+ *  This method is used for making room for the passed in
+ *  number of vertices and indices past the end of the arena.
+ *  The buffers are then allocated once at that size.
+ ***********************************************************/
+void MeshArena::Reserve(int vertexCount, int indexCount)
+{
+	m_vertices.reserve(m_vertices.size() + (size_t)vertexCount * g_FloatsPerVertex);
+	m_indices.reserve(m_indices.size() + (size_t)indexCount);
+}
+
+/***********************************************************
+ *  Allocate()
+ *
+ *  This method is used for copying the vertices and indices
+ *  of one mesh to the end of the arena.  The indices are kept
+ *  as they are, and the returned base vertex is added to them
+ *  when the mesh is drawn.
+ ***********************************************************/
+MeshArena::MESH_RANGE MeshArena::Allocate(const std::vector<GLfloat>& vertices, const std::vector<GLuint>& indices)
+{
+	MESH_RANGE range;
+	range.baseVertex = (GLint)(m_vertices.size() / g_FloatsPerVertex);
+	range.firstIndex = (GLuint)m_indices.size();
+	range.indexCount = (GLuint)indices.size();
+
+	m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
+	m_indices.insert(m_indices.end(), indices.begin(), indices.end());
+
+	return(range);
+}
+
+/***********************************************************
+ *  Upload()
+ *
+ *  This method is used for copying the meshes allocated since
+ *  the last upload into the shared buffers.  The buffers keep
+ *  the reserved capacity of the arena, so they only have to
+ *  be allocated again when more meshes are added than were
+ *  reserved for.  The vertex array uses the same attribute
+ *  locations as the ShapeMeshes primitives.
+ ***********************************************************/
+void MeshArena::Upload()
+{
+	const GLint stride = sizeof(GLfloat) * g_FloatsPerVertex;
+
+	if (0 == m_vao)
+	{
+		glGenVertexArrays(1, &m_vao);
+		glGenBuffers(1, &m_vertexBuffer);
+		glGenBuffers(1, &m_indexBuffer);
+
+		GLState::BindVertexArray(m_vao);
+		glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+
+		// vertex position, normal and texture coordinate
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(GLfloat) * 3));
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(GLfloat) * 6));
+		glEnableVertexAttribArray(2);
+	}
+	else
+	{
+		GLState::BindVertexArray(m_vao);
+		glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+	}
+
+	// the data past the last upload either fits into the buffers,
+	// or they are allocated again at the capacity of the arena
+	GLsizeiptr vertexBytes = m_vertices.size() * sizeof(GLfloat);
+	if (vertexBytes > m_vertexBufferSize)
+	{
+		m_vertexBufferSize = m_vertices.capacity() * sizeof(GLfloat);
+		glBufferData(GL_ARRAY_BUFFER, m_vertexBufferSize, NULL, GL_STATIC_DRAW);
+		m_uploadedVertices = 0;
+	}
+	if (m_vertices.size() > m_uploadedVertices)
+	{
+		glBufferSubData(GL_ARRAY_BUFFER, m_uploadedVertices * sizeof(GLfloat),
+			(m_vertices.size() - m_uploadedVertices) * sizeof(GLfloat), m_vertices.data() + m_uploadedVertices);
+		m_uploadedVertices = m_vertices.size();
+	}
+
+	GLsizeiptr indexBytes = m_indices.size() * sizeof(GLuint);
+	if (indexBytes > m_indexBufferSize)
+	{
+		m_indexBufferSize = m_indices.capacity() * sizeof(GLuint);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferSize, NULL, GL_STATIC_DRAW);
+		m_uploadedIndices = 0;
+	}
+	if (m_indices.size() > m_uploadedIndices)
+	{
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, m_uploadedIndices * sizeof(GLuint),
+			(m_indices.size() - m_uploadedIndices) * sizeof(GLuint), m_indices.data() + m_uploadedIndices);
+		m_uploadedIndices = m_indices.size();
+	}
+
+	GLState::BindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/***********************************************************
+ *  GetVertexArray()
+ *
+ *  This method is used for getting the vertex array that
+ *  draws every mesh of the arena.
+ ***********************************************************/
+GLuint MeshArena::GetVertexArray() const
+{
+	return(m_vao);
+}
+
+/***********************************************************
+ *  GetVertexCount()
+ *
+ *  This method is used for getting the number of vertices of
+ *  all the meshes in the arena.
+ ***********************************************************/
+int MeshArena::GetVertexCount() const
+{
+	return((int)(m_vertices.size() / g_FloatsPerVertex));
+}
+
+/***********************************************************
+ *  GetIndexCount()
+ *
+ *  This method is used for getting the number of indices of
+ *  all the meshes in the arena.
+ ***********************************************************/
+int MeshArena::GetIndexCount() const
+{
+	return((int)m_indices.size());
+}
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////
+// mesharena.h
+// ============
+// keep the geometry of many meshes in one shared vertex and index buffer
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <vector>
+
+/***********************************************************
+ *  MeshArena
+ *
+ *  This class contains the code for storing the vertices and
+ *  indices of many meshes in one vertex buffer and one index
+ *  buffer, drawn through a single vertex array.  Each mesh is
+ *  appended to the end of the arena and keeps its own indices
+ *  starting at zero, so a draw only needs the base vertex and
+ *  the first index of its range.  Meshes are never freed one
+ *  by one, the whole arena is freed at once.
+ ***********************************************************/
+class MeshArena
+{
+public:
+	// where one mesh landed in the arena
+	struct MESH_RANGE
+	{
+		GLint baseVertex;
+		GLuint firstIndex;
+		GLuint indexCount;
+	};
+
+	// constructor
+	MeshArena();
+	// destructor
+	~MeshArena();
+
+	// make room for this many more vertices and indices, so that
+	// the meshes that follow are copied without reallocating
+	void Reserve(int vertexCount, int indexCount);
+	// copy one mesh to the end of the arena
+	MESH_RANGE Allocate(const std::vector<GLfloat>& vertices, const std::vector<GLuint>& indices);
+	// upload the meshes allocated since the last upload
+	void Upload();
+
+	// the vertex array that draws all of the meshes
+	GLuint GetVertexArray() const;
+	// number of vertices and indices in the arena
+	int GetVertexCount() const;
+	int GetIndexCount() const;
+
+private:
+	// the meshes, kept for growing the buffers
+	std::vector<GLfloat> m_vertices;
+	std::vector<GLuint> m_indices;
+
+	// shared buffers and the vertex array reading them
+	GLuint m_vao;
+	GLuint m_vertexBuffer;
+	GLuint m_indexBuffer;
+	// bytes allocated in the buffers, and floats and indices in them
+	GLsizeiptr m_vertexBufferSize;
+	GLsizeiptr m_indexBufferSize;
+	size_t m_uploadedVertices;
+	size_t m_uploadedIndices;
+
+	// free the buffers and the vertex array
+	void Destroy();
+};
@@ -0,0 +1,663 @@
+///////////////////////////////////////////////////////////////////////////////
+// meshlibrary.cpp
+// ============
+// generate basic shape meshes that support instanced drawing
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshLibrary.h"
+#include "RingBuffer.h"
+#include "GLState.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	// number of floats per vertex - position, normal, texture coordinate
+	const int g_FloatsPerVertex = MeshLibrary::FLOATS_PER_VERTEX;
+
+	// tessellation of each level of detail of the generated meshes,
+	// with level 0 matching the ShapeMeshes primitives
+	const int g_SphereSlices[MeshLibrary::LOD_COUNT] = { 24, 12, 6 };
+	const int g_SphereStacks[MeshLibrary::LOD_COUNT] = { 16, 8, 4 };
+	const int g_CylinderSides[MeshLibrary::LOD_COUNT] = { 36, 16, 8 };
+
+	const float g_Pi = 3.14159265358979f;
+
+	// append one vertex to the vertex list
+	void AddVertex(
+		std::vector<GLfloat>& vertices,
+		glm::vec3 position,
+		glm::vec3 normal,
+		glm::vec2 textureCoordinate)
+	{
+		vertices.push_back(position.x);
+		vertices.push_back(position.y);
+		vertices.push_back(position.z);
+		vertices.push_back(normal.x);
+		vertices.push_back(normal.y);
+		vertices.push_back(normal.z);
+		vertices.push_back(textureCoordinate.x);
+		vertices.push_back(textureCoordinate.y);
+	}
+}
+
+/***********************************************************
+ *  MeshLibrary()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+MeshLibrary::MeshLibrary()
+{
+	m_planeRange = {};
+	m_boxRange = {};
+	for (int i = 0; i < LOD_COUNT; i++)
+	{
+		m_sphereLods[i] = {};
+		m_cylinderLods[i] = {};
+	}
+	m_instanceBuffer = 0;
+	m_instanceBufferSize = 0;
+}
+
+/***********************************************************
+ *  ~MeshLibrary()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+MeshLibrary::~MeshLibrary()
+{
+	if (0 != m_instanceBuffer)
+	{
+		glDeleteBuffers(1, &m_instanceBuffer);
+		m_instanceBuffer = 0;
+	}
+}
+
+/***********************************************************
+ *  SetupInstanceAttributes()
+ *
+ *  This method is used for attaching the shared instance
+ *  buffer to the arena vertex array, advancing once per
+ *  drawn instance instead of once per vertex.  The buffer
+ *  always holds at least one instance, since the draws of
+ *  single objects also fetch the first one.
+ ***********************************************************/
+void MeshLibrary::SetupInstanceAttributes()
+{
+	const GLint stride = sizeof(INSTANCE_DATA);
+
+	if (0 == m_instanceBuffer)
+	{
+		INSTANCE_DATA firstInstance = { glm::mat4(1.0f), glm::vec4(1.0f) };
+		glGenBuffers(1, &m_instanceBuffer);
+		glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(INSTANCE_DATA), &firstInstance, GL_STATIC_DRAW);
+		m_instanceBufferSize = sizeof(INSTANCE_DATA);
+	}
+
+	GLState::BindVertexArray(m_arena.GetVertexArray());
+	glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+
+	// a mat4 attribute takes four consecutive vec4 locations
+	for (GLuint column = 0; column < 4; column++)
+	{
+		GLuint location = INSTANCE_MODEL_LOCATION + column;
+		glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(glm::vec4) * column));
+		glEnableVertexAttribArray(location);
+		glVertexAttribDivisor(location, 1);
+	}
+
+	glVertexAttribPointer(INSTANCE_COLOR_LOCATION, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(INSTANCE_DATA, color));
+	glEnableVertexAttribArray(INSTANCE_COLOR_LOCATION);
+	glVertexAttribDivisor(INSTANCE_COLOR_LOCATION, 1);
+
+	GLState::BindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/***********************************************************
+ *  LoadMeshes()
+ *
+ *  This method is used for generating the plane, the box, and
+ *  every level of detail of the sphere with a radius of 1.0
+ *  centered on the origin and of the cylinder with a radius
+ *  of 1.0 and a height of 1.0 standing on the origin.  The
+ *  arena is reserved for all of them first, so each mesh is
+ *  copied into it without reallocating, and the shared
+ *  buffers are allocated and uploaded once.
+ ***********************************************************/
+void MeshLibrary::LoadMeshes()
+{
+	std::vector<GLfloat> vertices;
+	std::vector<GLuint> indices;
+	MeshArena::MESH_RANGE range;
+
+	if (0 != m_arena.GetVertexArray())
+	{
+		return;
+	}
+
+	// the plane and the box, then the vertices and indices of the
+	// sphere and the cylinder at each level of detail
+	int vertexCount = 4 + 24;
+	int indexCount = 6 + 36;
+	for (int lod = 0; lod < LOD_COUNT; lod++)
+	{
+		vertexCount += (g_SphereSlices[lod] + 1) * (g_SphereStacks[lod] + 1);
+		indexCount += g_SphereSlices[lod] * g_SphereStacks[lod] * 6;
+		vertexCount += 4 * (g_CylinderSides[lod] + 1) + 2;
+		indexCount += 12 * g_CylinderSides[lod];
+	}
+	m_arena.Reserve(vertexCount, indexCount);
+
+	GetPlaneGeometry(vertices, indices);
+	range = m_arena.Allocate(vertices, indices);
+	m_planeRange.firstIndex = range.firstIndex;
+	m_planeRange.indexCount = range.indexCount;
+	m_planeRange.baseVertex = range.baseVertex;
+
+	GetBoxGeometry(vertices, indices);
+	range = m_arena.Allocate(vertices, indices);
+	m_boxRange.firstIndex = range.firstIndex;
+	m_boxRange.indexCount = range.indexCount;
+	m_boxRange.baseVertex = range.baseVertex;
+
+	// all levels of detail of a mesh are allocated together, with
+	// their ranges moved to where the mesh landed
+	vertices.clear();
+	indices.clear();
+	for (int lod = 0; lod < LOD_COUNT; lod++)
+	{
+		AddSphereLod(vertices, indices, g_SphereSlices[lod], g_SphereStacks[lod], m_sphereLods[lod]);
+	}
+	range = m_arena.Allocate(vertices, indices);
+	for (int lod = 0; lod < LOD_COUNT; lod++)
+	{
+		m_sphereLods[lod].firstIndex += range.firstIndex;
+		m_sphereLods[lod].baseVertex = range.baseVertex;
+	}
+
+	vertices.clear();
+	indices.clear();
+	for (int lod = 0; lod < LOD_COUNT; lod++)
+	{
+		AddCylinderLod(vertices, indices, g_CylinderSides[lod], m_cylinderLods[lod]);
+	}
+	range = m_arena.Allocate(vertices, indices);
+	for (int lod = 0; lod < LOD_COUNT; lod++)
+	{
+		INDEX_RANGE* parts[3] = { &m_cylinderLods[lod].top, &m_cylinderLods[lod].sides, &m_cylinderLods[lod].bottom };
+		for (int i = 0; i < 3; i++)
+		{
+			parts[i]->firstIndex += range.firstIndex;
+			parts[i]->baseVertex = range.baseVertex;
+		}
+	}
+
+	m_arena.Upload();
+	SetupInstanceAttributes();
+}
+
+/***********************************************************
+ *  AddSphereLod()
+ *
+ *  This method is used for appending one level of detail of
+ *  the sphere, with the passed in number of slices around
+ *  and stacks from bottom to top.
+ ***********************************************************/
+void MeshLibrary::AddSphereLod(
+	std::vector<GLfloat>& vertices,
+	std::vector<GLuint>& indices,
+	int slices,
+	int stacks,
+	INDEX_RANGE& range)
+{
+	GLuint firstVertex = (GLuint)(vertices.size() / g_FloatsPerVertex);
+
+	for (int stack = 0; stack <= stacks; stack++)
+	{
+		float v = (float)stack / (float)stacks;
+		float phi = v * g_Pi;
+
+		for (int slice = 0; slice <= slices; slice++)
+		{
+			float u = (float)slice / (float)slices;
+			float theta = u * 2.0f * g_Pi;
+
+			glm::vec3 normal(
+				std::sin(phi) * std::cos(theta),
+				-std::cos(phi),
+				-std::sin(phi) * std::sin(theta));
+			AddVertex(vertices, normal, normal, glm::vec2(u, v));
+		}
+	}
+
+	range.firstIndex = (GLuint)indices.size();
+	for (int stack = 0; stack < stacks; stack++)
+	{
+		for (int slice = 0; slice < slices; slice++)
+		{
+			GLuint first = firstVertex + stack * (slices + 1) + slice;
+			GLuint second = first + slices + 1;
+
+			indices.push_back(first);
+			indices.push_back(first + 1);
+			indices.push_back(second);
+			indices.push_back(second);
+			indices.push_back(first + 1);
+			indices.push_back(second + 1);
+		}
+	}
+	range.indexCount = (GLuint)indices.size() - range.firstIndex;
+}
+
+/***********************************************************
+ *  AddCylinderLod()
+ *
+ *  This method is used for appending one level of detail of
+ *  the cylinder with the passed in number of sides.  The top,
+ *  sides and bottom are stored in that order so that
+ *  neighboring parts can be drawn with one call.
+ ***********************************************************/
+void MeshLibrary::AddCylinderLod(
+	std::vector<GLfloat>& vertices,
+	std::vector<GLuint>& indices,
+	int sides,
+	CYLINDER_PARTS& parts)
+{
+	// top cap - a center vertex with a ring around it
+	GLuint topCenter = (GLuint)(vertices.size() / g_FloatsPerVertex);
+	AddVertex(vertices, glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(0.5f, 0.5f));
+	for (int side = 0; side <= sides; side++)
+	{
+		float theta = (float)side / (float)sides * 2.0f * g_Pi;
+		float x = std::cos(theta);
+		float z = -std::sin(theta);
+		AddVertex(vertices, glm::vec3(x, 1.0f, z), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(0.5f + 0.5f * x, 0.5f - 0.5f * z));
+	}
+	parts.top.firstIndex = (GLuint)indices.size();
+	for (int side = 0; side < sides; side++)
+	{
+		indices.push_back(topCenter);
+		indices.push_back(topCenter + 1 + side);
+		indices.push_back(topCenter + 2 + side);
+	}
+	parts.top.indexCount = (GLuint)indices.size() - parts.top.firstIndex;
+
+	// sides - two rings with outward facing normals
+	GLuint sideStart = (GLuint)(vertices.size() / g_FloatsPerVertex);
+	for (int side = 0; side <= sides; side++)
+	{
+		float u = (float)side / (float)sides;
+		float theta = u * 2.0f * g_Pi;
+		glm::vec3 normal(std::cos(theta), 0.0f, -std::sin(theta));
+		AddVertex(vertices, glm::vec3(normal.x, 0.0f, normal.z), normal, glm::vec2(u, 0.0f));
+		AddVertex(vertices, glm::vec3(normal.x, 1.0f, normal.z), normal, glm::vec2(u, 1.0f));
+	}
+	parts.sides.firstIndex = (GLuint)indices.size();
+	for (int side = 0; side < sides; side++)
+	{
+		GLuint bottom = sideStart + side * 2;
+		indices.push_back(bottom);
+		indices.push_back(bottom + 2);
+		indices.push_back(bottom + 1);
+		indices.push_back(bottom + 1);
+		indices.push_back(bottom + 2);
+		indices.push_back(bottom + 3);
+	}
+	parts.sides.indexCount = (GLuint)indices.size() - parts.sides.firstIndex;
+
+	// bottom cap - a center vertex with a ring around it
+	GLuint bottomCenter = (GLuint)(vertices.size() / g_FloatsPerVertex);
+	AddVertex(vertices, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec2(0.5f, 0.5f));
+	for (int side = 0; side <= sides; side++)
+	{
+		float theta = (float)side / (float)sides * 2.0f * g_Pi;
+		float x = std::cos(theta);
+		float z = -std::sin(theta);
+		AddVertex(vertices, glm::vec3(x, 0.0f, z), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec2(0.5f + 0.5f * x, 0.5f + 0.5f * z));
+	}
+	parts.bottom.firstIndex = (GLuint)indices.size();
+	for (int side = 0; side < sides; side++)
+	{
+		indices.push_back(bottomCenter);
+		indices.push_back(bottomCenter + 2 + side);
+		indices.push_back(bottomCenter + 1 + side);
+	}
+	parts.bottom.indexCount = (GLuint)indices.size() - parts.bottom.firstIndex;
+}
+
+/***********************************************************
+ *  GetPlaneGeometry()
+ *
+ *  This method is used for getting the vertices and indices
+ *  of a plane of 2.0 by 2.0 units on the XZ plane, facing up
+ *  and centered on the origin.
+ ***********************************************************/
+void MeshLibrary::GetPlaneGeometry(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices)
+{
+	glm::vec3 normal(0.0f, 1.0f, 0.0f);
+
+	vertices.clear();
+	indices.clear();
+
+	AddVertex(vertices, glm::vec3(-1.0f, 0.0f, -1.0f), normal, glm::vec2(0.0f, 1.0f));
+	AddVertex(vertices, glm::vec3(-1.0f, 0.0f, 1.0f), normal, glm::vec2(0.0f, 0.0f));
+	AddVertex(vertices, glm::vec3(1.0f, 0.0f, 1.0f), normal, glm::vec2(1.0f, 0.0f));
+	AddVertex(vertices, glm::vec3(1.0f, 0.0f, -1.0f), normal, glm::vec2(1.0f, 1.0f));
+
+	GLuint planeIndices[6] = { 0, 1, 2, 0, 2, 3 };
+	indices.assign(planeIndices, planeIndices + 6);
+}
+
+/***********************************************************
+ *  GetBoxGeometry()
+ *
+ *  This method is used for getting the vertices and indices
+ *  of a box of 1.0 unit on each side, centered on the origin,
+ *  with the full texture on each of its faces.
+ ***********************************************************/
+void MeshLibrary::GetBoxGeometry(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices)
+{
+	// normal and the two tangent directions of each face
+	const glm::vec3 faces[6][3] = {
+		{ glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) },
+		{ glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) },
+		{ glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f) },
+		{ glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 1.0f, 0.0f) },
+		{ glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f) },
+		{ glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f) }
+	};
+
+	vertices.clear();
+	indices.clear();
+
+	for (int face = 0; face < 6; face++)
+	{
+		glm::vec3 normal = faces[face][0];
+		glm::vec3 right = faces[face][1];
+		glm::vec3 up = faces[face][2];
+		GLuint first = (GLuint)(vertices.size() / g_FloatsPerVertex);
+
+		AddVertex(vertices, (normal - right - up) * 0.5f, normal, glm::vec2(0.0f, 0.0f));
+		AddVertex(vertices, (normal + right - up) * 0.5f, normal, glm::vec2(1.0f, 0.0f));
+		AddVertex(vertices, (normal + right + up) * 0.5f, normal, glm::vec2(1.0f, 1.0f));
+		AddVertex(vertices, (normal - right + up) * 0.5f, normal, glm::vec2(0.0f, 1.0f));
+
+		indices.push_back(first);
+		indices.push_back(first + 1);
+		indices.push_back(first + 2);
+		indices.push_back(first);
+		indices.push_back(first + 2);
+		indices.push_back(first + 3);
+	}
+}
+
+/***********************************************************
+ *  GetSphereGeometry()
+ *
+ *  This method is used for getting the vertices and indices
+ *  of the full detail sphere.
+ ***********************************************************/
+void MeshLibrary::GetSphereGeometry(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices)
+{
+	INDEX_RANGE range;
+
+	vertices.clear();
+	indices.clear();
+
+	AddSphereLod(vertices, indices, g_SphereSlices[0], g_SphereStacks[0], range);
+}
+
+/***********************************************************
+ *  GetCylinderGeometry()
+ *
+ *  This method is used for getting the vertices and the
+ *  indices of the chosen parts of the full detail cylinder.
+ ***********************************************************/
+void MeshLibrary::GetCylinderGeometry(
+	bool bDrawTop,
+	bool bDrawBottom,
+	bool bDrawSides,
+	std::vector<GLfloat>& vertices,
+	std::vector<GLuint>& indices)
+{
+	std::vector<GLuint> allIndices;
+	CYLINDER_PARTS parts;
+
+	vertices.clear();
+	indices.clear();
+
+	AddCylinderLod(vertices, allIndices, g_CylinderSides[0], parts);
+
+	const INDEX_RANGE* partRanges[3] = { &parts.top, &parts.sides, &parts.bottom };
+	bool bDrawPart[3] = { bDrawTop, bDrawSides, bDrawBottom };
+	for (int i = 0; i < 3; i++)
+	{
+		if (bDrawPart[i] == true)
+		{
+			indices.insert(indices.end(),
+				allIndices.begin() + partRanges[i]->firstIndex,
+				allIndices.begin() + partRanges[i]->firstIndex + partRanges[i]->indexCount);
+		}
+	}
+}
+
+/***********************************************************
+ *  SetInstanceData()
+ *
+ *  This method is used for uploading the per-instance values
+ *  of all the instance groups into the shared instance buffer.
+ ***********************************************************/
+void MeshLibrary::SetInstanceData(const std::vector<INSTANCE_DATA>& instances)
+{
+	GLsizeiptr dataSize = instances.size() * sizeof(INSTANCE_DATA);
+
+	if (0 == m_instanceBuffer)
+	{
+		glGenBuffers(1, &m_instanceBuffer);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+
+	// only reallocate the buffer when the instances do not fit
+	if (dataSize > m_instanceBufferSize)
+	{
+		glBufferData(GL_ARRAY_BUFFER, dataSize, instances.data(), GL_STATIC_DRAW);
+		m_instanceBufferSize = dataSize;
+	}
+	else if (dataSize > 0)
+	{
+		// stage the instances in this frame's section of the ring
+		// buffer and let the GPU copy them in order with its other
+		// commands, instead of making the driver wait until the
+		// draws of the earlier frames stop reading the buffer
+		GLintptr stagingOffset = 0;
+		void* pStaging = RingBuffer::Allocate(dataSize, sizeof(glm::vec4), stagingOffset);
+		if (NULL != pStaging)
+		{
+			memcpy(pStaging, instances.data(), dataSize);
+			glBindBuffer(GL_COPY_READ_BUFFER, RingBuffer::GetBuffer());
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ARRAY_BUFFER, stagingOffset, 0, dataSize);
+			glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		}
+		else
+		{
+			glBufferSubData(GL_ARRAY_BUFFER, 0, dataSize, instances.data());
+		}
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/***********************************************************
+ *  IsBaseInstanceSupported()
+ *
+ *  This method is used for checking whether the driver can
+ *  start the instance attributes at a first instance.
+ ***********************************************************/
+bool MeshLibrary::IsBaseInstanceSupported()
+{
+	return(GLEW_VERSION_4_2 || GLEW_ARB_base_instance);
+}
+
+/***********************************************************
+ *  DrawInstancedRange()
+ *
+ *  This method is used for drawing a range of indices of the
+ *  arena for a number of instances.  Only a first instance
+ *  other than zero needs the base instance draw, the single
+ *  objects and the groups at the start of the instance buffer
+ *  use the base vertex draws of OpenGL 3.2.
+ ***********************************************************/
+void MeshLibrary::DrawInstancedRange(
+	const INDEX_RANGE& range,
+	GLsizei instanceCount,
+	GLuint firstInstance)
+{
+	void* indices = (void*)(sizeof(GLuint) * range.firstIndex);
+
+	if ((firstInstance == 0) && (instanceCount == 1))
+	{
+		glDrawElementsBaseVertex(GL_TRIANGLES, range.indexCount, GL_UNSIGNED_INT, indices, range.baseVertex);
+	}
+	else if (firstInstance == 0)
+	{
+		glDrawElementsInstancedBaseVertex(GL_TRIANGLES, range.indexCount, GL_UNSIGNED_INT, indices,
+			instanceCount, range.baseVertex);
+	}
+	else if (IsBaseInstanceSupported() == true)
+	{
+		glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, range.indexCount, GL_UNSIGNED_INT, indices,
+			instanceCount, range.baseVertex, firstInstance);
+	}
+}
+
+/***********************************************************
+ *  DrawCylinderParts()
+ *
+ *  This method is used for drawing the chosen parts of one
+ *  cylinder level of detail, with one draw call for each run
+ *  of neighboring parts.
+ ***********************************************************/
+void MeshLibrary::DrawCylinderParts(
+	const CYLINDER_PARTS& cylinder,
+	bool bDrawTop,
+	bool bDrawBottom,
+	bool bDrawSides,
+	GLsizei instanceCount,
+	GLuint firstInstance)
+{
+	const INDEX_RANGE* parts[3] = { &cylinder.top, &cylinder.sides, &cylinder.bottom };
+	bool bDrawPart[3] = { bDrawTop, bDrawSides, bDrawBottom };
+	INDEX_RANGE range = {};
+	bool bOpenRange = false;
+
+	GLState::BindVertexArray(m_arena.GetVertexArray());
+	for (int i = 0; i < 3; i++)
+	{
+		if (bDrawPart[i] == true)
+		{
+			// neighboring parts are merged into one range
+			if (bOpenRange == false)
+			{
+				range.firstIndex = parts[i]->firstIndex;
+				range.indexCount = 0;
+				range.baseVertex = parts[i]->baseVertex;
+				bOpenRange = true;
+			}
+			range.indexCount += parts[i]->indexCount;
+		}
+		else if (bOpenRange == true)
+		{
+			DrawInstancedRange(range, instanceCount, firstInstance);
+			bOpenRange = false;
+		}
+	}
+	if (bOpenRange == true)
+	{
+		DrawInstancedRange(range, instanceCount, firstInstance);
+	}
+}
+
+/***********************************************************
+ *  DrawSphereMeshInstanced()
+ *
+ *  This method is used for drawing a group of spheres at one
+ *  level of detail with one instanced draw call.
+ ***********************************************************/
+void MeshLibrary::DrawSphereMeshInstanced(int lod, GLsizei instanceCount, GLuint firstInstance)
+{
+	GLState::BindVertexArray(m_arena.GetVertexArray());
+	DrawInstancedRange(m_sphereLods[lod], instanceCount, firstInstance);
+}
+
+/***********************************************************
+ *  DrawCylinderMeshInstanced()
+ *
+ *  This method is used for drawing a group of cylinders with
+ *  one instanced draw call for each run of neighboring parts.
+ ***********************************************************/
+void MeshLibrary::DrawCylinderMeshInstanced(
+	bool bDrawTop,
+	bool bDrawBottom,
+	bool bDrawSides,
+	int lod,
+	GLsizei instanceCount,
+	GLuint firstInstance)
+{
+	DrawCylinderParts(m_cylinderLods[lod], bDrawTop, bDrawBottom, bDrawSides, instanceCount, firstInstance);
+}
+
+/***********************************************************
+ *  DrawPlaneMesh()
+ *
+ *  This method is used for drawing one plane, placed by the
+ *  model uniform instead of the instance buffer.
+ ***********************************************************/
+void MeshLibrary::DrawPlaneMesh()
+{
+	GLState::BindVertexArray(m_arena.GetVertexArray());
+	DrawInstancedRange(m_planeRange, 1, 0);
+}
+
+/***********************************************************
+ *  DrawBoxMesh()
+ *
+ *  This method is used for drawing one box, placed by the
+ *  model uniform instead of the instance buffer.
+ ***********************************************************/
+void MeshLibrary::DrawBoxMesh()
+{
+	GLState::BindVertexArray(m_arena.GetVertexArray());
+	DrawInstancedRange(m_boxRange, 1, 0);
+}
+
+/***********************************************************
+ *  DrawSphereMesh()
+ *
+ *  This method is used for drawing one full detail sphere,
+ *  placed by the model uniform instead of the instance buffer.
+ ***********************************************************/
+void MeshLibrary::DrawSphereMesh()
+{
+	GLState::BindVertexArray(m_arena.GetVertexArray());
+	DrawInstancedRange(m_sphereLods[0], 1, 0);
+}
+
+/***********************************************************
+ *  DrawCylinderMesh()
+ *
+ *  This method is used for drawing the chosen parts of one
+ *  full detail cylinder, placed by the model uniform instead
+ *  of the instance buffer.
+ ***********************************************************/
+void MeshLibrary::DrawCylinderMesh(bool bDrawTop, bool bDrawBottom, bool bDrawSides)
+{
+	DrawCylinderParts(m_cylinderLods[0], bDrawTop, bDrawBottom, bDrawSides, 1, 0);
+}
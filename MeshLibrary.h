@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////////////////////////
+// meshlibrary.h
+// ============
+// generate basic shape meshes that support instanced drawing
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "MeshArena.h"
+
+#include <vector>
+
+/***********************************************************
+ *  MeshLibrary
+ *
+ *  This class contains the code for generating plane, box,
+ *  sphere and cylinder meshes with the same size, orientation
+ *  and vertex layout as the ShapeMeshes primitives, plus the
+ *  per-instance attributes that allow a group of copies of a
+ *  mesh to be drawn with a single instanced draw call.  The
+ *  sphere and the cylinder are generated at several levels of
+ *  detail, with level 0 the full tessellation and every
+ *  following level using fewer vertices, for objects that
+ *  cover few pixels on screen.  All of the meshes share one
+ *  vertex array in a mesh arena, so switching between them
+ *  does not bind anything.
+ *
+ *  The vertex shader reads the instance data as:
+ *
+ *    layout (location = 3) in mat4 instanceModel;
+ *    layout (location = 7) in vec4 instanceColor;
+ *    uniform bool bUseInstancing;
+ *
+ *  and while bUseInstancing is set, passes instanceColor on in
+ *  place of objectColor, since the instances of one group may
+ *  have different colors.
+ ***********************************************************/
+class MeshLibrary
+{
+public:
+	// constructor
+	MeshLibrary();
+	// destructor
+	~MeshLibrary();
+
+	// per-instance values stored in the instance buffer
+	struct INSTANCE_DATA
+	{
+		glm::mat4 model;
+		glm::vec4 color;
+	};
+
+	// vertex attribute locations of the instance values
+	static const GLuint INSTANCE_MODEL_LOCATION = 3;
+	static const GLuint INSTANCE_COLOR_LOCATION = 7;
+	// number of generated levels of detail per mesh
+	static const int LOD_COUNT = 3;
+
+	// true when instances can be drawn from an offset into the
+	// instance buffer, which the instanced draws with a first
+	// instance other than zero need
+	static bool IsBaseInstanceSupported();
+
+	// generate all of the meshes into the shared arena
+	void LoadMeshes();
+
+	// full detail vertices and indices of a mesh, in the same
+	// layout as the uploaded meshes, for baking static geometry
+	void GetPlaneGeometry(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices);
+	void GetBoxGeometry(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices);
+	void GetSphereGeometry(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices);
+	void GetCylinderGeometry(
+		bool bDrawTop,
+		bool bDrawBottom,
+		bool bDrawSides,
+		std::vector<GLfloat>& vertices,
+		std::vector<GLuint>& indices);
+
+	// number of floats per vertex - position, normal, texture coordinate
+	static const int FLOATS_PER_VERTEX = 8;
+
+	// replace the contents of the instance buffer
+	void SetInstanceData(const std::vector<INSTANCE_DATA>& instances);
+
+	// draw one copy of a full detail mesh, like ShapeMeshes does
+	void DrawPlaneMesh();
+	void DrawBoxMesh();
+	void DrawSphereMesh();
+	void DrawCylinderMesh(bool bDrawTop, bool bDrawBottom, bool bDrawSides);
+
+	// draw instanceCount copies of a mesh at a level of detail,
+	// reading the instance values starting at firstInstance in
+	// the instance buffer
+	void DrawSphereMeshInstanced(int lod, GLsizei instanceCount, GLuint firstInstance);
+	void DrawCylinderMeshInstanced(
+		bool bDrawTop,
+		bool bDrawBottom,
+		bool bDrawSides,
+		int lod,
+		GLsizei instanceCount,
+		GLuint firstInstance);
+
+private:
+	// range of indices for one part of a mesh, whose indices
+	// start at the base vertex of the mesh in the arena
+	struct INDEX_RANGE
+	{
+		GLuint firstIndex;
+		GLuint indexCount;
+		GLint baseVertex;
+	};
+
+	// the parts of one cylinder level of detail
+	struct CYLINDER_PARTS
+	{
+		INDEX_RANGE top;
+		INDEX_RANGE sides;
+		INDEX_RANGE bottom;
+	};
+
+	// shared buffers of all of the meshes
+	MeshArena m_arena;
+	INDEX_RANGE m_planeRange;
+	INDEX_RANGE m_boxRange;
+	INDEX_RANGE m_sphereLods[LOD_COUNT];
+	// cylinder parts, stored top, sides, bottom in the index buffer
+	CYLINDER_PARTS m_cylinderLods[LOD_COUNT];
+
+	// shared per-instance buffer
+	GLuint m_instanceBuffer;
+	GLsizeiptr m_instanceBufferSize;
+
+	// append one level of detail of a mesh to the vertex lists
+	void AddSphereLod(
+		std::vector<GLfloat>& vertices,
+		std::vector<GLuint>& indices,
+		int slices,
+		int stacks,
+		INDEX_RANGE& range);
+	void AddCylinderLod(
+		std::vector<GLfloat>& vertices,
+		std::vector<GLuint>& indices,
+		int sides,
+		CYLINDER_PARTS& parts);
+	// attach the instance buffer to the arena vertex array
+	void SetupInstanceAttributes();
+	// draw a range of indices for a number of instances
+	void DrawInstancedRange(
+		const INDEX_RANGE& range,
+		GLsizei instanceCount,
+		GLuint firstInstance);
+	// draw the chosen parts of one cylinder level of detail
+	void DrawCylinderParts(
+		const CYLINDER_PARTS& cylinder,
+		bool bDrawTop,
+		bool bDrawBottom,
+		bool bDrawSides,
+		GLsizei instanceCount,
+		GLuint firstInstance);
+};
@@ -0,0 +1,579 @@
+///////////////////////////////////////////////////////////////////////////////
+// occlusionculler.cpp
+// ============
+// find the objects hidden behind others with a depth pyramid of the last frame
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "OcclusionCuller.h"
+#include "GLState.h"
+
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	// threads in each dimension of one compute work group
+	const int REDUCE_GROUP_SIZE = 8;
+
+	// the compute shader that writes one pyramid level from the
+	// level above it, or the first level from the depth copy.
+	// Each texel keeps the farthest depth of the source texels
+	// it covers, including the extra row and column of odd sizes
+	const char* g_ReduceShaderSource =
+		"#version 430 core\n"
+		"layout(local_size_x = 8, local_size_y = 8) in;\n"
+		"layout(r32f, binding = 0) writeonly uniform image2D destinationImage;\n"
+		"uniform sampler2D sourceTexture;\n"
+		"void main()\n"
+		"{\n"
+		"    ivec2 destinationSize = imageSize(destinationImage);\n"
+		"    ivec2 texel = ivec2(gl_GlobalInvocationID.xy);\n"
+		"    if (any(greaterThanEqual(texel, destinationSize)))\n"
+		"        return;\n"
+		"    ivec2 sourceSize = textureSize(sourceTexture, 0);\n"
+		"    ivec2 first = (texel * sourceSize) / destinationSize;\n"
+		"    ivec2 last = ((texel + 1) * sourceSize + destinationSize - 1) / destinationSize - 1;\n"
+		"    float farthest = 0.0;\n"
+		"    for (int y = first.y; y <= last.y; y++)\n"
+		"        for (int x = first.x; x <= last.x; x++)\n"
+		"            farthest = max(farthest, texelFetch(sourceTexture, ivec2(x, y), 0).r);\n"
+		"    imageStore(destinationImage, texel, vec4(farthest));\n"
+		"}\n";
+}
+
+/***********************************************************
+ *  OcclusionCuller()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+OcclusionCuller::OcclusionCuller()
+{
+	m_reduceProgram = 0;
+	m_sourceTextureLocation = -1;
+	m_depthTexture = 0;
+	m_pyramidTexture = 0;
+	m_width = 0;
+	m_height = 0;
+	m_levelCount = 0;
+	m_pyramidViewProjection = glm::mat4(1.0f);
+	m_bPyramid = false;
+	for (int i = 0; i < READBACK_COUNT; i++)
+	{
+		m_readbacks[i].buffer = 0;
+		m_readbacks[i].fence = 0;
+		m_readbacks[i].width = 0;
+		m_readbacks[i].height = 0;
+		m_readbacks[i].viewProjection = glm::mat4(1.0f);
+	}
+	m_readbackFrame = 0;
+	m_readbackLevel = 0;
+	m_levelsViewProjection = glm::mat4(1.0f);
+}
+
+/***********************************************************
+ *  ~OcclusionCuller()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+OcclusionCuller::~OcclusionCuller()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the textures, the pixel
+ *  buffers and their fences, and the compute shader program.
+ ***********************************************************/
+void OcclusionCuller::Destroy()
+{
+	GLuint* textures[2] = { &m_depthTexture, &m_pyramidTexture };
+	for (int i = 0; i < 2; i++)
+	{
+		if (0 != *textures[i])
+		{
+			GLState::ForgetTexture(*textures[i]);
+			glDeleteTextures(1, textures[i]);
+			*textures[i] = 0;
+		}
+	}
+
+	for (int i = 0; i < READBACK_COUNT; i++)
+	{
+		if (0 != m_readbacks[i].fence)
+		{
+			glDeleteSync(m_readbacks[i].fence);
+			m_readbacks[i].fence = 0;
+		}
+		if (0 != m_readbacks[i].buffer)
+		{
+			glDeleteBuffers(1, &m_readbacks[i].buffer);
+			m_readbacks[i].buffer = 0;
+		}
+	}
+
+	if (0 != m_reduceProgram)
+	{
+		glDeleteProgram(m_reduceProgram);
+		m_reduceProgram = 0;
+	}
+	m_width = 0;
+	m_height = 0;
+	m_levelCount = 0;
+	m_bPyramid = false;
+	m_levels.clear();
+}
+
+/***********************************************************
+ *  IsSupported()
+ *
+ *  This method is used for checking whether the driver has
+ *  compute shaders, image stores and immutable textures.
+ ***********************************************************/
+bool OcclusionCuller::IsSupported()
+{
+	return(GLEW_VERSION_4_3 ||
+		(GLEW_ARB_compute_shader && GLEW_ARB_shader_image_load_store && GLEW_ARB_texture_storage));
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for compiling and linking the depth
+ *  reduction compute shader.  It returns false when the
+ *  shader cannot be built, in which case nothing is culled by
+ *  occlusion.
+ ***********************************************************/
+bool OcclusionCuller::Initialize()
+{
+	GLint success = 0;
+	GLchar infoLog[512];
+
+	if (0 != m_reduceProgram)
+	{
+		return(true);
+	}
+
+	GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+	glShaderSource(shader, 1, &g_ReduceShaderSource, NULL);
+	glCompileShader(shader);
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		glGetShaderInfoLog(shader, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR: depth reduction compute shader compilation failed\n" << infoLog << std::endl;
+		glDeleteShader(shader);
+		return(false);
+	}
+
+	m_reduceProgram = glCreateProgram();
+	glAttachShader(m_reduceProgram, shader);
+	glLinkProgram(m_reduceProgram);
+	glDeleteShader(shader);
+	glGetProgramiv(m_reduceProgram, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		glGetProgramInfoLog(m_reduceProgram, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR: depth reduction compute shader linking failed\n" << infoLog << std::endl;
+		glDeleteProgram(m_reduceProgram);
+		m_reduceProgram = 0;
+		return(false);
+	}
+
+	// the source is always read from the same texture unit
+	m_sourceTextureLocation = glGetUniformLocation(m_reduceProgram, "sourceTexture");
+	GLuint activeProgram = GLState::GetProgram();
+	GLState::UseProgram(m_reduceProgram);
+	glUniform1i(m_sourceTextureLocation, PYRAMID_TEXTURE_UNIT);
+	GLState::UseProgram(activeProgram);
+
+	for (int i = 0; i < READBACK_COUNT; i++)
+	{
+		glGenBuffers(1, &m_readbacks[i].buffer);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  Resize()
+ *
+ *  This method is used for allocating the depth copy and the
+ *  pyramid for a viewport size, down to a single texel.  The
+ *  CPU copy is dropped, since it no longer matches the view.
+ ***********************************************************/
+void OcclusionCuller::Resize(int width, int height)
+{
+	if ((width == m_width) && (height == m_height))
+	{
+		return;
+	}
+
+	GLuint* textures[2] = { &m_depthTexture, &m_pyramidTexture };
+	for (int i = 0; i < 2; i++)
+	{
+		if (0 != *textures[i])
+		{
+			GLState::ForgetTexture(*textures[i]);
+			glDeleteTextures(1, textures[i]);
+			*textures[i] = 0;
+		}
+	}
+
+	m_width = width;
+	m_height = height;
+	m_levelCount = 1;
+	while ((std::max(width, height) >> m_levelCount) > 0)
+	{
+		m_levelCount++;
+	}
+
+	// the CPU tests against the first level that is small enough
+	m_readbackLevel = 0;
+	while ((m_readbackLevel < m_levelCount - 1) && ((m_width >> m_readbackLevel) > READBACK_WIDTH))
+	{
+		m_readbackLevel++;
+	}
+
+	GLState::ActiveTexture(PYRAMID_TEXTURE_UNIT);
+
+	// the depth copy is only read with texelFetch
+	glGenTextures(1, &m_depthTexture);
+	GLState::BindTexture(GL_TEXTURE_2D, m_depthTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT24, m_width, m_height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+
+	glGenTextures(1, &m_pyramidTexture);
+	GLState::BindTexture(GL_TEXTURE_2D, m_pyramidTexture);
+	glTexStorage2D(GL_TEXTURE_2D, m_levelCount, GL_R32F, m_width, m_height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	GLState::ActiveTexture(0);
+
+	// readbacks of the old size are of no use anymore
+	for (int i = 0; i < READBACK_COUNT; i++)
+	{
+		if (0 != m_readbacks[i].fence)
+		{
+			glDeleteSync(m_readbacks[i].fence);
+			m_readbacks[i].fence = 0;
+		}
+	}
+	m_levels.clear();
+	m_bPyramid = false;
+}
+
+/***********************************************************
+ *  BuildPyramid()
+ *
+ *  This method is used for copying the depth of the current
+ *  viewport from the bound framebuffer and reducing it into
+ *  every level of the pyramid.  While one level is written,
+ *  the pyramid only samples the level above it, so a level
+ *  is never read and written at the same time.  The shader
+ *  program that was active before is made active again.
+ ***********************************************************/
+void OcclusionCuller::BuildPyramid(const glm::mat4& viewProjection)
+{
+	GLint viewport[4];
+
+	if (0 == m_reduceProgram)
+	{
+		return;
+	}
+
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	if ((viewport[2] <= 0) || (viewport[3] <= 0))
+	{
+		return;
+	}
+	Resize(viewport[2], viewport[3]);
+
+	GLState::ActiveTexture(PYRAMID_TEXTURE_UNIT);
+	GLState::BindTexture(GL_TEXTURE_2D, m_depthTexture);
+	glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, viewport[0], viewport[1], m_width, m_height);
+
+	GLuint activeProgram = GLState::GetProgram();
+	GLState::UseProgram(m_reduceProgram);
+
+	for (int level = 0; level < m_levelCount; level++)
+	{
+		int levelWidth = std::max(m_width >> level, 1);
+		int levelHeight = std::max(m_height >> level, 1);
+
+		if (level > 0)
+		{
+			GLState::BindTexture(GL_TEXTURE_2D, m_pyramidTexture);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level - 1);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level - 1);
+		}
+
+		glBindImageTexture(0, m_pyramidTexture, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+		glDispatchCompute((levelWidth + REDUCE_GROUP_SIZE - 1) / REDUCE_GROUP_SIZE,
+			(levelHeight + REDUCE_GROUP_SIZE - 1) / REDUCE_GROUP_SIZE, 1);
+
+		// the next level reads the texels written by this one
+		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+	}
+
+	GLState::BindTexture(GL_TEXTURE_2D, m_pyramidTexture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_levelCount - 1);
+	glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+	glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT | GL_PIXEL_BUFFER_BARRIER_BIT);
+
+	GLState::UseProgram(activeProgram);
+
+	m_pyramidViewProjection = viewProjection;
+	m_bPyramid = true;
+
+	StartReadBack();
+
+	GLState::ActiveTexture(0);
+}
+
+/***********************************************************
+ *  StartReadBack()
+ *
+ *  This method is used for copying the level that the CPU
+ *  tests against into the next pixel buffer, along with a
+ *  fence that tells when the copy has arrived.  The pyramid
+ *  texture must be bound on the active unit.
+ ***********************************************************/
+void OcclusionCuller::StartReadBack()
+{
+	READBACK& readback = m_readbacks[m_readbackFrame % READBACK_COUNT];
+
+	// a copy that was never taken is replaced with a newer one
+	if (0 != readback.fence)
+	{
+		glDeleteSync(readback.fence);
+		readback.fence = 0;
+	}
+
+	int width = std::max(m_width >> m_readbackLevel, 1);
+	int height = std::max(m_height >> m_readbackLevel, 1);
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+	if ((width != readback.width) || (height != readback.height))
+	{
+		glBufferData(GL_PIXEL_PACK_BUFFER, width * height * sizeof(float), NULL, GL_STREAM_READ);
+		readback.width = width;
+		readback.height = height;
+	}
+	glGetTexImage(GL_TEXTURE_2D, m_readbackLevel, GL_RED, GL_FLOAT, (void*)0);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	readback.viewProjection = m_pyramidViewProjection;
+	m_readbackFrame++;
+}
+
+/***********************************************************
+ *  ReadBack()
+ *
+ *  This method is used for taking the newest copy of the
+ *  pyramid level that the GPU has finished, without waiting
+ *  for any of them, and reducing the CPU levels from it.
+ ***********************************************************/
+void OcclusionCuller::ReadBack()
+{
+	bool bTaken = false;
+
+	// from the oldest readback to the newest one
+	for (int i = 0; i < READBACK_COUNT; i++)
+	{
+		READBACK& readback = m_readbacks[(m_readbackFrame + i) % READBACK_COUNT];
+		if (0 == readback.fence)
+		{
+			continue;
+		}
+
+		GLenum result = glClientWaitSync(readback.fence, 0, 0);
+		if ((result != GL_ALREADY_SIGNALED) && (result != GL_CONDITION_SATISFIED))
+		{
+			continue;
+		}
+		glDeleteSync(readback.fence);
+		readback.fence = 0;
+
+		int texelCount = readback.width * readback.height;
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+		const float* pDepth = (const float*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+			texelCount * sizeof(float), GL_MAP_READ_BIT);
+		if (NULL != pDepth)
+		{
+			m_levels.resize(1);
+			m_levels[0].width = readback.width;
+			m_levels[0].height = readback.height;
+			m_levels[0].depth.resize(texelCount);
+			memcpy(m_levels[0].depth.data(), pDepth, texelCount * sizeof(float));
+			m_levelsViewProjection = readback.viewProjection;
+			bTaken = true;
+		}
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	}
+
+	if (bTaken == true)
+	{
+		ReduceLevels();
+	}
+}
+
+/***********************************************************
+ *  ReduceLevels()
+ *
+ *  This method is used for reducing the level read back into
+ *  the coarser CPU levels the same way as the compute shader,
+ *  so that any box is covered by at most a few texels of one
+ *  of the levels.
+ ***********************************************************/
+void OcclusionCuller::ReduceLevels()
+{
+	m_levels.resize(1);
+	while ((m_levels.back().width > 1) || (m_levels.back().height > 1))
+	{
+		DEPTH_LEVEL level;
+		const DEPTH_LEVEL& source = m_levels.back();
+		level.width = std::max(source.width / 2, 1);
+		level.height = std::max(source.height / 2, 1);
+		level.depth.resize(level.width * level.height);
+
+		for (int y = 0; y < level.height; y++)
+		{
+			int firstY = (y * source.height) / level.height;
+			int lastY = ((y + 1) * source.height + level.height - 1) / level.height - 1;
+			for (int x = 0; x < level.width; x++)
+			{
+				int firstX = (x * source.width) / level.width;
+				int lastX = ((x + 1) * source.width + level.width - 1) / level.width - 1;
+				float farthest = 0.0f;
+				for (int sy = firstY; sy <= lastY; sy++)
+				{
+					for (int sx = firstX; sx <= lastX; sx++)
+					{
+						farthest = std::max(farthest, source.depth[sy * source.width + sx]);
+					}
+				}
+				level.depth[y * level.width + x] = farthest;
+			}
+		}
+
+		m_levels.push_back(level);
+	}
+}
+
+/***********************************************************
+ *  GetPyramidTexture()
+ *
+ *  This method is used for getting the pyramid texture for
+ *  the culling compute shader, or 0 before the first build.
+ ***********************************************************/
+GLuint OcclusionCuller::GetPyramidTexture() const
+{
+	return((m_bPyramid == true) ? m_pyramidTexture : 0);
+}
+
+/***********************************************************
+ *  GetPyramidLevels()
+ *
+ *  This method is used for getting the number of pyramid
+ *  levels.
+ ***********************************************************/
+int OcclusionCuller::GetPyramidLevels() const
+{
+	return(m_levelCount);
+}
+
+/***********************************************************
+ *  GetPyramidViewProjection()
+ *
+ *  This method is used for getting the view-projection that
+ *  the depth of the pyramid was drawn with.
+ ***********************************************************/
+const glm::mat4& OcclusionCuller::GetPyramidViewProjection() const
+{
+	return(m_pyramidViewProjection);
+}
+
+/***********************************************************
+ *  IsOccluded()
+ *
+ *  This method is used for testing a world space box against
+ *  the CPU copy of the pyramid.  The box is projected with
+ *  the view-projection of the copy, and the level is picked
+ *  at which its screen rectangle covers at most two texels
+ *  across.  Boxes that reach behind the camera are never
+ *  hidden.
+ ***********************************************************/
+bool OcclusionCuller::IsOccluded(const FrustumCuller::BOUNDS& bounds) const
+{
+	if (m_levels.size() == 0)
+	{
+		return(false);
+	}
+
+	glm::vec2 rectMin(1.0f);
+	glm::vec2 rectMax(0.0f);
+	float nearest = 1.0f;
+	for (int i = 0; i < 8; i++)
+	{
+		glm::vec4 corner(
+			(i & 1) ? bounds.max.x : bounds.min.x,
+			(i & 2) ? bounds.max.y : bounds.min.y,
+			(i & 4) ? bounds.max.z : bounds.min.z,
+			1.0f);
+		glm::vec4 clip = m_levelsViewProjection * corner;
+		if (clip.w <= 0.0f)
+		{
+			return(false);
+		}
+
+		// window coordinates of the default depth range
+		glm::vec3 window = glm::vec3(clip) / clip.w * 0.5f + 0.5f;
+		rectMin = glm::min(rectMin, glm::vec2(window.x, window.y));
+		rectMax = glm::max(rectMax, glm::vec2(window.x, window.y));
+		nearest = std::min(nearest, window.z);
+	}
+	rectMin = glm::clamp(rectMin, 0.0f, 1.0f);
+	rectMax = glm::clamp(rectMax, 0.0f, 1.0f);
+
+	int levelIndex = 0;
+	float extent = std::max((rectMax.x - rectMin.x) * (float)m_levels[0].width,
+		(rectMax.y - rectMin.y) * (float)m_levels[0].height);
+	while ((levelIndex < (int)m_levels.size() - 1) && (extent > 1.0f))
+	{
+		extent *= 0.5f;
+		levelIndex++;
+	}
+
+	const DEPTH_LEVEL& level = m_levels[levelIndex];
+	int firstX = std::min((int)(rectMin.x * (float)level.width), level.width - 1);
+	int firstY = std::min((int)(rectMin.y * (float)level.height), level.height - 1);
+	int lastX = std::min((int)(rectMax.x * (float)level.width), level.width - 1);
+	int lastY = std::min((int)(rectMax.y * (float)level.height), level.height - 1);
+	for (int y = firstY; y <= lastY; y++)
+	{
+		for (int x = firstX; x <= lastX; x++)
+		{
+			if (nearest <= level.depth[y * level.width + x])
+			{
+				return(false);
+			}
+		}
+	}
+
+	return(true);
+}
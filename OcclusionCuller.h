@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////
+// occlusionculler.h
+// ============
+// find the objects hidden behind others with a depth pyramid of the last frame
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "FrustumCuller.h"
+
+#include <vector>
+
+/***********************************************************
+ *  OcclusionCuller
+ *
+ *  This class contains the code for hierarchical depth
+ *  occlusion culling.  Once the opaque objects of a frame are
+ *  drawn, their depth is copied and reduced by a compute
+ *  shader into a mip pyramid, in which every texel holds the
+ *  farthest depth of the texels below it.  The next frame
+ *  projects the box of each object with the view-projection
+ *  that the pyramid was drawn with, and the object is hidden
+ *  when the nearest point of its box is behind the farthest
+ *  depth of the few texels that cover it.
+ *
+ *  The GPU driven objects are tested by the culling compute
+ *  shader against the whole pyramid.  The render list is
+ *  tested on the CPU against a small level of the pyramid,
+ *  which is read back without waiting and is a few frames
+ *  old.  In both cases an object that comes into view again
+ *  is drawn a frame or more late.
+ ***********************************************************/
+class OcclusionCuller
+{
+public:
+	// constructor
+	OcclusionCuller();
+	// destructor
+	~OcclusionCuller();
+
+	// texture unit that the pyramid is bound to for sampling
+	static const GLuint PYRAMID_TEXTURE_UNIT = 31;
+	// the CPU reads the first level at most this many texels wide
+	static const int READBACK_WIDTH = 128;
+
+	// true when the driver supports compute shaders and images
+	static bool IsSupported();
+
+	// compile the depth reduction compute shader
+	bool Initialize();
+
+	// reduce the depth of the current viewport into the pyramid,
+	// which was drawn with the passed in view-projection
+	void BuildPyramid(const glm::mat4& viewProjection);
+	// take the oldest CPU copy of the pyramid that is finished
+	void ReadBack();
+
+	// the pyramid texture, its levels and view-projection, or 0
+	// until the first one was built
+	GLuint GetPyramidTexture() const;
+	int GetPyramidLevels() const;
+	const glm::mat4& GetPyramidViewProjection() const;
+
+	// true when the CPU copy hides the box completely, which
+	// can be asked by several jobs at the same time
+	bool IsOccluded(const FrustumCuller::BOUNDS& bounds) const;
+
+private:
+	// one level of the CPU copy of the pyramid
+	struct DEPTH_LEVEL
+	{
+		int width;
+		int height;
+		std::vector<float> depth;
+	};
+
+	// number of readbacks in flight
+	static const int READBACK_COUNT = 3;
+
+	// one readback of a pyramid level into a pixel buffer
+	struct READBACK
+	{
+		GLuint buffer;
+		GLsync fence;
+		int width;
+		int height;
+		glm::mat4 viewProjection;
+	};
+
+	// compute shader program and its uniform location
+	GLuint m_reduceProgram;
+	GLint m_sourceTextureLocation;
+
+	// copy of the depth buffer and the pyramid reduced from it
+	GLuint m_depthTexture;
+	GLuint m_pyramidTexture;
+	int m_width;
+	int m_height;
+	int m_levelCount;
+	glm::mat4 m_pyramidViewProjection;
+	bool m_bPyramid;
+
+	// readbacks of the level the CPU tests against
+	READBACK m_readbacks[READBACK_COUNT];
+	int m_readbackFrame;
+	int m_readbackLevel;
+
+	// the CPU copy, from the level read back down to one texel
+	std::vector<DEPTH_LEVEL> m_levels;
+	glm::mat4 m_levelsViewProjection;
+
+	// size the textures for a viewport, keeping them when it fits
+	void Resize(int width, int height);
+	// copy the pyramid level into the next pixel buffer
+	void StartReadBack();
+	// reduce each CPU level from the one above it
+	void ReduceLevels();
+	// free all of the textures, buffers and the program
+	void Destroy();
+};
@@ -0,0 +1,487 @@
+///////////////////////////////////////////////////////////////////////////////
+// profiler.cpp
+// ============
+// measure the CPU and GPU time of the frame stages
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// frames that are timed before the first one is read back,
+	// which keeps the timestamp queries from stalling the CPU
+	const int g_FramesInFlight = 4;
+	// per-frame samples kept for the rolling percentiles
+	const int g_HistorySize = 512;
+	// most events written into the trace file
+	const int g_MaxTraceEvents = 500000;
+	// trace thread IDs of the CPU and GPU timelines
+	const int g_CpuThreadID = 1;
+	const int g_GpuThreadID = 2;
+
+	const char* g_FrameScopeName = "Frame";
+
+	std::chrono::steady_clock::time_point g_StartTime;
+}
+
+bool Profiler::m_bInitialized = false;
+bool Profiler::m_bGPUTimers = false;
+bool Profiler::m_bDrawScopes = false;
+int Profiler::m_frameNumber = 0;
+int Profiler::m_currentFrame = -1;
+int Profiler::m_frameScope = -1;
+std::vector<Profiler::FRAME_RECORD> Profiler::m_frames;
+std::vector<Profiler::SCOPE_HISTORY> Profiler::m_history;
+double Profiler::m_gpuOffsetMs = 0.0;
+std::string Profiler::m_traceFilename;
+std::string Profiler::m_traceEvents;
+int Profiler::m_traceEventCount = 0;
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for starting the profiler.  It must be
+ *  called after the OpenGL context is created when the GPU
+ *  timers are used.
+ ***********************************************************/
+void Profiler::Initialize(bool bGPUTimers)
+{
+	g_StartTime = std::chrono::steady_clock::now();
+
+	m_bGPUTimers = bGPUTimers;
+	m_frameNumber = 0;
+	m_currentFrame = -1;
+	m_frames.clear();
+	m_frames.resize(g_FramesInFlight);
+	for (int i = 0; i < m_frames.size(); i++)
+	{
+		m_frames[i].frameNumber = 0;
+		m_frames[i].queriesUsed = 0;
+		m_frames[i].bPending = false;
+	}
+
+	// the GPU clock is lined up with the CPU clock for the trace
+	if (m_bGPUTimers == true)
+	{
+		GLint64 gpuTime = 0;
+		glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+		m_gpuOffsetMs = (double)gpuTime / 1000000.0 - GetCpuTimeMs();
+	}
+
+	m_bInitialized = true;
+}
+
+/***********************************************************
+ *  Shutdown()
+ *
+ *  This method is used for reading back the frames that are
+ *  still pending, writing the trace file if one was set, and
+ *  freeing the timer queries.
+ ***********************************************************/
+void Profiler::Shutdown()
+{
+	if (m_bInitialized == false)
+	{
+		return;
+	}
+
+	// resolve the pending frames from the oldest to the newest
+	for (int i = 0; i < g_FramesInFlight; i++)
+	{
+		FRAME_RECORD& frame = m_frames[(m_frameNumber + i) % g_FramesInFlight];
+		if (frame.bPending == true)
+		{
+			ResolveFrame(frame);
+		}
+	}
+
+	if (m_traceFilename.empty() == false)
+	{
+		std::ofstream traceFile(m_traceFilename.c_str());
+		if (!traceFile)
+		{
+			std::cout << "Could not write profiler trace:" << m_traceFilename << std::endl;
+		}
+		else
+		{
+			traceFile << "{\"traceEvents\":[\n";
+			traceFile << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << g_CpuThreadID << ",\"args\":{\"name\":\"CPU\"}},\n";
+			traceFile << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << g_GpuThreadID << ",\"args\":{\"name\":\"GPU\"}}";
+			traceFile << m_traceEvents;
+			traceFile << "\n],\"displayTimeUnit\":\"ms\"}\n";
+			std::cout << "INFO: profiler trace written to " << m_traceFilename << " (" << m_traceEventCount << " events)" << std::endl;
+		}
+	}
+
+	for (int i = 0; i < m_frames.size(); i++)
+	{
+		if (m_frames[i].queries.size() > 0)
+		{
+			glDeleteQueries((GLsizei)m_frames[i].queries.size(), m_frames[i].queries.data());
+		}
+	}
+	m_frames.clear();
+	m_traceEvents.clear();
+	m_bInitialized = false;
+}
+
+/***********************************************************
+ *  SetTraceFile()
+ *
+ *  This method is used for setting the Chrome trace file that
+ *  is written when the profiler is shut down.
+ ***********************************************************/
+void Profiler::SetTraceFile(const char* filename)
+{
+	m_traceFilename = (NULL != filename) ? filename : "";
+}
+
+/***********************************************************
+ *  SetDrawScopes() / GetDrawScopes()
+ *
+ *  These methods are used for switching the per-object draw
+ *  scopes on, which adds a scope for every submitted object.
+ ***********************************************************/
+void Profiler::SetDrawScopes(bool bEnabled)
+{
+	m_bDrawScopes = bEnabled;
+}
+
+bool Profiler::GetDrawScopes()
+{
+	return(m_bInitialized && m_bDrawScopes);
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for starting the scopes of a frame.
+ *  The frame that used the same query slot is read back
+ *  first, which it normally is already done with on the GPU.
+ ***********************************************************/
+void Profiler::BeginFrame()
+{
+	if (m_bInitialized == false)
+	{
+		return;
+	}
+
+	m_currentFrame = m_frameNumber % g_FramesInFlight;
+	FRAME_RECORD& frame = m_frames[m_currentFrame];
+	if (frame.bPending == true)
+	{
+		ResolveFrame(frame);
+	}
+
+	frame.frameNumber = m_frameNumber;
+	frame.scopes.clear();
+	frame.queriesUsed = 0;
+
+	m_frameScope = BeginScope(g_FrameScopeName);
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for ending the scopes of a frame.
+ ***********************************************************/
+void Profiler::EndFrame()
+{
+	if ((m_bInitialized == false) || (m_currentFrame < 0))
+	{
+		return;
+	}
+
+	EndScope(m_frameScope);
+	m_frames[m_currentFrame].bPending = true;
+	m_currentFrame = -1;
+	m_frameScope = -1;
+	m_frameNumber++;
+}
+
+/***********************************************************
+ *  BeginScope()
+ *
+ *  This method is used for starting a named scope inside the
+ *  current frame.  Scopes can be nested, since every scope
+ *  takes its own pair of GPU timestamps.
+ ***********************************************************/
+int Profiler::BeginScope(const char* scopeName)
+{
+	if ((m_bInitialized == false) || (m_currentFrame < 0))
+	{
+		return(-1);
+	}
+
+	FRAME_RECORD& frame = m_frames[m_currentFrame];
+	SCOPE_RECORD scope;
+	scope.nameID = FindNameID(scopeName);
+	scope.cpuEndMs = -1.0;
+	scope.gpuQuery = -1;
+
+	if (m_bGPUTimers == true)
+	{
+		if (frame.queriesUsed + 2 > frame.queries.size())
+		{
+			size_t oldSize = frame.queries.size();
+			frame.queries.resize((oldSize > 0) ? oldSize * 2 : 64);
+			glGenQueries((GLsizei)(frame.queries.size() - oldSize), &frame.queries[oldSize]);
+		}
+		scope.gpuQuery = frame.queriesUsed;
+		frame.queriesUsed += 2;
+		glQueryCounter(frame.queries[scope.gpuQuery], GL_TIMESTAMP);
+	}
+
+	scope.cpuStartMs = GetCpuTimeMs();
+	frame.scopes.push_back(scope);
+
+	return((int)frame.scopes.size() - 1);
+}
+
+/***********************************************************
+ *  EndScope()
+ *
+ *  This method is used for ending the scope that was started
+ *  with the passed in index.
+ ***********************************************************/
+void Profiler::EndScope(int scopeIndex)
+{
+	if ((m_bInitialized == false) || (m_currentFrame < 0) || (scopeIndex < 0))
+	{
+		return;
+	}
+
+	FRAME_RECORD& frame = m_frames[m_currentFrame];
+	if (scopeIndex >= frame.scopes.size())
+	{
+		return;
+	}
+
+	SCOPE_RECORD& scope = frame.scopes[scopeIndex];
+	scope.cpuEndMs = GetCpuTimeMs();
+	if (scope.gpuQuery >= 0)
+	{
+		glQueryCounter(frame.queries[scope.gpuQuery + 1], GL_TIMESTAMP);
+	}
+}
+
+/***********************************************************
+ *  GetLastGpuMs()
+ *
+ *  This method is used for getting the GPU time of a scope in
+ *  the newest frame whose timer queries were read back, which
+ *  is a few frames behind the frame being drawn.  A name that
+ *  was never timed is not added to the history here.
+ ***********************************************************/
+double Profiler::GetLastGpuMs(const char* scopeName)
+{
+	if (m_bGPUTimers == false)
+	{
+		return(-1.0);
+	}
+
+	for (int i = 0; i < m_history.size(); i++)
+	{
+		const SCOPE_HISTORY& history = m_history[i];
+		if (strcmp(history.name, scopeName) != 0)
+		{
+			continue;
+		}
+		if (history.gpuMs.size() == 0)
+		{
+			return(-1.0);
+		}
+
+		int newest = (history.nextSample + (int)history.gpuMs.size() - 1) % (int)history.gpuMs.size();
+		return(history.gpuMs[newest]);
+	}
+
+	return(-1.0);
+}
+
+/***********************************************************
+ *  PrintReport()
+ *
+ *  This method is used for printing the p50, p95 and p99 of
+ *  the CPU and GPU time of every scope over the last frames.
+ ***********************************************************/
+void Profiler::PrintReport()
+{
+	if (m_history.size() == 0)
+	{
+		return;
+	}
+
+	std::cout << "INFO: profiler, milliseconds over the last " << g_HistorySize << " frames" << std::endl;
+	std::cout << std::fixed << std::setprecision(3);
+	for (int i = 0; i < m_history.size(); i++)
+	{
+		const SCOPE_HISTORY& history = m_history[i];
+		std::cout << "  " << std::left << std::setw(20) << history.name << std::right
+			<< " CPU p50 " << GetPercentile(history.cpuMs, 50.0)
+			<< " p95 " << GetPercentile(history.cpuMs, 95.0)
+			<< " p99 " << GetPercentile(history.cpuMs, 99.0);
+		if (m_bGPUTimers == true)
+		{
+			std::cout << " | GPU p50 " << GetPercentile(history.gpuMs, 50.0)
+				<< " p95 " << GetPercentile(history.gpuMs, 95.0)
+				<< " p99 " << GetPercentile(history.gpuMs, 99.0);
+		}
+		std::cout << std::endl;
+	}
+	std::cout << std::defaultfloat;
+}
+
+/***********************************************************
+ *  GetCpuTimeMs()
+ *
+ *  This method is used for getting the steady clock time in
+ *  milliseconds since the profiler was initialized.
+ ***********************************************************/
+double Profiler::GetCpuTimeMs()
+{
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - g_StartTime;
+	return(elapsed.count());
+}
+
+/***********************************************************
+ *  FindNameID()
+ *
+ *  This method is used for finding the history entry of a
+ *  scope name, adding one the first time the name is used.
+ ***********************************************************/
+int Profiler::FindNameID(const char* scopeName)
+{
+	for (int i = 0; i < m_history.size(); i++)
+	{
+		if ((m_history[i].name == scopeName) || (strcmp(m_history[i].name, scopeName) == 0))
+		{
+			return(i);
+		}
+	}
+
+	SCOPE_HISTORY history;
+	history.name = scopeName;
+	history.nextSample = 0;
+	// a negative total marks a name not used in the frame
+	history.frameCpuMs = -1.0;
+	history.frameGpuMs = 0.0;
+	m_history.push_back(history);
+
+	return((int)m_history.size() - 1);
+}
+
+/***********************************************************
+ *  ResolveFrame()
+ *
+ *  This method is used for reading the GPU timestamps of a
+ *  finished frame, adding up the scopes with the same name
+ *  into the history and appending the scopes to the trace.
+ ***********************************************************/
+void Profiler::ResolveFrame(FRAME_RECORD& frame)
+{
+	for (int i = 0; i < frame.scopes.size(); i++)
+	{
+		const SCOPE_RECORD& scope = frame.scopes[i];
+		if (scope.cpuEndMs < 0.0)
+		{
+			continue;
+		}
+
+		SCOPE_HISTORY& history = m_history[scope.nameID];
+		double cpuMs = scope.cpuEndMs - scope.cpuStartMs;
+		history.frameCpuMs = (history.frameCpuMs < 0.0) ? cpuMs : history.frameCpuMs + cpuMs;
+		AddTraceEvent(history.name, g_CpuThreadID, scope.cpuStartMs, cpuMs);
+
+		if (scope.gpuQuery >= 0)
+		{
+			GLuint64 gpuStart = 0;
+			GLuint64 gpuEnd = 0;
+			glGetQueryObjectui64v(frame.queries[scope.gpuQuery], GL_QUERY_RESULT, &gpuStart);
+			glGetQueryObjectui64v(frame.queries[scope.gpuQuery + 1], GL_QUERY_RESULT, &gpuEnd);
+
+			double gpuMs = (gpuEnd > gpuStart) ? (double)(gpuEnd - gpuStart) / 1000000.0 : 0.0;
+			history.frameGpuMs += gpuMs;
+			AddTraceEvent(history.name, g_GpuThreadID, (double)gpuStart / 1000000.0 - m_gpuOffsetMs, gpuMs);
+		}
+	}
+
+	// one sample per name for each frame that used the name
+	for (int i = 0; i < m_history.size(); i++)
+	{
+		SCOPE_HISTORY& history = m_history[i];
+		if (history.frameCpuMs < 0.0)
+		{
+			continue;
+		}
+
+		if (history.cpuMs.size() < g_HistorySize)
+		{
+			history.cpuMs.push_back(history.frameCpuMs);
+			history.gpuMs.push_back(history.frameGpuMs);
+		}
+		else
+		{
+			history.cpuMs[history.nextSample] = history.frameCpuMs;
+			history.gpuMs[history.nextSample] = history.frameGpuMs;
+		}
+		history.nextSample = (history.nextSample + 1) % g_HistorySize;
+		history.frameCpuMs = -1.0;
+		history.frameGpuMs = 0.0;
+	}
+
+	frame.bPending = false;
+}
+
+/***********************************************************
+ *  AddTraceEvent()
+ *
+ *  This method is used for appending one complete event to
+ *  the Chrome trace, with the times in microseconds.
+ ***********************************************************/
+void Profiler::AddTraceEvent(const char* name, int threadID, double startMs, double durationMs)
+{
+	if (m_traceFilename.empty() || (m_traceEventCount >= g_MaxTraceEvents))
+	{
+		return;
+	}
+
+	char eventText[256];
+	snprintf(eventText, sizeof(eventText),
+		",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+		name, threadID, startMs * 1000.0, durationMs * 1000.0);
+	m_traceEvents += eventText;
+	m_traceEventCount++;
+}
+
+/***********************************************************
+ *  GetPercentile()
+ *
+ *  This method is used for getting the sample below which the
+ *  passed in percentage of the samples fall.
+ ***********************************************************/
+double Profiler::GetPercentile(const std::vector<double>& samples, double percentile)
+{
+	if (samples.size() == 0)
+	{
+		return(0.0);
+	}
+
+	std::vector<double> sorted(samples);
+	size_t index = (size_t)((percentile / 100.0) * (double)(sorted.size() - 1) + 0.5);
+	std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+
+	return(sorted[index]);
+}
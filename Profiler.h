@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+// profiler.h
+// ============
+// measure the CPU and GPU time of the frame stages
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  Profiler
+ *
+ *  This class is used for timing named scopes of each frame.
+ *  The CPU time of a scope is taken from a steady clock, and
+ *  the GPU time from a pair of timestamp queries that are
+ *  read back a few frames later, so that the profiler never
+ *  waits for the GPU.  Scopes with the same name in one frame
+ *  are added together, the last frames are kept for rolling
+ *  percentiles, and every scope can be written to a Chrome
+ *  trace file (chrome://tracing or ui.perfetto.dev).
+ ***********************************************************/
+class Profiler
+{
+public:
+	// create the timer queries, called once the OpenGL context exists
+	static void Initialize(bool bGPUTimers);
+	// write the trace file if requested and free the timer queries
+	static void Shutdown();
+
+	// write every scope into this Chrome trace file at shutdown
+	static void SetTraceFile(const char* filename);
+	// also time each Draw* object of the scene while rendering
+	static void SetDrawScopes(bool bEnabled);
+	static bool GetDrawScopes();
+
+	// mark the start and the end of one frame
+	static void BeginFrame();
+	static void EndFrame();
+
+	// start a named scope and return the index to end it with,
+	// the name must stay valid while the profiler is running
+	static int BeginScope(const char* scopeName);
+	static void EndScope(int scopeIndex);
+
+	// GPU milliseconds of a scope name in the newest resolved
+	// frame, or -1 when the scope has no GPU time yet
+	static double GetLastGpuMs(const char* scopeName);
+
+	// print the rolling percentiles of every scope
+	static void PrintReport();
+
+	// the given nearest rank percentile of a list of samples, also
+	// used for the latencies of the benchmark and the frame pacer
+	static double GetPercentile(const std::vector<double>& samples, double percentile);
+
+private:
+	// one timed scope of a frame
+	struct SCOPE_RECORD
+	{
+		int nameID;
+		double cpuStartMs;
+		double cpuEndMs;
+		// index of the begin timestamp query, or -1
+		int gpuQuery;
+	};
+
+	// the scopes of one frame waiting for the GPU results
+	struct FRAME_RECORD
+	{
+		int frameNumber;
+		std::vector<SCOPE_RECORD> scopes;
+		std::vector<GLuint> queries;
+		int queriesUsed;
+		bool bPending;
+	};
+
+	// the last per-frame totals of one scope name
+	struct SCOPE_HISTORY
+	{
+		const char* name;
+		std::vector<double> cpuMs;
+		std::vector<double> gpuMs;
+		int nextSample;
+		// totals of the frame being resolved
+		double frameCpuMs;
+		double frameGpuMs;
+	};
+
+	static bool m_bInitialized;
+	static bool m_bGPUTimers;
+	static bool m_bDrawScopes;
+	static int m_frameNumber;
+	static int m_currentFrame;
+	static int m_frameScope;
+	static std::vector<FRAME_RECORD> m_frames;
+	static std::vector<SCOPE_HISTORY> m_history;
+	// GPU timestamp minus CPU time, for lining up the trace
+	static double m_gpuOffsetMs;
+
+	static std::string m_traceFilename;
+	static std::string m_traceEvents;
+	static int m_traceEventCount;
+
+	// clock time in milliseconds since the profiler started
+	static double GetCpuTimeMs();
+	// index of the history entry of a scope name
+	static int FindNameID(const char* scopeName);
+	// add the results of a finished frame to the history
+	static void ResolveFrame(FRAME_RECORD& frame);
+	// append one complete event to the trace
+	static void AddTraceEvent(const char* name, int threadID, double startMs, double durationMs);
+};
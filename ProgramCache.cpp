@@ -0,0 +1,226 @@
+///////////////////////////////////////////////////////////////////////////////
+// programcache.cpp
+// ============
+// save linked shader programs as driver binaries and restore them
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ProgramCache.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+// declaration of global variables
+namespace
+{
+	// first bytes of every cache file, with the version of the layout
+	const uint32_t g_CacheMagic = 0x50424331;
+
+	// header written in front of the program binary
+	struct CACHE_HEADER
+	{
+		uint32_t magic;
+		uint32_t binaryFormat;
+		uint64_t programKey;
+		uint32_t binaryLength;
+		uint32_t padding;
+	};
+
+	// FNV-1a offset basis and prime for 64 bit hashes
+	const uint64_t g_HashBasis = 0xcbf29ce484222325ULL;
+	const uint64_t g_HashPrime = 0x100000001b3ULL;
+
+	/***********************************************************
+	 *  HashString()
+	 *
+	 *  Add the bytes of a string to a running FNV-1a hash, with
+	 *  a separator so that moving text between strings changes
+	 *  the hash.
+	 ***********************************************************/
+	uint64_t HashString(uint64_t hash, const char* text)
+	{
+		if (NULL != text)
+		{
+			for (const unsigned char* p = (const unsigned char*)text; *p != 0; p++)
+			{
+				hash = (hash ^ *p) * g_HashPrime;
+			}
+		}
+
+		return((hash ^ 0xff) * g_HashPrime);
+	}
+}
+
+/***********************************************************
+ *  IsSupported()
+ *
+ *  This method is used for checking whether program binaries
+ *  are supported and the driver offers at least one format.
+ ***********************************************************/
+bool ProgramCache::IsSupported()
+{
+	if (!(GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary))
+	{
+		return(false);
+	}
+
+	GLint formatCount = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+
+	return(formatCount > 0);
+}
+
+/***********************************************************
+ *  ReadSource()
+ *
+ *  This method is used for reading the text of a shader file.
+ ***********************************************************/
+bool ProgramCache::ReadSource(const char* filename, std::string& source)
+{
+	std::ifstream file(filename, std::ios::binary);
+	if (!file)
+	{
+		return(false);
+	}
+
+	std::stringstream text;
+	text << file.rdbuf();
+	source = text.str();
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetProgramKey()
+ *
+ *  This method is used for hashing everything that the
+ *  program binary depends on, the shader sources and the
+ *  driver and GPU it was built by.
+ ***********************************************************/
+unsigned long long ProgramCache::GetProgramKey(const std::string& vertexSource, const std::string& fragmentSource)
+{
+	uint64_t hash = g_HashBasis;
+
+	hash = HashString(hash, vertexSource.c_str());
+	hash = HashString(hash, fragmentSource.c_str());
+	hash = HashString(hash, (const char*)glGetString(GL_VENDOR));
+	hash = HashString(hash, (const char*)glGetString(GL_RENDERER));
+	hash = HashString(hash, (const char*)glGetString(GL_VERSION));
+
+	return((unsigned long long)hash);
+}
+
+/***********************************************************
+ *  GetCachePath()
+ *
+ *  This method is used for getting the path of the cache file
+ *  of a program, beside its vertex shader.
+ ***********************************************************/
+std::string ProgramCache::GetCachePath(const char* vertexShaderPath, unsigned long long programKey)
+{
+	char keyText[17];
+	snprintf(keyText, sizeof(keyText), "%016llx", programKey);
+
+	return(std::string(vertexShaderPath) + "." + keyText + ".bin");
+}
+
+/***********************************************************
+ *  Load()
+ *
+ *  This method is used for creating a program from the binary
+ *  in its cache file.  Binaries with another key, or that the
+ *  driver no longer accepts, are not used.
+ ***********************************************************/
+GLuint ProgramCache::Load(const std::string& cachePath, unsigned long long programKey)
+{
+	if (IsSupported() == false)
+	{
+		return(0);
+	}
+
+	std::ifstream file(cachePath.c_str(), std::ios::binary);
+	if (!file)
+	{
+		return(0);
+	}
+
+	CACHE_HEADER header = {};
+	file.read((char*)&header, sizeof(header));
+	if (!file || (header.magic != g_CacheMagic) ||
+		(header.programKey != programKey) || (header.binaryLength == 0))
+	{
+		return(0);
+	}
+
+	std::vector<char> binary(header.binaryLength);
+	file.read(binary.data(), binary.size());
+	if (!file)
+	{
+		return(0);
+	}
+
+	GLuint program = glCreateProgram();
+	glProgramBinary(program, header.binaryFormat, binary.data(), (GLsizei)binary.size());
+
+	GLint linked = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &linked);
+	if (linked == GL_FALSE)
+	{
+		glDeleteProgram(program);
+		return(0);
+	}
+
+	return(program);
+}
+
+/***********************************************************
+ *  Save()
+ *
+ *  This method is used for reading back the binary of a
+ *  linked program and writing it into its cache file.
+ ***********************************************************/
+bool ProgramCache::Save(GLuint program, const std::string& cachePath, unsigned long long programKey)
+{
+	if ((0 == program) || (IsSupported() == false))
+	{
+		return(false);
+	}
+
+	GLint binaryLength = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+	if (binaryLength <= 0)
+	{
+		return(false);
+	}
+
+	std::vector<char> binary(binaryLength);
+	GLenum binaryFormat = 0;
+	GLsizei writtenLength = 0;
+	glGetProgramBinary(program, binaryLength, &writtenLength, &binaryFormat, binary.data());
+	if (writtenLength <= 0)
+	{
+		return(false);
+	}
+
+	std::ofstream file(cachePath.c_str(), std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		return(false);
+	}
+
+	CACHE_HEADER header = {};
+	header.magic = g_CacheMagic;
+	header.binaryFormat = binaryFormat;
+	header.programKey = programKey;
+	header.binaryLength = (uint32_t)writtenLength;
+
+	file.write((const char*)&header, sizeof(header));
+	file.write(binary.data(), writtenLength);
+
+	return(file.good());
+}
@@ -0,0 +1,46 @@
+///////////////////////////////////////////////////////////////////////////////
+// programcache.h
+// ============
+// save linked shader programs as driver binaries and restore them
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <string>
+
+/***********************************************************
+ *  ProgramCache
+ *
+ *  This class contains the code for skipping the compile and
+ *  link of the shader programs on later launches.  A linked
+ *  program is read back with glGetProgramBinary and written
+ *  beside its vertex shader, in a file named after a hash of
+ *  the shader sources and of the vendor, renderer and version
+ *  strings of the driver.  Editing a shader or updating the
+ *  driver therefore misses the cache, and a binary that the
+ *  driver refuses anyway is compiled from source again.
+ ***********************************************************/
+class ProgramCache
+{
+public:
+	// true when the driver can save and load program binaries
+	static bool IsSupported();
+
+	// read one shader source file
+	static bool ReadSource(const char* filename, std::string& source);
+	// hash of the program sources and the driver strings
+	static unsigned long long GetProgramKey(const std::string& vertexSource, const std::string& fragmentSource);
+	// path of the cache file of a program
+	static std::string GetCachePath(const char* vertexShaderPath, unsigned long long programKey);
+
+	// create a program from its cache file, or return 0 when
+	// there is no usable binary
+	static GLuint Load(const std::string& cachePath, unsigned long long programKey);
+	// write the binary of a linked program into its cache file
+	static bool Save(GLuint program, const std::string& cachePath, unsigned long long programKey);
+};
@@ -0,0 +1,223 @@
+///////////////////////////////////////////////////////////////////////////////
+// ringbuffer.cpp
+// ============
+// persistently mapped buffer for the data written every frame
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RingBuffer.h"
+
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// longest wait for one fence before waiting again, in nanoseconds
+	const GLuint64 g_FenceTimeout = 1000000000;
+}
+
+GLuint RingBuffer::m_buffer = 0;
+unsigned char* RingBuffer::m_mappedData = NULL;
+GLsizeiptr RingBuffer::m_frameSize = 0;
+GLsync RingBuffer::m_fences[RingBuffer::FRAME_COUNT] = {};
+int RingBuffer::m_frameIndex = 0;
+GLsizeiptr RingBuffer::m_frameOffset = 0;
+bool RingBuffer::m_bInFrame = false;
+int RingBuffer::m_stallCount = 0;
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for creating the buffer with a section
+ *  of the passed in size for each frame in flight, and mapping
+ *  it once for the whole run.  The mapping is coherent, so
+ *  the written data needs no explicit flush.
+ ***********************************************************/
+bool RingBuffer::Initialize(GLsizeiptr frameSize)
+{
+	const GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	if (0 != m_buffer)
+	{
+		return(true);
+	}
+
+	if (!(GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage))
+	{
+		std::cout << "INFO: persistent buffer mapping is not supported, per-frame data uses buffer updates" << std::endl;
+		return(false);
+	}
+
+	glGenBuffers(1, &m_buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+	glBufferStorage(GL_COPY_WRITE_BUFFER, frameSize * FRAME_COUNT, NULL, mapFlags);
+	m_mappedData = (unsigned char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, frameSize * FRAME_COUNT, mapFlags);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	if (NULL == m_mappedData)
+	{
+		std::cout << "Could not map the per-frame ring buffer" << std::endl;
+		glDeleteBuffers(1, &m_buffer);
+		m_buffer = 0;
+		return(false);
+	}
+
+	m_frameSize = frameSize;
+	m_frameIndex = 0;
+	m_frameOffset = 0;
+	m_bInFrame = false;
+	m_stallCount = 0;
+
+	return(true);
+}
+
+/***********************************************************
+ *  Shutdown()
+ *
+ *  This method is used for waiting until the GPU has read
+ *  every section, and freeing the buffer.
+ ***********************************************************/
+void RingBuffer::Shutdown()
+{
+	for (int i = 0; i < FRAME_COUNT; i++)
+	{
+		if (0 != m_fences[i])
+		{
+			glClientWaitSync(m_fences[i], GL_SYNC_FLUSH_COMMANDS_BIT, g_FenceTimeout);
+			glDeleteSync(m_fences[i]);
+			m_fences[i] = 0;
+		}
+	}
+
+	if (0 != m_buffer)
+	{
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+		glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		glDeleteBuffers(1, &m_buffer);
+		m_buffer = 0;
+	}
+	m_mappedData = NULL;
+	m_bInFrame = false;
+}
+
+/***********************************************************
+ *  IsAvailable()
+ *
+ *  This method is used for checking whether the buffer exists,
+ *  so that the managers can fall back to buffer updates.
+ ***********************************************************/
+bool RingBuffer::IsAvailable()
+{
+	return(NULL != m_mappedData);
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for moving on to the section of the
+ *  next frame.  When the GPU is still reading that section
+ *  from three frames ago, this waits for its fence.
+ ***********************************************************/
+void RingBuffer::BeginFrame()
+{
+	if (NULL == m_mappedData)
+	{
+		return;
+	}
+
+	m_frameIndex = (m_frameIndex + 1) % FRAME_COUNT;
+	m_frameOffset = 0;
+	m_bInFrame = true;
+
+	GLsync fence = m_fences[m_frameIndex];
+	if (0 == fence)
+	{
+		return;
+	}
+
+	GLenum result = glClientWaitSync(fence, 0, 0);
+	if ((result == GL_TIMEOUT_EXPIRED) || (result == GL_WAIT_FAILED))
+	{
+		m_stallCount++;
+		do
+		{
+			result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, g_FenceTimeout);
+		} while (result == GL_TIMEOUT_EXPIRED);
+	}
+
+	glDeleteSync(fence);
+	m_fences[m_frameIndex] = 0;
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for placing the fence that signals
+ *  when the GPU has read everything in this frame's section.
+ ***********************************************************/
+void RingBuffer::EndFrame()
+{
+	if ((NULL == m_mappedData) || (m_bInFrame == false))
+	{
+		return;
+	}
+
+	m_fences[m_frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	m_bInFrame = false;
+}
+
+/***********************************************************
+ *  Allocate()
+ *
+ *  This method is used for reserving space in the section of
+ *  the current frame.  The returned pointer may be written
+ *  until the end of the frame, and the GPU reads the data at
+ *  the returned offset of GetBuffer().
+ ***********************************************************/
+void* RingBuffer::Allocate(GLsizeiptr size, GLsizeiptr alignment, GLintptr& offset)
+{
+	if ((NULL == m_mappedData) || (m_bInFrame == false))
+	{
+		return(NULL);
+	}
+
+	GLsizeiptr alignedOffset = m_frameOffset;
+	if (alignment > 1)
+	{
+		alignedOffset = ((m_frameOffset + alignment - 1) / alignment) * alignment;
+	}
+	if (alignedOffset + size > m_frameSize)
+	{
+		return(NULL);
+	}
+
+	m_frameOffset = alignedOffset + size;
+	offset = (GLintptr)(m_frameIndex * m_frameSize + alignedOffset);
+
+	return(m_mappedData + offset);
+}
+
+/***********************************************************
+ *  GetBuffer()
+ *
+ *  This method is used for getting the OpenGL buffer that the
+ *  allocated offsets are in.
+ ***********************************************************/
+GLuint RingBuffer::GetBuffer()
+{
+	return(m_buffer);
+}
+
+/***********************************************************
+ *  GetStallCount()
+ *
+ *  This method is used for getting the number of frames that
+ *  had to wait for the GPU before writing their section.
+ ***********************************************************/
+int RingBuffer::GetStallCount()
+{
+	return(m_stallCount);
+}
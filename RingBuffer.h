@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////
+// ringbuffer.h
+// ============
+// persistently mapped buffer for the data written every frame
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+/***********************************************************
+ *  RingBuffer
+ *
+ *  This class is used for writing the per-frame dynamic data
+ *  of the managers straight into GPU visible memory.  One
+ *  buffer is persistently mapped and split into a section for
+ *  each frame in flight.  While the GPU reads the section of
+ *  one frame, the CPU writes the next one, and a fence placed
+ *  at the end of every frame tells when a section may be
+ *  written again, so the CPU only waits when it gets more
+ *  than the frames in flight ahead of the GPU.
+ ***********************************************************/
+class RingBuffer
+{
+public:
+	// number of sections, one per frame in flight
+	static const int FRAME_COUNT = 3;
+
+	// create and map the buffer, called once the OpenGL context
+	// exists, returning false when persistent mapping is missing
+	static bool Initialize(GLsizeiptr frameSize);
+	// wait for the GPU and free the buffer
+	static void Shutdown();
+	// true when the buffer can be written
+	static bool IsAvailable();
+
+	// start writing into the section of the next frame
+	static void BeginFrame();
+	// place the fence that frees the section of this frame
+	static void EndFrame();
+
+	// reserve space in the section of this frame, returning the
+	// pointer to write to and the offset in the buffer, or NULL
+	// when the section is full
+	static void* Allocate(GLsizeiptr size, GLsizeiptr alignment, GLintptr& offset);
+	// the buffer that the allocated offsets refer to
+	static GLuint GetBuffer();
+
+	// number of frames that waited for the GPU to free a section
+	static int GetStallCount();
+
+private:
+	static GLuint m_buffer;
+	static unsigned char* m_mappedData;
+	static GLsizeiptr m_frameSize;
+	// fence of each section, or 0 when it is free
+	static GLsync m_fences[FRAME_COUNT];
+	// section of the current frame and the bytes used in it
+	static int m_frameIndex;
+	static GLsizeiptr m_frameOffset;
+	static bool m_bInFrame;
+	static int m_stallCount;
+};
@@ -0,0 +1,797 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.cpp
+// ============
+// read and write scene descriptions in text and binary form
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// declaration of global variables
+namespace
+{
+	// file name extension of the binary scene files
+	const char* g_BinaryExtension = ".sceneb";
+
+	const char g_BinaryMagic[4] = { 'S', 'C', 'N', 'B' };
+	const uint32_t g_BinaryVersion = 1;
+
+	// record arrays of the binary file, in the order of the
+	// counts and offsets in the header
+	enum RECORD_ARRAY
+	{
+		RECORD_TEXTURES = 0,
+		RECORD_MATERIALS,
+		RECORD_LIGHTS,
+		RECORD_OBJECTS,
+		RECORD_ARRAY_COUNT
+	};
+
+	struct SCENE_FILE_HEADER
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t counts[RECORD_ARRAY_COUNT];
+		uint32_t offsets[RECORD_ARRAY_COUNT];
+	};
+
+	// mesh names in the order of SceneManager::MESH_ID
+	const char* g_MeshNames[] = { "plane", "box", "cylinder", "torus", "sphere" };
+	const int g_MeshCount = 5;
+
+	// mesh part names and the matching SceneManager::MESH_FLAGS
+	const char* g_PartNames[] = { "top", "bottom", "sides" };
+	const uint32_t g_PartFlags[] = { 0x01, 0x02, 0x04 };
+	const uint32_t g_AllParts = 0x07;
+
+	/***********************************************************
+	 *  HasBinaryExtension()
+	 *
+	 *  True when the file name ends with the binary extension.
+	 ***********************************************************/
+	bool HasBinaryExtension(const char* filename)
+	{
+		size_t length = strlen(filename);
+		size_t extensionLength = strlen(g_BinaryExtension);
+
+		return((length >= extensionLength) &&
+			(strcmp(filename + length - extensionLength, g_BinaryExtension) == 0));
+	}
+
+	/***********************************************************
+	 *  ParseMeshParts()
+	 *
+	 *  Parse a list of mesh parts such as "top+sides".
+	 ***********************************************************/
+	bool ParseMeshParts(const std::string& text, uint32_t& meshFlags)
+	{
+		if (text == "all")
+		{
+			meshFlags = g_AllParts;
+			return(true);
+		}
+
+		meshFlags = 0;
+		std::stringstream parts(text);
+		std::string part;
+		while (std::getline(parts, part, '+'))
+		{
+			bool bFound = false;
+			for (int i = 0; i < 3; i++)
+			{
+				if (part == g_PartNames[i])
+				{
+					meshFlags |= g_PartFlags[i];
+					bFound = true;
+				}
+			}
+			if (bFound == false)
+			{
+				return(false);
+			}
+		}
+
+		return(meshFlags != 0);
+	}
+
+	/***********************************************************
+	 *  ReadFloats()
+	 *
+	 *  Read a number of floating point values from a record.
+	 ***********************************************************/
+	bool ReadFloats(std::istringstream& record, float* values, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			if (!(record >> values[i]))
+			{
+				return(false);
+			}
+		}
+		return(true);
+	}
+
+	/***********************************************************
+	 *  WriteFloats()
+	 *
+	 *  Write a number of floating point values to a record.
+	 ***********************************************************/
+	void WriteFloats(std::ostream& record, const float* values, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			record << " " << values[i];
+		}
+	}
+}
+
+/***********************************************************
+ *  SceneFile()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneFile::SceneFile()
+{
+	m_mappedTextures = NULL;
+	m_mappedMaterials = NULL;
+	m_mappedLights = NULL;
+	m_mappedObjects = NULL;
+	memset(m_mappedCounts, 0, sizeof(m_mappedCounts));
+	m_mappedData = NULL;
+	m_mappedSize = 0;
+	m_fileHandle = NULL;
+	m_mappingHandle = NULL;
+}
+
+/***********************************************************
+ *  ~SceneFile()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneFile::~SceneFile()
+{
+	UnmapFile();
+}
+
+/***********************************************************
+ *  Load()
+ *
+ *  This method is used for loading a scene file.  Files with
+ *  the .sceneb extension are mapped as binary files, and any
+ *  other file is parsed as a text file.
+ ***********************************************************/
+bool SceneFile::Load(const char* filename)
+{
+	Clear();
+
+	if (HasBinaryExtension(filename) == true)
+	{
+		return(LoadBinary(filename));
+	}
+
+	return(LoadText(filename));
+}
+
+/***********************************************************
+ *  Save()
+ *
+ *  This method is used for writing the scene records into a
+ *  text or binary file, picked by the file name extension.
+ ***********************************************************/
+bool SceneFile::Save(const char* filename) const
+{
+	if (HasBinaryExtension(filename) == true)
+	{
+		return(SaveBinary(filename));
+	}
+
+	return(SaveText(filename));
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all of the records, and
+ *  unmapping the binary file if one is loaded.
+ ***********************************************************/
+void SceneFile::Clear()
+{
+	UnmapFile();
+	m_textures.clear();
+	m_materials.clear();
+	m_lights.clear();
+	m_objects.clear();
+}
+
+/***********************************************************
+ *  AddTexture() / AddMaterial() / AddLight() / AddObject()
+ *
+ *  These methods are used for adding records to the scene
+ *  before it is saved.  The texture and material methods
+ *  return the index that objects refer to them with.
+ ***********************************************************/
+int SceneFile::AddTexture(const SCENE_TEXTURE& texture)
+{
+	m_textures.push_back(texture);
+	return((int)m_textures.size() - 1);
+}
+
+int SceneFile::AddMaterial(const SCENE_MATERIAL& material)
+{
+	m_materials.push_back(material);
+	return((int)m_materials.size() - 1);
+}
+
+void SceneFile::AddLight(const SCENE_LIGHT& light)
+{
+	m_lights.push_back(light);
+}
+
+void SceneFile::AddObject(const SCENE_OBJECT& object)
+{
+	m_objects.push_back(object);
+}
+
+/***********************************************************
+ *  Get*Count() / Get*()
+ *
+ *  These methods are used for getting the records of the
+ *  scene, read in place from the mapped binary file or from
+ *  the records of the parsed text file.
+ ***********************************************************/
+int SceneFile::GetTextureCount() const
+{
+	return(IsMapped() ? m_mappedCounts[RECORD_TEXTURES] : (int)m_textures.size());
+}
+
+const SceneFile::SCENE_TEXTURE* SceneFile::GetTextures() const
+{
+	return(IsMapped() ? m_mappedTextures : m_textures.data());
+}
+
+int SceneFile::GetMaterialCount() const
+{
+	return(IsMapped() ? m_mappedCounts[RECORD_MATERIALS] : (int)m_materials.size());
+}
+
+const SceneFile::SCENE_MATERIAL* SceneFile::GetMaterials() const
+{
+	return(IsMapped() ? m_mappedMaterials : m_materials.data());
+}
+
+int SceneFile::GetLightCount() const
+{
+	return(IsMapped() ? m_mappedCounts[RECORD_LIGHTS] : (int)m_lights.size());
+}
+
+const SceneFile::SCENE_LIGHT* SceneFile::GetLights() const
+{
+	return(IsMapped() ? m_mappedLights : m_lights.data());
+}
+
+int SceneFile::GetObjectCount() const
+{
+	return(IsMapped() ? m_mappedCounts[RECORD_OBJECTS] : (int)m_objects.size());
+}
+
+const SceneFile::SCENE_OBJECT* SceneFile::GetObjects() const
+{
+	return(IsMapped() ? m_mappedObjects : m_objects.data());
+}
+
+/***********************************************************
+ *  CopyName()
+ *
+ *  This method is used for copying a tag or file name into a
+ *  fixed-size record field, always ending it with a zero.
+ ***********************************************************/
+void SceneFile::CopyName(char* destination, const std::string& source, int destinationSize)
+{
+	memset(destination, 0, destinationSize);
+	if (source.size() >= (size_t)destinationSize)
+	{
+		std::cout << "SceneFile: name is too long and was shortened: " << source << std::endl;
+	}
+	strncpy(destination, source.c_str(), destinationSize - 1);
+}
+
+/***********************************************************
+ *  LoadText()
+ *
+ *  This method is used for parsing a text scene file.  An
+ *  object may refer to a texture or material tag that is
+ *  defined further down in the file.
+ ***********************************************************/
+bool SceneFile::LoadText(const char* filename)
+{
+	std::ifstream file(filename);
+	if (!file)
+	{
+		std::cout << "SceneFile: could not open " << filename << std::endl;
+		return(false);
+	}
+
+	// tags used by each object, resolved after the whole file is read
+	std::vector<std::string> objectTextureTags;
+	std::vector<std::string> objectMaterialTags;
+	std::vector<int> objectLines;
+
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(file, line))
+	{
+		lineNumber++;
+
+		size_t comment = line.find('#');
+		if (comment != std::string::npos)
+		{
+			line.erase(comment);
+		}
+
+		std::istringstream record(line);
+		std::string keyword;
+		if (!(record >> keyword))
+		{
+			continue;
+		}
+
+		bool bValid = true;
+		if (keyword == "texture")
+		{
+			SCENE_TEXTURE texture;
+			std::string tag;
+			std::string textureFilename;
+			bValid = (record >> tag) && std::getline(record >> std::ws, textureFilename) && (textureFilename.empty() == false);
+			if (bValid == true)
+			{
+				// allow trailing spaces after the file name
+				textureFilename.erase(textureFilename.find_last_not_of(" \t\r") + 1);
+				CopyName(texture.tag, tag, MAX_TAG_LENGTH);
+				CopyName(texture.filename, textureFilename, MAX_FILENAME_LENGTH);
+				m_textures.push_back(texture);
+			}
+		}
+		else if (keyword == "material")
+		{
+			SCENE_MATERIAL material;
+			std::string tag;
+			bValid = (record >> tag) &&
+				ReadFloats(record, material.ambientColor, 3) &&
+				ReadFloats(record, &material.ambientStrength, 1) &&
+				ReadFloats(record, material.diffuseColor, 3) &&
+				ReadFloats(record, material.specularColor, 3) &&
+				ReadFloats(record, &material.shininess, 1);
+			if (bValid == true)
+			{
+				CopyName(material.tag, tag, MAX_TAG_LENGTH);
+				m_materials.push_back(material);
+			}
+		}
+		else if (keyword == "light")
+		{
+			SCENE_LIGHT light;
+			bValid = ReadFloats(record, light.position, 3) &&
+				ReadFloats(record, light.direction, 3) &&
+				ReadFloats(record, light.ambientColor, 3) &&
+				ReadFloats(record, light.diffuseColor, 3) &&
+				ReadFloats(record, light.specularColor, 3) &&
+				ReadFloats(record, &light.focalStrength, 1) &&
+				ReadFloats(record, &light.specularIntensity, 1);
+			if (bValid == true)
+			{
+				m_lights.push_back(light);
+			}
+		}
+		else if (keyword == "object")
+		{
+			SCENE_OBJECT object;
+			std::string meshName;
+			std::string parts;
+			std::string textureTag;
+			std::string materialTag;
+
+			bValid = (record >> meshName >> parts) &&
+				ParseMeshParts(parts, object.meshFlags) &&
+				ReadFloats(record, object.scale, 3) &&
+				ReadFloats(record, object.rotationDegrees, 3) &&
+				ReadFloats(record, object.position, 3) &&
+				ReadFloats(record, object.color, 4) &&
+				(record >> textureTag) &&
+				ReadFloats(record, object.uvScale, 2) &&
+				(record >> materialTag);
+
+			object.meshID = -1;
+			for (int i = 0; i < g_MeshCount; i++)
+			{
+				if (meshName == g_MeshNames[i])
+				{
+					object.meshID = i;
+				}
+			}
+			bValid = bValid && (object.meshID >= 0);
+
+			if (bValid == true)
+			{
+				object.textureIndex = -1;
+				object.materialIndex = -1;
+				m_objects.push_back(object);
+				objectTextureTags.push_back(textureTag);
+				objectMaterialTags.push_back(materialTag);
+				objectLines.push_back(lineNumber);
+			}
+		}
+		else
+		{
+			bValid = false;
+		}
+
+		if (bValid == false)
+		{
+			std::cout << "SceneFile: " << filename << ":" << lineNumber << ": invalid " << keyword << " record" << std::endl;
+			Clear();
+			return(false);
+		}
+	}
+
+	// the first texture or material defined with a tag is used
+	for (int i = 0; i < m_objects.size(); i++)
+	{
+		if (objectTextureTags[i] != "-")
+		{
+			for (int t = 0; (t < m_textures.size()) && (m_objects[i].textureIndex < 0); t++)
+			{
+				if (objectTextureTags[i] == m_textures[t].tag)
+				{
+					m_objects[i].textureIndex = t;
+				}
+			}
+			if (m_objects[i].textureIndex < 0)
+			{
+				std::cout << "SceneFile: " << filename << ":" << objectLines[i] << ": unknown texture " << objectTextureTags[i] << std::endl;
+			}
+		}
+		if (objectMaterialTags[i] != "-")
+		{
+			for (int m = 0; (m < m_materials.size()) && (m_objects[i].materialIndex < 0); m++)
+			{
+				if (objectMaterialTags[i] == m_materials[m].tag)
+				{
+					m_objects[i].materialIndex = m;
+				}
+			}
+			if (m_objects[i].materialIndex < 0)
+			{
+				std::cout << "SceneFile: " << filename << ":" << objectLines[i] << ": unknown material " << objectMaterialTags[i] << std::endl;
+			}
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  SaveText()
+ *
+ *  This method is used for writing the records into a text
+ *  scene file.
+ ***********************************************************/
+bool SceneFile::SaveText(const char* filename) const
+{
+	std::ofstream file(filename);
+	if (!file)
+	{
+		std::cout << "SceneFile: could not write " << filename << std::endl;
+		return(false);
+	}
+
+	const SCENE_TEXTURE* textures = GetTextures();
+	const SCENE_MATERIAL* materials = GetMaterials();
+	const SCENE_LIGHT* lights = GetLights();
+	const SCENE_OBJECT* objects = GetObjects();
+
+	file << "# texture  <tag> <filename>" << std::endl;
+	for (int i = 0; i < GetTextureCount(); i++)
+	{
+		file << "texture " << textures[i].tag << " " << textures[i].filename << std::endl;
+	}
+
+	file << std::endl << "# material <tag> <ambient rgb> <ambient strength> <diffuse rgb> <specular rgb> <shininess>" << std::endl;
+	for (int i = 0; i < GetMaterialCount(); i++)
+	{
+		file << "material " << materials[i].tag;
+		WriteFloats(file, materials[i].ambientColor, 3);
+		WriteFloats(file, &materials[i].ambientStrength, 1);
+		WriteFloats(file, materials[i].diffuseColor, 3);
+		WriteFloats(file, materials[i].specularColor, 3);
+		WriteFloats(file, &materials[i].shininess, 1);
+		file << std::endl;
+	}
+
+	file << std::endl << "# light <position> <direction> <ambient rgb> <diffuse rgb> <specular rgb> <focal strength> <specular intensity>" << std::endl;
+	for (int i = 0; i < GetLightCount(); i++)
+	{
+		file << "light";
+		WriteFloats(file, lights[i].position, 3);
+		WriteFloats(file, lights[i].direction, 3);
+		WriteFloats(file, lights[i].ambientColor, 3);
+		WriteFloats(file, lights[i].diffuseColor, 3);
+		WriteFloats(file, lights[i].specularColor, 3);
+		WriteFloats(file, &lights[i].focalStrength, 1);
+		WriteFloats(file, &lights[i].specularIntensity, 1);
+		file << std::endl;
+	}
+
+	file << std::endl << "# object <mesh> <parts> <scale> <rotation> <position> <color rgba> <texture> <uv scale> <material>" << std::endl;
+	for (int i = 0; i < GetObjectCount(); i++)
+	{
+		const SCENE_OBJECT& object = objects[i];
+		if ((object.meshID < 0) || (object.meshID >= g_MeshCount))
+		{
+			continue;
+		}
+
+		std::string parts;
+		if ((object.meshFlags & g_AllParts) == g_AllParts)
+		{
+			parts = "all";
+		}
+		for (int p = 0; (p < 3) && (parts != "all"); p++)
+		{
+			if ((object.meshFlags & g_PartFlags[p]) != 0)
+			{
+				parts += (parts.empty() ? "" : "+") + std::string(g_PartNames[p]);
+			}
+		}
+
+		file << "object " << g_MeshNames[object.meshID] << " " << parts;
+		WriteFloats(file, object.scale, 3);
+		WriteFloats(file, object.rotationDegrees, 3);
+		WriteFloats(file, object.position, 3);
+		WriteFloats(file, object.color, 4);
+		file << " " << ((object.textureIndex >= 0) ? textures[object.textureIndex].tag : "-");
+		WriteFloats(file, object.uvScale, 2);
+		file << " " << ((object.materialIndex >= 0) ? materials[object.materialIndex].tag : "-");
+		file << std::endl;
+	}
+
+	return(file.good());
+}
+
+/***********************************************************
+ *  LoadBinary()
+ *
+ *  This method is used for mapping a binary scene file and
+ *  pointing the record arrays into the mapped memory.  The
+ *  header is checked, and the tags and file names of the
+ *  records, which are used as C strings, must end inside
+ *  their fields.  The other values are used as they are.
+ ***********************************************************/
+bool SceneFile::LoadBinary(const char* filename)
+{
+	if (MapFile(filename) == false)
+	{
+		std::cout << "SceneFile: could not map " << filename << std::endl;
+		return(false);
+	}
+
+	const unsigned char* data = (const unsigned char*)m_mappedData;
+	const SCENE_FILE_HEADER* header = (const SCENE_FILE_HEADER*)data;
+	const size_t recordSizes[RECORD_ARRAY_COUNT] = {
+		sizeof(SCENE_TEXTURE), sizeof(SCENE_MATERIAL), sizeof(SCENE_LIGHT), sizeof(SCENE_OBJECT) };
+
+	bool bValid = (m_mappedSize >= sizeof(SCENE_FILE_HEADER)) &&
+		(memcmp(header->magic, g_BinaryMagic, sizeof(g_BinaryMagic)) == 0) &&
+		(header->version == g_BinaryVersion);
+	for (int i = 0; (i < RECORD_ARRAY_COUNT) && (bValid == true); i++)
+	{
+		// the arrays must be inside the file and 4-byte aligned
+		bValid = ((header->offsets[i] % 4) == 0) &&
+			(header->offsets[i] <= m_mappedSize) &&
+			((uint64_t)header->counts[i] * recordSizes[i] <= m_mappedSize - header->offsets[i]);
+	}
+
+	const SCENE_TEXTURE* textures = bValid ? (const SCENE_TEXTURE*)(data + header->offsets[RECORD_TEXTURES]) : NULL;
+	for (uint32_t i = 0; (bValid == true) && (i < header->counts[RECORD_TEXTURES]); i++)
+	{
+		bValid = (memchr(textures[i].tag, 0, sizeof(textures[i].tag)) != NULL) &&
+			(memchr(textures[i].filename, 0, sizeof(textures[i].filename)) != NULL);
+	}
+	const SCENE_MATERIAL* materials = bValid ? (const SCENE_MATERIAL*)(data + header->offsets[RECORD_MATERIALS]) : NULL;
+	for (uint32_t i = 0; (bValid == true) && (i < header->counts[RECORD_MATERIALS]); i++)
+	{
+		bValid = (memchr(materials[i].tag, 0, sizeof(materials[i].tag)) != NULL);
+	}
+	if (bValid == false)
+	{
+		std::cout << "SceneFile: " << filename << " is not a valid binary scene file" << std::endl;
+		UnmapFile();
+		return(false);
+	}
+
+	for (int i = 0; i < RECORD_ARRAY_COUNT; i++)
+	{
+		m_mappedCounts[i] = (int)header->counts[i];
+	}
+	m_mappedTextures = textures;
+	m_mappedMaterials = materials;
+	m_mappedLights = (const SCENE_LIGHT*)(data + header->offsets[RECORD_LIGHTS]);
+	m_mappedObjects = (const SCENE_OBJECT*)(data + header->offsets[RECORD_OBJECTS]);
+
+	return(true);
+}
+
+/***********************************************************
+ *  SaveBinary()
+ *
+ *  This method is used for writing the records into a binary
+ *  scene file, one array of each record type after the header.
+ ***********************************************************/
+bool SceneFile::SaveBinary(const char* filename) const
+{
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		std::cout << "SceneFile: could not write " << filename << std::endl;
+		return(false);
+	}
+
+	const void* records[RECORD_ARRAY_COUNT] = { GetTextures(), GetMaterials(), GetLights(), GetObjects() };
+	const size_t recordSizes[RECORD_ARRAY_COUNT] = {
+		sizeof(SCENE_TEXTURE), sizeof(SCENE_MATERIAL), sizeof(SCENE_LIGHT), sizeof(SCENE_OBJECT) };
+
+	SCENE_FILE_HEADER header;
+	memcpy(header.magic, g_BinaryMagic, sizeof(g_BinaryMagic));
+	header.version = g_BinaryVersion;
+	header.counts[RECORD_TEXTURES] = (uint32_t)GetTextureCount();
+	header.counts[RECORD_MATERIALS] = (uint32_t)GetMaterialCount();
+	header.counts[RECORD_LIGHTS] = (uint32_t)GetLightCount();
+	header.counts[RECORD_OBJECTS] = (uint32_t)GetObjectCount();
+
+	// every record size is a multiple of 4, so the arrays stay aligned
+	uint32_t offset = sizeof(SCENE_FILE_HEADER);
+	for (int i = 0; i < RECORD_ARRAY_COUNT; i++)
+	{
+		header.offsets[i] = offset;
+		offset += (uint32_t)(header.counts[i] * recordSizes[i]);
+	}
+
+	file.write((const char*)&header, sizeof(header));
+	for (int i = 0; i < RECORD_ARRAY_COUNT; i++)
+	{
+		if (header.counts[i] > 0)
+		{
+			file.write((const char*)records[i], header.counts[i] * recordSizes[i]);
+		}
+	}
+
+	return(file.good());
+}
+
+/***********************************************************
+ *  MapFile()
+ *
+ *  This method is used for mapping a whole file read-only
+ *  into memory, so that its pages are only read from disk
+ *  as the records are used.
+ ***********************************************************/
+bool SceneFile::MapFile(const char* filename)
+{
+	UnmapFile();
+
+#ifdef _WIN32
+	HANDLE fileHandle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return(false);
+	}
+
+	LARGE_INTEGER fileSize;
+	if ((GetFileSizeEx(fileHandle, &fileSize) == FALSE) || (fileSize.QuadPart == 0))
+	{
+		CloseHandle(fileHandle);
+		return(false);
+	}
+
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	void* data = (NULL != mappingHandle) ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : NULL;
+	if (NULL == data)
+	{
+		if (NULL != mappingHandle)
+		{
+			CloseHandle(mappingHandle);
+		}
+		CloseHandle(fileHandle);
+		return(false);
+	}
+
+	m_fileHandle = fileHandle;
+	m_mappingHandle = mappingHandle;
+	m_mappedData = data;
+	m_mappedSize = (size_t)fileSize.QuadPart;
+#else
+	int fileDescriptor = open(filename, O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		return(false);
+	}
+
+	struct stat fileInfo;
+	if ((fstat(fileDescriptor, &fileInfo) != 0) || (fileInfo.st_size == 0))
+	{
+		close(fileDescriptor);
+		return(false);
+	}
+
+	void* data = mmap(NULL, (size_t)fileInfo.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	// the mapping stays valid after the file is closed
+	close(fileDescriptor);
+	if (data == MAP_FAILED)
+	{
+		return(false);
+	}
+
+	m_mappedData = data;
+	m_mappedSize = (size_t)fileInfo.st_size;
+#endif
+
+	return(true);
+}
+
+/***********************************************************
+ *  UnmapFile()
+ *
+ *  This method is used for releasing the mapped binary file.
+ ***********************************************************/
+void SceneFile::UnmapFile()
+{
+	if (NULL != m_mappedData)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(m_mappedData);
+		CloseHandle((HANDLE)m_mappingHandle);
+		CloseHandle((HANDLE)m_fileHandle);
+#else
+		munmap(m_mappedData, m_mappedSize);
+#endif
+	}
+
+	m_mappedData = NULL;
+	m_mappedSize = 0;
+	m_fileHandle = NULL;
+	m_mappingHandle = NULL;
+	m_mappedTextures = NULL;
+	m_mappedMaterials = NULL;
+	m_mappedLights = NULL;
+	m_mappedObjects = NULL;
+	memset(m_mappedCounts, 0, sizeof(m_mappedCounts));
+}
+
+/***********************************************************
+ *  IsMapped()
+ *
+ *  This method is used for checking whether the records are
+ *  read from a mapped binary file.
+ ***********************************************************/
+bool SceneFile::IsMapped() const
+{
+	return(NULL != m_mappedData);
+}
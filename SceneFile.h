@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.h
+// ============
+// read and write scene descriptions in text and binary form
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  SceneFile
+ *
+ *  This class contains the code for loading the materials,
+ *  textures, lights and objects of a 3D scene from a file.
+ *  Text files (.scene) are meant for editing by hand, and
+ *  binary files (.sceneb) hold the same records as arrays of
+ *  fixed-size structures, which are memory mapped and used
+ *  in place without any parsing.  The text format is one
+ *  record per line, with '#' starting a comment:
+ *
+ *    texture  <tag> <filename>
+ *    material <tag> <ambient r g b> <ambient strength>
+ *             <diffuse r g b> <specular r g b> <shininess>
+ *    light    <position x y z> <direction x y z> <ambient r g b>
+ *             <diffuse r g b> <specular r g b>
+ *             <focal strength> <specular intensity>
+ *    object   <mesh> <parts> <scale x y z> <rotation x y z>
+ *             <position x y z> <color r g b a>
+ *             <texture tag or -> <uv scale u v> <material tag or ->
+ *
+ *  where <mesh> is plane, box, cylinder, torus or sphere, and
+ *  <parts> is all, or top, bottom and sides joined with '+'.
+ ***********************************************************/
+class SceneFile
+{
+public:
+	// longest tag and file name stored in the binary records
+	static const int MAX_TAG_LENGTH = 32;
+	static const int MAX_FILENAME_LENGTH = 256;
+
+	struct SCENE_TEXTURE
+	{
+		char tag[MAX_TAG_LENGTH];
+		char filename[MAX_FILENAME_LENGTH];
+	};
+
+	struct SCENE_MATERIAL
+	{
+		char tag[MAX_TAG_LENGTH];
+		float ambientColor[3];
+		float ambientStrength;
+		float diffuseColor[3];
+		float specularColor[3];
+		float shininess;
+	};
+
+	struct SCENE_LIGHT
+	{
+		float position[3];
+		float direction[3];
+		float ambientColor[3];
+		float diffuseColor[3];
+		float specularColor[3];
+		float focalStrength;
+		float specularIntensity;
+	};
+
+	// mesh IDs and part flags use the SceneManager values, the
+	// texture and material refer to the records of the file, or -1
+	struct SCENE_OBJECT
+	{
+		int32_t meshID;
+		uint32_t meshFlags;
+		float scale[3];
+		float rotationDegrees[3];
+		float position[3];
+		float color[4];
+		int32_t textureIndex;
+		float uvScale[2];
+		int32_t materialIndex;
+	};
+
+	// constructor
+	SceneFile();
+	// destructor
+	~SceneFile();
+
+	// load a text or a binary scene file, picked by the extension
+	bool Load(const char* filename);
+	// write the loaded or added records as a text or binary file
+	bool Save(const char* filename) const;
+
+	// add records before saving a scene
+	void Clear();
+	int AddTexture(const SCENE_TEXTURE& texture);
+	int AddMaterial(const SCENE_MATERIAL& material);
+	void AddLight(const SCENE_LIGHT& light);
+	void AddObject(const SCENE_OBJECT& object);
+
+	// the records of the scene, valid while the file is loaded
+	int GetTextureCount() const;
+	const SCENE_TEXTURE* GetTextures() const;
+	int GetMaterialCount() const;
+	const SCENE_MATERIAL* GetMaterials() const;
+	int GetLightCount() const;
+	const SCENE_LIGHT* GetLights() const;
+	int GetObjectCount() const;
+	const SCENE_OBJECT* GetObjects() const;
+
+	// copy a string into a fixed-size record field
+	static void CopyName(char* destination, const std::string& source, int destinationSize);
+
+private:
+	// records parsed from a text file or added for saving
+	std::vector<SCENE_TEXTURE> m_textures;
+	std::vector<SCENE_MATERIAL> m_materials;
+	std::vector<SCENE_LIGHT> m_lights;
+	std::vector<SCENE_OBJECT> m_objects;
+
+	// records of a binary file, pointing into the mapped file
+	const SCENE_TEXTURE* m_mappedTextures;
+	const SCENE_MATERIAL* m_mappedMaterials;
+	const SCENE_LIGHT* m_mappedLights;
+	const SCENE_OBJECT* m_mappedObjects;
+	int m_mappedCounts[4];
+
+	// the memory mapping of a binary file
+	void* m_mappedData;
+	size_t m_mappedSize;
+	void* m_fileHandle;
+	void* m_mappingHandle;
+
+	bool LoadText(const char* filename);
+	bool LoadBinary(const char* filename);
+	bool SaveText(const char* filename) const;
+	bool SaveBinary(const char* filename) const;
+	// map a whole file read-only into memory
+	bool MapFile(const char* filename);
+	void UnmapFile();
+	// true when a binary file is mapped
+	bool IsMapped() const;
+};
@@ -8,243 +8,3151 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "SceneManager.h"
+#include "ViewManager.h"
 
-#ifndef STB_IMAGE_IMPLEMENTATION
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-#endif
+#include <glm/gtx/transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	const char* g_ModelName = "model";
+	const char* g_ColorValueName = "objectColor";
+	const char* g_TextureValueName = "objectTexture";
+	const char* g_UseTextureName = "bUseTexture";
+	const char* g_TextureArrayName = "objectTextureArray";
+	const char* g_TextureLayerName = "textureLayer";
+	const char* g_TextureHandleName = "objectTextureHandle";
+	const char* g_UseLightingName = "bUseLighting";
+	const char* g_UVScaleName = "UVscale";
+	const char* g_MaterialIndexName = "materialIndex";
+	const char* g_UseInstancingName = "bUseInstancing";
+	const char* g_UseStaticBatchName = "bUseStaticBatch";
+	const char* g_StaticDrawBlockName = "StaticDrawBlock";
+	const char* g_UseObjectBufferName = "bUseObjectBuffer";
+	const char* g_ObjectBlockName = "ObjectBlock";
+	const char* g_InstanceModelName = "instanceModel";
+	const char* g_MaterialBlockName = "MaterialBlock";
+	const char* g_LightBlockName = "LightBlock";
+	const char* g_ViewBlockName = "ViewBlock";
+	const char* g_ClusterBlockName = "ClusterBlock";
+	const char* g_ClusterLightBlockName = "ClusterLightBlock";
+	const char* g_ClusterCountBlockName = "ClusterCountBlock";
+	const char* g_ClusterIndexBlockName = "ClusterIndexBlock";
+	const char* g_ShadowBlockName = "ShadowBlock";
+	const char* g_ShadowMapsName = "shadowMaps";
+
+	// projected diameters in pixels below which an object uses
+	// the next, coarser level of detail
+	const float g_LodPixelSizes[MeshLibrary::LOD_COUNT - 1] = { 64.0f, 24.0f };
+
+	// render list items walked by one job of the scene traversal
+	const int g_JobGrainSize = 2048;
+
+	/***********************************************************
+	 *  GetMeshBounds()
+	 *
+	 *  Get the local space box of one of the basic shape meshes,
+	 *  before the model transformation is applied.
+	 ***********************************************************/
+	FrustumCuller::BOUNDS GetMeshBounds(int meshID)
+	{
+		FrustumCuller::BOUNDS bounds;
+		switch (meshID)
+		{
+		case SceneManager::MESH_PLANE:
+			bounds.min = glm::vec3(-1.0f, 0.0f, -1.0f);
+			bounds.max = glm::vec3(1.0f, 0.0f, 1.0f);
+			break;
+		case SceneManager::MESH_BOX:
+			bounds.min = glm::vec3(-0.5f);
+			bounds.max = glm::vec3(0.5f);
+			break;
+		case SceneManager::MESH_CYLINDER:
+			bounds.min = glm::vec3(-1.0f, 0.0f, -1.0f);
+			bounds.max = glm::vec3(1.0f, 1.0f, 1.0f);
+			break;
+		case SceneManager::MESH_SPHERE:
+			bounds.min = glm::vec3(-1.0f);
+			bounds.max = glm::vec3(1.0f);
+			break;
+		default:
+			// the torus ring and tube sizes are not exposed, so
+			// use a box that safely contains it
+			bounds.min = glm::vec3(-1.5f);
+			bounds.max = glm::vec3(1.5f);
+			break;
+		}
+		return(bounds);
+	}
+
+	// uniform buffer binding points and array sizes, which must
+	// match the block declarations in the shader code:
+	//
+	//   layout(std140) uniform MaterialBlock
+	//   {
+	//       Material materials[256];
+	//   };
+	//   uniform int materialIndex;
+	//
+	//   struct LightSource
+	//   {
+	//       vec3 position;      float focalStrength;
+	//       vec3 direction;     float specularIntensity;
+	//       vec3 ambientColor;
+	//       vec3 diffuseColor;
+	//       vec3 specularColor;
+	//   };
+	//   layout(std140) uniform LightBlock
+	//   {
+	//       LightSource lightSources[4];
+	//       int lightCount;
+	//   };
+	//
+	// Textures are sampled in one of three ways, picked by the
+	// uniforms that the shader declares:
+	//
+	//   #extension GL_ARB_bindless_texture : require
+	//   uniform uvec2 objectTextureHandle;
+	//   ... texture(sampler2D(objectTextureHandle), uv) ...
+	//
+	//   uniform sampler2DArray objectTextureArray;
+	//   uniform int textureLayer;
+	//   ... texture(objectTextureArray, vec3(uv, textureLayer)) ...
+	//
+	// or the plain sampler2D objectTexture, one unit per texture.
+	const GLuint MATERIAL_BLOCK_BINDING = 0;
+	const GLuint LIGHT_BLOCK_BINDING = 1;
+	const int MAX_OBJECT_MATERIALS = 256;
+	const int MAX_LIGHT_SOURCES = 4;
+
+	// std140 layout of one entry in the material block
+	struct MATERIAL_STD140
+	{
+		glm::vec3 ambientColor;
+		float ambientStrength;
+		glm::vec3 diffuseColor;
+		float padding;
+		glm::vec3 specularColor;
+		float shininess;
+	};
+
+	// std140 layout of one entry in the light block
+	struct LIGHT_STD140
+	{
+		glm::vec3 position;
+		float focalStrength;
+		glm::vec3 direction;
+		float specularIntensity;
+		glm::vec4 ambientColor;
+		glm::vec4 diffuseColor;
+		glm::vec4 specularColor;
+	};
+
+	// std140 layout of the whole light block
+	struct LIGHT_BLOCK_STD140
+	{
+		LIGHT_STD140 lightSources[MAX_LIGHT_SOURCES];
+		int lightCount;
+		int padding[3];
+	};
+
+	static_assert(sizeof(MATERIAL_STD140) == 48, "material entry must match the std140 layout");
+	static_assert(sizeof(LIGHT_STD140) == 80, "light entry must match the std140 layout");
+
+	// milliseconds between the checks of the watched files
+	const int g_HotReloadIntervalMs = 250;
+
+	// the std140 entry of one material
+	MATERIAL_STD140 PackMaterial(const SceneManager::OBJECT_MATERIAL& material)
+	{
+		MATERIAL_STD140 packed = {};
+		packed.ambientColor = material.ambientColor;
+		packed.ambientStrength = material.ambientStrength;
+		packed.diffuseColor = material.diffuseColor;
+		packed.specularColor = material.specularColor;
+		packed.shininess = material.shininess;
+		return(packed);
+	}
+}
+
+/***********************************************************
+ *  SceneManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneManager::SceneManager(ShaderManager *pShaderManager)
+{
+	m_pShaderManager = pShaderManager;
+	m_basicMeshes = new ShapeMeshes();
+	m_meshLibrary = new MeshLibrary();
+	m_textureLoader = new TextureLoader();
+	m_loadedTextures = 0;
+	m_textureMode = TEXTURE_SLOTS;
+	m_maxTextureSlots = 16;
+	m_textureArrays = NULL;
+	m_staticBatch = new StaticBatch();
+	m_bStaticBatching = false;
+	m_indirectRenderer = new IndirectRenderer();
+	m_bGpuDriven = false;
+	m_bObjectBuffer = false;
+	m_occlusionCuller = NULL;
+	m_bOcclusion = false;
+	m_bOcclusionCulling = false;
+	m_viewProjection = glm::mat4(1.0f);
+	m_bObjectBufferDirty = false;
+	m_sceneLightCount = 0;
+	m_fileWatcher = NULL;
+	m_bHotReload = false;
+	m_shadowMaps = NULL;
+	m_bShadows = false;
+	m_bShadowMaps = false;
+	m_bShadowCastersDirty = true;
+	// items added outside of a scene file belong to no record
+	m_recordState.sceneRecord = -1;
+	for (int i = 0; i <= MESH_SPHERE; i++)
+	{
+		for (int j = 0; j <= MESH_DRAW_ALL; j++)
+		{
+			m_gpuMeshRanges[i][j] = -1;
+		}
+	}
+
+	// no uniform locations are known until the shaders are active
+	m_uniforms.model = -1;
+	m_uniforms.objectColor = -1;
+	m_uniforms.objectTexture = -1;
+	m_uniforms.useTexture = -1;
+	m_uniforms.textureArray = -1;
+	m_uniforms.textureLayer = -1;
+	m_uniforms.textureHandle = -1;
+	m_uniforms.uvScale = -1;
+	m_uniforms.materialAmbientColor = -1;
+	m_uniforms.materialAmbientStrength = -1;
+	m_uniforms.materialDiffuseColor = -1;
+	m_uniforms.materialSpecularColor = -1;
+	m_uniforms.materialShininess = -1;
+	m_uniforms.materialIndex = -1;
+	m_uniforms.useInstancing = -1;
+	m_uniforms.useStaticBatch = -1;
+	m_uniforms.useObjectBuffer = -1;
+
+	m_bUseProgramCache = true;
+	m_shaderPermutations = NULL;
+	for (int i = 0; i < SHADER_VARIANT_COUNT; i++)
+	{
+		m_shaderPrograms[i].program = 0;
+		m_shaderPrograms[i].uniforms = m_uniforms;
+	}
+	m_bShaderPermutations = false;
+	m_activeShader = SHADER_GENERIC;
+	m_bDepthProgram = false;
+
+	m_depthMode = DEPTH_STATE_ORDER;
+	m_bDepthPass = false;
+	m_opaqueGroupCount = 0;
+	for (int i = 0; i < OVERDRAW_QUERY_COUNT; i++)
+	{
+		m_overdrawQueries[i] = 0;
+	}
+	m_overdrawFrame = 0;
+	m_shadedSamples = 0;
+
+	m_materialBuffer = 0;
+	m_lightBuffer = 0;
+	m_bMaterialBuffer = false;
+	m_bLightBuffer = false;
+	m_clusteredLights = NULL;
+	m_bClusteredLights = false;
+	m_bClusterView = false;
+	m_clusterView = glm::mat4(1.0f);
+	m_clusterProjection = glm::mat4(1.0f);
+	m_clusterNearPlane = 0.1f;
+	m_clusterFarPlane = 100.0f;
+	m_clusterViewWidth = 1;
+	m_clusterViewHeight = 1;
+
+	m_bRenderListDirty = false;
+	m_bAppliedStateValid = false;
+	m_bInstancing = false;
+	m_renderStats.drawCalls = 0;
+	m_renderStats.instancedObjects = 0;
+	m_renderStats.stateChanges = 0;
+	m_renderStats.stateChangesSkipped = 0;
+	m_renderStats.culledObjects = 0;
+	m_renderStats.occludedObjects = 0;
+	m_renderStats.reducedDetailObjects = 0;
+	m_renderStats.staticObjects = 0;
+	m_renderStats.gpuDrivenObjects = 0;
+	m_renderStats.programChanges = 0;
+	m_renderStats.prePassDrawCalls = 0;
+	m_renderStats.shadowMapsDrawn = 0;
+	m_renderStats.shadowDrawCalls = 0;
+	m_renderStats.shadedSamples = 0;
+	m_renderStats.shadedSamplesPerPixel = 0.0f;
+	m_bFrustumCulling = false;
+	m_bLodSelection = false;
+	m_lodCameraPosition = glm::vec3(0.0f);
+	m_lodPixelScale = 0.0f;
+}
+
+/***********************************************************
+ *  ~SceneManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneManager::~SceneManager()
+{
+	m_pShaderManager = NULL;
+	// stop watching before anything the reloads use is freed
+	delete m_fileWatcher;
+	m_fileWatcher = NULL;
+	delete m_basicMeshes;
+	m_basicMeshes = NULL;
+	delete m_meshLibrary;
+	m_meshLibrary = NULL;
+	delete m_textureLoader;
+	m_textureLoader = NULL;
+	delete m_textureArrays;
+	m_textureArrays = NULL;
+	delete m_staticBatch;
+	m_staticBatch = NULL;
+	delete m_indirectRenderer;
+	m_indirectRenderer = NULL;
+	delete m_shaderPermutations;
+	m_shaderPermutations = NULL;
+	delete m_clusteredLights;
+	m_clusteredLights = NULL;
+	delete m_occlusionCuller;
+	m_occlusionCuller = NULL;
+	delete m_shadowMaps;
+	m_shadowMaps = NULL;
+	if (0 != m_overdrawQueries[0])
+	{
+		glDeleteQueries(OVERDRAW_QUERY_COUNT, m_overdrawQueries);
+		m_overdrawQueries[0] = 0;
+	}
+	DestroyUniformBuffers();
+}
+
+/***********************************************************
+ *  CreateGLTexture()
+ *
+ *  This method is used for loading textures from image files
+ *  into the next available texture slot in memory.  The slot
+ *  gets a placeholder texture right away, and the image is
+ *  decoded on the texture loader threads and streamed into
+ *  the same texture during the following frames.
+ ***********************************************************/
+bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
+{
+	// only the texture slots are limited by the texture units
+	if ((m_textureMode == TEXTURE_SLOTS) && (m_loadedTextures >= m_maxTextureSlots))
+	{
+		std::cout << "No texture slot left for image:" << filename << ", the limit is " << m_maxTextureSlots << std::endl;
+		return false;
+	}
+
+	GLuint textureID = m_textureLoader->QueueTexture(filename);
+	if (0 == textureID)
+	{
+		std::cout << "Could not create texture for image:" << filename << std::endl;
+		return false;
+	}
+
+	// register the loaded texture and associate it with the special tag string
+	TEXTURE_INFO textureInfo;
+	textureInfo.ID = textureID;
+	textureInfo.tag = tag;
+	textureInfo.filename = filename;
+	// a bound slot shows the placeholder until the upload, while
+	// arrays and handles need the uploaded texture first
+	textureInfo.bReady = (m_textureMode == TEXTURE_SLOTS);
+	textureInfo.handle = 0;
+	textureInfo.arrayUnit = -1;
+	textureInfo.layer = -1;
+	textureInfo.reloadID = 0;
+	m_textureIDs.push_back(textureInfo);
+	m_textureSlots.emplace(textureID, m_loadedTextures);
+	// the first texture loaded with a tag keeps the tag
+	m_textureHandles.emplace(tag, m_loadedTextures);
+	m_loadedTextures++;
+
+	return true;
+}
+
+/***********************************************************
+ *  BindGLTextures()
+ *
+ *  This method is used for binding the loaded textures to
+ *  OpenGL texture memory slots.  There is one slot for each
+ *  texture unit.  The array textures are bound when they are
+ *  created, and bindless textures need no binding at all.
+ ***********************************************************/
+void SceneManager::BindGLTextures()
+{
+	if (m_textureMode != TEXTURE_SLOTS)
+	{
+		return;
+	}
+
+	for (int i = 0; i < m_loadedTextures; i++)
+	{
+		// bind textures on corresponding texture units
+		GLState::ActiveTexture(i);
+		GLState::BindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
+	}
+}
+
+/***********************************************************
+ *  DestroyGLTextures()
+ *
+ *  This method is used for freeing the memory in all the
+ *  used texture memory slots.
+ ***********************************************************/
+void SceneManager::DestroyGLTextures()
+{
+	for (int i = 0; i < m_loadedTextures; i++)
+	{
+		glGenTextures(1, &m_textureIDs[i].ID);
+	}
+}
+
+/***********************************************************
+ *  ResolveUploadedTextures()
+ *
+ *  This method is used for making the textures that finished
+ *  uploading available to the shader.  Bindless textures get
+ *  a resident handle, and the other textures are copied into
+ *  a layer of the array matching their size.
+ ***********************************************************/
+void SceneManager::ResolveUploadedTextures()
+{
+	std::vector<GLuint> uploadedTextures;
+	m_textureLoader->TakeUploadedTextures(uploadedTextures);
+
+	for (int i = 0; i < uploadedTextures.size(); i++)
+	{
+		std::unordered_map<GLuint, int>::const_iterator it = m_textureSlots.find(uploadedTextures[i]);
+		if (it == m_textureSlots.end())
+		{
+			continue;
+		}
+
+		TEXTURE_INFO& textureInfo = m_textureIDs[it->second];
+
+		// a reloaded image replaces the texture whose handle froze it,
+		// once the frames in flight no longer sample the old handle
+		if ((0 != textureInfo.reloadID) && (textureInfo.reloadID == uploadedTextures[i]))
+		{
+			glFinish();
+			glMakeTextureHandleNonResidentARB(textureInfo.handle);
+			m_textureSlots.erase(textureInfo.ID);
+			GLState::ForgetTexture(textureInfo.ID);
+			glDeleteTextures(1, &textureInfo.ID);
+			textureInfo.ID = textureInfo.reloadID;
+			textureInfo.reloadID = 0;
+			textureInfo.handle = 0;
+		}
+
+		if (m_textureMode == TEXTURE_BINDLESS)
+		{
+			// a handle freezes the texture, so it is only created
+			// after the real pixels are in place
+			if (0 == textureInfo.handle)
+			{
+				textureInfo.handle = glGetTextureHandleARB(textureInfo.ID);
+				glMakeTextureHandleResidentARB(textureInfo.handle);
+			}
+			textureInfo.bReady = (0 != textureInfo.handle);
+		}
+		else if (m_textureMode == TEXTURE_ARRAYS)
+		{
+			bool bCopied = false;
+			if (textureInfo.layer >= 0)
+			{
+				bCopied = m_textureArrays->UpdateTexture(textureInfo.ID, textureInfo.arrayUnit, textureInfo.layer);
+			}
+			// new textures, and reloaded ones that changed size
+			if (bCopied == false)
+			{
+				bCopied = m_textureArrays->AddTexture(textureInfo.ID, textureInfo.arrayUnit, textureInfo.layer);
+			}
+			textureInfo.bReady = bCopied;
+		}
+	}
+
+	// the handle or layer of an applied slot may have changed
+	if (uploadedTextures.size() > 0)
+	{
+		m_bAppliedStateValid = false;
+		m_bObjectBufferDirty = (m_gpuItems.size() > 0);
+	}
+}
+
+/***********************************************************
+ *  FindTextureID()
+ *
+ *  This method is used for getting an ID for the previously
+ *  loaded texture bitmap associated with the passed in tag.
+ ***********************************************************/
+int SceneManager::FindTextureID(const std::string& tag)
+{
+	int textureSlot = FindTextureSlot(tag);
+	if (textureSlot < 0)
+	{
+		return(-1);
+	}
+
+	return(m_textureIDs[textureSlot].ID);
+}
+
+/***********************************************************
+ *  FindTextureSlot()
+ *
+ *  This method is used for getting a slot index for the previously
+ *  loaded texture bitmap associated with the passed in tag.  The
+ *  slot index is the handle interned by CreateGLTexture().
+ ***********************************************************/
+int SceneManager::FindTextureSlot(const std::string& tag)
+{
+	std::unordered_map<std::string, int>::const_iterator it = m_textureHandles.find(tag);
+	if (it == m_textureHandles.end())
+	{
+		return(-1);
+	}
+
+	return(it->second);
+}
+
+/***********************************************************
+ *  FindMaterial()
+ *
+ *  This method is used for getting a material from the previously
+ *  defined materials list that is associated with the passed in tag.
+ ***********************************************************/
+bool SceneManager::FindMaterial(const std::string& tag, OBJECT_MATERIAL& material)
+{
+	int index = FindMaterialIndex(tag);
+	if (index < 0)
+	{
+		return(false);
+	}
+
+	material = m_objectMaterials[index];
+
+	return(true);
+}
+
+/***********************************************************
+ *  FindMaterialIndex()
+ *
+ *  This method is used for getting the position of a material
+ *  in the defined materials list, which is also its index in
+ *  the material uniform buffer and the handle interned by
+ *  AddObjectMaterial().
+ ***********************************************************/
+int SceneManager::FindMaterialIndex(const std::string& tag)
+{
+	std::unordered_map<std::string, int>::const_iterator it = m_materialHandles.find(tag);
+	if (it == m_materialHandles.end())
+	{
+		return(-1);
+	}
+
+	return(it->second);
+}
+
+/***********************************************************
+ *  AddObjectMaterial()
+ *
+ *  This method is used for adding a material to the defined
+ *  materials list and interning its tag, so that the material
+ *  can be found by handle without comparing strings.
+ ***********************************************************/
+void SceneManager::AddObjectMaterial(const OBJECT_MATERIAL& material)
+{
+	// the first material defined with a tag keeps the tag
+	m_materialHandles.emplace(material.tag, (int)m_objectMaterials.size());
+	m_objectMaterials.push_back(material);
+}
+
+/***********************************************************
+ *  CacheUniformLocations()
+ *
+ *  This method is used for resolving the shader uniform
+ *  locations used by the Set* methods.  It is called once
+ *  after the shader program has been loaded and activated,
+ *  so that no uniform names are looked up while rendering.
+ ***********************************************************/
+void SceneManager::CacheUniformLocations()
+{
+	UniformCache::BindActiveProgram();
+	LookupUniformLocations(m_uniforms);
+
+	// instanced drawing is only used when the vertex shader reads
+	// the model matrix from the per-instance attributes, and the
+	// groups after the first one start at a base instance
+	m_bInstancing = (MeshLibrary::IsBaseInstanceSupported() == true) && (m_uniforms.useInstancing >= 0) &&
+		(UniformCache::LookupAttribute(g_InstanceModelName) == (GLint)MeshLibrary::INSTANCE_MODEL_LOCATION);
+
+	// the uniform buffers are only used when the shader declares them
+	m_bMaterialBuffer = UniformCache::BindBlock(g_MaterialBlockName, MATERIAL_BLOCK_BINDING);
+	m_bLightBuffer = UniformCache::BindBlock(g_LightBlockName, LIGHT_BLOCK_BINDING);
+	// clustered lighting needs compute shaders and a shader that
+	// reads the lights of its cluster
+	m_bClusteredLights = (ClusteredLights::IsSupported() == true) && (BindClusterBlocks() == true);
+	// the shadows are only drawn when the shader samples them
+	m_bShadowMaps = (m_bShadows == true) && (BindShadowMaps() == true);
+
+	// static batches need indirect draws, the base instance in the
+	// shader, and the materials in the material buffer
+	m_bStaticBatching = (m_uniforms.useStaticBatch >= 0) && (m_bMaterialBuffer == true) &&
+		(GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect) &&
+		(GLEW_VERSION_4_6 || GLEW_ARB_shader_draw_parameters) &&
+		(UniformCache::BindStorageBlock(g_StaticDrawBlockName, StaticBatch::DRAW_BLOCK_BINDING) == true);
+
+	// pick the way textures are sampled from what the shader
+	// declares and what the driver supports
+	glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &m_maxTextureSlots);
+	// the depth pyramid and the shadow maps keep their units
+	m_maxTextureSlots = std::min(m_maxTextureSlots, (GLint)OcclusionCuller::PYRAMID_TEXTURE_UNIT);
+	m_maxTextureSlots = std::min(m_maxTextureSlots, (GLint)ShadowMaps::SHADOW_TEXTURE_UNIT);
+	if ((m_uniforms.textureHandle >= 0) && GLEW_ARB_bindless_texture)
+	{
+		m_textureMode = TEXTURE_BINDLESS;
+	}
+	else if ((m_uniforms.textureArray >= 0) && (m_uniforms.textureLayer >= 0) &&
+		(GLEW_VERSION_4_3 || GLEW_ARB_copy_image))
+	{
+		m_textureMode = TEXTURE_ARRAYS;
+		if (NULL == m_textureArrays)
+		{
+			m_textureArrays = new TextureArrays(m_maxTextureSlots);
+		}
+	}
+	else
+	{
+		m_textureMode = TEXTURE_SLOTS;
+	}
+
+	// nothing is known about the values in the new program
+	m_bAppliedStateValid = false;
+}
+
+/***********************************************************
+ *  LookupUniformLocations()
+ *
+ *  This method is used for resolving the locations of the
+ *  per-draw uniforms in the program UniformCache is bound to.
+ ***********************************************************/
+void SceneManager::LookupUniformLocations(UNIFORM_LOCATIONS& uniforms)
+{
+	uniforms.model = UniformCache::Lookup(g_ModelName);
+	uniforms.objectColor = UniformCache::Lookup(g_ColorValueName);
+	uniforms.objectTexture = UniformCache::Lookup(g_TextureValueName);
+	uniforms.useTexture = UniformCache::Lookup(g_UseTextureName);
+	uniforms.textureArray = UniformCache::Lookup(g_TextureArrayName);
+	uniforms.textureLayer = UniformCache::Lookup(g_TextureLayerName);
+	uniforms.textureHandle = UniformCache::Lookup(g_TextureHandleName);
+	uniforms.uvScale = UniformCache::Lookup(g_UVScaleName);
+	uniforms.materialAmbientColor = UniformCache::Lookup("material.ambientColor");
+	uniforms.materialAmbientStrength = UniformCache::Lookup("material.ambientStrength");
+	uniforms.materialDiffuseColor = UniformCache::Lookup("material.diffuseColor");
+	uniforms.materialSpecularColor = UniformCache::Lookup("material.specularColor");
+	uniforms.materialShininess = UniformCache::Lookup("material.shininess");
+	uniforms.materialIndex = UniformCache::Lookup(g_MaterialIndexName);
+	uniforms.useInstancing = UniformCache::Lookup(g_UseInstancingName);
+	uniforms.useStaticBatch = UniformCache::Lookup(g_UseStaticBatchName);
+	uniforms.useObjectBuffer = UniformCache::Lookup(g_UseObjectBufferName);
+}
+
+/***********************************************************
+ *  SetShaderSources()
+ *
+ *  This method is used for setting the shader files that the
+ *  specialized programs are built from in PrepareScene, and
+ *  whether their binaries are kept in the program cache.
+ ***********************************************************/
+void SceneManager::SetShaderSources(const char* vertexShaderPath, const char* fragmentShaderPath, bool bUseProgramCache)
+{
+	m_bUseProgramCache = bUseProgramCache;
+	m_vertexShaderPath = (NULL != vertexShaderPath) ? vertexShaderPath : "";
+	m_fragmentShaderPath = (NULL != fragmentShaderPath) ? fragmentShaderPath : "";
+}
+
+/***********************************************************
+ *  BuildShaderPermutations()
+ *
+ *  This method is used for building the untextured and the
+ *  textured program for the number of lights in the scene.
+ *  Only the per-draw values are uniforms of each program, so
+ *  the view, materials and lights must come from the uniform
+ *  buffers that every program is attached to.  Otherwise the
+ *  shader manager program keeps drawing everything.
+ ***********************************************************/
+void SceneManager::BuildShaderPermutations()
+{
+	m_bShaderPermutations = false;
+	m_activeShader = SHADER_GENERIC;
+
+	if ((m_vertexShaderPath.empty() == true) || (m_fragmentShaderPath.empty() == true))
+	{
+		return;
+	}
+
+	int lightCount = (int)std::min(m_lightSources.size(), (size_t)MAX_LIGHT_SOURCES);
+	if ((lightCount > 0) && (m_bLightBuffer == false) && (m_bClusteredLights == false))
+	{
+		std::cout << "INFO: shader permutations need the " << g_LightBlockName << " of the shader" << std::endl;
+		return;
+	}
+
+	if (NULL == m_shaderPermutations)
+	{
+		m_shaderPermutations = new ShaderPermutations();
+		if (m_shaderPermutations->LoadSources(m_vertexShaderPath.c_str(), m_fragmentShaderPath.c_str(), m_bUseProgramCache) == false)
+		{
+			return;
+		}
+	}
+
+	int buildScope = Profiler::BeginScope("BuildShaderPermutations");
+	GLuint genericProgram = GLState::GetProgram();
+	m_shaderPrograms[SHADER_GENERIC].program = genericProgram;
+	m_shaderPrograms[SHADER_GENERIC].uniforms = m_uniforms;
+
+	bool bBuilt = (BuildShaderVariant(SHADER_UNTEXTURED, false, lightCount > 0, lightCount) == true) &&
+		(BuildShaderVariant(SHADER_TEXTURED, true, lightCount > 0, lightCount) == true);
+
+	// the depth pre-pass can only use the unlit untextured program
+	// when every program computes the very same positions, since
+	// the shading pass tests them for equality
+	m_bDepthProgram = (bBuilt == true) &&
+		(m_shaderPermutations->IsPositionInvariant() == true) &&
+		(BuildShaderVariant(SHADER_DEPTH, false, false, 0) == true);
+
+	GLState::UseProgram(genericProgram);
+	UniformCache::BindActiveProgram();
+	Profiler::EndScope(buildScope);
+
+	if (bBuilt == false)
+	{
+		std::cout << "INFO: the shader permutations are not used, the render list is drawn with the uniform branches" << std::endl;
+		return;
+	}
+
+	m_bShaderPermutations = true;
+	std::cout << "INFO: render list drawn with " << m_shaderPermutations->GetProgramCount()
+		<< " shader permutations for " << lightCount << " lights" << std::endl;
+}
+
+/***********************************************************
+ *  BuildShaderVariant()
+ *
+ *  This method is used for building one permutation, and
+ *  resolving its uniform locations and attaching its blocks.
+ *  It leaves the permutation active, and returns false when
+ *  it does not build or lacks one of the blocks.
+ ***********************************************************/
+bool SceneManager::BuildShaderVariant(int shaderVariant, bool bTextured, bool bLit, int lightCount)
+{
+	GLuint program = m_shaderPermutations->GetProgram(bTextured, bLit, lightCount);
+	if (0 == program)
+	{
+		return(false);
+	}
+
+	GLState::UseProgram(program);
+	UniformCache::BindActiveProgram();
+	LookupUniformLocations(m_shaderPrograms[shaderVariant].uniforms);
+	m_shaderPrograms[shaderVariant].program = program;
+
+	bool bBound = UniformCache::BindBlock(g_ViewBlockName, ViewManager::VIEW_BLOCK_BINDING);
+	if (m_bMaterialBuffer == true)
+	{
+		bBound = bBound && UniformCache::BindBlock(g_MaterialBlockName, MATERIAL_BLOCK_BINDING);
+	}
+	if ((m_bLightBuffer == true) && (bLit == true))
+	{
+		bBound = bBound && UniformCache::BindBlock(g_LightBlockName, LIGHT_BLOCK_BINDING);
+	}
+	if ((m_bClusteredLights == true) && (bLit == true))
+	{
+		bBound = bBound && BindClusterBlocks();
+	}
+	if ((m_bShadowMaps == true) && (bLit == true))
+	{
+		bBound = bBound && BindShadowMaps();
+	}
+
+	return(bBound);
+}
+
+/***********************************************************
+ *  UseShaderProgram()
+ *
+ *  This method is used for making one of the shader programs
+ *  active along with its uniform locations.  The values last
+ *  sent belong to the other program, so every value of the
+ *  next draw item is sent again; the ones the new program
+ *  already has are dropped by GLState.
+ ***********************************************************/
+void SceneManager::UseShaderProgram(int shaderVariant)
+{
+	if ((m_bShaderPermutations == false) || (m_activeShader == shaderVariant))
+	{
+		return;
+	}
+
+	GLState::UseProgram(m_shaderPrograms[shaderVariant].program);
+	m_uniforms = m_shaderPrograms[shaderVariant].uniforms;
+	m_activeShader = shaderVariant;
+	m_bAppliedStateValid = false;
+	m_renderStats.programChanges++;
+}
+
+/***********************************************************
+ *  CreateMaterialBuffer()
+ *
+ *  This method is used for packing all of the defined object
+ *  materials into a std140 uniform buffer, so that each draw
+ *  only needs to send the index of its material.
+ ***********************************************************/
+void SceneManager::CreateMaterialBuffer()
+{
+	if (m_objectMaterials.size() > MAX_OBJECT_MATERIALS)
+	{
+		std::cout << "Only the first " << MAX_OBJECT_MATERIALS << " object materials fit in the material buffer" << std::endl;
+	}
+
+	// the buffer is sized for the whole block declared in the shader
+	std::vector<MATERIAL_STD140> packedMaterials(MAX_OBJECT_MATERIALS);
+	for (int i = 0; (i < m_objectMaterials.size()) && (i < MAX_OBJECT_MATERIALS); i++)
+	{
+		packedMaterials[i] = PackMaterial(m_objectMaterials[i]);
+	}
+
+	if (0 == m_materialBuffer)
+	{
+		glGenBuffers(1, &m_materialBuffer);
+	}
+	glBindBuffer(GL_UNIFORM_BUFFER, m_materialBuffer);
+	glBufferData(GL_UNIFORM_BUFFER, packedMaterials.size() * sizeof(MATERIAL_STD140), packedMaterials.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	glBindBufferBase(GL_UNIFORM_BUFFER, MATERIAL_BLOCK_BINDING, m_materialBuffer);
+}
+
+/***********************************************************
+ *  UpdateMaterialEntry()
+ *
+ *  This method is used for writing one changed material into
+ *  its entry of the material uniform buffer, leaving all of
+ *  the other entries as they are.  The shader without the
+ *  material block gets the new values with the next draw
+ *  that uses the material.
+ ***********************************************************/
+void SceneManager::UpdateMaterialEntry(int materialIndex)
+{
+	if ((materialIndex < 0) || (materialIndex >= m_objectMaterials.size()))
+	{
+		return;
+	}
+
+	if ((0 != m_materialBuffer) && (materialIndex < MAX_OBJECT_MATERIALS))
+	{
+		MATERIAL_STD140 packed = PackMaterial(m_objectMaterials[materialIndex]);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_materialBuffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, materialIndex * sizeof(MATERIAL_STD140), sizeof(MATERIAL_STD140), &packed);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	// the material of the applied state is sent again
+	m_bAppliedStateValid = false;
+}
+
+/***********************************************************
+ *  CreateLightBuffer()
+ *
+ *  This method is used for packing the defined light sources
+ *  into a std140 uniform buffer.  When the shader does not
+ *  declare the light block, the light values are sent into
+ *  the lightSources[] uniforms one time instead.
+ ***********************************************************/
+void SceneManager::CreateLightBuffer()
+{
+	LIGHT_BLOCK_STD140 lightBlock = {};
+	int lightCount = 0;
+
+	if ((m_bClusteredLights == true) && (NULL == m_clusteredLights))
+	{
+		m_clusteredLights = new ClusteredLights();
+		m_bClusteredLights = m_clusteredLights->Initialize();
+	}
+
+	// every light goes into the cluster lists, which have no
+	// fixed number of lights
+	if (m_bClusteredLights == true)
+	{
+		std::vector<ClusteredLights::LIGHT_RECORD> lightRecords(m_lightSources.size());
+		for (int i = 0; i < m_lightSources.size(); i++)
+		{
+			const LIGHT_SOURCE& light = m_lightSources[i];
+			lightRecords[i].position = glm::vec4(light.position, light.range);
+			lightRecords[i].direction = glm::vec4(light.direction, light.focalStrength);
+			lightRecords[i].ambientColor = glm::vec4(light.ambientColor, 0.0f);
+			lightRecords[i].diffuseColor = glm::vec4(light.diffuseColor, 0.0f);
+			lightRecords[i].specularColor = glm::vec4(light.specularColor, light.specularIntensity);
+		}
+		m_clusteredLights->SetLights(lightRecords);
+	}
+	else if (m_lightSources.size() > MAX_LIGHT_SOURCES)
+	{
+		std::cout << "Only the first " << MAX_LIGHT_SOURCES << " light sources are used" << std::endl;
+	}
+
+	for (int i = 0; (i < m_lightSources.size()) && (i < MAX_LIGHT_SOURCES); i++)
+	{
+		lightBlock.lightSources[i].position = m_lightSources[i].position;
+		lightBlock.lightSources[i].focalStrength = m_lightSources[i].focalStrength;
+		lightBlock.lightSources[i].direction = m_lightSources[i].direction;
+		lightBlock.lightSources[i].specularIntensity = m_lightSources[i].specularIntensity;
+		lightBlock.lightSources[i].ambientColor = glm::vec4(m_lightSources[i].ambientColor, 0.0f);
+		lightBlock.lightSources[i].diffuseColor = glm::vec4(m_lightSources[i].diffuseColor, 0.0f);
+		lightBlock.lightSources[i].specularColor = glm::vec4(m_lightSources[i].specularColor, 0.0f);
+		lightCount++;
+	}
+	lightBlock.lightCount = lightCount;
+
+	if (m_bLightBuffer == true)
+	{
+		if (0 == m_lightBuffer)
+		{
+			glGenBuffers(1, &m_lightBuffer);
+		}
+		glBindBuffer(GL_UNIFORM_BUFFER, m_lightBuffer);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(LIGHT_BLOCK_STD140), &lightBlock, GL_STATIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		glBindBufferBase(GL_UNIFORM_BUFFER, LIGHT_BLOCK_BINDING, m_lightBuffer);
+		return;
+	}
+
+	// the shader uses the plain light uniforms, which only
+	// need to be sent once since the lights do not change
+	for (int i = 0; i < lightCount; i++)
+	{
+		std::string lightName = "lightSources[" + std::to_string(i) + "].";
+		m_pShaderManager->setVec3Value(lightName + "position", m_lightSources[i].position);
+		m_pShaderManager->setVec3Value(lightName + "direction", m_lightSources[i].direction);
+		m_pShaderManager->setVec3Value(lightName + "ambientColor", m_lightSources[i].ambientColor);
+		m_pShaderManager->setVec3Value(lightName + "diffuseColor", m_lightSources[i].diffuseColor);
+		m_pShaderManager->setVec3Value(lightName + "specularColor", m_lightSources[i].specularColor);
+		m_pShaderManager->setFloatValue(lightName + "focalStrength", m_lightSources[i].focalStrength);
+		m_pShaderManager->setFloatValue(lightName + "specularIntensity", m_lightSources[i].specularIntensity);
+	}
+}
+
+/***********************************************************
+ *  BindClusterBlocks()
+ *
+ *  This method is used for attaching the cluster parameters
+ *  and the light lists of the active program to the binding
+ *  points written by the light assignment.  It returns false
+ *  when the shader does not declare all of them.
+ ***********************************************************/
+bool SceneManager::BindClusterBlocks()
+{
+	return((UniformCache::BindBlock(g_ClusterBlockName, ClusteredLights::CLUSTER_BLOCK_BINDING) == true) &&
+		(UniformCache::BindStorageBlock(g_ClusterLightBlockName, ClusteredLights::LIGHT_RECORD_BLOCK_BINDING) == true) &&
+		(UniformCache::BindStorageBlock(g_ClusterCountBlockName, ClusteredLights::LIGHT_COUNT_BLOCK_BINDING) == true) &&
+		(UniformCache::BindStorageBlock(g_ClusterIndexBlockName, ClusteredLights::LIGHT_INDEX_BLOCK_BINDING) == true));
+}
+
+/***********************************************************
+ *  BindShadowMaps()
+ *
+ *  This method is used for attaching the shadow block of the
+ *  active program to its binding point, and pointing its
+ *  shadow sampler at the unit the maps are bound to.  It
+ *  returns false when the shader does not declare both.
+ ***********************************************************/
+bool SceneManager::BindShadowMaps()
+{
+	GLint shadowMapsLocation = UniformCache::Lookup(g_ShadowMapsName);
+	if ((shadowMapsLocation < 0) ||
+		(UniformCache::BindBlock(g_ShadowBlockName, ShadowMaps::SHADOW_BLOCK_BINDING) == false))
+	{
+		return(false);
+	}
+
+	GLState::Uniform1i(shadowMapsLocation, ShadowMaps::SHADOW_TEXTURE_UNIT);
+	return(true);
+}
+
+/***********************************************************
+ *  DestroyUniformBuffers()
+ *
+ *  This method is used for freeing the material and light
+ *  uniform buffers.
+ ***********************************************************/
+void SceneManager::DestroyUniformBuffers()
+{
+	if (0 != m_materialBuffer)
+	{
+		glDeleteBuffers(1, &m_materialBuffer);
+		m_materialBuffer = 0;
+	}
+	if (0 != m_lightBuffer)
+	{
+		glDeleteBuffers(1, &m_lightBuffer);
+		m_lightBuffer = 0;
+	}
+}
+
+/***********************************************************
+ *  BuildRenderList()
+ *
+ *  This method is used for recording all of the objects in
+ *  the 3D scene into the retained render list.  The Draw*
+ *  methods set the draw state and add their items exactly as
+ *  they were drawn in immediate mode.
+ ***********************************************************/
+void SceneManager::BuildRenderList()
+{
+	m_renderList.clear();
+
+	// default draw state before the first object is recorded
+	m_recordState.meshID = MESH_PLANE;
+	m_recordState.meshFlags = MESH_DRAW_ALL;
+	m_recordState.transform = Transform();
+	m_recordState.color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+	m_recordState.textureSlot = -1;
+	m_recordState.uvScale = glm::vec2(1.0f, 1.0f);
+	m_recordState.materialID = -1;
+	m_recordState.sceneRecord = -1;
+
+	// Draw the countertop
+	m_recordState.sourceName = "DrawCountertop";
+	DrawCountertop();
+
+	// Draw the mug 
+	m_recordState.sourceName = "DrawMug";
+	DrawMug();
+
+	// Draw the cutting board
+	m_recordState.sourceName = "DrawCuttingBoard";
+	DrawCuttingBoard();
+
+	// Draw the grapes
+	m_recordState.sourceName = "DrawGrapes";
+	DrawGrapes();
+
+	// Draw the sausages
+	m_recordState.sourceName = "DrawSausages";
+	DrawSausages();
+
+	// Draw the tea box
+	m_recordState.sourceName = "DrawTeaBox";
+	DrawTeaBox();
+
+	m_bRenderListDirty = true;
+}
+
+/***********************************************************
+ *  LoadSceneFile()
+ *
+ *  This method is used for loading the materials, textures,
+ *  lights and objects of the scene from a scene file.  The
+ *  objects go straight into the render list, without the
+ *  Set* methods, and the texture and material records of the
+ *  file are resolved into handles once for all of them.
+ ***********************************************************/
+bool SceneManager::LoadSceneFile(const char* filename)
+{
+	SceneFile sceneFile;
+	if (sceneFile.Load(filename) == false)
+	{
+		return(false);
+	}
+
+	const SceneFile::SCENE_TEXTURE* textures = sceneFile.GetTextures();
+	std::vector<int> textureSlots(sceneFile.GetTextureCount(), -1);
+	for (int i = 0; i < textureSlots.size(); i++)
+	{
+		if (CreateGLTexture(textures[i].filename, textures[i].tag) == true)
+		{
+			textureSlots[i] = FindTextureSlot(textures[i].tag);
+		}
+	}
+	BindGLTextures();
+
+	const SceneFile::SCENE_MATERIAL* materials = sceneFile.GetMaterials();
+	std::vector<int> materialIDs(sceneFile.GetMaterialCount(), -1);
+	for (int i = 0; i < materialIDs.size(); i++)
+	{
+		OBJECT_MATERIAL material;
+		material.ambientColor = glm::make_vec3(materials[i].ambientColor);
+		material.ambientStrength = materials[i].ambientStrength;
+		material.diffuseColor = glm::make_vec3(materials[i].diffuseColor);
+		material.specularColor = glm::make_vec3(materials[i].specularColor);
+		material.shininess = materials[i].shininess;
+		material.tag = materials[i].tag;
+		AddObjectMaterial(material);
+		materialIDs[i] = FindMaterialIndex(material.tag);
+	}
+
+	const SceneFile::SCENE_LIGHT* lights = sceneFile.GetLights();
+	for (int i = 0; i < sceneFile.GetLightCount(); i++)
+	{
+		LIGHT_SOURCE light;
+		light.position = glm::make_vec3(lights[i].position);
+		light.direction = glm::make_vec3(lights[i].direction);
+		light.ambientColor = glm::make_vec3(lights[i].ambientColor);
+		light.diffuseColor = glm::make_vec3(lights[i].diffuseColor);
+		light.specularColor = glm::make_vec3(lights[i].specularColor);
+		light.focalStrength = lights[i].focalStrength;
+		light.specularIntensity = lights[i].specularIntensity;
+		// scene files have no light ranges
+		light.range = 0.0f;
+		m_lightSources.push_back(light);
+	}
+	m_sceneLightCount = sceneFile.GetLightCount();
+	m_pShaderManager->setBoolValue(g_UseLightingName, m_lightSources.size() > 0);
+
+	const SceneFile::SCENE_OBJECT* objects = sceneFile.GetObjects();
+	int objectCount = sceneFile.GetObjectCount();
+	m_renderList.clear();
+	m_renderList.reserve(objectCount);
+	for (int i = 0; i < objectCount; i++)
+	{
+		DRAW_ITEM item;
+		if (MakeSceneItem(objects[i], i, textureSlots, materialIDs, item) == true)
+		{
+			m_renderList.push_back(item);
+		}
+	}
+	m_sceneObjects.assign(objects, objects + objectCount);
+	m_bRenderListDirty = true;
+
+	std::cout << "INFO: loaded scene file " << filename << ": " << m_renderList.size() << " objects, "
+		<< materialIDs.size() << " materials, " << textureSlots.size() << " textures, "
+		<< m_lightSources.size() << " lights" << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  MakeSceneItem()
+ *
+ *  This method is used for turning one object record of a
+ *  scene file into a draw item.  The texture and material
+ *  indices of the record are resolved through the handles of
+ *  the texture and material records of the same file.
+ ***********************************************************/
+bool SceneManager::MakeSceneItem(const SceneFile::SCENE_OBJECT& object, int record,
+	const std::vector<int>& textureSlots, const std::vector<int>& materialIDs, DRAW_ITEM& item)
+{
+	if ((object.meshID < MESH_PLANE) || (object.meshID > MESH_SPHERE))
+	{
+		return(false);
+	}
+
+	item.meshID = object.meshID;
+	item.meshFlags = object.meshFlags;
+	item.transform.Set(
+		glm::make_vec3(object.scale),
+		object.rotationDegrees[0],
+		object.rotationDegrees[1],
+		object.rotationDegrees[2],
+		glm::make_vec3(object.position));
+	item.color = glm::make_vec4(object.color);
+	item.textureSlot = ((object.textureIndex >= 0) && (object.textureIndex < textureSlots.size())) ?
+		textureSlots[object.textureIndex] : -1;
+	item.uvScale = glm::make_vec2(object.uvScale);
+	item.materialID = ((object.materialIndex >= 0) && (object.materialIndex < materialIDs.size())) ?
+		materialIDs[object.materialIndex] : -1;
+	item.sourceName = "SceneFile";
+	item.sceneRecord = record;
+
+	return(true);
+}
+
+/***********************************************************
+ *  StartHotReload()
+ *
+ *  This method is used for watching the image file of every
+ *  texture once the scene is prepared, and the scene file
+ *  when the scene was loaded from one.
+ ***********************************************************/
+void SceneManager::StartHotReload(bool bSceneFile)
+{
+	if ((m_bHotReload == false) || (NULL != m_fileWatcher))
+	{
+		return;
+	}
+
+	m_fileWatcher = new FileWatcher();
+	if (bSceneFile == true)
+	{
+		m_fileWatcher->WatchFile(m_sceneFilename);
+	}
+	for (int i = 0; i < m_textureIDs.size(); i++)
+	{
+		m_fileWatcher->WatchFile(m_textureIDs[i].filename);
+	}
+	m_fileWatcher->Start(g_HotReloadIntervalMs);
+
+	std::cout << "INFO: hot reload is watching the scene file and " << m_textureIDs.size() << " textures" << std::endl;
+}
+
+/***********************************************************
+ *  ApplyFileChanges()
+ *
+ *  This method is used for reloading the files that changed
+ *  since the last frame.  Only the changed textures are
+ *  decoded again, on the texture loader threads, and the
+ *  rest of the scene stays on the GPU as it is.
+ ***********************************************************/
+void SceneManager::ApplyFileChanges()
+{
+	std::vector<std::string> changedFiles;
+	m_fileWatcher->TakeChangedFiles(changedFiles);
+
+	for (int i = 0; i < changedFiles.size(); i++)
+	{
+		if (changedFiles[i] == m_sceneFilename)
+		{
+			ReloadSceneFile();
+			continue;
+		}
+
+		// several tags may share one image file
+		for (int slot = 0; slot < m_textureIDs.size(); slot++)
+		{
+			if (m_textureIDs[slot].filename == changedFiles[i])
+			{
+				ReloadTexture(slot);
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  ReloadTexture()
+ *
+ *  This method is used for queueing the image of one texture
+ *  slot to be decoded again.  The image goes into the same
+ *  texture, so neither the slot binding nor the array layer
+ *  change, except for a texture with a bindless handle, whose
+ *  storage can no longer be replaced.  That image is decoded
+ *  into a new texture instead, which takes over the slot in
+ *  ResolveUploadedTextures() once it is uploaded.
+ ***********************************************************/
+void SceneManager::ReloadTexture(int textureSlot)
+{
+	TEXTURE_INFO& textureInfo = m_textureIDs[textureSlot];
+
+	if ((m_textureMode == TEXTURE_BINDLESS) && (0 != textureInfo.handle))
+	{
+		if (0 != textureInfo.reloadID)
+		{
+			m_textureLoader->ReloadTexture(textureInfo.filename.c_str(), textureInfo.reloadID);
+			return;
+		}
+		textureInfo.reloadID = m_textureLoader->QueueTexture(textureInfo.filename.c_str());
+		m_textureSlots.emplace(textureInfo.reloadID, textureSlot);
+		return;
+	}
+
+	m_textureLoader->ReloadTexture(textureInfo.filename.c_str(), textureInfo.ID);
+}
+
+/***********************************************************
+ *  ReloadSceneFile()
+ *
+ *  This method is used for reading the scene file again and
+ *  patching what changed into the running scene.  Changed
+ *  materials are written into their own entry of the material
+ *  buffer, textures whose file name changed are decoded again,
+ *  and only the draw items of changed object records are
+ *  replaced.  Records that were added or removed at the end
+ *  of the file add or remove their items.  The number of
+ *  lights decides which shader programs are built, so it
+ *  needs a restart, while the values of the lights do not.
+ ***********************************************************/
+void SceneManager::ReloadSceneFile()
+{
+	double startTime = glfwGetTime();
+
+	SceneFile sceneFile;
+	if (sceneFile.Load(m_sceneFilename.c_str()) == false)
+	{
+		return;
+	}
+
+	// textures are matched by tag, and new tags are loaded
+	int reloadedTextures = 0;
+	const SceneFile::SCENE_TEXTURE* textures = sceneFile.GetTextures();
+	std::vector<int> textureSlots(sceneFile.GetTextureCount(), -1);
+	for (int i = 0; i < textureSlots.size(); i++)
+	{
+		textureSlots[i] = FindTextureSlot(textures[i].tag);
+		if (textureSlots[i] < 0)
+		{
+			if (CreateGLTexture(textures[i].filename, textures[i].tag) == true)
+			{
+				textureSlots[i] = FindTextureSlot(textures[i].tag);
+				m_fileWatcher->WatchFile(textures[i].filename);
+				BindGLTextures();
+				reloadedTextures++;
+			}
+		}
+		else if (m_textureIDs[textureSlots[i]].filename != textures[i].filename)
+		{
+			m_textureIDs[textureSlots[i]].filename = textures[i].filename;
+			m_fileWatcher->WatchFile(textures[i].filename);
+			ReloadTexture(textureSlots[i]);
+			reloadedTextures++;
+		}
+	}
+
+	// materials are matched by tag, and each changed one is
+	// written into its entry of the buffer
+	int changedMaterials = 0;
+	const SceneFile::SCENE_MATERIAL* materials = sceneFile.GetMaterials();
+	std::vector<int> materialIDs(sceneFile.GetMaterialCount(), -1);
+	for (int i = 0; i < materialIDs.size(); i++)
+	{
+		OBJECT_MATERIAL material;
+		material.ambientColor = glm::make_vec3(materials[i].ambientColor);
+		material.ambientStrength = materials[i].ambientStrength;
+		material.diffuseColor = glm::make_vec3(materials[i].diffuseColor);
+		material.specularColor = glm::make_vec3(materials[i].specularColor);
+		material.shininess = materials[i].shininess;
+		material.tag = materials[i].tag;
+
+		materialIDs[i] = FindMaterialIndex(material.tag);
+		if (materialIDs[i] < 0)
+		{
+			AddObjectMaterial(material);
+			materialIDs[i] = FindMaterialIndex(material.tag);
+			UpdateMaterialEntry(materialIDs[i]);
+			changedMaterials++;
+			continue;
+		}
+
+		const OBJECT_MATERIAL& current = m_objectMaterials[materialIDs[i]];
+		if ((current.ambientColor != material.ambientColor) ||
+			(current.ambientStrength != material.ambientStrength) ||
+			(current.diffuseColor != material.diffuseColor) ||
+			(current.specularColor != material.specularColor) ||
+			(current.shininess != material.shininess))
+		{
+			m_objectMaterials[materialIDs[i]] = material;
+			UpdateMaterialEntry(materialIDs[i]);
+			changedMaterials++;
+		}
+	}
+
+	// the lights of the file come before any synthetic lights
+	const SceneFile::SCENE_LIGHT* lights = sceneFile.GetLights();
+	bool bLightsChanged = false;
+	if (sceneFile.GetLightCount() != m_sceneLightCount)
+	{
+		std::cout << "INFO: a different number of lights in " << m_sceneFilename << " needs a restart" << std::endl;
+	}
+	else
+	{
+		for (int i = 0; i < m_sceneLightCount; i++)
+		{
+			LIGHT_SOURCE& light = m_lightSources[i];
+			LIGHT_SOURCE reloaded = light;
+			reloaded.position = glm::make_vec3(lights[i].position);
+			reloaded.direction = glm::make_vec3(lights[i].direction);
+			reloaded.ambientColor = glm::make_vec3(lights[i].ambientColor);
+			reloaded.diffuseColor = glm::make_vec3(lights[i].diffuseColor);
+			reloaded.specularColor = glm::make_vec3(lights[i].specularColor);
+			reloaded.focalStrength = lights[i].focalStrength;
+			reloaded.specularIntensity = lights[i].specularIntensity;
+			if (memcmp(&reloaded, &light, sizeof(LIGHT_SOURCE)) != 0)
+			{
+				light = reloaded;
+				bLightsChanged = true;
+			}
+		}
+	}
+	// the plain light uniforms belong to one program only, so
+	// they are left to the next launch
+	if ((bLightsChanged == true) && ((m_bLightBuffer == true) || (m_bClusteredLights == true)))
+	{
+		CreateLightBuffer();
+	}
+	else if (bLightsChanged == true)
+	{
+		std::cout << "INFO: the changed lights of " << m_sceneFilename << " need a restart" << std::endl;
+	}
+
+	// object records are matched by their position in the file
+	const SceneFile::SCENE_OBJECT* objects = sceneFile.GetObjects();
+	int objectCount = sceneFile.GetObjectCount();
+	int oldObjectCount = (int)m_sceneObjects.size();
+	std::vector<char> changedRecords(objectCount, 0);
+	int changedObjects = 0;
+	for (int i = 0; i < objectCount; i++)
+	{
+		if ((i >= oldObjectCount) ||
+			(memcmp(&objects[i], &m_sceneObjects[i], sizeof(SceneFile::SCENE_OBJECT)) != 0))
+		{
+			changedRecords[i] = 1;
+			changedObjects++;
+		}
+	}
+	changedObjects += (oldObjectCount > objectCount) ? oldObjectCount - objectCount : 0;
+
+	if (changedObjects > 0)
+	{
+		if (PatchSceneItems(m_renderList, sceneFile, changedRecords, textureSlots, materialIDs) == true)
+		{
+			m_bRenderListDirty = true;
+		}
+		if (PatchSceneItems(m_gpuItems, sceneFile, changedRecords, textureSlots, materialIDs) == true)
+		{
+			m_bObjectBufferDirty = true;
+		}
+
+		// the static objects are baked into their batches, so the
+		// batches are merged again from the patched items
+		if (PatchSceneItems(m_staticItems, sceneFile, changedRecords, textureSlots, materialIDs) == true)
+		{
+			m_renderList.insert(m_renderList.end(), m_staticItems.begin(), m_staticItems.end());
+			BuildStaticBatches();
+			m_bRenderListDirty = true;
+		}
+
+		// records added at the end of the file
+		for (int i = oldObjectCount; i < objectCount; i++)
+		{
+			DRAW_ITEM item;
+			if (MakeSceneItem(objects[i], i, textureSlots, materialIDs, item) == true)
+			{
+				m_renderList.push_back(item);
+				m_bRenderListDirty = true;
+			}
+		}
+		m_sceneObjects.assign(objects, objects + objectCount);
+	}
+
+	std::cout << "INFO: reloaded scene file " << m_sceneFilename << ": " << changedObjects << " objects, "
+		<< changedMaterials << " materials, " << reloadedTextures << " textures changed in "
+		<< (glfwGetTime() - startTime) * 1000.0 << " ms" << std::endl;
+}
+
+/***********************************************************
+ *  PatchSceneItems()
+ *
+ *  This method is used for replacing the items of a list that
+ *  belong to changed object records, and dropping the items
+ *  of records that are no longer in the file, returning true
+ *  when the list was changed.
+ ***********************************************************/
+bool SceneManager::PatchSceneItems(std::vector<DRAW_ITEM>& items, const SceneFile& sceneFile,
+	const std::vector<char>& changedRecords, const std::vector<int>& textureSlots,
+	const std::vector<int>& materialIDs)
+{
+	const SceneFile::SCENE_OBJECT* objects = sceneFile.GetObjects();
+	bool bChanged = false;
+	int keptItems = 0;
+
+	for (int i = 0; i < items.size(); i++)
+	{
+		int record = items[i].sceneRecord;
+		bool bKeep = true;
+		if ((record >= 0) && ((record >= changedRecords.size()) || (changedRecords[record] != 0)))
+		{
+			bKeep = (record < changedRecords.size()) &&
+				(MakeSceneItem(objects[record], record, textureSlots, materialIDs, items[i]) == true);
+			bChanged = true;
+		}
+
+		if (bKeep == true)
+		{
+			if (keptItems != i)
+			{
+				items[keptItems] = items[i];
+			}
+			keptItems++;
+		}
+	}
+	items.resize(keptItems);
+
+	return(bChanged);
+}
+
+/***********************************************************
+ *  AddDrawItem()
+ *
+ *  This method is used for adding the passed in mesh to the
+ *  render list with the current recorded draw state.
+ ***********************************************************/
+void SceneManager::AddDrawItem(int meshID, unsigned int meshFlags)
+{
+	DRAW_ITEM item = m_recordState;
+
+	item.meshID = meshID;
+	item.meshFlags = meshFlags;
+	m_renderList.push_back(item);
+
+	m_bRenderListDirty = true;
+}
+
+/***********************************************************
+ *  CanBatchStatic()
+ *
+ *  This method is used for checking whether a draw item can be
+ *  merged into a static batch.  Transparent items keep their
+ *  blending order in the render list, spheres keep their
+ *  instancing and levels of detail, and the torus is left out
+ *  because its geometry is only known to ShapeMeshes.
+ ***********************************************************/
+bool SceneManager::CanBatchStatic(const DRAW_ITEM& item)
+{
+	if (item.color.a < 1.0f)
+		return(false);
+
+	return((item.meshID == MESH_PLANE) ||
+		(item.meshID == MESH_BOX) ||
+		(item.meshID == MESH_CYLINDER));
+}
+
+/***********************************************************
+ *  BuildStaticBatches()
+ *
+ *  This method is used for moving the static items out of the
+ *  render list, and baking them in world space into the static
+ *  batches.  The texture is still a uniform, so there is one
+ *  batch per texture, while the color, UV scale and material
+ *  of each item are read from the draw data buffer.  The
+ *  front to back depth mode keeps the static items in the
+ *  render list, so that they are sorted with the others.
+ ***********************************************************/
+void SceneManager::BuildStaticBatches()
+{
+	std::vector<DRAW_ITEM> dynamicItems;
+	std::vector<GLfloat> vertices;
+	std::vector<GLuint> indices;
+
+	m_staticBatch->Clear();
+	m_staticItems.clear();
+	m_staticBatchItems.clear();
+
+	// the GPU driven mode draws the static objects as well, and
+	// the batches would draw them before any of the sorted groups
+	if ((m_bStaticBatching == false) || (m_bObjectBuffer == true) ||
+		(m_depthMode == DEPTH_FRONT_TO_BACK))
+	{
+		return;
+	}
+
+	for (int i = 0; i < m_renderList.size(); i++)
+	{
+		if (CanBatchStatic(m_renderList[i]) == true)
+		{
+			m_staticItems.push_back(m_renderList[i]);
+		}
+		else
+		{
+			dynamicItems.push_back(m_renderList[i]);
+		}
+	}
+
+	if (m_staticItems.size() == 0)
+	{
+		return;
+	}
+	m_renderList.swap(dynamicItems);
+	m_bRenderListDirty = true;
+
+	// items with the same values are kept together so that they
+	// extend one indirect command
+	std::stable_sort(m_staticItems.begin(), m_staticItems.end(),
+		[](const DRAW_ITEM& a, const DRAW_ITEM& b)
+		{
+			if (a.textureSlot != b.textureSlot)
+				return(a.textureSlot < b.textureSlot);
+			if (a.materialID != b.materialID)
+				return(a.materialID < b.materialID);
+			for (int i = 0; i < 4; i++)
+			{
+				if (a.color[i] != b.color[i])
+					return(a.color[i] < b.color[i]);
+			}
+			if (a.uvScale.x != b.uvScale.x)
+				return(a.uvScale.x < b.uvScale.x);
+			return(a.uvScale.y < b.uvScale.y);
+		});
+
+	for (int i = 0; i < m_staticItems.size(); i++)
+	{
+		DRAW_ITEM& item = m_staticItems[i];
+		if ((i == 0) || (item.textureSlot != m_staticItems[i - 1].textureSlot))
+		{
+			m_staticBatch->BeginBatch();
+			m_staticBatchItems.push_back(i);
+		}
+
+		switch (item.meshID)
+		{
+		case MESH_PLANE:
+			m_meshLibrary->GetPlaneGeometry(vertices, indices);
+			break;
+		case MESH_BOX:
+			m_meshLibrary->GetBoxGeometry(vertices, indices);
+			break;
+		default:
+			m_meshLibrary->GetCylinderGeometry(
+				(item.meshFlags & MESH_DRAW_TOP) != 0,
+				(item.meshFlags & MESH_DRAW_BOTTOM) != 0,
+				(item.meshFlags & MESH_DRAW_SIDES) != 0,
+				vertices,
+				indices);
+			break;
+		}
+
+		// items recorded before any material use the first one,
+		// since the draw data cannot keep the previous material
+		StaticBatch::DRAW_DATA drawData;
+		drawData.color = item.color;
+		drawData.uvScale = item.uvScale;
+		drawData.materialIndex = (item.materialID >= 0) ? item.materialID : 0;
+		drawData.padding = 0;
+
+		item.transform.Update();
+		m_staticBatch->AddGeometry(vertices, indices, item.transform.GetModelMatrix(), drawData);
+	}
+	m_staticBatch->Upload();
+
+	std::cout << "INFO: merged " << m_staticBatch->GetObjectCount() << " static objects into "
+		<< m_staticBatch->GetBatchCount() << " batches" << std::endl;
+}
+
+/***********************************************************
+ *  SubmitStaticBatches()
+ *
+ *  This method is used for drawing each static batch with one
+ *  indirect draw call, after sending the texture state of its
+ *  first item.
+ ***********************************************************/
+void SceneManager::SubmitStaticBatches()
+{
+	bool bDrawScopes = Profiler::GetDrawScopes();
+
+	for (int i = 0; i < m_staticBatch->GetBatchCount(); i++)
+	{
+		const DRAW_ITEM& item = m_staticItems[m_staticBatchItems[i]];
+		int drawScope = bDrawScopes ? Profiler::BeginScope(item.sourceName) : -1;
+
+		ApplyDrawState(item, false);
+
+		ApplyDrawPath(false, true, false);
+		m_staticBatch->DrawBatch(i);
+
+		m_renderStats.drawCalls++;
+
+		Profiler::EndScope(drawScope);
+	}
+	m_renderStats.staticObjects = m_staticBatch->GetObjectCount();
+}
+
+/***********************************************************
+ *  SetGpuDriven()
+ *
+ *  This method is used for asking for the GPU driven mode, in
+ *  which the objects are culled by a compute shader and drawn
+ *  with one indirect call.  It only runs when the shader and
+ *  the driver support it.
+ ***********************************************************/
+void SceneManager::SetGpuDriven(bool bGpuDriven)
+{
+	m_bGpuDriven = bGpuDriven;
+}
+
+/***********************************************************
+ *  PrepareObjectBuffer()
+ *
+ *  This method is used for compiling the culling shader and
+ *  uploading the meshes of the GPU driven mode, with one mesh
+ *  range for each combination of cylinder parts.
+ ***********************************************************/
+void SceneManager::PrepareObjectBuffer()
+{
+	std::vector<GLfloat> vertices;
+	std::vector<GLuint> indices;
+
+	m_bObjectBuffer = false;
+	if ((m_bGpuDriven == false) || (m_bMaterialBuffer == false) || (m_uniforms.useObjectBuffer < 0))
+	{
+		return;
+	}
+	if ((IndirectRenderer::IsSupported() == false) ||
+		(UniformCache::BindStorageBlock(g_ObjectBlockName, IndirectRenderer::OBJECT_BLOCK_BINDING) == false))
+	{
+		std::cout << "INFO: the GPU driven mode is not supported, drawing from the render list" << std::endl;
+		return;
+	}
+	if (m_indirectRenderer->Initialize() == false)
+	{
+		return;
+	}
+
+	m_meshLibrary->GetPlaneGeometry(vertices, indices);
+	m_gpuMeshRanges[MESH_PLANE][0] = m_indirectRenderer->AddMesh(vertices, indices);
+	m_meshLibrary->GetBoxGeometry(vertices, indices);
+	m_gpuMeshRanges[MESH_BOX][0] = m_indirectRenderer->AddMesh(vertices, indices);
+	m_meshLibrary->GetSphereGeometry(vertices, indices);
+	m_gpuMeshRanges[MESH_SPHERE][0] = m_indirectRenderer->AddMesh(vertices, indices);
+	for (unsigned int flags = 1; flags <= MESH_DRAW_ALL; flags++)
+	{
+		m_meshLibrary->GetCylinderGeometry(
+			(flags & MESH_DRAW_TOP) != 0,
+			(flags & MESH_DRAW_BOTTOM) != 0,
+			(flags & MESH_DRAW_SIDES) != 0,
+			vertices,
+			indices);
+		m_gpuMeshRanges[MESH_CYLINDER][flags] = m_indirectRenderer->AddMesh(vertices, indices);
+	}
+	m_indirectRenderer->UploadMeshes();
+
+	m_bObjectBuffer = true;
+}
+
+/***********************************************************
+ *  CanDrawIndirect()
+ *
+ *  This method is used for checking whether a draw item can be
+ *  drawn from the object buffer.  The draws run in no fixed
+ *  order, so transparent items stay in the render list, and
+ *  textured items need bindless handles in their records.
+ ***********************************************************/
+bool SceneManager::CanDrawIndirect(const DRAW_ITEM& item)
+{
+	if (item.color.a < 1.0f)
+		return(false);
+	if ((item.textureSlot >= 0) && (m_textureMode != TEXTURE_BINDLESS))
+		return(false);
+	if ((item.meshID == MESH_CYLINDER) && ((item.meshFlags & MESH_DRAW_ALL) == 0))
+		return(false);
+
+	return((item.meshID >= 0) && (item.meshID <= MESH_SPHERE) && (item.meshID != MESH_TORUS));
+}
+
+/***********************************************************
+ *  UpdateObjectBuffer()
+ *
+ *  This method is used for moving the eligible items that were
+ *  added to the render list into the object buffer, and for
+ *  uploading the records of all of the items in it.  The
+ *  records are only written again when items are added or
+ *  their textures finish loading, so the items in the object
+ *  buffer are expected to stay where they are.
+ ***********************************************************/
+void SceneManager::UpdateObjectBuffer()
+{
+	std::vector<DRAW_ITEM> cpuItems;
+	std::vector<IndirectRenderer::OBJECT_RECORD> records;
+
+	for (int i = 0; i < m_renderList.size(); i++)
+	{
+		if (CanDrawIndirect(m_renderList[i]) == true)
+		{
+			m_gpuItems.push_back(m_renderList[i]);
+		}
+		else
+		{
+			cpuItems.push_back(m_renderList[i]);
+		}
+	}
+	if (cpuItems.size() != m_renderList.size())
+	{
+		m_renderList.swap(cpuItems);
+		m_bRenderListDirty = true;
+	}
+
+	records.resize(m_gpuItems.size());
+	for (int i = 0; i < m_gpuItems.size(); i++)
+	{
+		DRAW_ITEM& item = m_gpuItems[i];
+		IndirectRenderer::OBJECT_RECORD& record = records[i];
+
+		item.transform.Update();
+		FrustumCuller::BOUNDS bounds = FrustumCuller::TransformBounds(
+			GetMeshBounds(item.meshID), item.transform.GetModelMatrix());
+
+		record.model = item.transform.GetModelMatrix();
+		record.color = item.color;
+		record.boundsMin = glm::vec4(bounds.min, 1.0f);
+		record.boundsMax = glm::vec4(bounds.max, 1.0f);
+		record.textureHandle[0] = 0;
+		record.textureHandle[1] = 0;
+		record.uvScale = item.uvScale;
+		record.materialIndex = (item.materialID >= 0) ? item.materialID : 0;
+		record.meshRange = (GLuint)m_gpuMeshRanges[item.meshID][(item.meshID == MESH_CYLINDER) ? (item.meshFlags & MESH_DRAW_ALL) : 0];
+		record.useTexture = 0;
+		record.padding = 0;
+
+		// textures that are still loading are drawn untextured
+		if ((item.textureSlot >= 0) && (m_textureIDs[item.textureSlot].bReady == true))
+		{
+			GLuint64 handle = m_textureIDs[item.textureSlot].handle;
+			record.textureHandle[0] = (GLuint)(handle & 0xffffffff);
+			record.textureHandle[1] = (GLuint)(handle >> 32);
+			record.useTexture = 1;
+		}
+	}
+	m_indirectRenderer->SetObjects(records);
+
+	m_bObjectBufferDirty = false;
+}
+
+/***********************************************************
+ *  SubmitObjectBuffer()
+ *
+ *  This method is used for culling the object buffer against
+ *  the view frustum on the GPU, and drawing the visible
+ *  objects with one indirect call.
+ ***********************************************************/
+void SceneManager::SubmitObjectBuffer(bool bCull)
+{
+	if ((m_bObjectBuffer == false) || (m_indirectRenderer->GetObjectCount() == 0))
+	{
+		return;
+	}
+
+	if (bCull == true)
+	{
+		if (m_bOcclusionCulling == true)
+		{
+			m_indirectRenderer->SetOcclusion(m_occlusionCuller->GetPyramidTexture(),
+				m_occlusionCuller->GetPyramidLevels(), m_occlusionCuller->GetPyramidViewProjection());
+		}
+		m_indirectRenderer->Cull(m_frustumCuller.GetPlanes());
+	}
+
+	ApplyDrawPath(false, false, true);
+	m_indirectRenderer->Draw();
+
+	m_renderStats.drawCalls++;
+	m_renderStats.gpuDrivenObjects = m_indirectRenderer->GetObjectCount();
+}
+
+/***********************************************************
+ *  SortRenderList()
+ *
+ *  This method is used for sorting the render list by shader
+ *  state, then texture, then mesh, so that consecutive items
+ *  share as much state as possible.  Transparent items are
+ *  kept last and in their recorded order for blending.
+ ***********************************************************/
+void SceneManager::SortRenderList()
+{
+	std::stable_sort(m_renderList.begin(), m_renderList.end(),
+		[](const DRAW_ITEM& a, const DRAW_ITEM& b)
+		{
+			bool bTransparentA = (a.color.a < 1.0f);
+			bool bTransparentB = (b.color.a < 1.0f);
+			if (bTransparentA != bTransparentB)
+				return(bTransparentB);
+			if (bTransparentA == true)
+				return(false);
+
+			bool bTexturedA = (a.textureSlot >= 0);
+			bool bTexturedB = (b.textureSlot >= 0);
+			if (bTexturedA != bTexturedB)
+				return(bTexturedA);
+			if (a.materialID != b.materialID)
+				return(a.materialID < b.materialID);
+			if (a.textureSlot != b.textureSlot)
+				return(a.textureSlot < b.textureSlot);
+			if (a.meshID != b.meshID)
+				return(a.meshID < b.meshID);
+			if (a.meshFlags != b.meshFlags)
+				return(a.meshFlags < b.meshFlags);
+
+			// objects of one color are kept together, so the color
+			// uniform changes less often between single draws
+			for (int i = 0; i < 4; i++)
+			{
+				if (a.color[i] != b.color[i])
+					return(a.color[i] < b.color[i]);
+			}
+			return(false);
+		});
+
+	m_bRenderListDirty = false;
+}
+
+/***********************************************************
+ *  UpdateTransforms()
+ *
+ *  This method is used for recomputing the model matrices of
+ *  the render list items whose transformation values changed
+ *  since the last frame.  Static objects are composed once.
+ *  It returns true when any of the matrices changed.
+ ***********************************************************/
+bool SceneManager::UpdateTransforms()
+{
+	int itemCount = (int)m_renderList.size();
+	int chunkCount = JobSystem::GetChunkCount(itemCount, g_JobGrainSize);
+
+	// each job finds and composes the dirty transforms of its own
+	// chunk of the list into its own lists
+	m_chunkTransforms.resize(chunkCount);
+	m_chunkDirtyItems.resize(chunkCount);
+	JobSystem::ParallelFor(itemCount, g_JobGrainSize,
+		[&](int begin, int end)
+		{
+			int chunk = begin / g_JobGrainSize;
+			std::vector<Transform*>& transforms = m_chunkTransforms[chunk];
+			std::vector<int>& dirtyItems = m_chunkDirtyItems[chunk];
+			transforms.clear();
+			dirtyItems.clear();
+			for (int i = begin; i < end; i++)
+			{
+				if (m_renderList[i].transform.IsDirty() == true)
+				{
+					transforms.push_back(&m_renderList[i].transform);
+					dirtyItems.push_back(i);
+				}
+			}
+			if (transforms.size() > 0)
+			{
+				Transform::UpdateBatch(transforms.data(), (int)transforms.size());
+			}
+		});
+
+	// the chunks are merged in order, keeping the items ascending
+	m_dirtyItems.clear();
+	for (int i = 0; i < chunkCount; i++)
+	{
+		m_dirtyItems.insert(m_dirtyItems.end(), m_chunkDirtyItems[i].begin(), m_chunkDirtyItems[i].end());
+	}
+
+	if (m_dirtyItems.size() == 0)
+	{
+		return(false);
+	}
+
+	// the boxes of a list that is about to be sorted are all
+	// recomputed after sorting
+	if ((m_bRenderListDirty == false) && (m_itemBounds.size() == m_renderList.size()))
+	{
+		JobSystem::ParallelFor((int)m_dirtyItems.size(), g_JobGrainSize,
+			[&](int begin, int end)
+			{
+				for (int i = begin; i < end; i++)
+				{
+					UpdateItemBounds(m_dirtyItems[i]);
+				}
+			});
+		m_frustumCuller.Refit(m_itemBounds);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  UpdateItemBounds()
+ *
+ *  This method is used for recomputing the world space box of
+ *  one render list item from its mesh and model matrix.
+ ***********************************************************/
+void SceneManager::UpdateItemBounds(int itemIndex)
+{
+	const DRAW_ITEM& item = m_renderList[itemIndex];
+	m_itemBounds[itemIndex] = FrustumCuller::TransformBounds(
+		GetMeshBounds(item.meshID), item.transform.GetModelMatrix());
+}
+
+/***********************************************************
+ *  CullRenderList()
+ *
+ *  This method is used for collecting the render list items
+ *  whose boxes are inside the view frustum.  Every item is
+ *  visible until a view-projection matrix has been set.  It
+ *  returns true when the visible items changed since the
+ *  last frame.
+ ***********************************************************/
+bool SceneManager::CullRenderList()
+{
+	m_lastVisibleItems.swap(m_visibleItems);
+
+	if (m_bFrustumCulling == true)
+	{
+		m_frustumCuller.Query(m_visibleItems);
+	}
+	else
+	{
+		m_visibleItems.resize(m_renderList.size());
+		for (int i = 0; i < m_visibleItems.size(); i++)
+		{
+			m_visibleItems[i] = i;
+		}
+	}
+
+	m_renderStats.culledObjects = (int)(m_renderList.size() - m_visibleItems.size());
+
+	m_renderStats.occludedObjects = 0;
+	if ((m_bOcclusionCulling == true) && (m_bFrustumCulling == true))
+	{
+		m_occlusionCuller->ReadBack();
+		RemoveOccludedItems();
+	}
+
+	return(m_visibleItems != m_lastVisibleItems);
+}
+
+/***********************************************************
+ *  RemoveOccludedItems()
+ *
+ *  This method is used for dropping the visible items whose
+ *  boxes are hidden in the CPU copy of the depth pyramid.
+ *  The jobs only read the pyramid and the boxes, and the
+ *  items are kept in ascending order.
+ ***********************************************************/
+void SceneManager::RemoveOccludedItems()
+{
+	int visibleCount = (int)m_visibleItems.size();
+
+	m_itemOccluded.resize(visibleCount);
+	JobSystem::ParallelFor(visibleCount, g_JobGrainSize,
+		[&](int begin, int end)
+		{
+			for (int i = begin; i < end; i++)
+			{
+				m_itemOccluded[i] = m_occlusionCuller->IsOccluded(m_itemBounds[m_visibleItems[i]]) ? 1 : 0;
+			}
+		});
+
+	int keptCount = 0;
+	for (int i = 0; i < visibleCount; i++)
+	{
+		if (m_itemOccluded[i] == 0)
+		{
+			m_visibleItems[keptCount++] = m_visibleItems[i];
+		}
+	}
+	m_visibleItems.resize(keptCount);
+
+	m_renderStats.occludedObjects = visibleCount - keptCount;
+}
+
+/***********************************************************
+ *  PrepareOcclusionCulling()
+ *
+ *  This method is used for compiling the depth pyramid shader
+ *  when occlusion culling was asked for and the driver can
+ *  run it.
+ ***********************************************************/
+void SceneManager::PrepareOcclusionCulling()
+{
+	m_bOcclusionCulling = false;
+	if (m_bOcclusion == false)
+	{
+		return;
+	}
+	if (OcclusionCuller::IsSupported() == false)
+	{
+		std::cout << "INFO: occlusion culling is not supported, culling by the view frustum only" << std::endl;
+		return;
+	}
+
+	if (NULL == m_occlusionCuller)
+	{
+		m_occlusionCuller = new OcclusionCuller();
+	}
+	m_bOcclusionCulling = m_occlusionCuller->Initialize();
+}
+
+/***********************************************************
+ *  SetOcclusionCulling()
+ *
+ *  This method is used for asking for occlusion culling, in
+ *  which the objects hidden in the depth of the past frames
+ *  are not drawn.  It only runs when the driver supports it.
+ ***********************************************************/
+void SceneManager::SetOcclusionCulling(bool bOcclusion)
+{
+	m_bOcclusion = bOcclusion;
+}
+
+/***********************************************************
+ *  PrepareShadowMaps()
+ *
+ *  This method is used for creating the shadow maps when they
+ *  were asked for and every program samples them.
+ ***********************************************************/
+void SceneManager::PrepareShadowMaps()
+{
+	if (m_bShadows == false)
+	{
+		return;
+	}
+	if (m_bShadowMaps == false)
+	{
+		std::cout << "INFO: shadow maps need the " << g_ShadowBlockName << " and " << g_ShadowMapsName
+			<< " of the shader, drawing without shadows" << std::endl;
+		return;
+	}
+
+	if (NULL == m_shadowMaps)
+	{
+		m_shadowMaps = new ShadowMaps();
+	}
+	m_bShadowMaps = m_shadowMaps->Initialize();
+	m_bShadowCastersDirty = true;
+}
+
+/***********************************************************
+ *  SetShadows()
+ *
+ *  This method is used for asking for the shadows of the spot
+ *  light and the directional light.  They are only drawn when
+ *  the shader declares the shadow block and maps.
+ ***********************************************************/
+void SceneManager::SetShadows(bool bShadows)
+{
+	m_bShadows = bShadows;
+}
+
+/***********************************************************
+ *  UpdateShadowCasters()
+ *
+ *  This method is used for collecting the opaque objects of
+ *  the render list, the static batches and the object buffer
+ *  as the casters of the shadow maps, and building the
+ *  hierarchy over their boxes.  Transparent objects cast no
+ *  shadows.
+ ***********************************************************/
+void SceneManager::UpdateShadowCasters()
+{
+	const std::vector<DRAW_ITEM>* itemLists[3] = { &m_renderList, &m_staticItems, &m_gpuItems };
+
+	m_shadowCasters.clear();
+	m_casterBounds.clear();
+	for (int list = 0; list < 3; list++)
+	{
+		for (int i = 0; i < itemLists[list]->size(); i++)
+		{
+			const DRAW_ITEM& item = (*itemLists[list])[i];
+			if (item.color.a < 1.0f)
+			{
+				continue;
+			}
+
+			// the items moved out of the render list kept their
+			// transforms, which may not have been composed yet
+			Transform transform = item.transform;
+			transform.Update();
+
+			SHADOW_CASTER caster;
+			caster.model = transform.GetModelMatrix();
+			caster.meshID = item.meshID;
+			caster.meshFlags = item.meshFlags;
+			m_shadowCasters.push_back(caster);
+			m_casterBounds.push_back(FrustumCuller::TransformBounds(GetMeshBounds(item.meshID), caster.model));
+		}
+	}
+	m_casterCuller.Build(m_casterBounds);
+
+	if (m_casterBounds.size() > 0)
+	{
+		FrustumCuller::BOUNDS sceneBounds = m_casterBounds[0];
+		for (int i = 1; i < m_casterBounds.size(); i++)
+		{
+			sceneBounds.min = glm::min(sceneBounds.min, m_casterBounds[i].min);
+			sceneBounds.max = glm::max(sceneBounds.max, m_casterBounds[i].max);
+		}
+		m_shadowMaps->SetCasterBounds(sceneBounds);
+	}
+	m_shadowMaps->Invalidate();
+}
+
+/***********************************************************
+ *  UpdateShadowMaps()
+ *
+ *  This method is used for drawing the shadow maps that are
+ *  out of date, with the casters culled against each map.
+ *  The first light is the spot light and the second one the
+ *  light of the cascades, as set up by SetupSceneLights, and
+ *  a light without a direction casts no shadows.  Most frames
+ *  draw no map at all and only bind the cached ones.
+ ***********************************************************/
+void SceneManager::UpdateShadowMaps()
+{
+	if (m_bShadowCastersDirty == true)
+	{
+		UpdateShadowCasters();
+		m_bShadowCastersDirty = false;
+	}
+
+	glm::vec3 defaultDirection(0.0f, -1.0f, 0.0f);
+	bool bSpotLight = (m_lightSources.size() > 0) && (glm::length(m_lightSources[0].direction) > 0.0f);
+	bool bCascadeLight = (m_lightSources.size() > 1) && (glm::length(m_lightSources[1].direction) > 0.0f);
+	m_shadowMaps->SetLights(
+		bCascadeLight ? 1 : -1, bCascadeLight ? m_lightSources[1].direction : defaultDirection,
+		bSpotLight ? 0 : -1, bSpotLight ? m_lightSources[0].position : glm::vec3(0.0f),
+		bSpotLight ? m_lightSources[0].direction : defaultDirection);
+	if (m_bClusterView == true)
+	{
+		m_shadowMaps->SetView(m_clusterView, m_clusterProjection, m_clusterNearPlane, m_clusterFarPlane);
+	}
+
+	int drawCalls = 0;
+	m_renderStats.shadowMapsDrawn = m_shadowMaps->PrepareLayers();
+	for (int layer = 0; (layer < ShadowMaps::LAYER_COUNT) && (m_renderStats.shadowMapsDrawn > 0); layer++)
+	{
+		if (m_shadowMaps->IsLayerStale(layer) == false)
+		{
+			continue;
+		}
+
+		m_shadowMaps->BeginLayer(layer);
+		m_casterCuller.SetFrustum(m_shadowMaps->GetLayerViewProjection(layer));
+		m_casterCuller.Query(m_layerCasters);
+		for (int i = 0; i < m_layerCasters.size(); i++)
+		{
+			const SHADOW_CASTER& caster = m_shadowCasters[m_layerCasters[i]];
+			m_shadowMaps->SetCasterModel(caster.model);
+			DrawItemMesh(caster.meshID, caster.meshFlags);
+		}
+		drawCalls += (int)m_layerCasters.size();
+	}
+	m_shadowMaps->EndLayers();
+
+	m_renderStats.shadowDrawCalls = drawCalls;
+	m_renderStats.drawCalls += drawCalls;
+}
+
+/***********************************************************
+ *  SetViewProjection()
+ *
+ *  This method is used for setting the view and projection
+ *  matrices that the render list is culled against, which
+ *  turns on the view frustum culling.
+ ***********************************************************/
+void SceneManager::SetViewProjection(const glm::mat4& viewProjection)
+{
+	m_frustumCuller.SetFrustum(viewProjection);
+	m_viewProjection = viewProjection;
+	m_bFrustumCulling = true;
+}
+
+/***********************************************************
+ *  SelectLevelsOfDetail()
+ *
+ *  This method is used for picking the level of detail of
+ *  every visible item from the projected size of its bounding
+ *  sphere.  Only the MeshLibrary meshes have coarser levels,
+ *  and they are only drawn when the shader supports instancing.
+ *  It returns true when any of the levels changed.
+ ***********************************************************/
+bool SceneManager::SelectLevelsOfDetail()
+{
+	int visibleCount = (int)m_visibleItems.size();
+	int chunkCount = JobSystem::GetChunkCount(visibleCount, g_JobGrainSize);
+
+	// each job counts into its own entries, which are added up
+	// once all of the jobs are done
+	std::vector<int> chunkReduced(chunkCount, 0);
+	std::vector<char> chunkChanged(chunkCount, 0);
+	JobSystem::ParallelFor(visibleCount, g_JobGrainSize,
+		[&](int begin, int end)
+		{
+			int chunk = begin / g_JobGrainSize;
+			for (int i = begin; i < end; i++)
+			{
+				int itemIndex = m_visibleItems[i];
+				int lod = PickLevelOfDetail(itemIndex);
+
+				if (lod > 0)
+				{
+					chunkReduced[chunk]++;
+				}
+				if (m_itemLods[itemIndex] != lod)
+				{
+					m_itemLods[itemIndex] = lod;
+					chunkChanged[chunk] = 1;
+				}
+			}
+		});
+
+	bool bChanged = false;
+	m_renderStats.reducedDetailObjects = 0;
+	for (int i = 0; i < chunkCount; i++)
+	{
+		m_renderStats.reducedDetailObjects += chunkReduced[i];
+		bChanged = bChanged || (chunkChanged[i] != 0);
+	}
+
+	return(bChanged);
+}
+
+/***********************************************************
+ *  PickLevelOfDetail()
+ *
+ *  This method is used for picking the level of detail of
+ *  one visible item.  It only reads the scene, so the items
+ *  can be picked by several jobs at the same time.
+ ***********************************************************/
+int SceneManager::PickLevelOfDetail(int itemIndex) const
+{
+	const DRAW_ITEM& item = m_renderList[itemIndex];
+	int lod = 0;
+
+	if ((m_bLodSelection == true) && (m_bInstancing == true) &&
+		((item.meshID == MESH_SPHERE) || (item.meshID == MESH_CYLINDER)))
+	{
+		const FrustumCuller::BOUNDS& bounds = m_itemBounds[itemIndex];
+		glm::vec3 center = (bounds.min + bounds.max) * 0.5f;
+		float radius = glm::length(bounds.max - bounds.min) * 0.5f;
+		float distance = glm::length(center - m_lodCameraPosition);
+
+		// objects around the camera always use full detail
+		if (distance > radius)
+		{
+			float pixelSize = radius * m_lodPixelScale / distance;
+			while ((lod < MeshLibrary::LOD_COUNT - 1) && (pixelSize < g_LodPixelSizes[lod]))
+			{
+				lod++;
+			}
+		}
+	}
+
+	return(lod);
+}
+
+/***********************************************************
+ *  SetLodView()
+ *
+ *  This method is used for setting the camera position, the
+ *  vertical field of view and the height of the rendered
+ *  image in pixels, which the levels of detail are picked
+ *  for.  A field of view of zero, as for an orthographic
+ *  projection, draws every object at full detail.
+ ***********************************************************/
+void SceneManager::SetLodView(const glm::vec3& cameraPosition, float fieldOfViewDegrees, int viewHeight)
+{
+	m_bLodSelection = (fieldOfViewDegrees > 0.0f) && (viewHeight > 0);
+	m_lodCameraPosition = cameraPosition;
+	m_lodPixelScale = 0.0f;
+	if (m_bLodSelection == true)
+	{
+		// pixels covered by a diameter of one unit at distance one
+		m_lodPixelScale = (float)viewHeight / std::tan(glm::radians(fieldOfViewDegrees) * 0.5f);
+	}
+}
+
+/***********************************************************
+ *  SetClusterView()
+ *
+ *  This method is used for setting the view and projection
+ *  that the lights are assigned to the clusters of in the
+ *  next RenderScene().
+ ***********************************************************/
+void SceneManager::SetClusterView(const glm::mat4& view, const glm::mat4& projection,
+	float nearPlane, float farPlane, int viewWidth, int viewHeight)
+{
+	m_clusterView = view;
+	m_clusterProjection = projection;
+	m_clusterNearPlane = nearPlane;
+	m_clusterFarPlane = farPlane;
+	m_clusterViewWidth = viewWidth;
+	m_clusterViewHeight = viewHeight;
+	m_bClusterView = true;
+}
+
+/***********************************************************
+ *  BuildInstanceGroups()
+ *
+ *  This method is used for splitting the sorted render list
+ *  into groups of identical items, and uploading the model
+ *  matrix and color of every grouped item into the instance
+ *  buffer.  Items that cannot be instanced are in a group of
+ *  their own.  Only the visible items are grouped, so items
+ *  of a group are not always next to each other in the list,
+ *  and each run of identical items is split into one group
+ *  per level of detail.
+ ***********************************************************/
+void SceneManager::BuildInstanceGroups()
+{
+	// render list item of each instance, in instance buffer order
+	std::vector<int> instanceItems;
+	std::vector<MeshLibrary::INSTANCE_DATA> instances;
+
+	m_instanceGroups.clear();
+
+	int index = 0;
+	while (index < m_visibleItems.size())
+	{
+		const DRAW_ITEM& firstItem = m_renderList[m_visibleItems[index]];
+		int runCount = 1;
+
+		while (((index + runCount) < m_visibleItems.size()) &&
+			(CanInstanceTogether(firstItem, m_renderList[m_visibleItems[index + runCount]]) == true))
+		{
+			runCount++;
+		}
+
+		for (int lod = 0; lod < MeshLibrary::LOD_COUNT; lod++)
+		{
+			INSTANCE_GROUP group;
+			group.firstItem = -1;
+			group.itemCount = 0;
+			group.firstInstance = (GLuint)instanceItems.size();
+			group.lod = lod;
+
+			for (int i = 0; i < runCount; i++)
+			{
+				int itemIndex = m_visibleItems[index + i];
+				if (m_itemLods[itemIndex] != lod)
+				{
+					continue;
+				}
+
+				instanceItems.push_back(itemIndex);
+
+				if (group.itemCount == 0)
+				{
+					group.firstItem = itemIndex;
+				}
+				group.itemCount++;
+			}
+
+			if (group.itemCount == 0)
+			{
+				continue;
+			}
+
+			// a single full detail item is drawn with its own matrix
+			group.bInstanced = (group.itemCount > 1) || (lod > 0);
+			if (group.bInstanced == false)
+			{
+				instanceItems.resize(group.firstInstance);
+			}
+			m_instanceGroups.push_back(group);
+		}
+
+		index += runCount;
+	}
+
+	// the instance values are copied out by parallel jobs
+	instances.resize(instanceItems.size());
+	JobSystem::ParallelFor((int)instanceItems.size(), g_JobGrainSize,
+		[&](int begin, int end)
+		{
+			for (int i = begin; i < end; i++)
+			{
+				const DRAW_ITEM& item = m_renderList[instanceItems[i]];
+				instances[i].model = item.transform.GetModelMatrix();
+				instances[i].color = item.color;
+			}
+		});
+
+	m_meshLibrary->SetInstanceData(instances);
+}
+
+/***********************************************************
+ *  CanInstanceTogether()
+ *
+ *  This method is used for checking whether two draw items
+ *  only differ by their model matrix and their color, which
+ *  are both per-instance values, and use a mesh that supports
+ *  instanced drawing.
+ ***********************************************************/
+bool SceneManager::CanInstanceTogether(const DRAW_ITEM& a, const DRAW_ITEM& b)
+{
+	if (m_bInstancing == false)
+		return(false);
+	if ((a.meshID != MESH_SPHERE) && (a.meshID != MESH_CYLINDER))
+		return(false);
+	// transparent items are blended in their recorded order
+	if ((a.color.a < 1.0f) || (b.color.a < 1.0f))
+		return(false);
+
+	return((a.meshID == b.meshID) &&
+		(a.meshFlags == b.meshFlags) &&
+		(a.textureSlot == b.textureSlot) &&
+		(a.uvScale == b.uvScale) &&
+		(a.materialID == b.materialID));
+}
+
+/***********************************************************
+ *  IsItemTextured()
+ *
+ *  This method is used for checking whether an item samples
+ *  its texture this frame.  Textures that are still loading
+ *  are drawn untextured when they cannot show the placeholder
+ *  in their slot.
+ ***********************************************************/
+bool SceneManager::IsItemTextured(const DRAW_ITEM& item)
+{
+	return((item.textureSlot >= 0) && (m_textureIDs[item.textureSlot].bReady == true));
+}
+
+/***********************************************************
+ *  UseItemShaderProgram()
+ *
+ *  This method is used for making the permutation that draws
+ *  the passed in item active.  The render list is sorted with
+ *  the textured items first, so this switches programs only
+ *  a few times each frame.  The depth pre-pass draws every
+ *  item with the cheapest program when it can.
+ ***********************************************************/
+void SceneManager::UseItemShaderProgram(const DRAW_ITEM& item)
+{
+	if ((m_bDepthPass == true) && (m_bDepthProgram == true))
+	{
+		UseShaderProgram(SHADER_DEPTH);
+		return;
+	}
+
+	UseShaderProgram(IsItemTextured(item) ? SHADER_TEXTURED : SHADER_UNTEXTURED);
+}
+
+/***********************************************************
+ *  ApplyDrawState()
+ *
+ *  This method is used for sending the shader state of the
+ *  passed in draw item.  Values that are already in the
+ *  shader from the previous item are skipped.
+ ***********************************************************/
+void SceneManager::ApplyDrawState(const DRAW_ITEM& item, bool bSendModel)
+{
+	bool bValid = m_bAppliedStateValid;
+	bool bTextured = IsItemTextured(item);
+	int textureSlot = bTextured ? item.textureSlot : -1;
+
+	// every non-instanced item has its own model matrix
+	if (bSendModel == true)
+	{
+		GLState::UniformMatrix4(m_uniforms.model, item.transform.GetModelMatrix());
+		m_renderStats.stateChanges++;
+	}
+
+	if ((bValid == false) || ((m_appliedState.textureSlot >= 0) != bTextured))
+	{
+		GLState::Uniform1i(m_uniforms.useTexture, bTextured);
+		m_renderStats.stateChanges++;
+	}
+	else
+		m_renderStats.stateChangesSkipped++;
+
+	if ((bValid == false) || (m_appliedState.color != item.color))
+	{
+		GLState::Uniform4f(m_uniforms.objectColor, item.color);
+		m_appliedState.color = item.color;
+		m_renderStats.stateChanges++;
+	}
+	else
+		m_renderStats.stateChangesSkipped++;
+
+	// the sampler and UV scale are only read for textured items
+	if (bTextured == true)
+	{
+		if ((bValid == false) || (m_appliedState.textureSlot != textureSlot))
+		{
+			const TEXTURE_INFO& textureInfo = m_textureIDs[textureSlot];
+			if (m_textureMode == TEXTURE_BINDLESS)
+			{
+				GLState::Uniform2ui(m_uniforms.textureHandle, (GLuint)(textureInfo.handle & 0xffffffff), (GLuint)(textureInfo.handle >> 32));
+			}
+			else if (m_textureMode == TEXTURE_ARRAYS)
+			{
+				GLState::Uniform1i(m_uniforms.textureArray, textureInfo.arrayUnit);
+				GLState::Uniform1i(m_uniforms.textureLayer, textureInfo.layer);
+			}
+			else
+			{
+				GLState::Uniform1i(m_uniforms.objectTexture, textureSlot);
+			}
+			m_renderStats.stateChanges++;
+		}
+		else
+			m_renderStats.stateChangesSkipped++;
+
+		if ((bValid == false) || (m_appliedState.uvScale != item.uvScale))
+		{
+			GLState::Uniform2f(m_uniforms.uvScale, item.uvScale);
+			m_appliedState.uvScale = item.uvScale;
+			m_renderStats.stateChanges++;
+		}
+		else
+			m_renderStats.stateChangesSkipped++;
+	}
+	m_appliedState.textureSlot = textureSlot;
+
+	// items recorded before any material keep the current one
+	if (item.materialID >= 0)
+	{
+		if ((bValid == false) || (m_appliedState.materialID != item.materialID))
+		{
+			ApplyShaderMaterial(item.materialID);
+			m_appliedState.materialID = item.materialID;
+			m_renderStats.stateChanges++;
+		}
+		else
+			m_renderStats.stateChangesSkipped++;
+	}
+
+	m_bAppliedStateValid = true;
+}
+
+/***********************************************************
+ *  ApplyDrawPath()
+ *
+ *  This method is used for telling the shader where the next
+ *  draw reads its per-object values from.  The flags stay set
+ *  between draws, so a run of draws on the same path only
+ *  sends them once.
+ ***********************************************************/
+void SceneManager::ApplyDrawPath(bool bInstancing, bool bStaticBatch, bool bObjectBuffer)
+{
+	GLState::Uniform1i(m_uniforms.useInstancing, bInstancing);
+	GLState::Uniform1i(m_uniforms.useStaticBatch, bStaticBatch);
+	GLState::Uniform1i(m_uniforms.useObjectBuffer, bObjectBuffer);
+}
+
+/***********************************************************
+ *  SubmitDrawItem()
+ *
+ *  This method is used for sending the shader state of the
+ *  passed in draw item and drawing its mesh.
+ ***********************************************************/
+void SceneManager::SubmitDrawItem(const DRAW_ITEM& item)
+{
+	UseItemShaderProgram(item);
+	ApplyDrawState(item, true);
+	ApplyDrawPath(false, false, false);
+
+	DrawItemMesh(item.meshID, item.meshFlags);
+	m_renderStats.drawCalls++;
+}
+
+/***********************************************************
+ *  DrawItemMesh()
+ *
+ *  This method is used for drawing the full detail mesh of a
+ *  mesh ID and its cylinder part flags, with the shader state
+ *  already sent.
+ ***********************************************************/
+void SceneManager::DrawItemMesh(int meshID, unsigned int meshFlags)
+{
+	// all of the meshes but the torus share the vertex array of
+	// the mesh library, so consecutive draws bind nothing
+	switch (meshID)
+	{
+	case MESH_PLANE:
+		m_meshLibrary->DrawPlaneMesh();
+		break;
+	case MESH_BOX:
+		m_meshLibrary->DrawBoxMesh();
+		break;
+	case MESH_CYLINDER:
+		m_meshLibrary->DrawCylinderMesh(
+			(meshFlags & MESH_DRAW_TOP) != 0,
+			(meshFlags & MESH_DRAW_BOTTOM) != 0,
+			(meshFlags & MESH_DRAW_SIDES) != 0);
+		break;
+	case MESH_TORUS:
+		m_basicMeshes->DrawTorusMesh();
+		// ShapeMeshes binds its vertex arrays itself
+		GLState::InvalidateVertexArray();
+		break;
+	case MESH_SPHERE:
+		m_meshLibrary->DrawSphereMesh();
+		break;
+	}
+}
+
+/***********************************************************
+ *  SubmitInstanceGroup()
+ *
+ *  This method is used for drawing every item of an instance
+ *  group with one instanced draw call, with the shader reading
+ *  the model matrices from the instance buffer.
+ ***********************************************************/
+void SceneManager::SubmitInstanceGroup(const INSTANCE_GROUP& group)
+{
+	const DRAW_ITEM& item = m_renderList[group.firstItem];
+
+	UseItemShaderProgram(item);
+	ApplyDrawState(item, false);
+	ApplyDrawPath(true, false, false);
+
+	if (item.meshID == MESH_SPHERE)
+	{
+		m_meshLibrary->DrawSphereMeshInstanced(group.lod, group.itemCount, group.firstInstance);
+	}
+	else
+	{
+		m_meshLibrary->DrawCylinderMeshInstanced(
+			(item.meshFlags & MESH_DRAW_TOP) != 0,
+			(item.meshFlags & MESH_DRAW_BOTTOM) != 0,
+			(item.meshFlags & MESH_DRAW_SIDES) != 0,
+			group.lod,
+			group.itemCount,
+			group.firstInstance);
+	}
 
-#include <glm/gtx/transform.hpp>
+	m_renderStats.drawCalls++;
+	m_renderStats.instancedObjects += group.itemCount;
+}
 
-// declaration of global variables
-namespace
+/***********************************************************
+ *  SubmitGroup()
+ *
+ *  This method is used for drawing one instance group, and
+ *  adding its time to the Draw* method that recorded its
+ *  first item.
+ ***********************************************************/
+void SceneManager::SubmitGroup(int groupIndex)
 {
-	const char* g_ModelName = "model";
-	const char* g_ColorValueName = "objectColor";
-	const char* g_TextureValueName = "objectTexture";
-	const char* g_UseTextureName = "bUseTexture";
-	const char* g_UseLightingName = "bUseLighting";
+	const INSTANCE_GROUP& group = m_instanceGroups[groupIndex];
+	const DRAW_ITEM& firstItem = m_renderList[group.firstItem];
+	int drawScope = Profiler::GetDrawScopes() ? Profiler::BeginScope(firstItem.sourceName) : -1;
+
+	if (group.bInstanced == true)
+	{
+		SubmitInstanceGroup(group);
+	}
+	else
+	{
+		SubmitDrawItem(firstItem);
+	}
+
+	Profiler::EndScope(drawScope);
 }
 
 /***********************************************************
- *  SceneManager()
+ *  OrderInstanceGroups()
  *
- *  The constructor for the class
+ *  This method is used for counting the opaque groups, which
+ *  come before the transparent ones, and for ordering them
+ *  front to back by the view depth of their first item, from
+ *  the view set by SetClusterView(), so that the order does
+ *  not depend on the level of detail selection.  Near objects
+ *  then fill the depth buffer first and hide the fragments of
+ *  the objects behind them.  While the permutations draw the
+ *  items, texturing stays the first key so that the programs
+ *  only change a few times.
  ***********************************************************/
-SceneManager::SceneManager(ShaderManager *pShaderManager)
+void SceneManager::OrderInstanceGroups()
 {
-	m_pShaderManager = pShaderManager;
-	m_basicMeshes = new ShapeMeshes();
+	m_opaqueGroupCount = 0;
+	while ((m_opaqueGroupCount < m_instanceGroups.size()) &&
+		(m_renderList[m_instanceGroups[m_opaqueGroupCount].firstItem].color.a >= 1.0f))
+	{
+		m_opaqueGroupCount++;
+	}
+
+	m_groupOrder.resize(m_opaqueGroupCount);
+	for (int i = 0; i < m_opaqueGroupCount; i++)
+	{
+		m_groupOrder[i] = i;
+	}
+
+	if ((m_depthMode == DEPTH_STATE_ORDER) || (m_bClusterView == false))
+	{
+		return;
+	}
+
+	m_groupDistances.resize(m_opaqueGroupCount);
+	for (int i = 0; i < m_opaqueGroupCount; i++)
+	{
+		const FrustumCuller::BOUNDS& bounds = m_itemBounds[m_instanceGroups[i].firstItem];
+		glm::vec4 center = m_clusterView * glm::vec4((bounds.min + bounds.max) * 0.5f, 1.0f);
+		m_groupDistances[i] = -center.z;
+	}
+
+	bool bByProgram = (m_bShaderPermutations == true) &&
+		!((m_depthMode == DEPTH_PREPASS) && (m_bDepthProgram == true));
+	std::sort(m_groupOrder.begin(), m_groupOrder.end(),
+		[&](int a, int b)
+		{
+			if (bByProgram == true)
+			{
+				bool bTexturedA = IsItemTextured(m_renderList[m_instanceGroups[a].firstItem]);
+				bool bTexturedB = IsItemTextured(m_renderList[m_instanceGroups[b].firstItem]);
+				if (bTexturedA != bTexturedB)
+					return(bTexturedA);
+			}
+			return(m_groupDistances[a] < m_groupDistances[b]);
+		});
 }
 
 /***********************************************************
- *  ~SceneManager()
+ *  SubmitDepthPrePass()
  *
- *  The destructor for the class
+ *  This method is used for drawing every opaque object into
+ *  the depth buffer only, front to back.  The shading pass
+ *  that follows tests for equal depth without writing it, so
+ *  each visible sample is shaded exactly once.
  ***********************************************************/
-SceneManager::~SceneManager()
+void SceneManager::SubmitDepthPrePass()
 {
-	m_pShaderManager = NULL;
-	delete m_basicMeshes;
-	m_basicMeshes = NULL;
+	int drawCalls = m_renderStats.drawCalls;
+
+	m_bDepthPass = true;
+	GLState::ColorMask(GL_FALSE);
+	GLState::DepthMask(GL_TRUE);
+	GLState::DepthFunc(GL_LESS);
+
+	SubmitStaticBatches();
+	SubmitObjectBuffer(true);
+	for (int i = 0; i < m_opaqueGroupCount; i++)
+	{
+		SubmitGroup(m_groupOrder[i]);
+	}
+	UseShaderProgram(SHADER_GENERIC);
+
+	GLState::ColorMask(GL_TRUE);
+	GLState::DepthMask(GL_FALSE);
+	GLState::DepthFunc(GL_EQUAL);
+	m_bDepthPass = false;
+
+	m_renderStats.prePassDrawCalls = m_renderStats.drawCalls - drawCalls;
 }
 
 /***********************************************************
- *  CreateGLTexture()
+ *  BeginOverdrawQuery()
  *
- *  This method is used for loading textures from image files,
- *  configuring the texture mapping parameters in OpenGL,
- *  generating the mipmaps, and loading the read texture into
- *  the next available texture slot in memory.
+ *  This method is used for counting the samples that pass the
+ *  depth test in the shading pass.  The query of each frame
+ *  is read a few frames later, once the GPU has finished it,
+ *  so the counter never waits for the GPU.
  ***********************************************************/
-bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
+void SceneManager::BeginOverdrawQuery()
 {
-	int width = 0;
-	int height = 0;
-	int colorChannels = 0;
-	GLuint textureID = 0;
-
-	// indicate to always flip images vertically when loaded
-	stbi_set_flip_vertically_on_load(true);
-
-	// try to parse the image data from the specified image file
-	unsigned char* image = stbi_load(
-		filename,
-		&width,
-		&height,
-		&colorChannels,
-		0);
-
-	// if the image was successfully read from the image file
-	if (image)
-	{
-		std::cout << "Successfully loaded image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
-
-		glGenTextures(1, &textureID);
-		glBindTexture(GL_TEXTURE_2D, textureID);
-
-		// set the texture wrapping parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		// set texture filtering parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// if the loaded image is in RGB format
-		if (colorChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-		// if the loaded image is in RGBA format - it supports transparency
-		else if (colorChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-		else
+	if (0 == m_overdrawQueries[0])
+	{
+		glGenQueries(OVERDRAW_QUERY_COUNT, m_overdrawQueries);
+	}
+
+	GLuint query = m_overdrawQueries[m_overdrawFrame % OVERDRAW_QUERY_COUNT];
+	if (m_overdrawFrame >= OVERDRAW_QUERY_COUNT)
+	{
+		GLuint available = 0;
+		glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available != 0)
 		{
-			std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
-			return false;
+			GLuint64 samples = 0;
+			glGetQueryObjectui64v(query, GL_QUERY_RESULT, &samples);
+			m_shadedSamples = (long long)samples;
 		}
+	}
 
-		// generate the texture mipmaps for mapping textures to lower resolutions
-		glGenerateMipmap(GL_TEXTURE_2D);
+	m_renderStats.shadedSamples = m_shadedSamples;
+	long long pixels = (long long)m_clusterViewWidth * (long long)m_clusterViewHeight;
+	m_renderStats.shadedSamplesPerPixel = (pixels > 0) ? (float)((double)m_shadedSamples / (double)pixels) : 0.0f;
 
-		// free the image data from local memory
-		stbi_image_free(image);
-		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+	glBeginQuery(GL_SAMPLES_PASSED, query);
+}
 
-		// register the loaded texture and associate it with the special tag string
-		m_textureIDs[m_loadedTextures].ID = textureID;
-		m_textureIDs[m_loadedTextures].tag = tag;
-		m_loadedTextures++;
+/***********************************************************
+ *  EndOverdrawQuery()
+ *
+ *  This method is used for ending the query of this frame.
+ ***********************************************************/
+void SceneManager::EndOverdrawQuery()
+{
+	glEndQuery(GL_SAMPLES_PASSED);
+	m_overdrawFrame++;
+}
 
-		return true;
-	}
+/***********************************************************
+ *  SetDepthMode()
+ *
+ *  This method is used for picking the order of the opaque
+ *  objects and whether they are drawn into the depth buffer
+ *  before they are shaded.  It is called before PrepareScene(),
+ *  since the front to back order leaves out the static batches.
+ ***********************************************************/
+void SceneManager::SetDepthMode(DEPTH_MODE depthMode)
+{
+	m_depthMode = depthMode;
+}
 
-	std::cout << "Could not load image:" << filename << std::endl;
+/***********************************************************
+ *  GetRenderStats()
+ *
+ *  This method is used for getting the draw call and state
+ *  change counters of the last rendered frame.
+ ***********************************************************/
+const SceneManager::RENDER_STATS& SceneManager::GetRenderStats() const
+{
+	return(m_renderStats);
+}
 
-	// Error loading the image
-	return false;
+/***********************************************************
+ *  GetPendingTextureCount()
+ *
+ *  This method is used for getting the number of scene
+ *  textures that are still being decoded or uploaded.
+ ***********************************************************/
+int SceneManager::GetPendingTextureCount()
+{
+	return(m_textureLoader->GetPendingCount());
 }
 
 /***********************************************************
- *  BindGLTextures()
+ *  SetSceneFile()
  *
- *  This method is used for binding the loaded textures to
- *  OpenGL texture memory slots.  There are up to 16 slots.
+ *  This method is used for setting a scene file that is loaded
+ *  by PrepareScene() in place of the objects, materials,
+ *  textures and lights defined in the code.
  ***********************************************************/
-void SceneManager::BindGLTextures()
+void SceneManager::SetSceneFile(const char* filename)
 {
-	for (int i = 0; i < m_loadedTextures; i++)
-	{
-		// bind textures on corresponding texture units
-		glActiveTexture(GL_TEXTURE0 + i);
-		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
-	}
+	m_sceneFilename = (NULL != filename) ? filename : "";
 }
 
 /***********************************************************
- *  DestroyGLTextures()
+ *  SetHotReload()
  *
- *  This method is used for freeing the memory in all the
- *  used texture memory slots.
+ *  This method is used for watching the scene file and the
+ *  texture images once the scene is prepared, and patching
+ *  their changes into the running scene.  The materials and
+ *  objects defined in the code can be edited this way after
+ *  writing them into a scene file with SaveSceneFile().
  ***********************************************************/
-void SceneManager::DestroyGLTextures()
+void SceneManager::SetHotReload(bool bHotReload)
 {
-	for (int i = 0; i < m_loadedTextures; i++)
-	{
-		glGenTextures(1, &m_textureIDs[i].ID);
-	}
+	m_bHotReload = bHotReload;
 }
 
 /***********************************************************
- *  FindTextureID()
+ *  SaveSceneFile()
  *
- *  This method is used for getting an ID for the previously
- *  loaded texture bitmap associated with the passed in tag.
+ *  This method is used for writing the prepared scene into a
+ *  scene file, which turns the scene defined in the code into
+ *  a starting point for editing or for the binary form.
  ***********************************************************/
-int SceneManager::FindTextureID(std::string tag)
+bool SceneManager::SaveSceneFile(const char* filename)
 {
-	int textureID = -1;
-	int index = 0;
-	bool bFound = false;
+	SceneFile sceneFile;
 
-	while ((index < m_loadedTextures) && (bFound == false))
+	// the file records keep the order of the texture slots and
+	// material indices, so the item handles are used as they are
+	for (int i = 0; i < m_textureIDs.size(); i++)
 	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureID = m_textureIDs[index].ID;
-			bFound = true;
-		}
-		else
-			index++;
+		SceneFile::SCENE_TEXTURE texture;
+		SceneFile::CopyName(texture.tag, m_textureIDs[i].tag, SceneFile::MAX_TAG_LENGTH);
+		SceneFile::CopyName(texture.filename, m_textureIDs[i].filename, SceneFile::MAX_FILENAME_LENGTH);
+		sceneFile.AddTexture(texture);
+	}
+
+	for (int i = 0; i < m_objectMaterials.size(); i++)
+	{
+		const OBJECT_MATERIAL& source = m_objectMaterials[i];
+		SceneFile::SCENE_MATERIAL material;
+		SceneFile::CopyName(material.tag, source.tag, SceneFile::MAX_TAG_LENGTH);
+		memcpy(material.ambientColor, glm::value_ptr(source.ambientColor), sizeof(material.ambientColor));
+		material.ambientStrength = source.ambientStrength;
+		memcpy(material.diffuseColor, glm::value_ptr(source.diffuseColor), sizeof(material.diffuseColor));
+		memcpy(material.specularColor, glm::value_ptr(source.specularColor), sizeof(material.specularColor));
+		material.shininess = source.shininess;
+		sceneFile.AddMaterial(material);
+	}
+
+	for (int i = 0; i < m_lightSources.size(); i++)
+	{
+		const LIGHT_SOURCE& source = m_lightSources[i];
+		SceneFile::SCENE_LIGHT light;
+		memcpy(light.position, glm::value_ptr(source.position), sizeof(light.position));
+		memcpy(light.direction, glm::value_ptr(source.direction), sizeof(light.direction));
+		memcpy(light.ambientColor, glm::value_ptr(source.ambientColor), sizeof(light.ambientColor));
+		memcpy(light.diffuseColor, glm::value_ptr(source.diffuseColor), sizeof(light.diffuseColor));
+		memcpy(light.specularColor, glm::value_ptr(source.specularColor), sizeof(light.specularColor));
+		light.focalStrength = source.focalStrength;
+		light.specularIntensity = source.specularIntensity;
+		sceneFile.AddLight(light);
+	}
+
+	// the merged static and GPU driven items are saved along
+	// with the others
+	std::vector<const DRAW_ITEM*> items;
+	for (int i = 0; i < m_staticItems.size(); i++)
+	{
+		items.push_back(&m_staticItems[i]);
+	}
+	for (int i = 0; i < m_gpuItems.size(); i++)
+	{
+		items.push_back(&m_gpuItems[i]);
+	}
+	for (int i = 0; i < m_renderList.size(); i++)
+	{
+		items.push_back(&m_renderList[i]);
+	}
+
+	for (int i = 0; i < items.size(); i++)
+	{
+		const DRAW_ITEM& item = *items[i];
+		SceneFile::SCENE_OBJECT object;
+		object.meshID = item.meshID;
+		object.meshFlags = item.meshFlags;
+		glm::vec3 scale = item.transform.GetScale();
+		glm::vec3 rotation = item.transform.GetRotation();
+		glm::vec3 position = item.transform.GetPosition();
+		memcpy(object.scale, glm::value_ptr(scale), sizeof(object.scale));
+		memcpy(object.rotationDegrees, glm::value_ptr(rotation), sizeof(object.rotationDegrees));
+		memcpy(object.position, glm::value_ptr(position), sizeof(object.position));
+		memcpy(object.color, glm::value_ptr(item.color), sizeof(object.color));
+		object.textureIndex = item.textureSlot;
+		memcpy(object.uvScale, glm::value_ptr(item.uvScale), sizeof(object.uvScale));
+		object.materialIndex = item.materialID;
+		sceneFile.AddObject(object);
+	}
+
+	if (sceneFile.Save(filename) == false)
+	{
+		return(false);
 	}
 
-	return(textureID);
+	std::cout << "INFO: saved scene file " << filename << " with " << items.size() << " objects" << std::endl;
+	return(true);
 }
 
 /***********************************************************
- *  FindTextureSlot()
+ *  AddSyntheticObjects()
  *
- *  This method is used for getting a slot index for the previously
- *  loaded texture bitmap associated with the passed in tag.
+ *  This method is used for adding a square grid of generated
+ *  spheres, cylinders and boxes over the countertop, so that
+ *  the renderer can be measured with much larger scenes than
+ *  the kitchen scene.  The colors and materials repeat, which
+ *  gives both instanced groups and single draws.
  ***********************************************************/
-int SceneManager::FindTextureSlot(std::string tag)
+void SceneManager::AddSyntheticObjects(int objectCount)
 {
-	int textureSlot = -1;
-	int index = 0;
-	bool bFound = false;
+	const glm::vec4 palette[4] = {
+		glm::vec4(0.8f, 0.2f, 0.2f, 1.0f),
+		glm::vec4(0.2f, 0.7f, 0.3f, 1.0f),
+		glm::vec4(0.2f, 0.4f, 0.8f, 1.0f),
+		glm::vec4(0.9f, 0.8f, 0.3f, 1.0f)
+	};
+	const int meshes[3] = { MESH_SPHERE, MESH_CYLINDER, MESH_BOX };
 
-	while ((index < m_loadedTextures) && (bFound == false))
+	if (objectCount <= 0)
 	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureSlot = index;
-			bFound = true;
-		}
-		else
-			index++;
+		return;
+	}
+
+	int gridSize = 1;
+	while (gridSize * gridSize < objectCount)
+	{
+		gridSize++;
+	}
+
+	// the grid covers the 15 x 12 countertop
+	float spacingX = 15.0f / (float)gridSize;
+	float spacingZ = 12.0f / (float)gridSize;
+	float objectSize = 0.4f * ((spacingX < spacingZ) ? spacingX : spacingZ);
+	int materialCount = (int)m_objectMaterials.size();
+
+	m_recordState.sourceName = "SyntheticObjects";
+	m_recordState.textureSlot = -1;
+	m_recordState.uvScale = glm::vec2(1.0f, 1.0f);
+
+	// the items are stored by value in the render list, which
+	// grows once for all of them
+	m_renderList.reserve(m_renderList.size() + objectCount);
+
+	for (int i = 0; i < objectCount; i++)
+	{
+		int row = i / gridSize;
+		int column = i % gridSize;
+		glm::vec3 positionXYZ = glm::vec3(
+			-7.5f + (column + 0.5f) * spacingX,
+			objectSize,
+			-4.0f + (row + 0.5f) * spacingZ);
+
+		SetTransformations(glm::vec3(objectSize), 0.0f, (float)((i * 37) % 360), 0.0f, positionXYZ);
+		m_recordState.color = palette[(i / 3) % 4];
+		m_recordState.materialID = (materialCount > 0) ? (i / 12) % materialCount : -1;
+		AddDrawItem(meshes[i % 3]);
 	}
 
-	return(textureSlot);
+	std::cout << "INFO: added " << objectCount << " synthetic objects, render list holds " << m_renderList.size() << " items" << std::endl;
 }
 
 /***********************************************************
- *  FindMaterial()
+ *  AddSyntheticLights()
  *
- *  This method is used for getting a material from the previously
- *  defined materials list that is associated with the passed in tag.
+ *  This method is used for adding a square grid of colored
+ *  point lights over the countertop, each reaching a little
+ *  past its neighbors, so that clustered lighting can be
+ *  measured with many more lights than the light block holds.
  ***********************************************************/
-bool SceneManager::FindMaterial(std::string tag, OBJECT_MATERIAL& material)
+void SceneManager::AddSyntheticLights(int lightCount)
 {
-	if (m_objectMaterials.size() == 0)
+	const glm::vec3 palette[4] = {
+		glm::vec3(1.0f, 0.6f, 0.3f),
+		glm::vec3(0.3f, 0.6f, 1.0f),
+		glm::vec3(0.4f, 1.0f, 0.4f),
+		glm::vec3(1.0f, 0.3f, 0.6f)
+	};
+
+	if (lightCount <= 0)
 	{
-		return(false);
+		return;
 	}
 
-	int index = 0;
-	bool bFound = false;
-	while ((index < m_objectMaterials.size()) && (bFound == false))
+	int gridSize = 1;
+	while (gridSize * gridSize < lightCount)
 	{
-		if (m_objectMaterials[index].tag.compare(tag) == 0)
-		{
-			bFound = true;
-			material.ambientColor = m_objectMaterials[index].ambientColor;
-			material.ambientStrength = m_objectMaterials[index].ambientStrength;
-			material.diffuseColor = m_objectMaterials[index].diffuseColor;
-			material.specularColor = m_objectMaterials[index].specularColor;
-			material.shininess = m_objectMaterials[index].shininess;
-		}
-		else
-		{
-			index++;
-		}
+		gridSize++;
 	}
 
-	return(true);
+	// the grid covers the 15 x 12 countertop
+	float spacingX = 15.0f / (float)gridSize;
+	float spacingZ = 12.0f / (float)gridSize;
+	float range = 1.5f * ((spacingX > spacingZ) ? spacingX : spacingZ);
+
+	for (int i = 0; i < lightCount; i++)
+	{
+		int row = i / gridSize;
+		int column = i % gridSize;
+
+		LIGHT_SOURCE light = {};
+		light.position = glm::vec3(
+			-7.5f + (column + 0.5f) * spacingX,
+			1.0f,
+			-4.0f + (row + 0.5f) * spacingZ);
+		light.diffuseColor = palette[i % 4] * 0.5f;
+		light.specularColor = palette[i % 4] * 0.3f;
+		light.specularIntensity = 0.5f;
+		light.range = range;
+		m_lightSources.push_back(light);
+	}
+
+	// the light lists and the permutations are built again for
+	// the new number of lights
+	CreateLightBuffer();
+	BuildShaderPermutations();
+
+	std::cout << "INFO: added " << lightCount << " synthetic lights, the scene has " << m_lightSources.size() << " lights" << std::endl;
 }
 
 /***********************************************************
  *  SetTransformations()
  *
- *  This method is used for setting the transform buffer
- *  using the passed in transformation values.
+ *  This method is used for setting the model transform of
+ *  the next recorded draw item using the passed in
+ *  transformation values.
  ***********************************************************/
 void SceneManager::SetTransformations(
 	glm::vec3 scaleXYZ,
@@ -253,36 +3161,21 @@ void SceneManager::SetTransformations(
 	float ZrotationDegrees,
 	glm::vec3 positionXYZ)
 {
-	// variables for this method
-	glm::mat4 modelView;
-	glm::mat4 scale;
-	glm::mat4 rotationX;
-	glm::mat4 rotationY;
-	glm::mat4 rotationZ;
-	glm::mat4 translation;
-
-	// set the scale value in the transform buffer
-	scale = glm::scale(scaleXYZ);
-	// set the rotation values in the transform buffer
-	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
-	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
-	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
-	// set the translation value in the transform buffer
-	translation = glm::translate(positionXYZ);
-
-	modelView = translation * rotationX * rotationY * rotationZ * scale;
-
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setMat4Value(g_ModelName, modelView);
-	}
+	// the model matrix is composed once the whole
+	// render list has been recorded
+	m_recordState.transform.Set(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
 }
 
 /***********************************************************
  *  SetShaderColor()
  *
- *  This method is used for setting the passed in color
- *  into the shader for the next draw command
+ *  This method is used for setting the passed in color for
+ *  the next recorded draw item, which turns texturing off.
  ***********************************************************/
 void SceneManager::SetShaderColor(
 	float redColorValue,
@@ -298,70 +3191,99 @@ void SceneManager::SetShaderColor(
 	currentColor.b = blueColorValue;
 	currentColor.a = alphaValue;
 
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, false);
-		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
-	}
+	m_recordState.color = currentColor;
+	m_recordState.textureSlot = -1;
 }
 
 /***********************************************************
  *  SetShaderTexture()
  *
- *  This method is used for setting the texture data
- *  associated with the passed in ID into the shader.
+ *  This method is used for setting the texture associated
+ *  with the passed in tag for the next recorded draw item.
  ***********************************************************/
 void SceneManager::SetShaderTexture(
-	std::string textureTag)
+	const std::string& textureTag)
 {
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, true);
+	SetShaderTexture(FindTextureSlot(textureTag));
+}
 
-		int textureID = -1;
-		textureID = FindTextureSlot(textureTag);
-		m_pShaderManager->setSampler2DValue(g_TextureValueName, textureID);
-	}
+/***********************************************************
+ *  SetShaderTexture()
+ *
+ *  This method is used for setting the texture associated
+ *  with the passed in handle for the next recorded draw item.
+ ***********************************************************/
+void SceneManager::SetShaderTexture(
+	int textureHandle)
+{
+	m_recordState.textureSlot = textureHandle;
 }
 
 /***********************************************************
  *  SetTextureUVScale()
  *
  *  This method is used for setting the texture UV scale
- *  values into the shader.
+ *  values for the next recorded draw item.
  ***********************************************************/
 void SceneManager::SetTextureUVScale(float u, float v)
 {
-	if (NULL != m_pShaderManager)
+	m_recordState.uvScale = glm::vec2(u, v);
+}
+
+/***********************************************************
+ *  SetShaderMaterial()
+ *
+ *  This method is used for setting the material associated
+ *  with the passed in tag for the next recorded draw item.
+ ***********************************************************/
+void SceneManager::SetShaderMaterial(
+	const std::string& materialTag)
+{
+	SetShaderMaterial(FindMaterialIndex(materialTag));
+}
+
+/***********************************************************
+ *  SetShaderMaterial()
+ *
+ *  This method is used for setting the material associated
+ *  with the passed in handle for the next recorded draw item.
+ ***********************************************************/
+void SceneManager::SetShaderMaterial(
+	int materialHandle)
+{
+	if ((materialHandle >= 0) && (materialHandle < m_objectMaterials.size()))
 	{
-		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
+		m_recordState.materialID = materialHandle;
 	}
 }
 
 /***********************************************************
- *  SetShaderMaterial()
+ *  ApplyShaderMaterial()
  *
  *  This method is used for passing the material values
- *  into the shader.
+ *  associated with the passed in handle into the shader.
  ***********************************************************/
-void SceneManager::SetShaderMaterial(
-	std::string materialTag)
+void SceneManager::ApplyShaderMaterial(
+	int materialIndex)
 {
-	if (m_objectMaterials.size() > 0)
+	if ((materialIndex < 0) || (materialIndex >= m_objectMaterials.size()))
 	{
-		OBJECT_MATERIAL material;
-		bool bReturn = false;
+		return;
+	}
 
-		bReturn = FindMaterial(materialTag, material);
-		if (bReturn == true)
-		{
-			m_pShaderManager->setVec3Value("material.ambientColor", material.ambientColor);
-			m_pShaderManager->setFloatValue("material.ambientStrength", material.ambientStrength);
-			m_pShaderManager->setVec3Value("material.diffuseColor", material.diffuseColor);
-			m_pShaderManager->setVec3Value("material.specularColor", material.specularColor);
-			m_pShaderManager->setFloatValue("material.shininess", material.shininess);
-		}
+	// the material values are already in the uniform buffer
+	if (m_bMaterialBuffer == true)
+	{
+		GLState::Uniform1i(m_uniforms.materialIndex, materialIndex);
+		return;
 	}
+
+	const OBJECT_MATERIAL& material = m_objectMaterials[materialIndex];
+	GLState::Uniform3f(m_uniforms.materialAmbientColor, material.ambientColor);
+	GLState::Uniform1f(m_uniforms.materialAmbientStrength, material.ambientStrength);
+	GLState::Uniform3f(m_uniforms.materialDiffuseColor, material.diffuseColor);
+	GLState::Uniform3f(m_uniforms.materialSpecularColor, material.specularColor);
+	GLState::Uniform1f(m_uniforms.materialShininess, material.shininess);
 }
 
 /**************************************************************/
@@ -396,7 +3318,8 @@ void SceneManager::LoadSceneTextures()
 	
 	// after the texture image data is loaded into memory, the
 	// loaded textures need to be bound to texture slots - there
-	// are a total of 16 available slots for scene textures
+	// is one slot for each texture unit unless the shader uses
+	// texture arrays or bindless textures
 	BindGLTextures();
 }
 
@@ -427,7 +3350,7 @@ void SceneManager::DefineObjectMaterials()
 	counterMaterial.specularColor = glm::vec3(0.2f, 0.2f, 0.2f); 
 	counterMaterial.shininess = 32.0f;  
 	counterMaterial.tag = "counter";
-	m_objectMaterials.push_back(counterMaterial);
+	AddObjectMaterial(counterMaterial);
 
 	// Material for the mug
 	OBJECT_MATERIAL mugOuterMaterial;
@@ -437,7 +3360,7 @@ void SceneManager::DefineObjectMaterials()
 	mugOuterMaterial.specularColor = glm::vec3(0.1f, 0.1f, 0.1f); 
 	mugOuterMaterial.shininess = 8.0f; 
 	mugOuterMaterial.tag = "mugOuter";
-	m_objectMaterials.push_back(mugOuterMaterial);
+	AddObjectMaterial(mugOuterMaterial);
 
 	// Material for the handle 
 	OBJECT_MATERIAL handleMaterial;
@@ -447,7 +3370,7 @@ void SceneManager::DefineObjectMaterials()
 	handleMaterial.specularColor = glm::vec3(0.1f, 0.1f, 0.1f);
 	handleMaterial.shininess = 8.0f;
 	handleMaterial.tag = "mugHandle";
-	m_objectMaterials.push_back(handleMaterial);
+	AddObjectMaterial(handleMaterial);
 
 	// Material for the cutting board
 	OBJECT_MATERIAL woodMaterial;
@@ -457,7 +3380,7 @@ void SceneManager::DefineObjectMaterials()
 	woodMaterial.specularColor = glm::vec3(0.2f, 0.2f, 0.2f); 
 	woodMaterial.shininess = 16.0f; 
 	woodMaterial.tag = "wood";
-	m_objectMaterials.push_back(woodMaterial);
+	AddObjectMaterial(woodMaterial);
 
 
 }
@@ -478,19 +3401,23 @@ void SceneManager::SetupSceneLights()
 	m_pShaderManager->setBoolValue("bUseLighting", true);
 
 	// Light 1: Blue Spotlight
-	m_pShaderManager->setVec3Value("lightSources[0].position", 7.5f, 20.0f, 5.0f);
-	m_pShaderManager->setVec3Value("lightSources[0].direction", 0.0f, -1.0f, -0.5f);
-	m_pShaderManager->setVec3Value("lightSources[0].ambientColor", 0.05f, 0.05f, 0.3f);
-	m_pShaderManager->setVec3Value("lightSources[0].diffuseColor", 0.1f, 0.1f, 1.0f);
-	m_pShaderManager->setVec3Value("lightSources[0].specularColor", 0.2f, 0.2f, 1.0f);
-	m_pShaderManager->setFloatValue("lightSources[0].focalStrength", 350.0f);
-	m_pShaderManager->setFloatValue("lightSources[0].specularIntensity", 0.9f);
+	LIGHT_SOURCE spotLight = {};
+	spotLight.position = glm::vec3(7.5f, 20.0f, 5.0f);
+	spotLight.direction = glm::vec3(0.0f, -1.0f, -0.5f);
+	spotLight.ambientColor = glm::vec3(0.05f, 0.05f, 0.3f);
+	spotLight.diffuseColor = glm::vec3(0.1f, 0.1f, 1.0f);
+	spotLight.specularColor = glm::vec3(0.2f, 0.2f, 1.0f);
+	spotLight.focalStrength = 350.0f;
+	spotLight.specularIntensity = 0.9f;
+	m_lightSources.push_back(spotLight);
 
 	// Light 2: Directional white Light 
-	m_pShaderManager->setVec3Value("lightSources[1].direction", -0.3f, -1.0f, -0.3f); 
-	m_pShaderManager->setVec3Value("lightSources[1].ambientColor", 0.1f, 0.1f, 0.1f); 
-	m_pShaderManager->setVec3Value("lightSources[1].diffuseColor", 0.7f, 0.7f, 0.7f);   
-	m_pShaderManager->setVec3Value("lightSources[1].specularColor", 0.5f, 0.5f, 0.5f); 
+	LIGHT_SOURCE directionalLight = {};
+	directionalLight.direction = glm::vec3(-0.3f, -1.0f, -0.3f);
+	directionalLight.ambientColor = glm::vec3(0.1f, 0.1f, 0.1f);
+	directionalLight.diffuseColor = glm::vec3(0.7f, 0.7f, 0.7f);
+	directionalLight.specularColor = glm::vec3(0.5f, 0.5f, 0.5f);
+	m_lightSources.push_back(directionalLight);
 
 }
 
@@ -509,44 +3436,221 @@ void SceneManager::PrepareScene()
 	// loaded in memory no matter how many times it is drawn
 	// in the rendered 3D scene
 
-	DefineObjectMaterials();
-	LoadSceneTextures();
-	SetupSceneLights();
+	// the shader program is active at this point, so resolve
+	// the uniform locations once for all of the draw calls
+	CacheUniformLocations();
+
+	// a scene file replaces the materials, textures, lights and
+	// objects that are otherwise defined in the methods below
+	bool bSceneFile = (m_sceneFilename.empty() == false) &&
+		(LoadSceneFile(m_sceneFilename.c_str()) == true);
+	if (bSceneFile == false)
+	{
+		DefineObjectMaterials();
+		LoadSceneTextures();
+		SetupSceneLights();
+	}
+	CreateMaterialBuffer();
+	CreateLightBuffer();
+	// the number of lights is known now, so the programs that
+	// are specialized for it can be built
+	BuildShaderPermutations();
 
 
-	m_basicMeshes->LoadPlaneMesh();
-	m_basicMeshes->LoadCylinderMesh();
+	// the primitives share one vertex and index buffer, with the
+	// repeated ones also drawn a whole group at a time with one
+	// instanced call.  Only the torus is still drawn by ShapeMeshes
+	m_meshLibrary->LoadMeshes();
 	m_basicMeshes->LoadTorusMesh();
-	m_basicMeshes->LoadBoxMesh();
-	m_basicMeshes->LoadSphereMesh();
+
+	// record every object once, the render list is then
+	// drawn each frame without rebuilding the state
+	if (bSceneFile == false)
+	{
+		BuildRenderList();
+	}
+
+	// objects that never move are merged into shared buffers,
+	// unless the GPU culls and draws all of them
+	PrepareObjectBuffer();
+	BuildStaticBatches();
+
+	// the depth of each frame hides the objects behind others
+	// in the frames after it
+	PrepareOcclusionCulling();
+
+	// the cached shadow maps are drawn on the first frame
+	PrepareShadowMaps();
+
+	// edits of the scene and texture files are picked up while
+	// the scene runs
+	StartHotReload(bSceneFile);
 }
 
 /***********************************************************
  *  RenderScene()
  *
  *  This method is used for rendering the 3D scene by 
- *  transforming and drawing the basic 3D shapes
+ *  submitting the state sorted render list
  ***********************************************************/
 void SceneManager::RenderScene()
 {
-	// Draw the countertop
-	DrawCountertop();
+	m_renderStats.drawCalls = 0;
+	m_renderStats.instancedObjects = 0;
+	m_renderStats.stateChanges = 0;
+	m_renderStats.stateChangesSkipped = 0;
+	m_renderStats.culledObjects = 0;
+	m_renderStats.occludedObjects = 0;
+	m_renderStats.reducedDetailObjects = 0;
+	m_renderStats.staticObjects = 0;
+	m_renderStats.gpuDrivenObjects = 0;
+	m_renderStats.programChanges = 0;
+	m_renderStats.prePassDrawCalls = 0;
+	m_renderStats.shadowMapsDrawn = 0;
+	m_renderStats.shadowDrawCalls = 0;
+
+	// patch in the scene and texture files changed since the last frame
+	if (NULL != m_fileWatcher)
+	{
+		int reloadScope = Profiler::BeginScope("HotReload");
+		ApplyFileChanges();
+		Profiler::EndScope(reloadScope);
+	}
 
-	// Draw the mug 
-	DrawMug();
+	// stream in any textures that finished decoding
+	int uploadScope = Profiler::BeginScope("TextureUploads");
+	m_textureLoader->ProcessUploads();
+	ResolveUploadedTextures();
+	Profiler::EndScope(uploadScope);
 
-	// Draw the cutting board
-	DrawCuttingBoard();
+	int updateScope = Profiler::BeginScope("UpdateRenderList");
+	// added, removed or patched objects change the shadows
+	bool bObjectsChanged = (m_bRenderListDirty == true) || (m_bObjectBufferDirty == true);
+	if ((m_bObjectBuffer == true) && ((m_bRenderListDirty == true) || (m_bObjectBufferDirty == true)))
+	{
+		UpdateObjectBuffer();
+	}
+	bool bTransformsChanged = UpdateTransforms();
 
-	// Draw the grapes
-	DrawGrapes();
+	bool bListChanged = m_bRenderListDirty;
 
-	// Draw the sausages
-	DrawSausages();
+	if (m_bRenderListDirty == true)
+	{
+		SortRenderList();
+
+		// sorting moved the items, so every box and the whole
+		// hierarchy are rebuilt
+		m_itemBounds.resize(m_renderList.size());
+		m_itemLods.assign(m_renderList.size(), 0);
+		JobSystem::ParallelFor((int)m_renderList.size(), g_JobGrainSize,
+			[&](int begin, int end)
+			{
+				for (int i = begin; i < end; i++)
+				{
+					UpdateItemBounds(i);
+				}
+			});
+		m_frustumCuller.Build(m_itemBounds);
+	}
+	if ((bObjectsChanged == true) || (bTransformsChanged == true))
+	{
+		m_bShadowCastersDirty = true;
+	}
+	Profiler::EndScope(updateScope);
 
-	// Draw the tea box
-	DrawTeaBox();
+	int cullScope = Profiler::BeginScope("FrustumCulling");
+	bool bVisibilityChanged = CullRenderList();
+	Profiler::EndScope(cullScope);
+
+	int lodScope = Profiler::BeginScope("LevelOfDetail");
+	bool bLodsChanged = SelectLevelsOfDetail();
+	Profiler::EndScope(lodScope);
+
+	// the groups only change with the list, the visible items or
+	// their levels of detail, moved objects only change the
+	// instance matrices
+	if ((bListChanged == true) || (bVisibilityChanged == true) ||
+		(bLodsChanged == true) || (bTransformsChanged == true))
+	{
+		BuildInstanceGroups();
+	}
+
+	// the light lists are rebuilt for every view before any of
+	// the draws read them
+	if ((m_bClusteredLights == true) && (m_bClusterView == true))
+	{
+		int clusterScope = Profiler::BeginScope("ClusterLights");
+		m_clusteredLights->Update(m_clusterView, m_clusterProjection,
+			m_clusterNearPlane, m_clusterFarPlane, m_clusterViewWidth, m_clusterViewHeight);
+		Profiler::EndScope(clusterScope);
+	}
+
+	// the cached shadow maps are only drawn again when the
+	// casters, the lights or the cascades of the view moved
+	if (m_bShadowMaps == true)
+	{
+		int shadowScope = Profiler::BeginScope("ShadowMaps");
+		UpdateShadowMaps();
+		Profiler::EndScope(shadowScope);
+	}
+
+	OrderInstanceGroups();
+
+	if (m_depthMode == DEPTH_PREPASS)
+	{
+		int prePassScope = Profiler::BeginScope("DepthPrePass");
+		SubmitDepthPrePass();
+		Profiler::EndScope(prePassScope);
+	}
+
+	// the samples that pass the depth test from here on are the
+	// ones that get shaded
+	BeginOverdrawQuery();
+
+	int staticScope = Profiler::BeginScope("SubmitStaticBatches");
+	SubmitStaticBatches();
+	Profiler::EndScope(staticScope);
+
+	// the pre-pass already wrote this frame's draw commands
+	int objectScope = Profiler::BeginScope("SubmitObjectBuffer");
+	SubmitObjectBuffer(m_depthMode != DEPTH_PREPASS);
+	Profiler::EndScope(objectScope);
+
+	// after the pre-pass every opaque sample is shaded once in any
+	// order, so the shading pass keeps the state sorted order
+	int submitScope = Profiler::BeginScope("SubmitRenderList");
+	for (int i = 0; i < m_opaqueGroupCount; i++)
+	{
+		SubmitGroup((m_depthMode == DEPTH_FRONT_TO_BACK) ? m_groupOrder[i] : i);
+	}
+
+	// the depth of the opaque objects hides the objects behind
+	// them in the next frames, the transparent ones hide nothing
+	if ((m_bOcclusionCulling == true) && (m_bFrustumCulling == true))
+	{
+		int pyramidScope = Profiler::BeginScope("DepthPyramid");
+		m_occlusionCuller->BuildPyramid(m_viewProjection);
+		Profiler::EndScope(pyramidScope);
+	}
+
+	// transparent items are tested against the finished depth
+	// buffer and write into it as they always did
+	if (m_depthMode == DEPTH_PREPASS)
+	{
+		GLState::DepthMask(GL_TRUE);
+		GLState::DepthFunc(GL_LESS);
+	}
+	for (int i = m_opaqueGroupCount; i < m_instanceGroups.size(); i++)
+	{
+		SubmitGroup(i);
+	}
+
+	// the batches and the shader manager setters use the program
+	// with the uniform branches
+	UseShaderProgram(SHADER_GENERIC);
+	Profiler::EndScope(submitScope);
 
+	EndOverdrawQuery();
 }
 
 void SceneManager::DrawCountertop() {
@@ -560,7 +3664,7 @@ void SceneManager::DrawCountertop() {
 	SetShaderColor(0.5f, 0.5f, 0.5f, 1.0f);
 	SetShaderTexture("counter");
 	SetShaderMaterial("counter");
-	m_basicMeshes->DrawPlaneMesh();
+	AddDrawItem(MESH_PLANE);
 }
 
 void SceneManager::DrawTeaBox() {
@@ -571,7 +3675,7 @@ void SceneManager::DrawTeaBox() {
 
 	SetShaderColor(0.8f, 0.7f, 0.5f, 1.0f); 
 
-	m_basicMeshes->DrawBoxMesh();
+	AddDrawItem(MESH_BOX);
 }
 
 // Function for 2 sausages
@@ -601,7 +3705,7 @@ void SceneManager::DrawSausages() {
 		// Set shader color and material for sausages
 		SetShaderColor(0.65f, 0.32f, 0.17f, 1.0f); // Brownish color for sausages
 
-		m_basicMeshes->DrawCylinderMesh(false, true, true); // Draw a closed cylinder
+		AddDrawItem(MESH_CYLINDER, MESH_DRAW_BOTTOM | MESH_DRAW_SIDES); // Draw a closed cylinder
 	}
 }
 
@@ -629,7 +3733,7 @@ void SceneManager::DrawGrapes() {
 		SetShaderColor(0.5f, 0.0f, 0.5f, 1.0f); // Purple color for grapes
 
 		// Draw the grape using a sphere mesh
-		m_basicMeshes->DrawSphereMesh();
+		AddDrawItem(MESH_SPHERE);
 	}
 }
 
@@ -646,7 +3750,7 @@ void SceneManager::DrawCuttingBoard() {
 	SetShaderMaterial("wood");
 
 	// Draw the box mesh for the cutting board
-	m_basicMeshes->DrawBoxMesh();
+	AddDrawItem(MESH_BOX);
 }
 
 void SceneManager::DrawMug() {
@@ -659,7 +3763,7 @@ void SceneManager::DrawMug() {
 	SetTextureUVScale(5.0, 1.0);
 	SetShaderTexture("mug");
 	SetShaderMaterial("mugOuter");
-	m_basicMeshes->DrawCylinderMesh(false, false, true);
+	AddDrawItem(MESH_CYLINDER, MESH_DRAW_SIDES);
 
 	// Draw the torus handle of the mug
 	scaleXYZ = glm::vec3(0.7f, 0.7f, 0.2f);
@@ -670,7 +3774,7 @@ void SceneManager::DrawMug() {
 	SetShaderColor(1.0f, 1.0f, 1.0f, 1.0f);
 	SetTextureUVScale(2.0, 1.0);
 	SetShaderTexture("mug");
-	m_basicMeshes->DrawTorusMesh();
+	AddDrawItem(MESH_TORUS);
 
 	// Draw the black outer rim of the mug
 	scaleXYZ = glm::vec3(1.01f, 0.05f, 1.01f);
@@ -678,7 +3782,7 @@ void SceneManager::DrawMug() {
 
 	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
 	SetShaderColor(0.0f, 0.0f, 0.0f, 1.0f);
-	m_basicMeshes->DrawCylinderMesh();
+	AddDrawItem(MESH_CYLINDER);
 
 	// Draw the inner rim of the mug
 	scaleXYZ = glm::vec3(0.99f, 0.05f, 0.99f);
@@ -686,7 +3790,7 @@ void SceneManager::DrawMug() {
 
 	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
 	SetShaderColor(1.0f, 1.0f, 1.0f, 1.0f);
-	m_basicMeshes->DrawCylinderMesh();
+	AddDrawItem(MESH_CYLINDER);
 
 	// Draw the tea tag box
 	scaleXYZ = glm::vec3(0.4f, 0.6f, 0.1f);
@@ -694,7 +3798,7 @@ void SceneManager::DrawMug() {
 
 	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
 	SetShaderColor(0.0f, 0.0f, 0.0f, 1.0f);
-	m_basicMeshes->DrawBoxMesh();
+	AddDrawItem(MESH_BOX);
 
 	// Draw the string for the tea tag
 	scaleXYZ = glm::vec3(0.02f, 1.75f, 0.02f);
@@ -702,5 +3806,5 @@ void SceneManager::DrawMug() {
 
 	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
 	SetShaderColor(0.96f, 0.87f, 0.70f, 1.0f); // Beige color
-	m_basicMeshes->DrawCylinderMesh();
+	AddDrawItem(MESH_CYLINDER);
 }
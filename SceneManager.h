@@ -11,8 +11,26 @@
 
 #include "ShaderManager.h"
 #include "ShapeMeshes.h"
+#include "MeshLibrary.h"
+#include "TextureLoader.h"
+#include "TextureArrays.h"
+#include "Transform.h"
+#include "UniformCache.h"
+#include "GLState.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "SceneFile.h"
+#include "FrustumCuller.h"
+#include "StaticBatch.h"
+#include "IndirectRenderer.h"
+#include "ShaderPermutations.h"
+#include "ClusteredLights.h"
+#include "OcclusionCuller.h"
+#include "FileWatcher.h"
+#include "ShadowMaps.h"
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /***********************************************************
@@ -33,6 +51,25 @@ public:
 	{
 		std::string tag;
 		uint32_t ID;
+		// image file the texture was loaded from
+		std::string filename;
+		// true once the texture can be sampled by the shader
+		bool bReady;
+		// bindless handle, or the array unit and layer
+		GLuint64 handle;
+		int arrayUnit;
+		int layer;
+		// texture that a reloaded image with a bindless handle is
+		// uploaded into before it replaces this one, or 0
+		GLuint reloadID;
+	};
+
+	// how the shader samples the scene textures
+	enum TEXTURE_MODE
+	{
+		TEXTURE_SLOTS = 0,
+		TEXTURE_ARRAYS,
+		TEXTURE_BINDLESS
 	};
 
 	struct OBJECT_MATERIAL
@@ -45,17 +82,332 @@ public:
 		std::string tag;
 	};
 
+	struct LIGHT_SOURCE
+	{
+		glm::vec3 position;
+		glm::vec3 direction;
+		glm::vec3 ambientColor;
+		glm::vec3 diffuseColor;
+		glm::vec3 specularColor;
+		float focalStrength;
+		float specularIntensity;
+		// reach of a point or spot light, or 0 for a light that
+		// falls on every object
+		float range;
+	};
+
+	// basic shape meshes that can be drawn from the render list
+	enum MESH_ID
+	{
+		MESH_PLANE = 0,
+		MESH_BOX,
+		MESH_CYLINDER,
+		MESH_TORUS,
+		MESH_SPHERE
+	};
+
+	// which parts of a cylinder mesh are drawn
+	enum MESH_FLAGS
+	{
+		MESH_DRAW_TOP = 0x01,
+		MESH_DRAW_BOTTOM = 0x02,
+		MESH_DRAW_SIDES = 0x04,
+		MESH_DRAW_ALL = 0x07
+	};
+
+	// one object in the retained render list, holding all of
+	// the shader state that is needed to draw it
+	struct DRAW_ITEM
+	{
+		int meshID;
+		unsigned int meshFlags;
+		Transform transform;
+		glm::vec4 color;
+		int textureSlot;
+		glm::vec2 uvScale;
+		int materialID;
+		// name of the Draw* method that recorded the item
+		const char* sourceName;
+		// object record of the scene file the item came from, or -1
+		int sceneRecord;
+	};
+
+	// counters for the last rendered frame
+	struct RENDER_STATS
+	{
+		int drawCalls;
+		int instancedObjects;
+		int stateChanges;
+		int stateChangesSkipped;
+		int culledObjects;
+		// visible items hidden behind others in the depth of the past frames
+		int occludedObjects;
+		int reducedDetailObjects;
+		int staticObjects;
+		int gpuDrivenObjects;
+		int programChanges;
+		// draws of the depth pre-pass, included in drawCalls
+		int prePassDrawCalls;
+		// shadow maps drawn again, and their draws included in drawCalls
+		int shadowMapsDrawn;
+		int shadowDrawCalls;
+		// samples shaded a few frames ago, and per pixel of the view
+		long long shadedSamples;
+		float shadedSamplesPerPixel;
+	};
+
+	// the order of the opaque objects, and whether their depth is
+	// drawn in a pass of its own before they are shaded
+	enum DEPTH_MODE
+	{
+		DEPTH_STATE_ORDER = 0,
+		DEPTH_FRONT_TO_BACK,
+		DEPTH_PREPASS
+	};
+
+	// a run of identical draw items in the sorted render list
+	// that are drawn with one instanced draw call
+	struct INSTANCE_GROUP
+	{
+		int firstItem;
+		int itemCount;
+		GLuint firstInstance;
+		// level of detail of the MeshLibrary mesh
+		int lod;
+		// false for single full detail items drawn one at a time
+		bool bInstanced;
+	};
+
+	// shader uniform locations resolved once after the
+	// shader program has been activated
+	struct UNIFORM_LOCATIONS
+	{
+		GLint model;
+		GLint objectColor;
+		GLint objectTexture;
+		GLint useTexture;
+		GLint textureArray;
+		GLint textureLayer;
+		GLint textureHandle;
+		GLint uvScale;
+		GLint materialAmbientColor;
+		GLint materialAmbientStrength;
+		GLint materialDiffuseColor;
+		GLint materialSpecularColor;
+		GLint materialShininess;
+		GLint materialIndex;
+		GLint useInstancing;
+		GLint useStaticBatch;
+		GLint useObjectBuffer;
+	};
+
+	// the shader programs that draw items can be sent to, with
+	// the program of the shader manager branching on uniforms
+	enum SHADER_VARIANT
+	{
+		SHADER_GENERIC = 0,
+		SHADER_UNTEXTURED,
+		SHADER_TEXTURED,
+		SHADER_DEPTH,
+		SHADER_VARIANT_COUNT
+	};
+
+	// one shader program and its uniform locations
+	struct SHADER_PROGRAM
+	{
+		GLuint program;
+		UNIFORM_LOCATIONS uniforms;
+	};
+
+	// one opaque object drawn into the shadow maps
+	struct SHADOW_CASTER
+	{
+		glm::mat4 model;
+		int meshID;
+		unsigned int meshFlags;
+	};
+
 private:
 	// pointer to shader manager object
 	ShaderManager* m_pShaderManager;
 	// pointer to basic shapes object
 	ShapeMeshes* m_basicMeshes;
+	// pointer to the meshes that support instanced drawing
+	MeshLibrary* m_meshLibrary;
+	// pointer to the background texture loader
+	TextureLoader* m_textureLoader;
 	// total number of loaded textures
 	int m_loadedTextures;
 	// loaded textures info
-	TEXTURE_INFO m_textureIDs[16];
+	std::vector<TEXTURE_INFO> m_textureIDs;
+	// texture slot of each OpenGL texture ID
+	std::unordered_map<GLuint, int> m_textureSlots;
+	// how the shader samples the scene textures
+	TEXTURE_MODE m_textureMode;
+	// texture units available for one texture per slot
+	GLint m_maxTextureSlots;
+	// array textures holding the layers in TEXTURE_ARRAYS mode
+	TextureArrays* m_textureArrays;
 	// defined object materials
 	std::vector<OBJECT_MATERIAL> m_objectMaterials;
+	// tags interned into texture slot and material index handles
+	std::unordered_map<std::string, int> m_textureHandles;
+	std::unordered_map<std::string, int> m_materialHandles;
+	// defined scene light sources
+	std::vector<LIGHT_SOURCE> m_lightSources;
+	// cached uniform locations of the active shader program
+	UNIFORM_LOCATIONS m_uniforms;
+	// shader files that the permutations are built from
+	std::string m_vertexShaderPath;
+	std::string m_fragmentShaderPath;
+	bool m_bUseProgramCache;
+	// programs specialized for texturing and the scene lights
+	ShaderPermutations* m_shaderPermutations;
+	SHADER_PROGRAM m_shaderPrograms[SHADER_VARIANT_COUNT];
+	// true when the render list is drawn with the permutations
+	bool m_bShaderPermutations;
+	int m_activeShader;
+	// true when the depth pre-pass has the unlit untextured program
+	bool m_bDepthProgram;
+	// uniform buffers holding the material and light data
+	GLuint m_materialBuffer;
+	GLuint m_lightBuffer;
+	// true when the shader reads the data from the buffers
+	bool m_bMaterialBuffer;
+	bool m_bLightBuffer;
+	// lights assigned to view space clusters, when the shader
+	// declares the cluster blocks
+	ClusteredLights* m_clusteredLights;
+	bool m_bClusteredLights;
+	// the view that the lights are assigned to the clusters of
+	bool m_bClusterView;
+	glm::mat4 m_clusterView;
+	glm::mat4 m_clusterProjection;
+	float m_clusterNearPlane;
+	float m_clusterFarPlane;
+	int m_clusterViewWidth;
+	int m_clusterViewHeight;
+
+	// retained list of all the objects in the 3D scene
+	std::vector<DRAW_ITEM> m_renderList;
+	// true when the render list must be sorted before drawing
+	bool m_bRenderListDirty;
+	// draw state for the next item added to the render list
+	DRAW_ITEM m_recordState;
+	// draw state last sent into the shader
+	DRAW_ITEM m_appliedState;
+	bool m_bAppliedStateValid;
+	// counters for the last rendered frame
+	RENDER_STATS m_renderStats;
+	// transforms recomputed during the current frame, one list
+	// for each chunk of the render list walked by a job
+	std::vector<std::vector<Transform*> > m_chunkTransforms;
+	std::vector<std::vector<int> > m_chunkDirtyItems;
+	// render list items whose transforms were recomputed
+	std::vector<int> m_dirtyItems;
+	// world space box of each render list item
+	std::vector<FrustumCuller::BOUNDS> m_itemBounds;
+	// hierarchy over the item boxes for view frustum culling
+	FrustumCuller m_frustumCuller;
+	// true once a view-projection matrix has been set
+	bool m_bFrustumCulling;
+	// render list items inside the frustum, this frame and last
+	std::vector<int> m_visibleItems;
+	std::vector<int> m_lastVisibleItems;
+	// hides the items behind others in the depth of past frames
+	OcclusionCuller* m_occlusionCuller;
+	// true when occlusion culling was asked for, and when it runs
+	bool m_bOcclusion;
+	bool m_bOcclusionCulling;
+	// view-projection of this frame, which its depth pyramid is drawn with
+	glm::mat4 m_viewProjection;
+	// whether each visible item is hidden, written by the jobs
+	std::vector<char> m_itemOccluded;
+	// level of detail picked for each render list item
+	std::vector<int> m_itemLods;
+	// camera values for picking the levels of detail
+	bool m_bLodSelection;
+	glm::vec3 m_lodCameraPosition;
+	float m_lodPixelScale;
+	// groups of render list items drawn together
+	std::vector<INSTANCE_GROUP> m_instanceGroups;
+	// the opaque groups come first, in this front to back order
+	int m_opaqueGroupCount;
+	std::vector<int> m_groupOrder;
+	std::vector<float> m_groupDistances;
+	// order of the opaque objects and the depth pre-pass
+	DEPTH_MODE m_depthMode;
+	bool m_bDepthPass;
+	// samples passed queries of the last frames, read back late
+	static const int OVERDRAW_QUERY_COUNT = 4;
+	GLuint m_overdrawQueries[OVERDRAW_QUERY_COUNT];
+	int m_overdrawFrame;
+	long long m_shadedSamples;
+	// true when the shader reads the per-instance attributes
+	bool m_bInstancing;
+	// static objects merged into shared buffers
+	StaticBatch* m_staticBatch;
+	// true when the shader reads the static batch draw data
+	bool m_bStaticBatching;
+	// the merged objects, and the one setting the state of each batch
+	std::vector<DRAW_ITEM> m_staticItems;
+	std::vector<int> m_staticBatchItems;
+	// objects culled and drawn by the GPU from the object buffer
+	IndirectRenderer* m_indirectRenderer;
+	// true when the GPU driven mode was asked for, and when it runs
+	bool m_bGpuDriven;
+	bool m_bObjectBuffer;
+	// the items in the object buffer, which must be uploaded again
+	// when their textures finish loading
+	std::vector<DRAW_ITEM> m_gpuItems;
+	bool m_bObjectBufferDirty;
+	// object buffer mesh range by mesh ID and cylinder part flags
+	int m_gpuMeshRanges[MESH_SPHERE + 1][MESH_DRAW_ALL + 1];
+	// scene file loaded by PrepareScene instead of the Draw* methods
+	std::string m_sceneFilename;
+	// the object records and number of lights of the loaded scene
+	// file, which a reload is compared against
+	std::vector<SceneFile::SCENE_OBJECT> m_sceneObjects;
+	int m_sceneLightCount;
+	// watches the scene and texture files when hot reload is on
+	FileWatcher* m_fileWatcher;
+	bool m_bHotReload;
+	// shadow maps of the spot and the directional light, when
+	// asked for and when the shader declares them
+	ShadowMaps* m_shadowMaps;
+	bool m_bShadows;
+	bool m_bShadowMaps;
+	// every opaque object of the scene, and the hierarchy over
+	// their boxes that each map culls them with
+	std::vector<SHADOW_CASTER> m_shadowCasters;
+	std::vector<FrustumCuller::BOUNDS> m_casterBounds;
+	FrustumCuller m_casterCuller;
+	std::vector<int> m_layerCasters;
+	// true when objects were added, removed or moved
+	bool m_bShadowCastersDirty;
+
+	// resolve the shader uniform locations used while rendering
+	void CacheUniformLocations();
+	// resolve the uniform locations of the active program
+	void LookupUniformLocations(UNIFORM_LOCATIONS& uniforms);
+	// build the programs specialized for the scene lights
+	void BuildShaderPermutations();
+	// build one permutation and attach its blocks
+	bool BuildShaderVariant(int shaderVariant, bool bTextured, bool bLit, int lightCount);
+	// make one of the shader programs active
+	void UseShaderProgram(int shaderVariant);
+	// pack the defined materials into the material uniform buffer
+	void CreateMaterialBuffer();
+	// write one changed material into the material uniform buffer
+	void UpdateMaterialEntry(int materialIndex);
+	// pack the defined lights into the light uniform buffer
+	void CreateLightBuffer();
+	// free the material and light uniform buffers
+	void DestroyUniformBuffers();
+	// attach the cluster blocks of the active program
+	bool BindClusterBlocks();
+	// attach the shadow block and maps of the active program
+	bool BindShadowMaps();
 
 	// load texture images and convert to OpenGL texture data
 	bool CreateGLTexture(const char* filename, std::string tag);
@@ -63,11 +415,103 @@ private:
 	void BindGLTextures();
 	// free the loaded OpenGL textures
 	void DestroyGLTextures();
+	// start sampling the textures that finished uploading
+	void ResolveUploadedTextures();
 	// find a loaded texture by tag
-	int FindTextureID(std::string tag);
-	int FindTextureSlot(std::string tag);
+	int FindTextureID(const std::string& tag);
+	int FindTextureSlot(const std::string& tag);
 	// find a defined material by tag
-	bool FindMaterial(std::string tag, OBJECT_MATERIAL& material);
+	bool FindMaterial(const std::string& tag, OBJECT_MATERIAL& material);
+	int FindMaterialIndex(const std::string& tag);
+	// add a material to the defined materials and intern its tag
+	void AddObjectMaterial(const OBJECT_MATERIAL& material);
+
+	// record the Draw* objects into the render list
+	void BuildRenderList();
+	// load the materials, textures, lights and render list from a file
+	bool LoadSceneFile(const char* filename);
+	// the draw item of one object record, or false for an unknown mesh
+	bool MakeSceneItem(const SceneFile::SCENE_OBJECT& object, int record,
+		const std::vector<int>& textureSlots, const std::vector<int>& materialIDs, DRAW_ITEM& item);
+	// start watching the files the scene was loaded from
+	void StartHotReload(bool bSceneFile);
+	// reload the scene and texture files that were changed
+	void ApplyFileChanges();
+	// decode the image of one texture slot again
+	void ReloadTexture(int textureSlot);
+	// patch the changed records of the scene file into the scene
+	void ReloadSceneFile();
+	// update or drop the items of changed or removed object records
+	bool PatchSceneItems(std::vector<DRAW_ITEM>& items, const SceneFile& sceneFile,
+		const std::vector<char>& changedRecords, const std::vector<int>& textureSlots,
+		const std::vector<int>& materialIDs);
+	// add a draw item using the current recorded draw state
+	void AddDrawItem(int meshID, unsigned int meshFlags = MESH_DRAW_ALL);
+	// move the static objects from the render list into batches
+	void BuildStaticBatches();
+	// true when an item can be merged into a static batch
+	bool CanBatchStatic(const DRAW_ITEM& item);
+	// draw every static batch with one indirect call each
+	void SubmitStaticBatches();
+	// set up the culling shader and meshes of the GPU driven mode
+	void PrepareObjectBuffer();
+	// true when an item can be drawn from the object buffer
+	bool CanDrawIndirect(const DRAW_ITEM& item);
+	// move the eligible render list items into the object buffer
+	void UpdateObjectBuffer();
+	// cull and draw the object buffer with one indirect call
+	void SubmitObjectBuffer(bool bCull);
+	// sort the render list to minimize shader state changes
+	void SortRenderList();
+	// recompute the model matrices that are out of date
+	bool UpdateTransforms();
+	// recompute the world space box of one render list item
+	void UpdateItemBounds(int itemIndex);
+	// collect the render list items inside the view frustum
+	bool CullRenderList();
+	// compile the depth pyramid shader when occlusion culling is on
+	void PrepareOcclusionCulling();
+	// create the shadow maps when they are asked for
+	void PrepareShadowMaps();
+	// collect the opaque objects of every draw path as casters
+	void UpdateShadowCasters();
+	// draw the shadow maps that are out of date
+	void UpdateShadowMaps();
+	// drop the visible items hidden in the depth pyramid
+	void RemoveOccludedItems();
+	// pick the level of detail of the visible items
+	bool SelectLevelsOfDetail();
+	// the level of detail of one visible item
+	int PickLevelOfDetail(int itemIndex) const;
+	// group identical neighboring items for instanced drawing
+	void BuildInstanceGroups();
+	// true when two items can share one instanced draw call
+	bool CanInstanceTogether(const DRAW_ITEM& a, const DRAW_ITEM& b);
+	// true when an item is drawn with its texture this frame
+	bool IsItemTextured(const DRAW_ITEM& item);
+	// select the shader program of one draw item
+	void UseItemShaderProgram(const DRAW_ITEM& item);
+	// send the changed shader state of one draw item
+	void ApplyDrawState(const DRAW_ITEM& item, bool bSendModel);
+	// select the per-object values read by the next draw
+	void ApplyDrawPath(bool bInstancing, bool bStaticBatch, bool bObjectBuffer);
+	// draw one full detail mesh with the state already sent
+	void DrawItemMesh(int meshID, unsigned int meshFlags);
+	// send the changed state of one draw item and draw its mesh
+	void SubmitDrawItem(const DRAW_ITEM& item);
+	// draw all items of an instance group with one draw call
+	void SubmitInstanceGroup(const INSTANCE_GROUP& group);
+	// draw one instance group, either way
+	void SubmitGroup(int groupIndex);
+	// count the opaque groups and order them front to back
+	void OrderInstanceGroups();
+	// draw the depth of the opaque objects without shading them
+	void SubmitDepthPrePass();
+	// count the samples shaded in this frame
+	void BeginOverdrawQuery();
+	void EndOverdrawQuery();
+	// send the values of a material into the shader
+	void ApplyShaderMaterial(int materialIndex);
 
 	// set the transformation values 
 	// into the transform buffer
@@ -87,7 +531,9 @@ private:
 
 	// set the texture data into the shader
 	void SetShaderTexture(
-		std::string textureTag);
+		const std::string& textureTag);
+	void SetShaderTexture(
+		int textureHandle);
 
 	// set the UV scale for the texture mapping
 	void SetTextureUVScale(
@@ -95,7 +541,9 @@ private:
 
 	// set the object material into the shader
 	void SetShaderMaterial(
-		std::string materialTag);
+		const std::string& materialTag);
+	void SetShaderMaterial(
+		int materialHandle);
 
 public:
 
@@ -104,6 +552,45 @@ public:
 	void PrepareScene();
 	void RenderScene();
 
+	// counters for the last rendered frame
+	const RENDER_STATS& GetRenderStats() const;
+	// cull the render list against this view and projection
+	void SetViewProjection(const glm::mat4& viewProjection);
+	// pick the levels of detail for this camera and view height
+	void SetLodView(const glm::vec3& cameraPosition, float fieldOfViewDegrees, int viewHeight);
+	// assign the lights to the clusters of this view
+	void SetClusterView(const glm::mat4& view, const glm::mat4& projection,
+		float nearPlane, float farPlane, int viewWidth, int viewHeight);
+	// number of scene textures that are still loading
+	int GetPendingTextureCount();
+
+	// add a grid of generated objects for benchmarking
+	void AddSyntheticObjects(int objectCount);
+	// add a grid of generated point lights for benchmarking
+	void AddSyntheticLights(int lightCount);
+
+	// cull and draw the objects on the GPU, set before PrepareScene
+	void SetGpuDriven(bool bGpuDriven);
+	// skip the objects hidden behind others, set before PrepareScene
+	void SetOcclusionCulling(bool bOcclusion);
+	// order and depth pre-pass of the opaque objects
+	void SetDepthMode(DEPTH_MODE depthMode);
+	// draw the shadows of the spot and the directional light, set
+	// before PrepareScene
+	void SetShadows(bool bShadows);
+	// build specialized shader programs from these files, and
+	// restore them from the program cache if asked, set before
+	// PrepareScene
+	void SetShaderSources(const char* vertexShaderPath, const char* fragmentShaderPath, bool bUseProgramCache);
+
+	// load this scene file in PrepareScene instead of the Draw* objects
+	void SetSceneFile(const char* filename);
+	// reload the scene and texture files when they change, set
+	// before PrepareScene
+	void SetHotReload(bool bHotReload);
+	// write the prepared scene as a text or binary scene file
+	bool SaveSceneFile(const char* filename);
+
 	// loads textures from image files
 	void LoadSceneTextures();
 
@@ -113,6 +600,7 @@ public:
 	// pre-define the object materials for lighting
 	void DefineObjectMaterials();
 
+	// add the scene objects to the render list
 	void DrawCountertop();
 	void DrawMug();
 	void DrawCuttingBoard();
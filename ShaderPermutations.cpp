@@ -0,0 +1,262 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderpermutations.cpp
+// ============
+// build specialized shader programs from #define variants of the shaders
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShaderPermutations.h"
+#include "ProgramCache.h"
+
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// the define that the shaders test for to opt in
+	const char* g_PermutationDefine = "SHADER_PERMUTATION";
+}
+
+/***********************************************************
+ *  ShaderPermutations()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShaderPermutations::ShaderPermutations()
+{
+	m_bUseProgramCache = true;
+}
+
+/***********************************************************
+ *  ~ShaderPermutations()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ShaderPermutations::~ShaderPermutations()
+{
+	for (std::unordered_map<int, GLuint>::iterator it = m_programs.begin(); it != m_programs.end(); ++it)
+	{
+		if (0 != it->second)
+		{
+			glDeleteProgram(it->second);
+		}
+	}
+	m_programs.clear();
+}
+
+/***********************************************************
+ *  LoadSources()
+ *
+ *  This method is used for reading the shader files.  Shaders
+ *  that never test for the permutation define would only
+ *  compile into the same program again, so they are refused.
+ ***********************************************************/
+bool ShaderPermutations::LoadSources(const char* vertexShaderPath, const char* fragmentShaderPath, bool bUseProgramCache)
+{
+	if ((ProgramCache::ReadSource(vertexShaderPath, m_vertexSource) == false) ||
+		(ProgramCache::ReadSource(fragmentShaderPath, m_fragmentSource) == false))
+	{
+		std::cout << "Could not read the shader sources for the shader permutations" << std::endl;
+		return(false);
+	}
+
+	if (m_fragmentSource.find(g_PermutationDefine) == std::string::npos)
+	{
+		std::cout << "INFO: the fragment shader does not test for "
+			<< g_PermutationDefine << ", so no shader permutations are built" << std::endl;
+		return(false);
+	}
+
+	m_vertexShaderPath = vertexShaderPath;
+	m_bUseProgramCache = bUseProgramCache;
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetProgram()
+ *
+ *  This method is used for getting the program of one
+ *  combination of texturing, lighting and number of lights.
+ *  A combination that fails to build is remembered, so its
+ *  errors are only reported once.
+ ***********************************************************/
+GLuint ShaderPermutations::GetProgram(bool bTextured, bool bLit, int lightCount)
+{
+	if (m_fragmentSource.empty() == true)
+	{
+		return(0);
+	}
+
+	int key = (lightCount << 2) | (bLit ? 2 : 0) | (bTextured ? 1 : 0);
+	std::unordered_map<int, GLuint>::iterator found = m_programs.find(key);
+	if (found != m_programs.end())
+	{
+		return(found->second);
+	}
+
+	std::string defines = std::string("#define ") + g_PermutationDefine + " 1\n" +
+		"#define USE_TEXTURE " + (bTextured ? "1" : "0") + "\n" +
+		"#define USE_LIGHTING " + (bLit ? "1" : "0") + "\n" +
+		"#define LIGHT_COUNT " + std::to_string(lightCount) + "\n";
+
+	GLuint program = BuildProgram(defines);
+	m_programs[key] = program;
+
+	return(program);
+}
+
+/***********************************************************
+ *  GetProgramCount()
+ *
+ *  This method is used for getting the number of programs
+ *  that have been built.
+ ***********************************************************/
+int ShaderPermutations::GetProgramCount() const
+{
+	int programCount = 0;
+
+	for (std::unordered_map<int, GLuint>::const_iterator it = m_programs.begin(); it != m_programs.end(); ++it)
+	{
+		if (0 != it->second)
+		{
+			programCount++;
+		}
+	}
+
+	return(programCount);
+}
+
+/***********************************************************
+ *  IsPositionInvariant()
+ *
+ *  This method is used for checking whether the vertex shader
+ *  declares "invariant gl_Position;", without which programs
+ *  built from different defines may compute slightly
+ *  different depths for the same vertex.
+ ***********************************************************/
+bool ShaderPermutations::IsPositionInvariant() const
+{
+	return(m_vertexSource.find("invariant gl_Position") != std::string::npos);
+}
+
+/***********************************************************
+ *  BuildProgram()
+ *
+ *  This method is used for building the program of one set
+ *  of defines.  The defined sources are hashed into the
+ *  program cache key, so each permutation has its own cached
+ *  binary and only the first launch compiles them, unless the
+ *  program cache was turned off.
+ ***********************************************************/
+GLuint ShaderPermutations::BuildProgram(const std::string& defines)
+{
+	GLint success = 0;
+	GLchar infoLog[512];
+
+	std::string vertexSource = InsertDefines(m_vertexSource, defines);
+	std::string fragmentSource = InsertDefines(m_fragmentSource, defines);
+
+	bool bCacheable = (m_bUseProgramCache == true) && (ProgramCache::IsSupported() == true);
+	unsigned long long programKey = 0;
+	std::string cachePath;
+	if (bCacheable == true)
+	{
+		programKey = ProgramCache::GetProgramKey(vertexSource, fragmentSource);
+		cachePath = ProgramCache::GetCachePath(m_vertexShaderPath.c_str(), programKey);
+
+		GLuint program = ProgramCache::Load(cachePath, programKey);
+		if (0 != program)
+		{
+			return(program);
+		}
+	}
+
+	GLuint vertexShader = CompileShader(GL_VERTEX_SHADER, vertexSource);
+	GLuint fragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentSource);
+	if ((0 == vertexShader) || (0 == fragmentShader))
+	{
+		glDeleteShader(vertexShader);
+		glDeleteShader(fragmentShader);
+		return(0);
+	}
+
+	GLuint program = glCreateProgram();
+	glAttachShader(program, vertexShader);
+	glAttachShader(program, fragmentShader);
+	if (bCacheable == true)
+	{
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+	glLinkProgram(program);
+	glDeleteShader(vertexShader);
+	glDeleteShader(fragmentShader);
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		glGetProgramInfoLog(program, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR: shader permutation linking failed\n" << defines << infoLog << std::endl;
+		glDeleteProgram(program);
+		return(0);
+	}
+
+	if (bCacheable == true)
+	{
+		ProgramCache::Save(program, cachePath, programKey);
+	}
+
+	return(program);
+}
+
+/***********************************************************
+ *  CompileShader()
+ *
+ *  This method is used for compiling one shader stage, and
+ *  returns 0 after reporting the errors when it fails.
+ ***********************************************************/
+GLuint ShaderPermutations::CompileShader(GLenum type, const std::string& source)
+{
+	GLint success = 0;
+	GLchar infoLog[512];
+
+	const GLchar* pSource = source.c_str();
+	GLuint shader = glCreateShader(type);
+	glShaderSource(shader, 1, &pSource, NULL);
+	glCompileShader(shader);
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		glGetShaderInfoLog(shader, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR: shader permutation compilation failed\n" << infoLog << std::endl;
+		glDeleteShader(shader);
+		return(0);
+	}
+
+	return(shader);
+}
+
+/***********************************************************
+ *  InsertDefines()
+ *
+ *  This method is used for inserting the defines after the
+ *  #version line, which must stay the first statement of a
+ *  shader.  Sources without one get the defines in front.
+ ***********************************************************/
+std::string ShaderPermutations::InsertDefines(const std::string& source, const std::string& defines)
+{
+	size_t version = source.find("#version");
+	if (version == std::string::npos)
+	{
+		return(defines + source);
+	}
+
+	size_t lineEnd = source.find('\n', version);
+	if (lineEnd == std::string::npos)
+	{
+		return(source + "\n" + defines);
+	}
+
+	return(source.substr(0, lineEnd + 1) + defines + source.substr(lineEnd + 1));
+}
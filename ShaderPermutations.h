@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderpermutations.h
+// ============
+// build specialized shader programs from #define variants of the shaders
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <string>
+#include <unordered_map>
+
+/***********************************************************
+ *  ShaderPermutations
+ *
+ *  This class contains the code for compiling the scene
+ *  shaders once for each combination of texturing, lighting
+ *  and number of lights, instead of branching on the
+ *  bUseTexture and bUseLighting uniforms for every fragment.
+ *  The combination is passed to the shaders as defines that
+ *  are inserted after the #version line:
+ *
+ *    #define SHADER_PERMUTATION 1
+ *    #define USE_TEXTURE 0 or 1
+ *    #define USE_LIGHTING 0 or 1
+ *    #define LIGHT_COUNT 0 to 4
+ *
+ *  The shaders opt in by testing for SHADER_PERMUTATION and
+ *  keep the uniform branches for the program compiled by the
+ *  shader manager, which still draws the batched objects:
+ *
+ *    #ifdef SHADER_PERMUTATION
+ *        #if USE_TEXTURE
+ *            vec4 baseColor = texture(objectTexture, fragmentTextureCoordinate * UVscale);
+ *        #else
+ *            vec4 baseColor = objectColor;
+ *        #endif
+ *    #else
+ *        vec4 baseColor = bUseTexture ? texture(...) : objectColor;
+ *    #endif
+ *
+ *  The attribute locations must be set with layout qualifiers,
+ *  so that every program reads the same vertex arrays.
+ ***********************************************************/
+class ShaderPermutations
+{
+public:
+	// constructor
+	ShaderPermutations();
+	// destructor
+	~ShaderPermutations();
+
+	// read the shader files, returning false when they cannot be
+	// read or do not test for SHADER_PERMUTATION, and whether the
+	// programs are restored from the program cache
+	bool LoadSources(const char* vertexShaderPath, const char* fragmentShaderPath, bool bUseProgramCache);
+	// the program of one combination, built the first time it is
+	// asked for, or 0 when it does not compile
+	GLuint GetProgram(bool bTextured, bool bLit, int lightCount);
+	// number of programs built so far
+	int GetProgramCount() const;
+	// true when the vertex shader declares gl_Position invariant,
+	// so that every permutation computes the same depth
+	bool IsPositionInvariant() const;
+
+private:
+	std::string m_vertexShaderPath;
+	std::string m_vertexSource;
+	std::string m_fragmentSource;
+	bool m_bUseProgramCache;
+	// built programs by combination, with 0 for failed builds
+	std::unordered_map<int, GLuint> m_programs;
+
+	// compile and link the shaders with the passed in defines,
+	// or restore the program from the program cache
+	GLuint BuildProgram(const std::string& defines);
+	// compile one shader stage
+	static GLuint CompileShader(GLenum type, const std::string& source);
+	// the source with the defines inserted after its #version line
+	static std::string InsertDefines(const std::string& source, const std::string& defines);
+};
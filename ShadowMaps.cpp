@@ -0,0 +1,682 @@
+///////////////////////////////////////////////////////////////////////////////
+// shadowmaps.cpp
+// ============
+// cached shadow maps of the directional and the spot light of the scene
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShadowMaps.h"
+#include "GLState.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	// the cascades end at this view depth, and what lies beyond
+	// is drawn without shadows
+	const float g_ShadowDistance = 40.0f;
+	// blend of the logarithmic and the even split of the cascades
+	const float g_SplitWeight = 0.75f;
+	// a cascade is drawn for an area this much larger than its slice
+	const float g_CascadeMargin = 1.25f;
+	// room before and after the casters in the light depth range
+	const float g_DepthPadding = 1.0f;
+	// slope scaled depth bias against shadow acne
+	const float g_PolygonOffsetFactor = 2.0f;
+	const float g_PolygonOffsetUnits = 4.0f;
+	// cone of the spot light map, fitted around the casters
+	const float g_SpotMinHalfAngle = 5.0f;
+	const float g_SpotMaxHalfAngle = 75.0f;
+	const float g_SpotNearPlane = 0.1f;
+
+	// the depth only shader of the casters, with the positions at
+	// the same attribute location as the scene meshes
+	const char* g_DepthVertexSource =
+		"#version 330 core\n"
+		"layout(location = 0) in vec3 inVertexPosition;\n"
+		"uniform mat4 model;\n"
+		"uniform mat4 lightViewProjection;\n"
+		"void main()\n"
+		"{\n"
+		"    gl_Position = lightViewProjection * model * vec4(inVertexPosition, 1.0);\n"
+		"}\n";
+	const char* g_DepthFragmentSource =
+		"#version 330 core\n"
+		"void main()\n"
+		"{\n"
+		"}\n";
+
+	// the eight corners of a box
+	void GetBoxCorners(const FrustumCuller::BOUNDS& bounds, glm::vec3 corners[8])
+	{
+		for (int i = 0; i < 8; i++)
+		{
+			corners[i] = glm::vec3(
+				(i & 1) ? bounds.max.x : bounds.min.x,
+				(i & 2) ? bounds.max.y : bounds.min.y,
+				(i & 4) ? bounds.max.z : bounds.min.z);
+		}
+	}
+
+	// an up vector for a light view that is never parallel to it
+	glm::vec3 GetLightUp(const glm::vec3& direction)
+	{
+		return((std::fabs(direction.y) > 0.99f) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f));
+	}
+
+	// compile one stage of the depth only shader
+	GLuint CompileDepthShader(GLenum stage, const char* source, const char* stageName)
+	{
+		GLint success = 0;
+		GLchar infoLog[512];
+
+		GLuint shader = glCreateShader(stage);
+		glShaderSource(shader, 1, &source, NULL);
+		glCompileShader(shader);
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+		if (!success)
+		{
+			glGetShaderInfoLog(shader, sizeof(infoLog), NULL, infoLog);
+			std::cout << "ERROR: shadow map " << stageName << " shader compilation failed\n" << infoLog << std::endl;
+			glDeleteShader(shader);
+			return(0);
+		}
+		return(shader);
+	}
+}
+
+/***********************************************************
+ *  ShadowMaps()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShadowMaps::ShadowMaps()
+{
+	m_depthTexture = 0;
+	m_framebuffer = 0;
+	m_shadowBuffer = 0;
+	m_depthProgram = 0;
+	m_modelLocation = -1;
+	m_viewProjectionLocation = -1;
+	m_cascadeLight = -1;
+	m_cascadeDirection = glm::vec3(0.0f, -1.0f, 0.0f);
+	m_spotLight = -1;
+	m_spotPosition = glm::vec3(0.0f);
+	m_spotDirection = glm::vec3(0.0f, -1.0f, 0.0f);
+	m_casterBounds.min = glm::vec3(0.0f);
+	m_casterBounds.max = glm::vec3(0.0f);
+	m_bCasterBounds = false;
+	m_bView = false;
+	for (int i = 0; i < 4; i++)
+	{
+		m_nearCorners[i] = glm::vec3(0.0f);
+		m_farCorners[i] = glm::vec3(0.0f);
+	}
+	m_nearPlane = 0.1f;
+	m_farPlane = 100.0f;
+	for (int i = 0; i < CASCADE_COUNT; i++)
+	{
+		m_cascadeAreas[i].center = glm::vec2(0.0f);
+		m_cascadeAreas[i].halfSize = 0.0f;
+		m_cascadeAreas[i].radius = 0.0f;
+	}
+	for (int i = 0; i < LAYER_COUNT; i++)
+	{
+		m_layerViewProjections[i] = glm::mat4(1.0f);
+		m_bLayerStale[i] = false;
+	}
+	m_bInvalid = true;
+	m_bDrawn = false;
+	m_shadowBlock = {};
+	m_bBlockChanged = true;
+	m_bDrawing = false;
+	m_savedFramebuffer = 0;
+	for (int i = 0; i < 4; i++)
+	{
+		m_savedViewport[i] = 0;
+	}
+	m_savedProgram = 0;
+}
+
+/***********************************************************
+ *  ~ShadowMaps()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ShadowMaps::~ShadowMaps()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the depth texture array,
+ *  the framebuffer, the shadow block buffer and the program.
+ ***********************************************************/
+void ShadowMaps::Destroy()
+{
+	if (0 != m_depthTexture)
+	{
+		GLState::ForgetTexture(m_depthTexture);
+		glDeleteTextures(1, &m_depthTexture);
+		m_depthTexture = 0;
+	}
+	if (0 != m_framebuffer)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		m_framebuffer = 0;
+	}
+	if (0 != m_shadowBuffer)
+	{
+		glDeleteBuffers(1, &m_shadowBuffer);
+		m_shadowBuffer = 0;
+	}
+	if (0 != m_depthProgram)
+	{
+		glDeleteProgram(m_depthProgram);
+		m_depthProgram = 0;
+	}
+	m_bDrawn = false;
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for creating the depth texture array
+ *  with one layer per map, the framebuffer that draws into
+ *  one layer at a time, the shadow block buffer and the depth
+ *  only shader.  It returns false when any of them cannot be
+ *  created, in which case the scene is drawn without shadows.
+ ***********************************************************/
+bool ShadowMaps::Initialize()
+{
+	if (0 != m_depthProgram)
+	{
+		return(true);
+	}
+	if (BuildDepthProgram() == false)
+	{
+		return(false);
+	}
+
+	// the maps are compared in the sampler with linear filtering,
+	// and everything outside of a map is lit
+	const GLfloat borderColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	glGenTextures(1, &m_depthTexture);
+	GLState::ActiveTexture(SHADOW_TEXTURE_UNIT);
+	GLState::BindTexture(GL_TEXTURE_2D_ARRAY, m_depthTexture);
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, MAP_SIZE, MAP_SIZE, LAYER_COUNT, 0,
+		GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+	glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderColor);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+	GLState::ActiveTexture(0);
+
+	GLint framebuffer = 0;
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+	glGenFramebuffers(1, &m_framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_depthTexture, 0, 0);
+	glDrawBuffer(GL_NONE);
+	glReadBuffer(GL_NONE);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)framebuffer);
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "ERROR: the shadow map framebuffer is not complete" << std::endl;
+		Destroy();
+		return(false);
+	}
+
+	glGenBuffers(1, &m_shadowBuffer);
+	glBindBuffer(GL_UNIFORM_BUFFER, m_shadowBuffer);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(SHADOW_BLOCK_STD140), NULL, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	m_bBlockChanged = true;
+	m_bInvalid = true;
+
+	return(true);
+}
+
+/***********************************************************
+ *  BuildDepthProgram()
+ *
+ *  This method is used for compiling and linking the depth
+ *  only shader that the casters are drawn into the maps with.
+ ***********************************************************/
+bool ShadowMaps::BuildDepthProgram()
+{
+	GLint success = 0;
+	GLchar infoLog[512];
+
+	GLuint vertexShader = CompileDepthShader(GL_VERTEX_SHADER, g_DepthVertexSource, "vertex");
+	if (0 == vertexShader)
+	{
+		return(false);
+	}
+	GLuint fragmentShader = CompileDepthShader(GL_FRAGMENT_SHADER, g_DepthFragmentSource, "fragment");
+	if (0 == fragmentShader)
+	{
+		glDeleteShader(vertexShader);
+		return(false);
+	}
+
+	m_depthProgram = glCreateProgram();
+	glAttachShader(m_depthProgram, vertexShader);
+	glAttachShader(m_depthProgram, fragmentShader);
+	glLinkProgram(m_depthProgram);
+	glDeleteShader(vertexShader);
+	glDeleteShader(fragmentShader);
+	glGetProgramiv(m_depthProgram, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		glGetProgramInfoLog(m_depthProgram, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR: shadow map shader linking failed\n" << infoLog << std::endl;
+		glDeleteProgram(m_depthProgram);
+		m_depthProgram = 0;
+		return(false);
+	}
+
+	m_modelLocation = glGetUniformLocation(m_depthProgram, "model");
+	m_viewProjectionLocation = glGetUniformLocation(m_depthProgram, "lightViewProjection");
+
+	return(true);
+}
+
+/***********************************************************
+ *  SetLights()
+ *
+ *  This method is used for setting the shadow casting lights,
+ *  and drawing every map again when one of them changed.
+ ***********************************************************/
+void ShadowMaps::SetLights(int cascadeLight, const glm::vec3& cascadeDirection,
+	int spotLight, const glm::vec3& spotPosition, const glm::vec3& spotDirection)
+{
+	if ((cascadeLight == m_cascadeLight) && (cascadeDirection == m_cascadeDirection) &&
+		(spotLight == m_spotLight) && (spotPosition == m_spotPosition) && (spotDirection == m_spotDirection))
+	{
+		return;
+	}
+
+	m_cascadeLight = cascadeLight;
+	m_cascadeDirection = cascadeDirection;
+	m_spotLight = spotLight;
+	m_spotPosition = spotPosition;
+	m_spotDirection = spotDirection;
+	m_bInvalid = true;
+}
+
+/***********************************************************
+ *  SetCasterBounds()
+ *
+ *  This method is used for setting the box around all of the
+ *  casters, which the depth range of the cascades and the
+ *  cone of the spot map are fitted to.
+ ***********************************************************/
+void ShadowMaps::SetCasterBounds(const FrustumCuller::BOUNDS& bounds)
+{
+	if ((m_bCasterBounds == true) && (bounds.min == m_casterBounds.min) && (bounds.max == m_casterBounds.max))
+	{
+		return;
+	}
+
+	m_casterBounds = bounds;
+	m_bCasterBounds = true;
+	m_bInvalid = true;
+}
+
+/***********************************************************
+ *  Invalidate()
+ *
+ *  This method is used for drawing every map again in the
+ *  next frame, after casters were added, removed or moved.
+ ***********************************************************/
+void ShadowMaps::Invalidate()
+{
+	m_bInvalid = true;
+}
+
+/***********************************************************
+ *  SetView()
+ *
+ *  This method is used for setting the view that the cascades
+ *  are fitted to, keeping the world space corners of its
+ *  near and far planes.
+ ***********************************************************/
+void ShadowMaps::SetView(const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane)
+{
+	glm::mat4 inverseViewProjection = glm::inverse(projection * view);
+
+	for (int i = 0; i < 4; i++)
+	{
+		float x = (i & 1) ? 1.0f : -1.0f;
+		float y = (i & 2) ? 1.0f : -1.0f;
+		glm::vec4 nearCorner = inverseViewProjection * glm::vec4(x, y, -1.0f, 1.0f);
+		glm::vec4 farCorner = inverseViewProjection * glm::vec4(x, y, 1.0f, 1.0f);
+		m_nearCorners[i] = glm::vec3(nearCorner) / nearCorner.w;
+		m_farCorners[i] = glm::vec3(farCorner) / farCorner.w;
+	}
+
+	m_nearPlane = nearPlane;
+	m_farPlane = farPlane;
+	m_bView = (farPlane > nearPlane);
+}
+
+/***********************************************************
+ *  PrepareLayers()
+ *
+ *  This method is used for fitting the maps to the lights and
+ *  the view, and finding the ones that must be drawn again.
+ *  The values of the shadow block are only uploaded in
+ *  EndLayers when they changed.
+ ***********************************************************/
+int ShadowMaps::PrepareLayers()
+{
+	for (int i = 0; i < LAYER_COUNT; i++)
+	{
+		m_bLayerStale[i] = false;
+	}
+	if ((0 == m_depthProgram) || (m_bCasterBounds == false))
+	{
+		return(0);
+	}
+
+	if ((m_spotLight >= 0) && (m_bInvalid == true))
+	{
+		FitSpotLight();
+		m_bLayerStale[SPOT_LAYER] = true;
+	}
+
+	// the split distances blend a logarithmic and an even split of
+	// the depth range that has shadows
+	float splits[CASCADE_COUNT + 1] = {};
+	if ((m_cascadeLight >= 0) && (m_bView == true))
+	{
+		float shadowFar = std::min(m_farPlane, g_ShadowDistance);
+		splits[0] = m_nearPlane;
+		for (int i = 1; i <= CASCADE_COUNT; i++)
+		{
+			float fraction = (float)i / (float)CASCADE_COUNT;
+			float logSplit = m_nearPlane * std::pow(shadowFar / m_nearPlane, fraction);
+			float evenSplit = m_nearPlane + (shadowFar - m_nearPlane) * fraction;
+			splits[i] = g_SplitWeight * logSplit + (1.0f - g_SplitWeight) * evenSplit;
+		}
+		for (int i = 0; i < CASCADE_COUNT; i++)
+		{
+			m_bLayerStale[i] = FitCascade(i, splits[i], splits[i + 1]);
+		}
+	}
+	m_bInvalid = false;
+
+	int staleCount = 0;
+	for (int i = 0; i < LAYER_COUNT; i++)
+	{
+		if (m_bLayerStale[i] == true)
+		{
+			staleCount++;
+		}
+	}
+
+	// the matrices of the block also map the clip space of each
+	// map into its texture coordinates and depth
+	glm::mat4 bias = glm::translate(glm::mat4(1.0f), glm::vec3(0.5f)) * glm::scale(glm::mat4(1.0f), glm::vec3(0.5f));
+	SHADOW_BLOCK_STD140 shadowBlock = {};
+	for (int i = 0; i < LAYER_COUNT; i++)
+	{
+		shadowBlock.shadowMatrices[i] = bias * m_layerViewProjections[i];
+	}
+	shadowBlock.cascadeSplits = glm::vec4(splits[1], splits[2], splits[3],
+		((m_bDrawn == true) || (staleCount > 0)) ? 1.0f : 0.0f);
+	shadowBlock.shadowLights[0] = m_bView ? m_cascadeLight : -1;
+	shadowBlock.shadowLights[1] = m_spotLight;
+	shadowBlock.shadowLights[2] = CASCADE_COUNT;
+	shadowBlock.shadowLights[3] = 0;
+	if (memcmp(&shadowBlock, &m_shadowBlock, sizeof(SHADOW_BLOCK_STD140)) != 0)
+	{
+		m_shadowBlock = shadowBlock;
+		m_bBlockChanged = true;
+	}
+
+	return(staleCount);
+}
+
+/***********************************************************
+ *  IsLayerStale()
+ *
+ *  This method is used for checking whether a map must be
+ *  drawn again in this frame.
+ ***********************************************************/
+bool ShadowMaps::IsLayerStale(int layer) const
+{
+	return((layer >= 0) && (layer < LAYER_COUNT) && (m_bLayerStale[layer] == true));
+}
+
+/***********************************************************
+ *  GetLayerViewProjection()
+ *
+ *  This method is used for getting the view-projection that
+ *  a map is drawn with, for culling the casters against it.
+ ***********************************************************/
+const glm::mat4& ShadowMaps::GetLayerViewProjection(int layer) const
+{
+	return(m_layerViewProjections[layer]);
+}
+
+/***********************************************************
+ *  GetCascadeLightView()
+ *
+ *  This method is used for getting the view of the cascade
+ *  light, which looks along the light direction from the
+ *  world origin.
+ ***********************************************************/
+glm::mat4 ShadowMaps::GetCascadeLightView() const
+{
+	glm::vec3 direction = glm::normalize(m_cascadeDirection);
+	return(glm::lookAt(glm::vec3(0.0f), direction, GetLightUp(direction)));
+}
+
+/***********************************************************
+ *  FitCascade()
+ *
+ *  This method is used for fitting one cascade to a depth
+ *  slice of the view.  The slice is bounded by a sphere,
+ *  which keeps the size of the cascade when the camera turns.
+ *  The cached cascade is kept while the sphere stays inside
+ *  the area it was drawn for, and otherwise the area is
+ *  centered on the sphere again, snapped to whole texels.
+ ***********************************************************/
+bool ShadowMaps::FitCascade(int cascade, float sliceNear, float sliceFar)
+{
+	glm::vec3 corners[8];
+	float nearFraction = (sliceNear - m_nearPlane) / (m_farPlane - m_nearPlane);
+	float farFraction = (sliceFar - m_nearPlane) / (m_farPlane - m_nearPlane);
+	glm::vec3 center(0.0f);
+	for (int i = 0; i < 4; i++)
+	{
+		corners[i] = glm::mix(m_nearCorners[i], m_farCorners[i], nearFraction);
+		corners[i + 4] = glm::mix(m_nearCorners[i], m_farCorners[i], farFraction);
+	}
+	for (int i = 0; i < 8; i++)
+	{
+		center += corners[i];
+	}
+	center /= 8.0f;
+
+	float radius = 0.0f;
+	for (int i = 0; i < 8; i++)
+	{
+		radius = std::max(radius, glm::length(corners[i] - center));
+	}
+	// rounded up so the size does not change by rounding errors
+	radius = std::ceil(radius * 16.0f) / 16.0f;
+
+	glm::mat4 lightView = GetCascadeLightView();
+	glm::vec4 lightCenter = lightView * glm::vec4(center, 1.0f);
+
+	CASCADE_AREA& area = m_cascadeAreas[cascade];
+	bool bStale = (m_bInvalid == true) ||
+		(radius > area.radius) || (radius < area.radius * 0.75f) ||
+		(std::fabs(lightCenter.x - area.center.x) + radius > area.halfSize) ||
+		(std::fabs(lightCenter.y - area.center.y) + radius > area.halfSize);
+	if (bStale == false)
+	{
+		return(false);
+	}
+
+	area.radius = radius;
+	area.halfSize = radius * g_CascadeMargin;
+	float texelSize = (2.0f * area.halfSize) / (float)MAP_SIZE;
+	area.center = glm::vec2(std::floor(lightCenter.x / texelSize) * texelSize,
+		std::floor(lightCenter.y / texelSize) * texelSize);
+
+	// every caster between the light and the slice must be in the
+	// depth range, so it is taken from the box of all casters
+	glm::vec3 casterCorners[8];
+	GetBoxCorners(m_casterBounds, casterCorners);
+	float minZ = 0.0f;
+	float maxZ = 0.0f;
+	for (int i = 0; i < 8; i++)
+	{
+		float z = (lightView * glm::vec4(casterCorners[i], 1.0f)).z;
+		minZ = (i == 0) ? z : std::min(minZ, z);
+		maxZ = (i == 0) ? z : std::max(maxZ, z);
+	}
+
+	glm::mat4 projection = glm::ortho(
+		area.center.x - area.halfSize, area.center.x + area.halfSize,
+		area.center.y - area.halfSize, area.center.y + area.halfSize,
+		-maxZ - g_DepthPadding, -minZ + g_DepthPadding);
+	m_layerViewProjections[cascade] = projection * lightView;
+
+	return(true);
+}
+
+/***********************************************************
+ *  FitSpotLight()
+ *
+ *  This method is used for fitting the cone of the spot map
+ *  around the corners of the caster box in front of the
+ *  light, within a range of angles.
+ ***********************************************************/
+void ShadowMaps::FitSpotLight()
+{
+	glm::vec3 direction = glm::normalize(m_spotDirection);
+	glm::mat4 lightView = glm::lookAt(m_spotPosition, m_spotPosition + direction, GetLightUp(direction));
+
+	glm::vec3 casterCorners[8];
+	GetBoxCorners(m_casterBounds, casterCorners);
+	float maxSlope = 0.0f;
+	float farDepth = g_SpotNearPlane;
+	for (int i = 0; i < 8; i++)
+	{
+		glm::vec4 corner = lightView * glm::vec4(casterCorners[i], 1.0f);
+		float depth = -corner.z;
+		if (depth <= g_SpotNearPlane)
+		{
+			continue;
+		}
+		maxSlope = std::max(maxSlope, std::max(std::fabs(corner.x), std::fabs(corner.y)) / depth);
+		farDepth = std::max(farDepth, depth);
+	}
+
+	float halfAngle = glm::degrees(std::atan(maxSlope)) + 1.0f;
+	halfAngle = std::min(std::max(halfAngle, g_SpotMinHalfAngle), g_SpotMaxHalfAngle);
+	glm::mat4 projection = glm::perspective(glm::radians(2.0f * halfAngle), 1.0f,
+		g_SpotNearPlane, farDepth + g_DepthPadding);
+	m_layerViewProjections[SPOT_LAYER] = projection * lightView;
+}
+
+/***********************************************************
+ *  BeginLayer()
+ *
+ *  This method is used for clearing one map and drawing the
+ *  following casters into it.  The first map of a frame also
+ *  saves the framebuffer, viewport and program of the scene.
+ ***********************************************************/
+void ShadowMaps::BeginLayer(int layer)
+{
+	if (m_bDrawing == false)
+	{
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_savedFramebuffer);
+		glGetIntegerv(GL_VIEWPORT, m_savedViewport);
+		m_savedProgram = GLState::GetProgram();
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+		glViewport(0, 0, MAP_SIZE, MAP_SIZE);
+		GLState::UseProgram(m_depthProgram);
+		GLState::Enable(GL_DEPTH_TEST);
+		GLState::DepthMask(GL_TRUE);
+		GLState::DepthFunc(GL_LESS);
+		GLState::Enable(GL_POLYGON_OFFSET_FILL);
+		glPolygonOffset(g_PolygonOffsetFactor, g_PolygonOffsetUnits);
+		m_bDrawing = true;
+	}
+
+	glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_depthTexture, 0, layer);
+	glClear(GL_DEPTH_BUFFER_BIT);
+	GLState::UniformMatrix4(m_viewProjectionLocation, m_layerViewProjections[layer]);
+}
+
+/***********************************************************
+ *  SetCasterModel()
+ *
+ *  This method is used for setting the model matrix of the
+ *  next caster drawn into the map.
+ ***********************************************************/
+void ShadowMaps::SetCasterModel(const glm::mat4& model)
+{
+	GLState::UniformMatrix4(m_modelLocation, model);
+}
+
+/***********************************************************
+ *  EndLayers()
+ *
+ *  This method is used for going back to the framebuffer,
+ *  viewport and program of the scene after maps were drawn,
+ *  and for binding the maps and the shadow block that the
+ *  shading pass reads.  It is called every frame, so the
+ *  block is current even when no map was drawn.
+ ***********************************************************/
+void ShadowMaps::EndLayers()
+{
+	if (0 == m_depthProgram)
+	{
+		return;
+	}
+
+	if (m_bDrawing == true)
+	{
+		GLState::Disable(GL_POLYGON_OFFSET_FILL);
+		glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)m_savedFramebuffer);
+		glViewport(m_savedViewport[0], m_savedViewport[1], m_savedViewport[2], m_savedViewport[3]);
+		GLState::UseProgram(m_savedProgram);
+		m_bDrawing = false;
+		m_bDrawn = true;
+	}
+
+	if (m_bBlockChanged == true)
+	{
+		glBindBuffer(GL_UNIFORM_BUFFER, m_shadowBuffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(SHADOW_BLOCK_STD140), &m_shadowBlock);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		m_bBlockChanged = false;
+	}
+	glBindBufferBase(GL_UNIFORM_BUFFER, SHADOW_BLOCK_BINDING, m_shadowBuffer);
+
+	GLState::ActiveTexture(SHADOW_TEXTURE_UNIT);
+	GLState::BindTexture(GL_TEXTURE_2D_ARRAY, m_depthTexture);
+	GLState::ActiveTexture(0);
+}
@@ -0,0 +1,171 @@
+///////////////////////////////////////////////////////////////////////////////
+// shadowmaps.h
+// ============
+// cached shadow maps of the directional and the spot light of the scene
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "FrustumCuller.h"
+
+/***********************************************************
+ *  ShadowMaps
+ *
+ *  This class contains the code for the shadow maps of two
+ *  scene lights, kept as the layers of one depth texture
+ *  array.  The directional light has a few cascades, each
+ *  covering one depth slice of the view, and the spot light
+ *  has one perspective map that covers every shadow caster.
+ *
+ *  The maps only hold the static casters and are kept from
+ *  frame to frame.  A map is drawn again when the casters or
+ *  the light move, and a cascade also when the slice of the
+ *  view has left the area it was drawn for.  Each cascade is
+ *  drawn for an area a little larger than its slice, snapped
+ *  to whole texels, so a moving camera only redraws it once
+ *  in a while and the shadow edges do not crawl.  On every
+ *  other frame the shadows cost the shading pass one texture
+ *  lookup, which the fragment shader does as:
+ *
+ *    layout(std140) uniform ShadowBlock
+ *    {
+ *        mat4 shadowMatrices[4];    // the cascades, then the spot map
+ *        vec4 cascadeSplits;        // view depth at the end of each cascade, w = 1 once drawn
+ *        ivec4 shadowLights;        // index of the cascade and the spot light, -1 for none
+ *    };
+ *    uniform sampler2DArrayShadow shadowMaps;
+ *
+ *    float viewDepth = -(view * vec4(fragmentPosition, 1.0)).z;
+ *    int layer = (viewDepth < cascadeSplits.x) ? 0 : ((viewDepth < cascadeSplits.y) ? 1 : 2);
+ *    ... for lightSources[shadowLights.y] use layer 3 ...
+ *    vec4 shadowPosition = shadowMatrices[layer] * vec4(fragmentPosition, 1.0);
+ *    shadowPosition.xyz /= shadowPosition.w;
+ *    float lit = texture(shadowMaps, vec4(shadowPosition.xy, layer, shadowPosition.z));
+ *
+ *  with a fragment beyond the last cascade, or any fragment
+ *  while cascadeSplits.w is 0, fully lit.
+ ***********************************************************/
+class ShadowMaps
+{
+public:
+	// constructor
+	ShadowMaps();
+	// destructor
+	~ShadowMaps();
+
+	// cascades of the directional light, and the layer of the spot light
+	static const int CASCADE_COUNT = 3;
+	static const int SPOT_LAYER = CASCADE_COUNT;
+	static const int LAYER_COUNT = CASCADE_COUNT + 1;
+	// width and height of every map in texels
+	static const int MAP_SIZE = 2048;
+
+	// uniform buffer binding point of the shadow block
+	static const GLuint SHADOW_BLOCK_BINDING = 4;
+	// texture unit that the maps are bound to for sampling
+	static const GLuint SHADOW_TEXTURE_UNIT = 30;
+
+	// create the depth texture array, framebuffer and depth shader
+	bool Initialize();
+
+	// the lights casting the shadows, by their index in the scene
+	// lights, with -1 for no light
+	void SetLights(int cascadeLight, const glm::vec3& cascadeDirection,
+		int spotLight, const glm::vec3& spotPosition, const glm::vec3& spotDirection);
+	// the box around every shadow caster
+	void SetCasterBounds(const FrustumCuller::BOUNDS& bounds);
+	// draw every map again, after the casters moved
+	void Invalidate();
+	// fit the cascades to the depth slices of this view
+	void SetView(const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane);
+
+	// find the maps that must be drawn again, returning how many
+	int PrepareLayers();
+	bool IsLayerStale(int layer) const;
+	// view-projection that a map layer is drawn with
+	const glm::mat4& GetLayerViewProjection(int layer) const;
+
+	// start drawing the casters into one stale map
+	void BeginLayer(int layer);
+	// set the model matrix of the next caster drawn
+	void SetCasterModel(const glm::mat4& model);
+	// finish the maps, and bind them and their block for shading
+	void EndLayers();
+
+private:
+	// the area a cascade was last drawn for, in light space
+	struct CASCADE_AREA
+	{
+		glm::vec2 center;
+		float halfSize;
+		float radius;
+	};
+
+	// std140 layout of the shadow block
+	struct SHADOW_BLOCK_STD140
+	{
+		glm::mat4 shadowMatrices[LAYER_COUNT];
+		glm::vec4 cascadeSplits;
+		GLint shadowLights[4];
+	};
+
+	// depth texture array, the framebuffer drawing into it and
+	// the block the shading pass reads
+	GLuint m_depthTexture;
+	GLuint m_framebuffer;
+	GLuint m_shadowBuffer;
+	// depth only shader program and its uniform locations
+	GLuint m_depthProgram;
+	GLint m_modelLocation;
+	GLint m_viewProjectionLocation;
+
+	// the shadow casting lights
+	int m_cascadeLight;
+	glm::vec3 m_cascadeDirection;
+	int m_spotLight;
+	glm::vec3 m_spotPosition;
+	glm::vec3 m_spotDirection;
+	FrustumCuller::BOUNDS m_casterBounds;
+	bool m_bCasterBounds;
+
+	// corners of the view at the near and the far plane, which
+	// the cascades are fitted to
+	bool m_bView;
+	glm::vec3 m_nearCorners[4];
+	glm::vec3 m_farCorners[4];
+	float m_nearPlane;
+	float m_farPlane;
+
+	// the cached maps
+	CASCADE_AREA m_cascadeAreas[CASCADE_COUNT];
+	glm::mat4 m_layerViewProjections[LAYER_COUNT];
+	bool m_bLayerStale[LAYER_COUNT];
+	bool m_bInvalid;
+	bool m_bDrawn;
+	// block values last uploaded, and whether they changed since
+	SHADOW_BLOCK_STD140 m_shadowBlock;
+	bool m_bBlockChanged;
+
+	// state that the drawn maps are restored to
+	bool m_bDrawing;
+	GLint m_savedFramebuffer;
+	GLint m_savedViewport[4];
+	GLuint m_savedProgram;
+
+	// light view of the directional light, looking along its direction
+	glm::mat4 GetCascadeLightView() const;
+	// fit one cascade to a slice, returning true when it must be drawn
+	bool FitCascade(int cascade, float sliceNear, float sliceFar);
+	// fit the spot map around the casters
+	void FitSpotLight();
+	// compile and link the depth only shader program
+	bool BuildDepthProgram();
+	// free the texture, framebuffer, buffer and program
+	void Destroy();
+};
@@ -0,0 +1,287 @@
+///////////////////////////////////////////////////////////////////////////////
+// staticbatch.cpp
+// ============
+// merge static objects into shared buffers drawn with indirect draw calls
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "StaticBatch.h"
+#include "MeshLibrary.h"
+#include "GLState.h"
+
+// declaration of global variables
+namespace
+{
+	const int g_FloatsPerVertex = MeshLibrary::FLOATS_PER_VERTEX;
+
+	static_assert(sizeof(StaticBatch::DRAW_DATA) == 32, "draw data must match the std430 layout");
+
+	/***********************************************************
+	 *  IsSameDrawData()
+	 *
+	 *  Check whether two objects can share one indirect command.
+	 ***********************************************************/
+	bool IsSameDrawData(const StaticBatch::DRAW_DATA& a, const StaticBatch::DRAW_DATA& b)
+	{
+		return((a.color == b.color) &&
+			(a.uvScale == b.uvScale) &&
+			(a.materialIndex == b.materialIndex));
+	}
+}
+
+/***********************************************************
+ *  StaticBatch()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+StaticBatch::StaticBatch()
+{
+	m_objectCount = 0;
+	m_vao = 0;
+	m_vertexBuffer = 0;
+	m_indexBuffer = 0;
+	m_commandBuffer = 0;
+	m_drawDataBuffer = 0;
+}
+
+/***********************************************************
+ *  ~StaticBatch()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+StaticBatch::~StaticBatch()
+{
+	DestroyBuffers();
+}
+
+/***********************************************************
+ *  DestroyBuffers()
+ *
+ *  This method is used for freeing the uploaded buffers.
+ ***********************************************************/
+void StaticBatch::DestroyBuffers()
+{
+	if (0 != m_vao)
+	{
+		GLState::ForgetVertexArray(m_vao);
+		glDeleteVertexArrays(1, &m_vao);
+		m_vao = 0;
+	}
+
+	GLuint buffers[4] = { m_vertexBuffer, m_indexBuffer, m_commandBuffer, m_drawDataBuffer };
+	for (int i = 0; i < 4; i++)
+	{
+		if (0 != buffers[i])
+		{
+			glDeleteBuffers(1, &buffers[i]);
+		}
+	}
+	m_vertexBuffer = 0;
+	m_indexBuffer = 0;
+	m_commandBuffer = 0;
+	m_drawDataBuffer = 0;
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing the geometry of all the
+ *  batches, both the baked and the uploaded copies.
+ ***********************************************************/
+void StaticBatch::Clear()
+{
+	m_vertices.clear();
+	m_indices.clear();
+	m_commands.clear();
+	m_drawData.clear();
+	m_batches.clear();
+	m_objectCount = 0;
+
+	DestroyBuffers();
+}
+
+/***********************************************************
+ *  BeginBatch()
+ *
+ *  This method is used for starting a new batch.  The objects
+ *  added after this call are drawn by one indirect call.
+ ***********************************************************/
+void StaticBatch::BeginBatch()
+{
+	BATCH batch;
+	batch.firstCommand = (int)m_commands.size();
+	batch.commandCount = 0;
+	m_batches.push_back(batch);
+}
+
+/***********************************************************
+ *  AddGeometry()
+ *
+ *  This method is used for baking the passed in vertices into
+ *  world space and adding them to the current batch.  Objects
+ *  added one after the other with the same draw data extend
+ *  the same indirect command.
+ ***********************************************************/
+void StaticBatch::AddGeometry(
+	const std::vector<GLfloat>& vertices,
+	const std::vector<GLuint>& indices,
+	const glm::mat4& model,
+	const DRAW_DATA& drawData)
+{
+	if (m_batches.size() == 0)
+	{
+		BeginBatch();
+	}
+
+	// normals are transformed by the inverse transpose, so that
+	// they stay perpendicular with non-uniform scales
+	glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+	GLuint firstVertex = (GLuint)(m_vertices.size() / g_FloatsPerVertex);
+
+	for (int i = 0; i + g_FloatsPerVertex <= vertices.size(); i += g_FloatsPerVertex)
+	{
+		glm::vec3 position = glm::vec3(model * glm::vec4(vertices[i], vertices[i + 1], vertices[i + 2], 1.0f));
+		glm::vec3 normal = glm::normalize(normalMatrix * glm::vec3(vertices[i + 3], vertices[i + 4], vertices[i + 5]));
+
+		m_vertices.push_back(position.x);
+		m_vertices.push_back(position.y);
+		m_vertices.push_back(position.z);
+		m_vertices.push_back(normal.x);
+		m_vertices.push_back(normal.y);
+		m_vertices.push_back(normal.z);
+		m_vertices.push_back(vertices[i + 6]);
+		m_vertices.push_back(vertices[i + 7]);
+	}
+
+	BATCH& batch = m_batches.back();
+	if ((batch.commandCount == 0) || (IsSameDrawData(m_drawData.back(), drawData) == false))
+	{
+		DRAW_COMMAND command;
+		command.count = 0;
+		command.instanceCount = 1;
+		command.firstIndex = (GLuint)m_indices.size();
+		command.baseVertex = 0;
+		command.baseInstance = (GLuint)m_drawData.size();
+		m_commands.push_back(command);
+		m_drawData.push_back(drawData);
+		batch.commandCount++;
+	}
+
+	for (int i = 0; i < indices.size(); i++)
+	{
+		m_indices.push_back(firstVertex + indices[i]);
+	}
+	m_commands.back().count += (GLuint)indices.size();
+	m_objectCount++;
+}
+
+/***********************************************************
+ *  Upload()
+ *
+ *  This method is used for uploading the baked vertices and
+ *  indices, the indirect commands and the draw data into
+ *  buffers.  The baked copies are freed afterwards.
+ ***********************************************************/
+void StaticBatch::Upload()
+{
+	const GLint stride = sizeof(GLfloat) * g_FloatsPerVertex;
+
+	DestroyBuffers();
+	if (m_commands.size() == 0)
+	{
+		return;
+	}
+
+	glGenVertexArrays(1, &m_vao);
+	GLState::BindVertexArray(m_vao);
+
+	glGenBuffers(1, &m_vertexBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(GLfloat), m_vertices.data(), GL_STATIC_DRAW);
+	glGenBuffers(1, &m_indexBuffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(GLuint), m_indices.data(), GL_STATIC_DRAW);
+
+	// vertex position, normal and texture coordinate
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(GLfloat) * 3));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(GLfloat) * 6));
+	glEnableVertexAttribArray(2);
+
+	GLState::BindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glGenBuffers(1, &m_commandBuffer);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+	glBufferData(GL_DRAW_INDIRECT_BUFFER, m_commands.size() * sizeof(DRAW_COMMAND), m_commands.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+	glGenBuffers(1, &m_drawDataBuffer);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_drawDataBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, m_drawData.size() * sizeof(DRAW_DATA), m_drawData.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	// the geometry now only lives in the buffers
+	std::vector<GLfloat>().swap(m_vertices);
+	std::vector<GLuint>().swap(m_indices);
+}
+
+/***********************************************************
+ *  GetBatchCount()
+ *
+ *  This method is used for getting the number of batches,
+ *  which is the number of draw calls for all of them.
+ ***********************************************************/
+int StaticBatch::GetBatchCount() const
+{
+	return((int)m_batches.size());
+}
+
+/***********************************************************
+ *  GetObjectCount()
+ *
+ *  This method is used for getting the number of objects that
+ *  were merged into the batches.
+ ***********************************************************/
+int StaticBatch::GetObjectCount() const
+{
+	return(m_objectCount);
+}
+
+/***********************************************************
+ *  DrawBatch()
+ *
+ *  This method is used for drawing all of the indirect
+ *  commands of one batch with one draw call.  The shader state
+ *  shared by the batch must already be set.
+ ***********************************************************/
+void StaticBatch::DrawBatch(int batchIndex)
+{
+	if ((0 == m_vao) || (batchIndex < 0) || (batchIndex >= m_batches.size()))
+	{
+		return;
+	}
+
+	const BATCH& batch = m_batches[batchIndex];
+	if (batch.commandCount == 0)
+	{
+		return;
+	}
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DRAW_BLOCK_BINDING, m_drawDataBuffer);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+	GLState::BindVertexArray(m_vao);
+
+	glMultiDrawElementsIndirect(
+		GL_TRIANGLES,
+		GL_UNSIGNED_INT,
+		(void*)(sizeof(DRAW_COMMAND) * batch.firstCommand),
+		batch.commandCount,
+		0);
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
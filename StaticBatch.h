@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////////
+// staticbatch.h
+// ============
+// merge static objects into shared buffers drawn with indirect draw calls
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  StaticBatch
+ *
+ *  This class contains the code for baking the geometry of
+ *  objects that never move into one shared vertex and index
+ *  buffer, already transformed into world space.  The objects
+ *  are split into batches, and each batch is drawn with one
+ *  glMultiDrawElementsIndirect call, with one indirect command
+ *  per run of objects with the same color, UV scale and
+ *  material.  The base instance of each command is the index
+ *  of its values in the draw data storage buffer:
+ *
+ *    struct StaticDraw
+ *    {
+ *        vec4 color;
+ *        vec2 uvScale;
+ *        int materialIndex;
+ *        int padding;
+ *    };
+ *    layout(std430) buffer StaticDrawBlock
+ *    {
+ *        StaticDraw staticDraws[];
+ *    };
+ *    uniform bool bUseStaticBatch;
+ *    ... staticDraws[gl_BaseInstance] ...
+ *
+ *  With bUseStaticBatch set, the vertex shader uses the vertex
+ *  positions and normals as they are, without a model matrix.
+ ***********************************************************/
+class StaticBatch
+{
+public:
+	// constructor
+	StaticBatch();
+	// destructor
+	~StaticBatch();
+
+	// std430 layout of the values of one indirect command
+	struct DRAW_DATA
+	{
+		glm::vec4 color;
+		glm::vec2 uvScale;
+		GLint materialIndex;
+		GLint padding;
+	};
+
+	// shader storage buffer binding point of the draw data
+	static const GLuint DRAW_BLOCK_BINDING = 2;
+
+	// remove the geometry of all the batches
+	void Clear();
+	// start a new batch, drawn by its own indirect draw call
+	void BeginBatch();
+	// add the geometry of one object to the current batch
+	void AddGeometry(
+		const std::vector<GLfloat>& vertices,
+		const std::vector<GLuint>& indices,
+		const glm::mat4& model,
+		const DRAW_DATA& drawData);
+	// upload the baked geometry and the indirect commands
+	void Upload();
+
+	// number of batches and of merged objects
+	int GetBatchCount() const;
+	int GetObjectCount() const;
+	// draw all of the commands of one batch with one call
+	void DrawBatch(int batchIndex);
+
+private:
+	// layout of one glMultiDrawElementsIndirect command
+	struct DRAW_COMMAND
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+
+	// range of indirect commands drawn by one call
+	struct BATCH
+	{
+		int firstCommand;
+		int commandCount;
+	};
+
+	// baked geometry and commands waiting for the upload
+	std::vector<GLfloat> m_vertices;
+	std::vector<GLuint> m_indices;
+	std::vector<DRAW_COMMAND> m_commands;
+	std::vector<DRAW_DATA> m_drawData;
+	std::vector<BATCH> m_batches;
+	int m_objectCount;
+
+	// buffers of the uploaded batches
+	GLuint m_vao;
+	GLuint m_vertexBuffer;
+	GLuint m_indexBuffer;
+	GLuint m_commandBuffer;
+	GLuint m_drawDataBuffer;
+
+	// free the uploaded buffers
+	void DestroyBuffers();
+};
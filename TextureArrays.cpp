@@ -0,0 +1,268 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturearrays.cpp
+// ============
+// pack same-sized textures into the layers of 2D array textures
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureArrays.h"
+#include "GLState.h"
+
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// layers reserved when an array is created, doubled when full
+	const GLint g_InitialLayerCapacity = 4;
+}
+
+/***********************************************************
+ *  TextureArrays()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TextureArrays::TextureArrays(GLint unitLimit)
+{
+	m_maxUnits = unitLimit;
+}
+
+/***********************************************************
+ *  ~TextureArrays()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TextureArrays::~TextureArrays()
+{
+	for (int i = 0; i < m_arrays.size(); i++)
+	{
+		GLState::ForgetTexture(m_arrays[i].arrayID);
+		glDeleteTextures(1, &m_arrays[i].arrayID);
+	}
+	m_arrays.clear();
+}
+
+/***********************************************************
+ *  GetArrayCount()
+ *
+ *  This method is used for getting the number of array
+ *  textures, each of which is bound to its own unit.
+ ***********************************************************/
+int TextureArrays::GetArrayCount() const
+{
+	return((int)m_arrays.size());
+}
+
+/***********************************************************
+ *  AddTexture()
+ *
+ *  This method is used for copying a loaded 2D texture into
+ *  the first free layer of the array with the same size and
+ *  format, creating or growing that array when needed.  The
+ *  texture unit of the array is the index of the array after
+ *  the first array unit.
+ ***********************************************************/
+bool TextureArrays::AddTexture(GLuint textureID, int& textureUnit, int& layer)
+{
+	TEXTURE_ARRAY description;
+	if (DescribeTexture(textureID, description) == false)
+	{
+		return(false);
+	}
+
+	int arrayIndex = -1;
+	for (int i = 0; (i < m_arrays.size()) && (arrayIndex < 0); i++)
+	{
+		if ((m_arrays[i].width == description.width) &&
+			(m_arrays[i].height == description.height) &&
+			(m_arrays[i].internalFormat == description.internalFormat) &&
+			(m_arrays[i].levels == description.levels))
+		{
+			arrayIndex = i;
+		}
+	}
+
+	if (arrayIndex < 0)
+	{
+		if (FIRST_ARRAY_UNIT + (GLint)m_arrays.size() >= m_maxUnits)
+		{
+			std::cout << "No texture unit left for a " << description.width << "x" << description.height << " texture array" << std::endl;
+			return(false);
+		}
+
+		description.arrayID = 0;
+		description.capacity = 0;
+		description.layerCount = 0;
+		m_arrays.push_back(description);
+		arrayIndex = (int)m_arrays.size() - 1;
+	}
+
+	TEXTURE_ARRAY& textureArray = m_arrays[arrayIndex];
+
+	// full arrays are replaced by one with twice the layers
+	if (textureArray.layerCount >= textureArray.capacity)
+	{
+		GLint capacity = (textureArray.capacity > 0) ? textureArray.capacity * 2 : g_InitialLayerCapacity;
+
+		// each array stays bound to the unit matching its index,
+		// so the new storage is created on that unit
+		GLState::ActiveTexture(FIRST_ARRAY_UNIT + arrayIndex);
+		GLuint arrayID = CreateArrayStorage(textureArray, capacity);
+
+		if (0 != textureArray.arrayID)
+		{
+			GLState::ForgetTexture(textureArray.arrayID);
+			glDeleteTextures(1, &textureArray.arrayID);
+		}
+		textureArray.arrayID = arrayID;
+		textureArray.capacity = capacity;
+	}
+
+	CopyLayer(textureID, textureArray, textureArray.layerCount);
+
+	textureUnit = FIRST_ARRAY_UNIT + arrayIndex;
+	layer = textureArray.layerCount;
+	textureArray.layerCount++;
+
+	return(true);
+}
+
+/***********************************************************
+ *  UpdateTexture()
+ *
+ *  This method is used for copying a reloaded 2D texture into
+ *  the layer it already occupies.  It returns false when the
+ *  texture no longer matches the size and format of the array.
+ ***********************************************************/
+bool TextureArrays::UpdateTexture(GLuint textureID, int textureUnit, int layer)
+{
+	TEXTURE_ARRAY description;
+	int arrayIndex = textureUnit - FIRST_ARRAY_UNIT;
+	if ((arrayIndex < 0) || (arrayIndex >= m_arrays.size()) ||
+		(DescribeTexture(textureID, description) == false))
+	{
+		return(false);
+	}
+
+	const TEXTURE_ARRAY& textureArray = m_arrays[arrayIndex];
+	if ((textureArray.width != description.width) ||
+		(textureArray.height != description.height) ||
+		(textureArray.internalFormat != description.internalFormat) ||
+		(textureArray.levels != description.levels) ||
+		(layer < 0) || (layer >= textureArray.layerCount))
+	{
+		return(false);
+	}
+
+	CopyLayer(textureID, textureArray, layer);
+
+	return(true);
+}
+
+/***********************************************************
+ *  DescribeTexture()
+ *
+ *  This method is used for reading the size, format and the
+ *  number of mipmap levels of a 2D texture.
+ ***********************************************************/
+bool TextureArrays::DescribeTexture(GLuint textureID, TEXTURE_ARRAY& description)
+{
+	GLint boundTexture = 0;
+	GLint maxLevel = 0;
+
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &boundTexture);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &description.width);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &description.height);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &description.internalFormat);
+	glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, &maxLevel);
+	glBindTexture(GL_TEXTURE_2D, boundTexture);
+
+	if ((description.width <= 0) || (description.height <= 0))
+	{
+		return(false);
+	}
+
+	// the levels of a complete mipmap chain, limited by the
+	// base texture when it was uploaded with fewer levels
+	GLint levels = 1;
+	GLint size = (description.width > description.height) ? description.width : description.height;
+	while (size > 1)
+	{
+		size /= 2;
+		levels++;
+	}
+	description.levels = (maxLevel + 1 < levels) ? maxLevel + 1 : levels;
+
+	return(true);
+}
+
+/***********************************************************
+ *  CreateArrayStorage()
+ *
+ *  This method is used for creating the storage of an array
+ *  texture with the passed in number of layers.  The layers
+ *  of the current array, if any, are copied into it.
+ ***********************************************************/
+GLuint TextureArrays::CreateArrayStorage(const TEXTURE_ARRAY& textureArray, GLint capacity)
+{
+	GLuint arrayID = 0;
+
+	glGenTextures(1, &arrayID);
+	GLState::BindTexture(GL_TEXTURE_2D_ARRAY, arrayID);
+	glTexStorage3D(
+		GL_TEXTURE_2D_ARRAY,
+		textureArray.levels,
+		textureArray.internalFormat,
+		textureArray.width,
+		textureArray.height,
+		capacity);
+
+	// the same wrapping and filtering as the 2D textures
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER,
+		(textureArray.levels > 1) ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	if ((0 != textureArray.arrayID) && (textureArray.layerCount > 0))
+	{
+		GLint width = textureArray.width;
+		GLint height = textureArray.height;
+		for (GLint level = 0; level < textureArray.levels; level++)
+		{
+			glCopyImageSubData(
+				textureArray.arrayID, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+				arrayID, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+				width, height, textureArray.layerCount);
+			width = (width > 1) ? width / 2 : 1;
+			height = (height > 1) ? height / 2 : 1;
+		}
+	}
+
+	return(arrayID);
+}
+
+/***********************************************************
+ *  CopyLayer()
+ *
+ *  This method is used for copying every mipmap level of a
+ *  2D texture into one layer of an array texture.
+ ***********************************************************/
+void TextureArrays::CopyLayer(GLuint textureID, const TEXTURE_ARRAY& textureArray, int layer)
+{
+	GLint width = textureArray.width;
+	GLint height = textureArray.height;
+
+	for (GLint level = 0; level < textureArray.levels; level++)
+	{
+		glCopyImageSubData(
+			textureID, GL_TEXTURE_2D, level, 0, 0, 0,
+			textureArray.arrayID, GL_TEXTURE_2D_ARRAY, level, 0, 0, layer,
+			width, height, 1);
+		width = (width > 1) ? width / 2 : 1;
+		height = (height > 1) ? height / 2 : 1;
+	}
+}
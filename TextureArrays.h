@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturearrays.h
+// ============
+// pack same-sized textures into the layers of 2D array textures
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <vector>
+
+/***********************************************************
+ *  TextureArrays
+ *
+ *  This class contains the code for copying loaded 2D
+ *  textures into GL_TEXTURE_2D_ARRAY textures.  Textures with
+ *  the same size, format and number of mipmap levels share
+ *  one array, and each array stays bound to its own texture
+ *  unit, so that switching textures while rendering only
+ *  changes the unit and layer uniforms.  The arrays start
+ *  after unit 0, which stays with the sampler2D objectTexture
+ *  of a shader that declares both samplers, since samplers of
+ *  different types must not share a unit.
+ ***********************************************************/
+class TextureArrays
+{
+public:
+	// constructor, with the units below unitLimit free for arrays
+	TextureArrays(GLint unitLimit);
+	// destructor
+	~TextureArrays();
+
+	// texture unit of the first array
+	static const GLint FIRST_ARRAY_UNIT = 1;
+
+	// copy a complete 2D texture into a free array layer
+	bool AddTexture(GLuint textureID, int& textureUnit, int& layer);
+	// copy a 2D texture again into the layer it was added to
+	bool UpdateTexture(GLuint textureID, int textureUnit, int layer);
+
+	// number of arrays, which is the number of units in use
+	// from FIRST_ARRAY_UNIT on
+	int GetArrayCount() const;
+
+private:
+	// one array texture and the size of its layers
+	struct TEXTURE_ARRAY
+	{
+		GLuint arrayID;
+		GLint width;
+		GLint height;
+		GLint internalFormat;
+		GLint levels;
+		GLint capacity;
+		GLint layerCount;
+	};
+
+	// units up to this one are free for the arrays
+	GLint m_maxUnits;
+	std::vector<TEXTURE_ARRAY> m_arrays;
+
+	// read the size, format and mipmap levels of a 2D texture
+	bool DescribeTexture(GLuint textureID, TEXTURE_ARRAY& description);
+	// create array storage, copying the layers of an older array
+	GLuint CreateArrayStorage(const TEXTURE_ARRAY& textureArray, GLint capacity);
+	// copy every mipmap level of a 2D texture into one layer
+	void CopyLayer(GLuint textureID, const TEXTURE_ARRAY& textureArray, int layer);
+};
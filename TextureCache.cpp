@@ -0,0 +1,546 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturecache.cpp
+// ============
+// compress texture images to BC1/BC3 and cache them in KTX files
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureCache.h"
+
+#include <sys/stat.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+// declaration of global variables
+namespace
+{
+	// file name extension of the cache files
+	const char* g_CacheExtension = ".ktx";
+
+	// KTX 1.1 file identifier and header values
+	const unsigned char g_KTXIdentifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+	const uint32_t g_KTXEndianness = 0x04030201;
+	const char* g_OrientationKey = "KTXorientation";
+	// images are flipped vertically when they are decoded
+	const char* g_OrientationValue = "S=r,T=u";
+	const char* g_SourceStampKey = "SourceStamp";
+
+	const GLenum g_BC1Format = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	const GLenum g_BC3Format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+
+	struct KTX_HEADER
+	{
+		uint32_t endianness;
+		uint32_t glType;
+		uint32_t glTypeSize;
+		uint32_t glFormat;
+		uint32_t glInternalFormat;
+		uint32_t glBaseInternalFormat;
+		uint32_t pixelWidth;
+		uint32_t pixelHeight;
+		uint32_t pixelDepth;
+		uint32_t numberOfArrayElements;
+		uint32_t numberOfFaces;
+		uint32_t numberOfMipmapLevels;
+		uint32_t bytesOfKeyValueData;
+	};
+
+	/***********************************************************
+	 *  GetSourceStamp()
+	 *
+	 *  Describe the size and modification time of a source
+	 *  image, or return an empty string if it does not exist.
+	 ***********************************************************/
+	std::string GetSourceStamp(const std::string& sourceFile)
+	{
+		struct stat fileInfo;
+
+		if (stat(sourceFile.c_str(), &fileInfo) != 0)
+		{
+			return(std::string());
+		}
+
+		std::ostringstream stamp;
+		stamp << (long long)fileInfo.st_size << ":" << (long long)fileInfo.st_mtime;
+		return(stamp.str());
+	}
+
+	/***********************************************************
+	 *  WriteKeyValue()
+	 *
+	 *  Append one KTX key and value pair, padded to four bytes.
+	 ***********************************************************/
+	void WriteKeyValue(std::string& keyValueData, const std::string& key, const std::string& value)
+	{
+		uint32_t byteSize = (uint32_t)(key.size() + 1 + value.size() + 1);
+
+		keyValueData.append((const char*)&byteSize, sizeof(byteSize));
+		keyValueData.append(key.c_str(), key.size() + 1);
+		keyValueData.append(value.c_str(), value.size() + 1);
+		while ((keyValueData.size() % 4) != 0)
+		{
+			keyValueData.push_back('\0');
+		}
+	}
+
+	/***********************************************************
+	 *  FindKeyValue()
+	 *
+	 *  Look up the value of one key in the KTX key and value data.
+	 ***********************************************************/
+	std::string FindKeyValue(const std::vector<char>& keyValueData, const std::string& key)
+	{
+		size_t offset = 0;
+
+		while ((offset + sizeof(uint32_t)) <= keyValueData.size())
+		{
+			uint32_t byteSize = 0;
+			memcpy(&byteSize, &keyValueData[offset], sizeof(byteSize));
+			offset += sizeof(byteSize);
+			if ((offset + byteSize) > keyValueData.size())
+			{
+				break;
+			}
+
+			const char* entry = &keyValueData[offset];
+			size_t keyLength = strnlen(entry, byteSize);
+			if ((keyLength < byteSize) && (key.compare(0, std::string::npos, entry, keyLength) == 0))
+			{
+				return(std::string(entry + keyLength + 1, strnlen(entry + keyLength + 1, byteSize - keyLength - 1)));
+			}
+
+			offset += (byteSize + 3) & ~3u;
+		}
+
+		return(std::string());
+	}
+
+	/***********************************************************
+	 *  To565() / From565()
+	 *
+	 *  Convert between 8-bit RGB and the 5:6:5 endpoint colors
+	 *  used in the BC1 color blocks.
+	 ***********************************************************/
+	uint16_t To565(const unsigned char* color)
+	{
+		return((uint16_t)(((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3)));
+	}
+
+	void From565(uint16_t packed, int* color)
+	{
+		int r = (packed >> 11) & 31;
+		int g = (packed >> 5) & 63;
+		int b = packed & 31;
+
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+	}
+
+	/***********************************************************
+	 *  EncodeColorBlock()
+	 *
+	 *  Compress a 4x4 block of RGBA pixels into an 8 byte BC1
+	 *  color block.  The endpoints are the corners of the color
+	 *  bounding box, inset slightly, which is a fast fit that
+	 *  works well for the photographic scene textures.
+	 ***********************************************************/
+	void EncodeColorBlock(const unsigned char block[16][4], unsigned char* output)
+	{
+		unsigned char minColor[3] = { 255, 255, 255 };
+		unsigned char maxColor[3] = { 0, 0, 0 };
+
+		for (int i = 0; i < 16; i++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				minColor[c] = (block[i][c] < minColor[c]) ? block[i][c] : minColor[c];
+				maxColor[c] = (block[i][c] > maxColor[c]) ? block[i][c] : maxColor[c];
+			}
+		}
+
+		// inset the bounding box by 1/16 of its size
+		for (int c = 0; c < 3; c++)
+		{
+			int inset = (maxColor[c] - minColor[c]) >> 4;
+			minColor[c] = (unsigned char)((minColor[c] + inset <= 255) ? minColor[c] + inset : 255);
+			maxColor[c] = (unsigned char)((maxColor[c] >= inset) ? maxColor[c] - inset : 0);
+		}
+
+		uint16_t color0 = To565(maxColor);
+		uint16_t color1 = To565(minColor);
+		uint32_t indices = 0;
+
+		// color0 must be the larger value for the four color mode
+		if (color0 < color1)
+		{
+			uint16_t swap = color0;
+			color0 = color1;
+			color1 = swap;
+		}
+
+		if (color0 != color1)
+		{
+			int palette[4][3];
+			From565(color0, palette[0]);
+			From565(color1, palette[1]);
+			for (int c = 0; c < 3; c++)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+
+			for (int i = 0; i < 16; i++)
+			{
+				int bestIndex = 0;
+				int bestDistance = 0x7fffffff;
+				for (int p = 0; p < 4; p++)
+				{
+					int dr = block[i][0] - palette[p][0];
+					int dg = block[i][1] - palette[p][1];
+					int db = block[i][2] - palette[p][2];
+					int distance = dr * dr + dg * dg + db * db;
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						bestIndex = p;
+					}
+				}
+				indices |= (uint32_t)bestIndex << (2 * i);
+			}
+		}
+
+		memcpy(output, &color0, 2);
+		memcpy(output + 2, &color1, 2);
+		memcpy(output + 4, &indices, 4);
+	}
+
+	/***********************************************************
+	 *  EncodeAlphaBlock()
+	 *
+	 *  Compress the alpha values of a 4x4 block of RGBA pixels
+	 *  into the 8 byte alpha block of BC3.
+	 ***********************************************************/
+	void EncodeAlphaBlock(const unsigned char block[16][4], unsigned char* output)
+	{
+		int alpha0 = 0;
+		int alpha1 = 255;
+		uint64_t indices = 0;
+
+		for (int i = 0; i < 16; i++)
+		{
+			alpha0 = (block[i][3] > alpha0) ? block[i][3] : alpha0;
+			alpha1 = (block[i][3] < alpha1) ? block[i][3] : alpha1;
+		}
+
+		if (alpha0 != alpha1)
+		{
+			// alpha0 > alpha1 selects the eight value mode
+			int palette[8];
+			palette[0] = alpha0;
+			palette[1] = alpha1;
+			for (int p = 1; p < 7; p++)
+			{
+				palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+			}
+
+			for (int i = 0; i < 16; i++)
+			{
+				int bestIndex = 0;
+				int bestDistance = 256;
+				for (int p = 0; p < 8; p++)
+				{
+					int distance = block[i][3] - palette[p];
+					distance = (distance < 0) ? -distance : distance;
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						bestIndex = p;
+					}
+				}
+				indices |= (uint64_t)bestIndex << (3 * i);
+			}
+		}
+
+		output[0] = (unsigned char)alpha0;
+		output[1] = (unsigned char)alpha1;
+		for (int b = 0; b < 6; b++)
+		{
+			output[2 + b] = (unsigned char)((indices >> (8 * b)) & 0xff);
+		}
+	}
+
+	/***********************************************************
+	 *  CompressLevel()
+	 *
+	 *  Compress one RGBA mipmap level into BC1 or BC3 blocks.
+	 *  Blocks past the right or bottom edge repeat the edge
+	 *  pixels.
+	 ***********************************************************/
+	void CompressLevel(const std::vector<unsigned char>& rgba, int width, int height, bool bAlpha, std::vector<unsigned char>& output)
+	{
+		int blocksWide = (width + 3) / 4;
+		int blocksHigh = (height + 3) / 4;
+		int blockBytes = bAlpha ? 16 : 8;
+		unsigned char block[16][4];
+
+		output.resize((size_t)blocksWide * blocksHigh * blockBytes);
+		unsigned char* out = output.data();
+
+		for (int by = 0; by < blocksHigh; by++)
+		{
+			for (int bx = 0; bx < blocksWide; bx++)
+			{
+				for (int y = 0; y < 4; y++)
+				{
+					int py = (by * 4 + y < height) ? by * 4 + y : height - 1;
+					for (int x = 0; x < 4; x++)
+					{
+						int px = (bx * 4 + x < width) ? bx * 4 + x : width - 1;
+						memcpy(block[y * 4 + x], &rgba[((size_t)py * width + px) * 4], 4);
+					}
+				}
+
+				if (bAlpha == true)
+				{
+					EncodeAlphaBlock(block, out);
+					out += 8;
+				}
+				EncodeColorBlock(block, out);
+				out += 8;
+			}
+		}
+	}
+
+	/***********************************************************
+	 *  DownsampleLevel()
+	 *
+	 *  Build the next smaller RGBA mipmap level with a 2x2 box
+	 *  filter.
+	 ***********************************************************/
+	void DownsampleLevel(const std::vector<unsigned char>& source, int width, int height, std::vector<unsigned char>& output, int& outWidth, int& outHeight)
+	{
+		outWidth = (width > 1) ? width / 2 : 1;
+		outHeight = (height > 1) ? height / 2 : 1;
+		output.resize((size_t)outWidth * outHeight * 4);
+
+		for (int y = 0; y < outHeight; y++)
+		{
+			int y0 = (y * 2 < height) ? y * 2 : height - 1;
+			int y1 = (y * 2 + 1 < height) ? y * 2 + 1 : height - 1;
+			for (int x = 0; x < outWidth; x++)
+			{
+				int x0 = (x * 2 < width) ? x * 2 : width - 1;
+				int x1 = (x * 2 + 1 < width) ? x * 2 + 1 : width - 1;
+				for (int c = 0; c < 4; c++)
+				{
+					int sum = source[((size_t)y0 * width + x0) * 4 + c] +
+						source[((size_t)y0 * width + x1) * 4 + c] +
+						source[((size_t)y1 * width + x0) * 4 + c] +
+						source[((size_t)y1 * width + x1) * 4 + c];
+					output[((size_t)y * outWidth + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+				}
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  GetCachePath()
+ *
+ *  This method is used for getting the path of the cache
+ *  file that is stored beside the passed in source image.
+ ***********************************************************/
+std::string TextureCache::GetCachePath(const std::string& sourceFile)
+{
+	return(sourceFile + g_CacheExtension);
+}
+
+/***********************************************************
+ *  Compress()
+ *
+ *  This method is used for building the block compressed
+ *  mipmap chain of a decoded image.  It is run once on a
+ *  texture loader thread when no cache file exists yet.
+ ***********************************************************/
+bool TextureCache::Compress(
+	const unsigned char* pixels,
+	int width,
+	int height,
+	int colorChannels,
+	COMPRESSED_IMAGE& image)
+{
+	if ((NULL == pixels) || (width <= 0) || (height <= 0) ||
+		((colorChannels != 3) && (colorChannels != 4)))
+	{
+		return(false);
+	}
+
+	bool bAlpha = (colorChannels == 4);
+	std::vector<unsigned char> rgba((size_t)width * height * 4);
+
+	// expand the pixels to RGBA so every level is handled the same
+	for (size_t i = 0; i < (size_t)width * height; i++)
+	{
+		rgba[i * 4 + 0] = pixels[i * colorChannels + 0];
+		rgba[i * 4 + 1] = pixels[i * colorChannels + 1];
+		rgba[i * 4 + 2] = pixels[i * colorChannels + 2];
+		rgba[i * 4 + 3] = bAlpha ? pixels[i * colorChannels + 3] : 255;
+	}
+
+	image.internalFormat = bAlpha ? g_BC3Format : g_BC1Format;
+	image.levels.clear();
+
+	int levelWidth = width;
+	int levelHeight = height;
+	while (true)
+	{
+		MIP_LEVEL level;
+		level.width = levelWidth;
+		level.height = levelHeight;
+		CompressLevel(rgba, levelWidth, levelHeight, bAlpha, level.data);
+		image.levels.push_back(level);
+
+		if ((levelWidth == 1) && (levelHeight == 1))
+		{
+			break;
+		}
+
+		std::vector<unsigned char> smaller;
+		DownsampleLevel(rgba, levelWidth, levelHeight, smaller, levelWidth, levelHeight);
+		rgba.swap(smaller);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  Save()
+ *
+ *  This method is used for writing a compressed image into
+ *  a KTX 1.1 file beside its source image.
+ ***********************************************************/
+bool TextureCache::Save(const std::string& sourceFile, const COMPRESSED_IMAGE& image)
+{
+	if (image.levels.size() == 0)
+	{
+		return(false);
+	}
+
+	std::ofstream file(GetCachePath(sourceFile).c_str(), std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		return(false);
+	}
+
+	std::string keyValueData;
+	WriteKeyValue(keyValueData, g_OrientationKey, g_OrientationValue);
+	WriteKeyValue(keyValueData, g_SourceStampKey, GetSourceStamp(sourceFile));
+
+	KTX_HEADER header = {};
+	header.endianness = g_KTXEndianness;
+	header.glTypeSize = 1;
+	header.glInternalFormat = image.internalFormat;
+	header.glBaseInternalFormat = (image.internalFormat == g_BC3Format) ? GL_RGBA : GL_RGB;
+	header.pixelWidth = image.levels[0].width;
+	header.pixelHeight = image.levels[0].height;
+	header.numberOfFaces = 1;
+	header.numberOfMipmapLevels = (uint32_t)image.levels.size();
+	header.bytesOfKeyValueData = (uint32_t)keyValueData.size();
+
+	file.write((const char*)g_KTXIdentifier, sizeof(g_KTXIdentifier));
+	file.write((const char*)&header, sizeof(header));
+	file.write(keyValueData.data(), keyValueData.size());
+
+	// block data is always a multiple of 8 bytes, so no mip padding
+	for (int i = 0; i < image.levels.size(); i++)
+	{
+		uint32_t imageSize = (uint32_t)image.levels[i].data.size();
+		file.write((const char*)&imageSize, sizeof(imageSize));
+		file.write((const char*)image.levels[i].data.data(), imageSize);
+	}
+
+	return(file.good());
+}
+
+/***********************************************************
+ *  Load()
+ *
+ *  This method is used for reading the cache file of the
+ *  passed in source image.  It returns false when there is
+ *  no cache file, or when the source image has changed since
+ *  the cache file was written.
+ ***********************************************************/
+bool TextureCache::Load(const std::string& sourceFile, COMPRESSED_IMAGE& image)
+{
+	std::ifstream file(GetCachePath(sourceFile).c_str(), std::ios::binary);
+	if (!file)
+	{
+		return(false);
+	}
+
+	unsigned char identifier[12];
+	KTX_HEADER header;
+	file.read((char*)identifier, sizeof(identifier));
+	file.read((char*)&header, sizeof(header));
+	if (!file ||
+		(memcmp(identifier, g_KTXIdentifier, sizeof(identifier)) != 0) ||
+		(header.endianness != g_KTXEndianness) ||
+		((header.glInternalFormat != g_BC1Format) && (header.glInternalFormat != g_BC3Format)) ||
+		(header.numberOfMipmapLevels == 0))
+	{
+		return(false);
+	}
+
+	std::vector<char> keyValueData(header.bytesOfKeyValueData);
+	if (header.bytesOfKeyValueData > 0)
+	{
+		file.read(keyValueData.data(), keyValueData.size());
+	}
+
+	// a missing or edited source image makes the cache stale
+	std::string stamp = GetSourceStamp(sourceFile);
+	if (stamp.empty() || (stamp != FindKeyValue(keyValueData, g_SourceStampKey)))
+	{
+		return(false);
+	}
+
+	image.internalFormat = header.glInternalFormat;
+	image.levels.clear();
+
+	int blockBytes = (header.glInternalFormat == g_BC3Format) ? 16 : 8;
+	int levelWidth = header.pixelWidth;
+	int levelHeight = header.pixelHeight;
+	for (uint32_t i = 0; i < header.numberOfMipmapLevels; i++)
+	{
+		uint32_t imageSize = 0;
+		file.read((char*)&imageSize, sizeof(imageSize));
+
+		size_t expectedSize = (size_t)((levelWidth + 3) / 4) * ((levelHeight + 3) / 4) * blockBytes;
+		if (!file || (imageSize != expectedSize))
+		{
+			return(false);
+		}
+
+		MIP_LEVEL level;
+		level.width = levelWidth;
+		level.height = levelHeight;
+		level.data.resize(imageSize);
+		file.read((char*)level.data.data(), imageSize);
+		if (!file)
+		{
+			return(false);
+		}
+		image.levels.push_back(level);
+
+		levelWidth = (levelWidth > 1) ? levelWidth / 2 : 1;
+		levelHeight = (levelHeight > 1) ? levelHeight / 2 : 1;
+	}
+
+	return(true);
+}
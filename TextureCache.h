@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturecache.h
+// ============
+// compress texture images to BC1/BC3 and cache them in KTX files
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  TextureCache
+ *
+ *  This class contains the code for converting decoded
+ *  images into block compressed textures with a complete
+ *  mipmap chain, and for storing them in KTX files next to
+ *  the source images.  RGB images are stored as BC1 (DXT1)
+ *  and RGBA images as BC3 (DXT5).  A cache file records the
+ *  size and modification time of its source image, so that
+ *  an edited image is compressed again on the next launch.
+ ***********************************************************/
+class TextureCache
+{
+public:
+	// one level of the mipmap chain
+	struct MIP_LEVEL
+	{
+		int width;
+		int height;
+		std::vector<unsigned char> data;
+	};
+
+	// a block compressed image ready for glCompressedTexImage2D
+	struct COMPRESSED_IMAGE
+	{
+		GLenum internalFormat;
+		std::vector<MIP_LEVEL> levels;
+	};
+
+	// path of the cache file that belongs to a source image
+	static std::string GetCachePath(const std::string& sourceFile);
+
+	// read the cache file of a source image if it is up to date
+	static bool Load(const std::string& sourceFile, COMPRESSED_IMAGE& image);
+	// write the cache file of a source image
+	static bool Save(const std::string& sourceFile, const COMPRESSED_IMAGE& image);
+
+	// build the compressed mipmap chain of a decoded image
+	static bool Compress(
+		const unsigned char* pixels,
+		int width,
+		int height,
+		int colorChannels,
+		COMPRESSED_IMAGE& image);
+};
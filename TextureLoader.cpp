@@ -0,0 +1,445 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureloader.cpp
+// ============
+// decode texture images on worker threads and stream them to OpenGL
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureLoader.h"
+
+#ifndef STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#endif
+
+#include <cstring>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// most worker threads used for decoding
+	const unsigned int g_MaxWorkers = 8;
+	// bytes of pixels uploaded per frame before the rest
+	// of the decoded images wait for the next frame
+	const size_t g_UploadBytesPerFrame = 16 * 1024 * 1024;
+	// mid gray shown until the real image is uploaded
+	const unsigned char g_PlaceholderPixel[4] = { 128, 128, 128, 255 };
+}
+
+/***********************************************************
+ *  TextureLoader()
+ *
+ *  The constructor for the class - starts the worker threads
+ ***********************************************************/
+TextureLoader::TextureLoader()
+{
+	m_pendingCount = 0;
+	m_bStopping = false;
+	m_uploadBuffer = 0;
+
+	// the extension flags are only valid on the OpenGL thread,
+	// so the workers read this copy of the flag instead
+	m_bCompressTextures = (GLEW_EXT_texture_compression_s3tc != 0);
+
+	// the flip setting is global in stb_image, so it is set once
+	// here before any of the workers start decoding
+	stbi_set_flip_vertically_on_load(true);
+
+	// leave one core for the OpenGL thread
+	unsigned int workerCount = std::thread::hardware_concurrency();
+	workerCount = (workerCount > 1) ? workerCount - 1 : 1;
+	workerCount = (workerCount > g_MaxWorkers) ? g_MaxWorkers : workerCount;
+
+	for (unsigned int i = 0; i < workerCount; i++)
+	{
+		m_workers.push_back(std::thread(&TextureLoader::WorkerLoop, this));
+	}
+}
+
+/***********************************************************
+ *  ~TextureLoader()
+ *
+ *  The destructor for the class - stops the worker threads
+ ***********************************************************/
+TextureLoader::~TextureLoader()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStopping = true;
+		m_decodeJobs.clear();
+	}
+	m_jobReady.notify_all();
+
+	for (int i = 0; i < m_workers.size(); i++)
+	{
+		m_workers[i].join();
+	}
+
+	// free any images that were decoded but never uploaded
+	while (m_decodedImages.size() > 0)
+	{
+		stbi_image_free(m_decodedImages.front().pixels);
+		m_decodedImages.pop_front();
+	}
+
+	if (0 != m_uploadBuffer)
+	{
+		glDeleteBuffers(1, &m_uploadBuffer);
+		m_uploadBuffer = 0;
+	}
+}
+
+/***********************************************************
+ *  QueueTexture()
+ *
+ *  This method is used for creating a texture that shows a
+ *  placeholder color, and queueing the image file so that
+ *  the real pixels replace the placeholder once decoded.
+ ***********************************************************/
+GLuint TextureLoader::QueueTexture(const char* filename)
+{
+	GLuint textureID = 0;
+	GLint boundTexture = 0;
+
+	// keep the texture that is bound to the active slot
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &boundTexture);
+
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, g_PlaceholderPixel);
+	glBindTexture(GL_TEXTURE_2D, boundTexture);
+
+	ReloadTexture(filename, textureID);
+
+	return(textureID);
+}
+
+/***********************************************************
+ *  ReloadTexture()
+ *
+ *  This method is used for queueing an image file to be
+ *  decoded into an existing texture.
+ ***********************************************************/
+void TextureLoader::ReloadTexture(const char* filename, GLuint textureID)
+{
+	DECODE_JOB job;
+
+	job.filename = filename;
+	job.textureID = textureID;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_decodeJobs.push_back(job);
+		m_pendingCount++;
+	}
+	m_jobReady.notify_one();
+}
+
+/***********************************************************
+ *  GetPendingCount()
+ *
+ *  This method is used for getting the number of queued
+ *  textures that are still showing their placeholder.
+ ***********************************************************/
+int TextureLoader::GetPendingCount()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return(m_pendingCount);
+}
+
+/***********************************************************
+ *  TakeUploadedTextures()
+ *
+ *  This method is used for getting the IDs of the textures
+ *  that received their real pixels since the last call, so
+ *  that the caller can start using the finished textures.
+ ***********************************************************/
+void TextureLoader::TakeUploadedTextures(std::vector<GLuint>& textureIDs)
+{
+	textureIDs.clear();
+	textureIDs.swap(m_uploadedTextures);
+}
+
+/***********************************************************
+ *  WorkerLoop()
+ *
+ *  This method is run by each worker thread, decoding the
+ *  queued image files and handing the pixels back to the
+ *  OpenGL thread.
+ ***********************************************************/
+void TextureLoader::WorkerLoop()
+{
+	while (true)
+	{
+		DECODE_JOB job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_jobReady.wait(lock, [this] { return(m_bStopping || (m_decodeJobs.size() > 0)); });
+			if (m_bStopping == true)
+			{
+				return;
+			}
+			job = m_decodeJobs.front();
+			m_decodeJobs.pop_front();
+		}
+
+		DECODED_IMAGE image;
+		image.filename = job.filename;
+		image.textureID = job.textureID;
+		image.width = 0;
+		image.height = 0;
+		image.colorChannels = 0;
+		image.pixels = NULL;
+		image.bCompressed = false;
+
+		// an up to date cache file skips decoding altogether
+		if ((m_bCompressTextures == true) &&
+			(TextureCache::Load(job.filename, image.compressed) == true))
+		{
+			image.bCompressed = true;
+		}
+		else
+		{
+			// try to parse the image data from the specified image file
+			image.pixels = stbi_load(
+				job.filename.c_str(),
+				&image.width,
+				&image.height,
+				&image.colorChannels,
+				0);
+
+			// compress the image once and keep it for the next launch
+			if ((m_bCompressTextures == true) &&
+				(NULL != image.pixels) &&
+				(TextureCache::Compress(image.pixels, image.width, image.height, image.colorChannels, image.compressed) == true))
+			{
+				if (TextureCache::Save(job.filename, image.compressed) == false)
+				{
+					std::cout << "Could not write texture cache:" << TextureCache::GetCachePath(job.filename) << std::endl;
+				}
+				stbi_image_free(image.pixels);
+				image.pixels = NULL;
+				image.bCompressed = true;
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_decodedImages.push_back(image);
+		}
+	}
+}
+
+/***********************************************************
+ *  ProcessUploads()
+ *
+ *  This method is used for uploading the decoded images into
+ *  their textures.  It must be called on the OpenGL thread,
+ *  and stops after a fixed number of bytes per frame so that
+ *  a burst of large images is spread over several frames.
+ *  It returns the number of textures that were uploaded.
+ ***********************************************************/
+int TextureLoader::ProcessUploads()
+{
+	size_t uploadedBytes = 0;
+	int uploadCount = 0;
+
+	while (uploadedBytes < g_UploadBytesPerFrame)
+	{
+		DECODED_IMAGE image;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_decodedImages.size() == 0)
+			{
+				break;
+			}
+			image = m_decodedImages.front();
+			m_decodedImages.pop_front();
+			m_pendingCount--;
+		}
+
+		if (image.bCompressed == true)
+		{
+			UploadCompressedImage(image);
+			m_uploadedTextures.push_back(image.textureID);
+			for (int i = 0; i < image.compressed.levels.size(); i++)
+			{
+				uploadedBytes += image.compressed.levels[i].data.size();
+			}
+			uploadCount++;
+			continue;
+		}
+
+		if (NULL == image.pixels)
+		{
+			std::cout << "Could not load image:" << image.filename << std::endl;
+			continue;
+		}
+
+		UploadImage(image);
+		m_uploadedTextures.push_back(image.textureID);
+		uploadedBytes += (size_t)image.width * image.height * image.colorChannels;
+		uploadCount++;
+
+		// free the image data from local memory
+		stbi_image_free(image.pixels);
+	}
+
+	return(uploadCount);
+}
+
+/***********************************************************
+ *  UploadImage()
+ *
+ *  This method is used for copying the decoded pixels into a
+ *  pixel buffer object and filling the texture from it, which
+ *  lets the driver transfer the pixels without stalling.
+ ***********************************************************/
+void TextureLoader::UploadImage(const DECODED_IMAGE& image)
+{
+	GLenum internalFormat = GL_RGB8;
+	GLenum pixelFormat = GL_RGB;
+
+	// if the loaded image is in RGB format
+	if (image.colorChannels == 3)
+	{
+		internalFormat = GL_RGB8;
+		pixelFormat = GL_RGB;
+	}
+	// if the loaded image is in RGBA format - it supports transparency
+	else if (image.colorChannels == 4)
+	{
+		internalFormat = GL_RGBA8;
+		pixelFormat = GL_RGBA;
+	}
+	else
+	{
+		std::cout << "Not implemented to handle image with " << image.colorChannels << " channels" << std::endl;
+		return;
+	}
+
+	std::cout << "Successfully loaded image:" << image.filename << ", width:" << image.width << ", height:" << image.height << ", channels:" << image.colorChannels << std::endl;
+
+	GLsizeiptr dataSize = (GLsizeiptr)image.width * image.height * image.colorChannels;
+	bool bMapped = FillUploadBuffer(image.pixels, dataSize);
+
+	// the scene textures stay bound to their slots, so the
+	// texture bound to the active slot is put back afterwards
+	GLint boundTexture = 0;
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &boundTexture);
+	glBindTexture(GL_TEXTURE_2D, image.textureID);
+
+	// rows of RGB images are not padded to four bytes
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	if (bMapped == true)
+	{
+		// the pixels are read from offset zero of the bound buffer
+		glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, image.width, image.height, 0, pixelFormat, GL_UNSIGNED_BYTE, (void*)0);
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	if (bMapped == false)
+	{
+		glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, image.width, image.height, 0, pixelFormat, GL_UNSIGNED_BYTE, image.pixels);
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	// generate the texture mipmaps for mapping textures to lower
+	// resolutions, and sample them once the chain is complete
+	glGenerateMipmap(GL_TEXTURE_2D);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+
+	glBindTexture(GL_TEXTURE_2D, boundTexture);
+}
+
+/***********************************************************
+ *  UploadCompressedImage()
+ *
+ *  This method is used for filling a texture with the block
+ *  compressed mipmap chain of an image.  All of the levels
+ *  are copied into the pixel buffer object at once, and each
+ *  level is read from its own offset into the buffer.
+ ***********************************************************/
+void TextureLoader::UploadCompressedImage(const DECODED_IMAGE& image)
+{
+	const std::vector<TextureCache::MIP_LEVEL>& levels = image.compressed.levels;
+	std::vector<unsigned char> allLevels;
+
+	for (int i = 0; i < levels.size(); i++)
+	{
+		allLevels.insert(allLevels.end(), levels[i].data.begin(), levels[i].data.end());
+	}
+
+	std::cout << "Successfully loaded compressed image:" << image.filename << ", width:" << levels[0].width << ", height:" << levels[0].height << ", levels:" << levels.size() << std::endl;
+
+	bool bMapped = FillUploadBuffer(allLevels.data(), (GLsizeiptr)allLevels.size());
+
+	GLint boundTexture = 0;
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &boundTexture);
+	glBindTexture(GL_TEXTURE_2D, image.textureID);
+
+	size_t offset = 0;
+	for (int i = 0; i < levels.size(); i++)
+	{
+		const void* levelData = bMapped ? (const void*)offset : (const void*)&allLevels[offset];
+		glCompressedTexImage2D(
+			GL_TEXTURE_2D,
+			i,
+			image.compressed.internalFormat,
+			levels[i].width,
+			levels[i].height,
+			0,
+			(GLsizei)levels[i].data.size(),
+			levelData);
+		offset += levels[i].data.size();
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	// the cache holds the whole chain, so no mipmaps are generated
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levels.size() - 1);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (levels.size() > 1) ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+
+	glBindTexture(GL_TEXTURE_2D, boundTexture);
+}
+
+/***********************************************************
+ *  FillUploadBuffer()
+ *
+ *  This method is used for copying bytes into the pixel
+ *  buffer object and leaving it bound for the upload.  It
+ *  returns false if the buffer could not be mapped, in which
+ *  case the buffer is unbound and the caller uploads from
+ *  client memory.
+ ***********************************************************/
+bool TextureLoader::FillUploadBuffer(const void* data, GLsizeiptr dataSize)
+{
+	if (0 == m_uploadBuffer)
+	{
+		glGenBuffers(1, &m_uploadBuffer);
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_uploadBuffer);
+
+	// orphan the previous storage so the copy never waits
+	// for an earlier upload to finish
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, dataSize, NULL, GL_STREAM_DRAW);
+	void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, dataSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	if (NULL == mapped)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		return(false);
+	}
+
+	memcpy(mapped, data, dataSize);
+	glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+	return(true);
+}
@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureloader.h
+// ============
+// decode texture images on worker threads and stream them to OpenGL
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include "TextureCache.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  TextureLoader
+ *
+ *  This class contains the code for loading texture images
+ *  without blocking the OpenGL thread.  Each queued texture
+ *  gets a placeholder right away, a pool of worker threads
+ *  decodes the image files, and the OpenGL thread uploads the
+ *  decoded pixels through a pixel buffer object into the same
+ *  texture, so that OpenGL texture IDs never change.  When
+ *  the driver supports S3TC, decoded images are compressed
+ *  once and read back from the texture cache afterwards.
+ ***********************************************************/
+class TextureLoader
+{
+public:
+	// constructor
+	TextureLoader();
+	// destructor
+	~TextureLoader();
+
+	// create a placeholder texture and queue the image for decoding
+	GLuint QueueTexture(const char* filename);
+	// queue an image to be decoded into an existing texture
+	void ReloadTexture(const char* filename, GLuint textureID);
+
+	// upload decoded images, called once per frame on the OpenGL thread
+	int ProcessUploads();
+
+	// number of queued textures that are not uploaded yet
+	int GetPendingCount();
+
+	// move out the IDs of the textures uploaded since the last call
+	void TakeUploadedTextures(std::vector<GLuint>& textureIDs);
+
+private:
+	// one image waiting to be decoded
+	struct DECODE_JOB
+	{
+		std::string filename;
+		GLuint textureID;
+	};
+
+	// one decoded image waiting to be uploaded
+	struct DECODED_IMAGE
+	{
+		std::string filename;
+		GLuint textureID;
+		unsigned char* pixels;
+		int width;
+		int height;
+		int colorChannels;
+		// set when the image came from or went into the cache
+		bool bCompressed;
+		TextureCache::COMPRESSED_IMAGE compressed;
+	};
+
+	// worker threads decoding the image files
+	std::vector<std::thread> m_workers;
+	std::mutex m_mutex;
+	std::condition_variable m_jobReady;
+	std::deque<DECODE_JOB> m_decodeJobs;
+	std::deque<DECODED_IMAGE> m_decodedImages;
+	// number of queued textures not uploaded yet
+	int m_pendingCount;
+	bool m_bStopping;
+	// true when the driver accepts S3TC compressed textures
+	bool m_bCompressTextures;
+
+	// textures uploaded since the last TakeUploadedTextures(),
+	// only used on the OpenGL thread
+	std::vector<GLuint> m_uploadedTextures;
+
+	// pixel buffer used for streaming the pixels to OpenGL
+	GLuint m_uploadBuffer;
+
+	// decode queued image files until the loader is destroyed
+	void WorkerLoop();
+	// upload one decoded image into its texture
+	void UploadImage(const DECODED_IMAGE& image);
+	// upload the compressed mipmap chain of one image into its texture
+	void UploadCompressedImage(const DECODED_IMAGE& image);
+	// copy bytes into the orphaned pixel buffer, or return false
+	bool FillUploadBuffer(const void* data, GLsizeiptr dataSize);
+};
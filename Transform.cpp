@@ -0,0 +1,268 @@
+///////////////////////////////////////////////////////////////////////////////
+// transform.cpp
+// ============
+// store object transformations and compose their model matrices
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Transform.h"
+
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_IX86)
+#include <xmmintrin.h>
+#define TRANSFORM_USE_SSE
+#endif
+
+// declaration of global variables
+namespace
+{
+	/***********************************************************
+	 *  ComposeModelMatrix()
+	 *
+	 *  Build translation * rotX * rotY * rotZ * scale in closed
+	 *  form from the cosines and sines of the three rotations,
+	 *  which gives the same matrix as multiplying the five
+	 *  glm matrices together.
+	 ***********************************************************/
+	void ComposeModelMatrix(
+		float cx, float sx,
+		float cy, float sy,
+		float cz, float sz,
+		glm::vec3 scale,
+		glm::vec3 position,
+		glm::mat4& model)
+	{
+		model[0] = glm::vec4(cy * cz, cx * sz + sx * sy * cz, sx * sz - cx * sy * cz, 0.0f) * scale.x;
+		model[1] = glm::vec4(-cy * sz, cx * cz - sx * sy * sz, sx * cz + cx * sy * sz, 0.0f) * scale.y;
+		model[2] = glm::vec4(sy, -sx * cy, cx * cy, 0.0f) * scale.z;
+		model[3] = glm::vec4(position, 1.0f);
+	}
+}
+
+/***********************************************************
+ *  Transform()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+Transform::Transform()
+{
+	m_scale = glm::vec3(1.0f, 1.0f, 1.0f);
+	m_rotationDegrees = glm::vec3(0.0f, 0.0f, 0.0f);
+	m_position = glm::vec3(0.0f, 0.0f, 0.0f);
+	m_model = glm::mat4(1.0f);
+	m_bDirty = false;
+}
+
+/***********************************************************
+ *  Set()
+ *
+ *  This method is used for setting all of the transformation
+ *  values, with the same parameters as SetTransformations().
+ ***********************************************************/
+void Transform::Set(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	SetScale(scaleXYZ);
+	SetRotation(glm::vec3(XrotationDegrees, YrotationDegrees, ZrotationDegrees));
+	SetPosition(positionXYZ);
+}
+
+/***********************************************************
+ *  SetScale()
+ *
+ *  This method is used for changing the scale, which marks
+ *  the model matrix out of date.
+ ***********************************************************/
+void Transform::SetScale(glm::vec3 scaleXYZ)
+{
+	if (m_scale != scaleXYZ)
+	{
+		m_scale = scaleXYZ;
+		m_bDirty = true;
+	}
+}
+
+/***********************************************************
+ *  SetRotation()
+ *
+ *  This method is used for changing the rotation around the
+ *  X, Y and Z axis in degrees, which marks the model matrix
+ *  out of date.
+ ***********************************************************/
+void Transform::SetRotation(glm::vec3 rotationDegreesXYZ)
+{
+	if (m_rotationDegrees != rotationDegreesXYZ)
+	{
+		m_rotationDegrees = rotationDegreesXYZ;
+		m_bDirty = true;
+	}
+}
+
+/***********************************************************
+ *  SetPosition()
+ *
+ *  This method is used for changing the position, which marks
+ *  the model matrix out of date.
+ ***********************************************************/
+void Transform::SetPosition(glm::vec3 positionXYZ)
+{
+	if (m_position != positionXYZ)
+	{
+		m_position = positionXYZ;
+		m_bDirty = true;
+	}
+}
+
+glm::vec3 Transform::GetScale() const
+{
+	return(m_scale);
+}
+
+glm::vec3 Transform::GetRotation() const
+{
+	return(m_rotationDegrees);
+}
+
+glm::vec3 Transform::GetPosition() const
+{
+	return(m_position);
+}
+
+/***********************************************************
+ *  IsDirty()
+ *
+ *  This method is used for checking whether the model matrix
+ *  needs to be recomputed.
+ ***********************************************************/
+bool Transform::IsDirty() const
+{
+	return(m_bDirty);
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for recomputing the model matrix when
+ *  one of the transformation values has changed.
+ ***********************************************************/
+void Transform::Update()
+{
+	if (m_bDirty == false)
+	{
+		return;
+	}
+
+	float rx = glm::radians(m_rotationDegrees.x);
+	float ry = glm::radians(m_rotationDegrees.y);
+	float rz = glm::radians(m_rotationDegrees.z);
+
+	ComposeModelMatrix(
+		std::cos(rx), std::sin(rx),
+		std::cos(ry), std::sin(ry),
+		std::cos(rz), std::sin(rz),
+		m_scale,
+		m_position,
+		m_model);
+	m_bDirty = false;
+}
+
+/***********************************************************
+ *  GetModelMatrix()
+ *
+ *  This method is used for getting the model matrix as of
+ *  the last call to Update() or UpdateBatch().
+ ***********************************************************/
+const glm::mat4& Transform::GetModelMatrix() const
+{
+	return(m_model);
+}
+
+/***********************************************************
+ *  UpdateBatch()
+ *
+ *  This method is used for recomputing the model matrices of
+ *  the passed in transforms.  Four transforms are composed at
+ *  a time using SSE, with the rotation and scale terms of the
+ *  four matrices held side by side in the vector registers.
+ ***********************************************************/
+void Transform::UpdateBatch(Transform* const* transforms, int count)
+{
+	int index = 0;
+
+#ifdef TRANSFORM_USE_SSE
+	for (; (index + 4) <= count; index += 4)
+	{
+		alignas(16) float cosX[4], sinX[4], cosY[4], sinY[4], cosZ[4], sinZ[4];
+		alignas(16) float scaleX[4], scaleY[4], scaleZ[4];
+		alignas(16) float terms[9][4];
+
+		for (int lane = 0; lane < 4; lane++)
+		{
+			const Transform* transform = transforms[index + lane];
+			float rx = glm::radians(transform->m_rotationDegrees.x);
+			float ry = glm::radians(transform->m_rotationDegrees.y);
+			float rz = glm::radians(transform->m_rotationDegrees.z);
+
+			cosX[lane] = std::cos(rx);
+			sinX[lane] = std::sin(rx);
+			cosY[lane] = std::cos(ry);
+			sinY[lane] = std::sin(ry);
+			cosZ[lane] = std::cos(rz);
+			sinZ[lane] = std::sin(rz);
+			scaleX[lane] = transform->m_scale.x;
+			scaleY[lane] = transform->m_scale.y;
+			scaleZ[lane] = transform->m_scale.z;
+		}
+
+		__m128 cx = _mm_load_ps(cosX);
+		__m128 sx = _mm_load_ps(sinX);
+		__m128 cy = _mm_load_ps(cosY);
+		__m128 sy = _mm_load_ps(sinY);
+		__m128 cz = _mm_load_ps(cosZ);
+		__m128 sz = _mm_load_ps(sinZ);
+		__m128 scx = _mm_load_ps(scaleX);
+		__m128 scy = _mm_load_ps(scaleY);
+		__m128 scz = _mm_load_ps(scaleZ);
+		__m128 sxsy = _mm_mul_ps(sx, sy);
+		__m128 cxsy = _mm_mul_ps(cx, sy);
+
+		// first column - scaled by the X scale
+		_mm_store_ps(terms[0], _mm_mul_ps(_mm_mul_ps(cy, cz), scx));
+		_mm_store_ps(terms[1], _mm_mul_ps(_mm_add_ps(_mm_mul_ps(cx, sz), _mm_mul_ps(sxsy, cz)), scx));
+		_mm_store_ps(terms[2], _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(sx, sz), _mm_mul_ps(cxsy, cz)), scx));
+		// second column - scaled by the Y scale
+		_mm_store_ps(terms[3], _mm_mul_ps(_mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(cy, sz)), scy));
+		_mm_store_ps(terms[4], _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(cx, cz), _mm_mul_ps(sxsy, sz)), scy));
+		_mm_store_ps(terms[5], _mm_mul_ps(_mm_add_ps(_mm_mul_ps(sx, cz), _mm_mul_ps(cxsy, sz)), scy));
+		// third column - scaled by the Z scale
+		_mm_store_ps(terms[6], _mm_mul_ps(sy, scz));
+		_mm_store_ps(terms[7], _mm_mul_ps(_mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(sx, cy)), scz));
+		_mm_store_ps(terms[8], _mm_mul_ps(_mm_mul_ps(cx, cy), scz));
+
+		for (int lane = 0; lane < 4; lane++)
+		{
+			Transform* transform = transforms[index + lane];
+			glm::mat4& model = transform->m_model;
+
+			model[0] = glm::vec4(terms[0][lane], terms[1][lane], terms[2][lane], 0.0f);
+			model[1] = glm::vec4(terms[3][lane], terms[4][lane], terms[5][lane], 0.0f);
+			model[2] = glm::vec4(terms[6][lane], terms[7][lane], terms[8][lane], 0.0f);
+			model[3] = glm::vec4(transform->m_position, 1.0f);
+			transform->m_bDirty = false;
+		}
+	}
+#endif
+
+	// the remaining transforms are composed one at a time
+	for (; index < count; index++)
+	{
+		transforms[index]->Update();
+	}
+}
@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////////
+// transform.h
+// ============
+// store object transformations and compose their model matrices
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  Transform
+ *
+ *  This class holds the scale, rotation and position of one
+ *  object together with the composed model matrix.  The model
+ *  matrix is only recomputed after one of the values changed,
+ *  and many dirty transforms can be composed in one batch.
+ ***********************************************************/
+class Transform
+{
+public:
+	// constructor
+	Transform();
+
+	// set all of the transformation values
+	void Set(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// change one of the transformation values
+	void SetScale(glm::vec3 scaleXYZ);
+	void SetRotation(glm::vec3 rotationDegreesXYZ);
+	void SetPosition(glm::vec3 positionXYZ);
+
+	glm::vec3 GetScale() const;
+	glm::vec3 GetRotation() const;
+	glm::vec3 GetPosition() const;
+
+	// true when the model matrix is out of date
+	bool IsDirty() const;
+	// recompute the model matrix if it is out of date
+	void Update();
+	// the model matrix as of the last update
+	const glm::mat4& GetModelMatrix() const;
+
+	// recompute the model matrices of many transforms at once
+	static void UpdateBatch(Transform* const* transforms, int count);
+
+private:
+	glm::vec3 m_scale;
+	glm::vec3 m_rotationDegrees;
+	glm::vec3 m_position;
+	// model matrix composed as translation * rotX * rotY * rotZ * scale
+	glm::mat4 m_model;
+	bool m_bDirty;
+};
@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////
+// uniformcache.cpp
+// ============
+// resolve shader uniform locations once and count name lookups
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "UniformCache.h"
+
+#include <iostream>
+
+GLuint UniformCache::m_programID = 0;
+int UniformCache::m_frameLookups = 0;
+
+/***********************************************************
+ *  BindActiveProgram()
+ *
+ *  This method is used for remembering the shader program
+ *  that is currently in use, so that the following lookups
+ *  resolve against it.  It must be called after the shader
+ *  manager has loaded and activated the shaders.
+ ***********************************************************/
+void UniformCache::BindActiveProgram()
+{
+	GLint programID = 0;
+
+	glGetIntegerv(GL_CURRENT_PROGRAM, &programID);
+	m_programID = (GLuint)programID;
+
+	if (0 == m_programID)
+	{
+		std::cout << "UniformCache: no active shader program" << std::endl;
+	}
+}
+
+/***********************************************************
+ *  Lookup()
+ *
+ *  This method is used for resolving the location of the
+ *  passed in uniform name.  It returns -1 when the active
+ *  shader does not use the uniform, which OpenGL silently
+ *  ignores in the glUniform calls.
+ ***********************************************************/
+GLint UniformCache::Lookup(const char* uniformName)
+{
+	m_frameLookups++;
+
+	if (0 == m_programID)
+	{
+		BindActiveProgram();
+	}
+
+	return(glGetUniformLocation(m_programID, uniformName));
+}
+
+/***********************************************************
+ *  LookupAttribute()
+ *
+ *  This method is used for resolving the location of the
+ *  passed in vertex attribute, or -1 when the vertex shader
+ *  does not read it.
+ ***********************************************************/
+GLint UniformCache::LookupAttribute(const char* attributeName)
+{
+	m_frameLookups++;
+
+	if (0 == m_programID)
+	{
+		BindActiveProgram();
+	}
+
+	return(glGetAttribLocation(m_programID, attributeName));
+}
+
+/***********************************************************
+ *  BindBlock()
+ *
+ *  This method is used for attaching the named uniform block
+ *  of the active shader to the passed in buffer binding point.
+ *  It returns false when the shader does not declare the block.
+ ***********************************************************/
+bool UniformCache::BindBlock(const char* blockName, GLuint bindingPoint)
+{
+	m_frameLookups++;
+
+	if (0 == m_programID)
+	{
+		BindActiveProgram();
+	}
+
+	GLuint blockIndex = glGetUniformBlockIndex(m_programID, blockName);
+	if (GL_INVALID_INDEX == blockIndex)
+	{
+		return(false);
+	}
+
+	glUniformBlockBinding(m_programID, blockIndex, bindingPoint);
+
+	return(true);
+}
+
+/***********************************************************
+ *  BindStorageBlock()
+ *
+ *  This method is used for attaching the named shader storage
+ *  block of the active shader to the passed in buffer binding
+ *  point.  It returns false when the shader does not declare
+ *  the block, or the driver has no shader storage buffers.
+ ***********************************************************/
+bool UniformCache::BindStorageBlock(const char* blockName, GLuint bindingPoint)
+{
+	m_frameLookups++;
+
+	if (!(GLEW_VERSION_4_3 || GLEW_ARB_shader_storage_buffer_object))
+	{
+		return(false);
+	}
+
+	if (0 == m_programID)
+	{
+		BindActiveProgram();
+	}
+
+	GLuint blockIndex = glGetProgramResourceIndex(m_programID, GL_SHADER_STORAGE_BLOCK, blockName);
+	if (GL_INVALID_INDEX == blockIndex)
+	{
+		return(false);
+	}
+
+	glShaderStorageBlockBinding(m_programID, blockIndex, bindingPoint);
+
+	return(true);
+}
+
+/***********************************************************
+ *  ResetFrameLookups()
+ *
+ *  This method is used for resetting the name lookup counter
+ *  at the start of each rendered frame.
+ ***********************************************************/
+void UniformCache::ResetFrameLookups()
+{
+	m_frameLookups = 0;
+}
+
+/***********************************************************
+ *  GetFrameLookups()
+ *
+ *  This method is used for getting the number of uniform
+ *  name lookups since the last reset.
+ ***********************************************************/
+int UniformCache::GetFrameLookups()
+{
+	return(m_frameLookups);
+}
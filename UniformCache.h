@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////////
+// uniformcache.h
+// ============
+// resolve shader uniform locations once and count name lookups
+//
+//  AUTHOR: agent
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 14th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+/***********************************************************
+ *  UniformCache
+ *
+ *  This class is used for resolving the locations of shader
+ *  uniforms by name.  Every call to Lookup() is one name
+ *  lookup in the driver, so the managers call it once after
+ *  the shader program is made active and keep the returned
+ *  locations.  The per-frame counter should read zero once
+ *  the scene is running.
+ ***********************************************************/
+class UniformCache
+{
+public:
+	// remember the currently active shader program
+	static void BindActiveProgram();
+	// resolve the location of the named uniform
+	static GLint Lookup(const char* uniformName);
+	// resolve the location of the named vertex attribute
+	static GLint LookupAttribute(const char* attributeName);
+	// attach the named uniform block to a buffer binding point
+	static bool BindBlock(const char* blockName, GLuint bindingPoint);
+	// attach the named shader storage block to a buffer binding point
+	static bool BindStorageBlock(const char* blockName, GLuint bindingPoint);
+
+	// reset the lookup counter at the start of each frame
+	static void ResetFrameLookups();
+	// number of name lookups since the last reset
+	static int GetFrameLookups();
+
+private:
+	// shader program that the locations belong to
+	static GLuint m_programID;
+	// name lookups since the last reset
+	static int m_frameLookups;
+};
@@ -8,20 +8,54 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "ViewManager.h"
+#include "RingBuffer.h"
+#include "FrameCapture.h"
 
 // GLM Math Header inclusions
 #include <glm/glm.hpp>
 #include <glm/gtx/transform.hpp>
 #include <glm/gtc/type_ptr.hpp>    
 
+#include <cmath>
+#include <cstring>
+
 // declaration of the global variables and defines
 namespace
 {
 	// Variables for window width and height
 	const int WINDOW_WIDTH = 1000;
 	const int WINDOW_HEIGHT = 800;
+	// size of the display window in pixels, which follows the
+	// window as it is resized
+	int gWindowWidth = WINDOW_WIDTH;
+	int gWindowHeight = WINDOW_HEIGHT;
 	const char* g_ViewName = "view";
 	const char* g_ProjectionName = "projection";
+	const char* g_ViewPositionName = "viewPosition";
+	// distances of the near and far clipping planes
+	const float NEAR_PLANE = 0.1f;
+	const float FAR_PLANE = 100.0f;
+
+	// the view values are written into the per-frame ring buffer
+	// when the shader declares them in a uniform block:
+	//
+	//   layout(std140) uniform ViewBlock
+	//   {
+	//       mat4 view;
+	//       mat4 projection;
+	//       vec4 viewPosition;
+	//   };
+	const char* g_ViewBlockName = "ViewBlock";
+
+	// std140 layout of the view block
+	struct VIEW_BLOCK_STD140
+	{
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::vec4 viewPosition;
+	};
+
+	static_assert(sizeof(VIEW_BLOCK_STD140) == 144, "view block must match the std140 layout");
 
 	// camera object used for viewing and interacting with
 	// the 3D scene
@@ -35,6 +69,8 @@ namespace
 	// time between current frame and last frame
 	float gDeltaTime = 0.0f; 
 	float gLastFrame = 0.0f;
+	// time of the last prepared view, for the recorded frame times
+	float gLastViewTime = -1.0f;
 
 	// the following variable is false when orthographic projection
 	// is off and true when it is on
@@ -52,6 +88,19 @@ ViewManager::ViewManager(
 	// initialize the member variables
 	m_pShaderManager = pShaderManager;
 	m_pWindow = NULL;
+	m_viewLocation = -1;
+	m_projectionLocation = -1;
+	m_viewPositionLocation = -1;
+	m_bViewBuffer = false;
+	m_bFixedUpdate = false;
+	m_viewBuffer = 0;
+	m_uniformBufferAlignment = 256;
+	m_viewWidth = WINDOW_WIDTH;
+	m_viewHeight = WINDOW_HEIGHT;
+	m_aspectRatio = (float)WINDOW_WIDTH / (float)WINDOW_HEIGHT;
+	m_view = glm::mat4(1.0f);
+	m_projection = glm::mat4(1.0f);
+	m_viewProjection = glm::mat4(1.0f);
 	g_pCamera = new Camera();
 	// default camera view parameters
 	g_pCamera->Position = glm::vec3(1.0f, 5.0f, 12.0f);
@@ -70,6 +119,11 @@ ViewManager::~ViewManager()
 	// free up allocated memory
 	m_pShaderManager = NULL;
 	m_pWindow = NULL;
+	if (0 != m_viewBuffer)
+	{
+		glDeleteBuffers(1, &m_viewBuffer);
+		m_viewBuffer = 0;
+	}
 	if (NULL != g_pCamera)
 	{
 		delete g_pCamera;
@@ -100,6 +154,12 @@ GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
 	}
 	glfwMakeContextCurrent(window);
 
+	// the framebuffer can have more pixels than the window on a
+	// high density display
+	glfwGetFramebufferSize(window, &gWindowWidth, &gWindowHeight);
+	// this callback is used to receive window resizing events
+	glfwSetFramebufferSizeCallback(window, &ViewManager::Framebuffer_Size_Callback);
+
 	// this callback is used to receive mouse moving events
 	glfwSetCursorPosCallback(window, &ViewManager::Mouse_Position_Callback);
 
@@ -118,6 +178,128 @@ GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
 	return(window);
 }
 
+/***********************************************************
+ *  CreateOffscreenWindow()
+ *
+ *  This method is used to create a hidden window for the
+ *  headless mode.  The window is never shown and only holds
+ *  the OpenGL context, the scene is drawn into a framebuffer
+ *  object instead.
+ ***********************************************************/
+GLFWwindow* ViewManager::CreateOffscreenWindow(const char* windowTitle)
+{
+	GLFWwindow* window = nullptr;
+
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	window = glfwCreateWindow(1, 1, windowTitle, NULL, NULL);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+	if (window == NULL)
+	{
+		std::cout << "Failed to create hidden GLFW window" << std::endl;
+		glfwTerminate();
+		return NULL;
+	}
+	glfwMakeContextCurrent(window);
+
+	// enable blending for supporting tranparent rendering
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	m_pWindow = window;
+
+	return(window);
+}
+
+/***********************************************************
+ *  SetViewSize()
+ *
+ *  This method is used to set the size of the rendered image,
+ *  which the projection matrix uses for the aspect ratio.
+ ***********************************************************/
+void ViewManager::SetViewSize(int width, int height)
+{
+	if ((width > 0) && (height > 0))
+	{
+		m_viewWidth = width;
+		m_viewHeight = height;
+		m_aspectRatio = (float)width / (float)height;
+	}
+}
+
+/***********************************************************
+ *  SetAspectRatio()
+ *
+ *  This method is used to set the aspect ratio from the size
+ *  the rendered image is stretched to, after SetViewSize().
+ *  A scaled image has its sides rounded separately, so its
+ *  own size is slightly off the aspect ratio of the window.
+ ***********************************************************/
+void ViewManager::SetAspectRatio(int displayWidth, int displayHeight)
+{
+	if ((displayWidth > 0) && (displayHeight > 0))
+	{
+		m_aspectRatio = (float)displayWidth / (float)displayHeight;
+	}
+}
+
+/***********************************************************
+ *  Framebuffer_Size_Callback()
+ *
+ *  This method is automatically called from GLFW whenever
+ *  the size of the display window changes.  A minimized
+ *  window has no size and keeps the size it had before.
+ ***********************************************************/
+void ViewManager::Framebuffer_Size_Callback(GLFWwindow* window, int width, int height)
+{
+	if ((width > 0) && (height > 0))
+	{
+		gWindowWidth = width;
+		gWindowHeight = height;
+	}
+}
+
+/***********************************************************
+ *  GetWindowWidth()
+ *
+ *  This method is used for getting the width of the display
+ *  window in pixels.
+ ***********************************************************/
+int ViewManager::GetWindowWidth() const
+{
+	return(gWindowWidth);
+}
+
+/***********************************************************
+ *  GetWindowHeight()
+ *
+ *  This method is used for getting the height of the display
+ *  window in pixels.
+ ***********************************************************/
+int ViewManager::GetWindowHeight() const
+{
+	return(gWindowHeight);
+}
+
+/***********************************************************
+ *  CacheUniformLocations()
+ *
+ *  This method is used for resolving the view and projection
+ *  uniform locations once after the shader program has been
+ *  loaded and activated.
+ ***********************************************************/
+void ViewManager::CacheUniformLocations()
+{
+	UniformCache::BindActiveProgram();
+
+	m_viewLocation = UniformCache::Lookup(g_ViewName);
+	m_projectionLocation = UniformCache::Lookup(g_ProjectionName);
+	m_viewPositionLocation = UniformCache::Lookup(g_ViewPositionName);
+
+	// the view block is only used when the shader declares it
+	m_bViewBuffer = UniformCache::BindBlock(g_ViewBlockName, VIEW_BLOCK_BINDING);
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &m_uniformBufferAlignment);
+}
+
 /***********************************************************
  *  Mouse_Position_Callback()
  *
@@ -144,6 +326,13 @@ void ViewManager::Mouse_Position_Callback(GLFWwindow* window, double xMousePos,
 	gLastX = xMousePos;
 	gLastY = yMousePos;
 
+	// the replayed poses already contain the recorded mouse movement
+	if (FrameCapture::IsReplaying() == true)
+	{
+		return;
+	}
+	FrameCapture::AddMouseMovement(xOffset, yOffset);
+
 	// move the 3D camera according to the calculated offsets
 	g_pCamera->ProcessMouseMovement(xOffset, yOffset);
 }
@@ -162,12 +351,32 @@ void ViewManager::ProcessKeyboardEvents()
 		glfwSetWindowShouldClose(m_pWindow, true);
 	}
 
-	// if the camera object is null, then exit this method
-	if (NULL == g_pCamera)
+	// if the camera object is null, or the camera is driven by a
+	// replay, then exit this method
+	if ((NULL == g_pCamera) || (FrameCapture::IsReplaying() == true))
 	{
 		return;
 	}
 
+	// the keys held down are recorded with the frame
+	if (FrameCapture::IsRecording() == true)
+	{
+		const int keyCodes[8] = { GLFW_KEY_W, GLFW_KEY_S, GLFW_KEY_A, GLFW_KEY_D,
+			GLFW_KEY_Q, GLFW_KEY_E, GLFW_KEY_P, GLFW_KEY_O };
+		const unsigned int keyBits[8] = { FrameCapture::KEY_FORWARD, FrameCapture::KEY_BACKWARD,
+			FrameCapture::KEY_LEFT, FrameCapture::KEY_RIGHT, FrameCapture::KEY_UP,
+			FrameCapture::KEY_DOWN, FrameCapture::KEY_PERSPECTIVE, FrameCapture::KEY_ORTHOGRAPHIC };
+		unsigned int keys = 0;
+		for (int i = 0; i < 8; i++)
+		{
+			if (glfwGetKey(m_pWindow, keyCodes[i]) == GLFW_PRESS)
+			{
+				keys |= keyBits[i];
+			}
+		}
+		FrameCapture::AddKeys(keys);
+	}
+
 	// process camera zooming in and out
 	if (glfwGetKey(m_pWindow, GLFW_KEY_W) == GLFW_PRESS)
 	{
@@ -216,6 +425,23 @@ void ViewManager::ProcessKeyboardEvents()
 
 }
 
+/***********************************************************
+ *  UpdateView()
+ *
+ *  This method is used for moving the camera by one fixed
+ *  timestep of the keyboard input.  Once the main loop calls
+ *  this, PrepareSceneView() only builds the matrices from the
+ *  camera, so the camera speed no longer depends on the frame
+ *  rate.
+ ***********************************************************/
+void ViewManager::UpdateView(float deltaTime)
+{
+	m_bFixedUpdate = true;
+
+	gDeltaTime = deltaTime;
+	ProcessKeyboardEvents();
+}
+
 /***********************************************************
  *  PrepareSceneView()
  *
@@ -228,14 +454,55 @@ void ViewManager::PrepareSceneView()
 	glm::mat4 view;
 	glm::mat4 projection;
 
-	// per-frame timing
-	float currentFrame = glfwGetTime();
-	gDeltaTime = currentFrame - gLastFrame;
-	gLastFrame = currentFrame;
+	// without the fixed timestep updates, the camera moves by
+	// the time since the last frame
+	if (m_bFixedUpdate == false)
+	{
+		// per-frame timing
+		float currentFrame = glfwGetTime();
+		gDeltaTime = currentFrame - gLastFrame;
+		gLastFrame = currentFrame;
+
+		// process any keyboard events that may be waiting in the 
+		// event queue
+		ProcessKeyboardEvents();
+	}
 
-	// process any keyboard events that may be waiting in the 
-	// event queue
-	ProcessKeyboardEvents();
+	// a replay sets the recorded camera pose, and a recording keeps
+	// the pose that the input of this frame led to
+	float viewTime = (float)glfwGetTime();
+	FrameCapture::CAPTURE_FRAME frame = {};
+	if (FrameCapture::NextReplayFrame(frame) == true)
+	{
+		gDeltaTime = frame.deltaTime;
+		g_pCamera->Position = glm::vec3(frame.position[0], frame.position[1], frame.position[2]);
+		g_pCamera->Front = glm::vec3(frame.front[0], frame.front[1], frame.front[2]);
+		g_pCamera->Up = glm::vec3(frame.up[0], frame.up[1], frame.up[2]);
+		g_pCamera->Zoom = frame.zoom;
+		bOrthographicProjection = frame.bOrthographic;
+
+		// the mouse turns the camera by its angles, which are taken
+		// from the replayed front so the camera does not jump back
+		// once the replay ends
+		glm::vec3 front = glm::normalize(g_pCamera->Front);
+		g_pCamera->Pitch = glm::degrees(std::asin(glm::clamp(front.y, -1.0f, 1.0f)));
+		g_pCamera->Yaw = glm::degrees(std::atan2(front.z, front.x));
+		g_pCamera->Right = glm::normalize(glm::cross(front, g_pCamera->WorldUp));
+	}
+	else if (FrameCapture::IsRecording() == true)
+	{
+		frame.deltaTime = (gLastViewTime >= 0.0f) ? viewTime - gLastViewTime : 0.0f;
+		for (int i = 0; i < 3; i++)
+		{
+			frame.position[i] = g_pCamera->Position[i];
+			frame.front[i] = g_pCamera->Front[i];
+			frame.up[i] = g_pCamera->Up[i];
+		}
+		frame.zoom = g_pCamera->Zoom;
+		frame.bOrthographic = bOrthographicProjection;
+		FrameCapture::RecordFrame(frame);
+	}
+	gLastViewTime = viewTime;
 
 	// get the current view matrix from the camera
 	view = g_pCamera->GetViewMatrix();
@@ -244,41 +511,189 @@ void ViewManager::PrepareSceneView()
 	if (bOrthographicProjection == false)
 	{
 		// perspective projection
-		projection = glm::perspective(glm::radians(g_pCamera->Zoom), (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT, 0.1f, 100.0f);
+		projection = glm::perspective(glm::radians(g_pCamera->Zoom), m_aspectRatio, NEAR_PLANE, FAR_PLANE);
 	}
 	else
 	{
 		// front-view orthographic projection with correct aspect ratio
 		double scale = 0.0;
-		if (WINDOW_WIDTH > WINDOW_HEIGHT)
+		if (m_aspectRatio > 1.0f)
 		{
-			scale = (double)WINDOW_HEIGHT / (double)WINDOW_WIDTH;
-			projection = glm::ortho(-10.0f, 7.5f, -5.0f * (float)scale, 5.0f * (float)scale, 0.1f, 100.0f);
+			scale = 1.0 / (double)m_aspectRatio;
+			projection = glm::ortho(-10.0f, 7.5f, -5.0f * (float)scale, 5.0f * (float)scale, NEAR_PLANE, FAR_PLANE);
 		}
-		else if (WINDOW_WIDTH < WINDOW_HEIGHT)
+		else if (m_aspectRatio < 1.0f)
 		{
-			scale = (double)WINDOW_WIDTH / (double)WINDOW_HEIGHT;
-			projection = glm::ortho(-5.0f * (float)scale, 5.0f * (float)scale, -5.0f, 5.0f, 0.1f, 100.0f);
+			scale = (double)m_aspectRatio;
+			projection = glm::ortho(-5.0f * (float)scale, 5.0f * (float)scale, -5.0f, 5.0f, NEAR_PLANE, FAR_PLANE);
 		}
 		else
 		{
-			projection = glm::ortho(-10.0f, 8.0f, -5.0f, 5.0f, 0.1f, 100.0f);
+			projection = glm::ortho(-10.0f, 8.0f, -5.0f, 5.0f, NEAR_PLANE, FAR_PLANE);
 		}
 	}
 
-	// if the shader manager object is valid
-	if (NULL != m_pShaderManager)
+	if (m_bViewBuffer == true)
+	{
+		VIEW_BLOCK_STD140 viewBlock;
+		viewBlock.view = view;
+		viewBlock.projection = projection;
+		viewBlock.viewPosition = glm::vec4(g_pCamera->Position, 1.0f);
+
+		// write the view values into this frame's section of the
+		// ring buffer, where the GPU reads them without waiting on
+		// the earlier frames
+		GLintptr viewBlockOffset = 0;
+		void* pViewBlock = RingBuffer::Allocate(
+			sizeof(VIEW_BLOCK_STD140), m_uniformBufferAlignment, viewBlockOffset);
+		if (NULL != pViewBlock)
+		{
+			memcpy(pViewBlock, &viewBlock, sizeof(VIEW_BLOCK_STD140));
+			glBindBufferRange(GL_UNIFORM_BUFFER, VIEW_BLOCK_BINDING,
+				RingBuffer::GetBuffer(), viewBlockOffset, sizeof(VIEW_BLOCK_STD140));
+		}
+		else
+		{
+			// without the ring buffer the block storage is replaced
+			// every frame, so the driver can hand out fresh memory
+			if (0 == m_viewBuffer)
+			{
+				glGenBuffers(1, &m_viewBuffer);
+			}
+			glBindBuffer(GL_UNIFORM_BUFFER, m_viewBuffer);
+			glBufferData(GL_UNIFORM_BUFFER, sizeof(VIEW_BLOCK_STD140), &viewBlock, GL_STREAM_DRAW);
+			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+			glBindBufferBase(GL_UNIFORM_BUFFER, VIEW_BLOCK_BINDING, m_viewBuffer);
+		}
+	}
+	else
 	{
 		// set the view matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ViewName, view);
-		// set the view matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ProjectionName, projection);
+		GLState::UniformMatrix4(m_viewLocation, view);
+		// set the projection matrix into the shader for proper rendering
+		GLState::UniformMatrix4(m_projectionLocation, projection);
 		// set the view position of the camera into the shader for proper rendering
-		m_pShaderManager->setVec3Value("viewPosition", g_pCamera->Position);
+		GLState::Uniform3f(m_viewPositionLocation, g_pCamera->Position);
+	}
+
+	m_view = view;
+	m_projection = projection;
+	m_viewProjection = projection * view;
+}
+
+/***********************************************************
+ *  GetViewProjection()
+ *
+ *  This method is used for getting the combined view and
+ *  projection matrix of the last prepared view, which the
+ *  scene is culled against.
+ ***********************************************************/
+const glm::mat4& ViewManager::GetViewProjection() const
+{
+	return(m_viewProjection);
+}
+
+/***********************************************************
+ *  GetView()
+ *
+ *  This method is used for getting the view matrix of the
+ *  last prepared view.
+ ***********************************************************/
+const glm::mat4& ViewManager::GetView() const
+{
+	return(m_view);
+}
+
+/***********************************************************
+ *  GetProjection()
+ *
+ *  This method is used for getting the projection matrix of
+ *  the last prepared view.
+ ***********************************************************/
+const glm::mat4& ViewManager::GetProjection() const
+{
+	return(m_projection);
+}
+
+/***********************************************************
+ *  GetNearPlane()
+ *
+ *  This method is used for getting the distance of the near
+ *  clipping plane of both projections.
+ ***********************************************************/
+float ViewManager::GetNearPlane() const
+{
+	return(NEAR_PLANE);
+}
+
+/***********************************************************
+ *  GetFarPlane()
+ *
+ *  This method is used for getting the distance of the far
+ *  clipping plane of both projections.
+ ***********************************************************/
+float ViewManager::GetFarPlane() const
+{
+	return(FAR_PLANE);
+}
+
+/***********************************************************
+ *  GetCameraPosition()
+ *
+ *  This method is used for getting the position of the
+ *  camera in world space.
+ ***********************************************************/
+glm::vec3 ViewManager::GetCameraPosition() const
+{
+	return(g_pCamera->Position);
+}
+
+/***********************************************************
+ *  GetFieldOfView()
+ *
+ *  This method is used for getting the vertical field of view
+ *  of the perspective projection in degrees, or zero for the
+ *  orthographic projection, where the size of an object on
+ *  screen does not depend on its distance.
+ ***********************************************************/
+float ViewManager::GetFieldOfView() const
+{
+	if (bOrthographicProjection == true)
+	{
+		return(0.0f);
 	}
+	return(g_pCamera->Zoom);
+}
+
+/***********************************************************
+ *  GetViewWidth()
+ *
+ *  This method is used for getting the width of the rendered
+ *  image in pixels.
+ ***********************************************************/
+int ViewManager::GetViewWidth() const
+{
+	return(m_viewWidth);
+}
+
+/***********************************************************
+ *  GetViewHeight()
+ *
+ *  This method is used for getting the height of the rendered
+ *  image in pixels.
+ ***********************************************************/
+int ViewManager::GetViewHeight() const
+{
+	return(m_viewHeight);
 }
 //add code to control speep with scroll wheel
 void ViewManager::Mouse_Scroll_Wheel_Callback(GLFWwindow* window, double xOffset, double yOffset)
 {
+	if (FrameCapture::IsReplaying() == true)
+	{
+		return;
+	}
+	FrameCapture::AddScroll((float)yOffset);
+
 	g_pCamera->ProcessMouseScroll(yOffset);
 }
\ No newline at end of file
@@ -10,6 +10,8 @@
 #pragma once
 
 #include "ShaderManager.h"
+#include "UniformCache.h"
+#include "GLState.h"
 #include "camera.h"
 
 // GLFW library
@@ -24,16 +26,41 @@ public:
 	// destructor
 	~ViewManager();
 
+	// uniform buffer binding point of the ViewBlock of the shaders
+	static const GLuint VIEW_BLOCK_BINDING = 2;
+
 	// mouse position callback for mouse interaction with the 3D scene
 	static void Mouse_Position_Callback(GLFWwindow* window, double xMousePos, double yMousePos);
 
 	static void Mouse_Scroll_Wheel_Callback(GLFWwindow* window, double xOffset, double yOffset);
 
+	// window size callback for following the resized window
+	static void Framebuffer_Size_Callback(GLFWwindow* window, int width, int height);
+
 private:
 	// pointer to shader manager object
 	ShaderManager* m_pShaderManager;
 	// active OpenGL display window
 	GLFWwindow* m_pWindow;
+	// cached shader uniform locations
+	GLint m_viewLocation;
+	GLint m_projectionLocation;
+	GLint m_viewPositionLocation;
+	// true when the shader reads the view values from a uniform block
+	bool m_bViewBuffer;
+	GLuint m_viewBuffer;
+	GLint m_uniformBufferAlignment;
+	// true once the camera is moved by the fixed timestep updates
+	bool m_bFixedUpdate;
+	// size of the rendered image, and the aspect ratio of the
+	// image it is shown as
+	int m_viewWidth;
+	int m_viewHeight;
+	float m_aspectRatio;
+	// view and projection matrices of the last prepared view
+	glm::mat4 m_view;
+	glm::mat4 m_projection;
+	glm::mat4 m_viewProjection;
 
 	// process keyboard events for interaction with the 3D scene
 	void ProcessKeyboardEvents();
@@ -41,7 +68,35 @@ private:
 public:
 	// create the initial OpenGL display window
 	GLFWwindow* CreateDisplayWindow(const char* windowTitle);
+	// create a hidden window that only provides the OpenGL context
+	GLFWwindow* CreateOffscreenWindow(const char* windowTitle);
+
+	// set the size of the rendered image, which also sets the
+	// aspect ratio unless it is shown stretched to another size
+	void SetViewSize(int width, int height);
+	void SetAspectRatio(int displayWidth, int displayHeight);
+	// size of the display window in pixels
+	int GetWindowWidth() const;
+	int GetWindowHeight() const;
+
+	// resolve the shader uniform locations used for the view
+	void CacheUniformLocations();
 	
+	// move the camera by one fixed timestep of the keyboard input
+	void UpdateView(float deltaTime);
 	// prepare the conversion from 3D object display to 2D scene display
 	void PrepareSceneView();
+	// combined view and projection matrix of the last prepared view
+	const glm::mat4& GetViewProjection() const;
+	// view and projection matrices of the last prepared view
+	const glm::mat4& GetView() const;
+	const glm::mat4& GetProjection() const;
+	// distances of the clipping planes
+	float GetNearPlane() const;
+	float GetFarPlane() const;
+	// camera values for picking the levels of detail
+	glm::vec3 GetCameraPosition() const;
+	float GetFieldOfView() const;
+	int GetViewWidth() const;
+	int GetViewHeight() const;
 };
\ No newline at end of file